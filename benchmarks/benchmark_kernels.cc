@@ -0,0 +1,374 @@
+/**
+ * @file   benchmark_kernels.cc
+ *
+ * @author Lars Pastewka <lars.pastewka@imtek.uni-freiburg.de>
+ *
+ * @date   16 Oct 2026
+ *
+ * @brief  Throughput of the core kernels of muGrid: gradient operator,
+ *         field maps, strided copies, field registration and NetCDF
+ *         output
+ *
+ * Copyright © 2026 Lars Pastewka
+ *
+ * µGrid is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * µGrid is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with µGrid; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * Additional permission under GNU GPL version 3 section 7
+ *
+ * If you modify this Program, or any covered work, by linking or combining it
+ * with proprietary FFT implementations or numerical libraries, containing parts
+ * covered by the terms of those libraries' licenses, the licensors of this
+ * Program grant you additional permission to convey the resulting work.
+ *
+ */
+
+#include "benchmarks.hh"
+
+#include "libmugrid/cartesian_decomposition.hh"
+#include "libmugrid/field_collection_global.hh"
+#include "libmugrid/field_expression.hh"
+#include "libmugrid/field_linalg.hh"
+#include "libmugrid/field_map.hh"
+#include "libmugrid/field_map_static.hh"
+#include "libmugrid/field_typed.hh"
+#include "libmugrid/raw_memory_operations.hh"
+#include "libmugrid/tensor_algebra.hh"
+
+#ifdef WITH_NETCDF_IO
+#include "libmugrid/file_io_netcdf.hh"
+#endif
+
+#include <cstdio>
+
+using muGrid::DynCcoord_t;
+using muGrid::GlobalFieldCollection;
+using muGrid::Index_t;
+using muGrid::Real;
+using muGrid::Shape_t;
+using muGrid::benchmarks::Harness;
+using muGrid::benchmarks::Parameters_t;
+
+//! parameters common to all benchmarks on a grid
+Parameters_t grid_parameters(const DynCcoord_t & nb_grid_pts,
+                             const Index_t & nb_components) {
+  std::stringstream grid{};
+  grid << nb_grid_pts;
+  return {{"dim", std::to_string(nb_grid_pts.get_dim()) + "D"},
+          {"grid", grid.str()},
+          {"components", std::to_string(nb_components)}};
+}
+
+//! gradient of a nodal field on the multilinear element
+void benchmark_apply_gradient(Harness & harness,
+                              const DynCcoord_t & nb_grid_pts,
+                              const Index_t & nb_components) {
+  const Index_t dim{nb_grid_pts.get_dim()};
+  auto && op{muGrid::benchmarks::make_multilinear_operator(dim)};
+  GlobalFieldCollection collection{nb_grid_pts, nb_grid_pts};
+  collection.set_nb_sub_pts("quad", op.get_nb_pixel_quad_pts());
+  collection.set_nb_sub_pts("nodal", op.get_nb_pixel_nodal_pts());
+  auto & nodal_field{
+      collection.register_real_field("nodal", nb_components, "nodal")};
+  auto & quad_field{
+      collection.register_real_field("quad", dim * nb_components, "quad")};
+  nodal_field.eigen_vec().setRandom();
+
+  const Real nb_pixels{static_cast<Real>(collection.get_nb_pixels())};
+  const Real bytes{static_cast<Real>(
+      sizeof(Real) *
+      (nodal_field.get_buffer_size() + quad_field.get_buffer_size()))};
+  harness.run("apply_gradient", grid_parameters(nb_grid_pts, nb_components),
+              bytes, nb_pixels,
+              [&]() { op.apply_gradient(nodal_field, quad_field); });
+}
+
+//! gradient of a nodal field on subdomains with ghost layers, which are
+//! either filled before applying the operator or while it evaluates the
+//! interior
+void benchmark_ghosted_gradient(Harness & harness,
+                                const DynCcoord_t & nb_grid_pts,
+                                const Index_t & nb_components,
+                                const muGrid::Communicator & comm) {
+  const Index_t dim{nb_grid_pts.get_dim()};
+  auto && op{muGrid::benchmarks::make_multilinear_operator(dim)};
+  muGrid::CartesianDecomposition decomposition{nb_grid_pts, comm};
+  GlobalFieldCollection collection{dim};
+  const DynCcoord_t nb_ghosts{muGrid::CcoordOps::get_cube(dim, Index_t{1})};
+  decomposition.initialise(collection, nb_ghosts, nb_ghosts);
+  collection.set_nb_sub_pts("quad", op.get_nb_pixel_quad_pts());
+  collection.set_nb_sub_pts("nodal", op.get_nb_pixel_nodal_pts());
+  auto & nodal_field{
+      collection.register_real_field("nodal", nb_components, "nodal")};
+  auto & quad_field{
+      collection.register_real_field("quad", dim * nb_components, "quad")};
+  nodal_field.eigen_vec().setRandom();
+
+  const Real nb_pixels{static_cast<Real>(
+      muGrid::CcoordOps::get_size(collection.get_nb_subdomain_grid_pts()))};
+  const Real bytes{static_cast<Real>(
+      sizeof(Real) *
+      (nodal_field.get_buffer_size() + quad_field.get_buffer_size()))};
+  for (bool overlapping : {false, true}) {
+    auto && parameters{grid_parameters(nb_grid_pts, nb_components)};
+    parameters.emplace_back("ghosts", overlapping ? "overlapping" : "manual");
+    parameters.emplace_back("ranks", std::to_string(comm.size()));
+    harness.run("apply_gradient_ghosted", parameters, bytes, nb_pixels,
+                [&]() {
+                  if (overlapping) {
+                    op.begin_apply_gradient<Real>({&nodal_field},
+                                                  {&quad_field})
+                        .finish();
+                  } else {
+                    nodal_field.communicate_ghosts();
+                    op.apply_gradient(nodal_field, quad_field);
+                  }
+                });
+  }
+}
+
+//! iteration over the per-pixel and per-sub-point maps of a field
+void benchmark_field_map(Harness & harness, const DynCcoord_t & nb_grid_pts,
+                         const Index_t & nb_components) {
+  GlobalFieldCollection collection{nb_grid_pts, nb_grid_pts};
+  collection.set_nb_sub_pts("quad", 4);
+  auto & field{
+      collection.register_real_field("field", nb_components, "quad")};
+  field.eigen_vec().setRandom();
+  auto && pixel_map{field.get_pixel_map()};
+  auto && sub_pt_map{field.get_sub_pt_map()};
+
+  const Real bytes{static_cast<Real>(sizeof(Real) * field.get_buffer_size())};
+  // the sums are stored to keep the loops from being optimised away
+  volatile Real sink{0.};
+  harness.run("field_map_pixels", grid_parameters(nb_grid_pts, nb_components),
+              bytes, static_cast<Real>(collection.get_nb_pixels()), [&]() {
+                Real sum{0.};
+                for (auto && value : pixel_map) {
+                  sum += value.sum();
+                }
+                sink = sum;
+              });
+  harness.run("field_map_sub_pts",
+              grid_parameters(nb_grid_pts, nb_components), bytes,
+              static_cast<Real>(field.get_nb_entries()), [&]() {
+                Real sum{0.};
+                for (auto && value : sub_pt_map) {
+                  sum += value.sum();
+                }
+                sink = sum;
+              });
+}
+
+//! stress σ = C:ε per quadrature point and in SIMD batches
+template <Index_t Dim>
+void benchmark_tensmult(Harness & harness, const DynCcoord_t & nb_grid_pts,
+                        const muGrid::StorageOrder & storage_order) {
+  using muGrid::IterUnit;
+  using muGrid::Mapping;
+  GlobalFieldCollection collection{nb_grid_pts,
+                                   nb_grid_pts,
+                                   DynCcoord_t(nb_grid_pts.get_dim()),
+                                   muGrid::StorageOrder::ColMajor,
+                                   {{"quad", 2}},
+                                   storage_order};
+  const Shape_t t2_shape{Dim, Dim};
+  const Shape_t t4_shape{Dim * Dim, Dim * Dim};
+  auto & strain{collection.register_real_field("strain", t2_shape, "quad")};
+  auto & stiffness{
+      collection.register_real_field("stiffness", t4_shape, "quad")};
+  auto & stress{collection.register_real_field("stress", t2_shape, "quad")};
+  strain.eigen_vec().setRandom();
+  stiffness.eigen_vec().setRandom();
+  muGrid::StridedT2FieldMap<Real, Mapping::Const, Dim, IterUnit::SubPt>
+      strain_map{strain};
+  muGrid::StridedT4FieldMap<Real, Mapping::Const, Dim, IterUnit::SubPt>
+      stiffness_map{stiffness};
+  muGrid::StridedT2FieldMap<Real, Mapping::Mut, Dim, IterUnit::SubPt>
+      stress_map{stress};
+
+  auto parameters{grid_parameters(nb_grid_pts, Dim * Dim)};
+  parameters.emplace_back(
+      "storage", storage_order == muGrid::StorageOrder::ColMajor ? "AoS"
+                                                                 : "SoA");
+  const Real bytes{static_cast<Real>(
+      sizeof(Real) * (strain.get_buffer_size() + stiffness.get_buffer_size() +
+                      stress.get_buffer_size()))};
+  const Real nb_points{static_cast<Real>(strain.get_nb_entries())};
+  harness.run("tensmult_per_point", parameters, bytes, nb_points, [&]() {
+    for (auto && tup : akantu::zip(strain_map, stiffness_map, stress_map)) {
+      std::get<2>(tup) =
+          muGrid::Matrices::tensmult(std::get<1>(tup), std::get<0>(tup));
+    }
+  });
+  harness.run("tensmult_batched", parameters, bytes, nb_points, [&]() {
+    for (auto && tup : akantu::zip(strain_map.batches(),
+                                   stiffness_map.batches(),
+                                   stress_map.batches())) {
+      std::get<2>(tup).store(muGrid::Batches::tensmult<Dim>(
+          std::get<1>(tup).load(), std::get<0>(tup).load()));
+    }
+  });
+}
+
+//! y ← αx + y on the threads of the field operations
+void benchmark_axpy(Harness & harness, const DynCcoord_t & nb_grid_pts,
+                    const Index_t & nb_components) {
+  GlobalFieldCollection collection{nb_grid_pts, nb_grid_pts};
+  auto & x{collection.register_real_field("x", nb_components)};
+  auto & y{collection.register_real_field("y", nb_components)};
+  x.eigen_vec().setRandom();
+  y.eigen_vec().setRandom();
+  const Real nb_values{static_cast<Real>(x.get_nb_entries() * nb_components)};
+  const Real bytes{3 * nb_values * sizeof(Real)};
+  for (Index_t nb_threads : {1, 4}) {
+    muGrid::linalg::set_nb_threads(nb_threads);
+    auto && parameters{grid_parameters(nb_grid_pts, nb_components)};
+    parameters.emplace_back("threads", std::to_string(nb_threads));
+    harness.run("axpy", parameters, bytes, nb_values,
+                [&]() { muGrid::linalg::axpy(Real{.5}, x, y); });
+  }
+  muGrid::linalg::set_nb_threads(1);
+}
+
+//! c = a + αb - d evaluated as a fused expression
+void benchmark_field_expression(Harness & harness,
+                                const DynCcoord_t & nb_grid_pts,
+                                const Index_t & nb_components) {
+  GlobalFieldCollection collection{nb_grid_pts, nb_grid_pts};
+  auto & a{collection.register_real_field("a", nb_components)};
+  auto & b{collection.register_real_field("b", nb_components)};
+  auto & c{collection.register_real_field("c", nb_components)};
+  auto & d{collection.register_real_field("d", nb_components)};
+  a.eigen_vec().setRandom();
+  b.eigen_vec().setRandom();
+  d.eigen_vec().setRandom();
+  const Real nb_values{static_cast<Real>(a.get_nb_entries() * nb_components)};
+  const Real bytes{4 * nb_values * sizeof(Real)};
+  const Real alpha{.5};
+  harness.run("field_expression", grid_parameters(nb_grid_pts, nb_components),
+              bytes, nb_values, [&]() { c = a + alpha * b - d; });
+}
+
+//! conversion of a field from array-of-structures to structure-of-arrays
+//! storage order
+void benchmark_strided_copy(Harness & harness,
+                            const DynCcoord_t & nb_grid_pts,
+                            const Index_t & nb_components) {
+  const Index_t nb_pixels{
+      static_cast<Index_t>(muGrid::CcoordOps::get_size(nb_grid_pts))};
+  std::vector<Real> input(nb_components * nb_pixels, 1.),
+      output(nb_components * nb_pixels);
+  const Shape_t logical_shape{nb_components, nb_pixels};
+  const Shape_t aos_strides{1, nb_components}, soa_strides{nb_pixels, 1};
+
+  const Real bytes{static_cast<Real>(2 * sizeof(Real) * input.size())};
+  harness.run("strided_copy", grid_parameters(nb_grid_pts, nb_components),
+              bytes, static_cast<Real>(nb_pixels), [&]() {
+                muGrid::raw_mem_ops::strided_copy(logical_shape, aos_strides,
+                                                  soa_strides, input.data(),
+                                                  output.data());
+              });
+}
+
+//! registration of fields in a new collection, including their allocation
+void benchmark_register_field(Harness & harness,
+                              const DynCcoord_t & nb_grid_pts,
+                              const Index_t & nb_components) {
+  const Index_t nb_fields{16};
+  const Index_t nb_pixels{
+      static_cast<Index_t>(muGrid::CcoordOps::get_size(nb_grid_pts))};
+  const Real bytes{
+      static_cast<Real>(sizeof(Real) * nb_fields * nb_components * nb_pixels)};
+  harness.run("register_field", grid_parameters(nb_grid_pts, nb_components),
+              bytes, static_cast<Real>(nb_fields), [&]() {
+                GlobalFieldCollection collection{nb_grid_pts, nb_grid_pts};
+                for (Index_t i{0}; i < nb_fields; ++i) {
+                  collection.register_real_field(
+                      "field " + std::to_string(i), nb_components);
+                }
+              });
+}
+
+#ifdef WITH_NETCDF_IO
+//! writing a frame of a few fields to a NetCDF file
+void benchmark_netcdf_write(Harness & harness,
+                            const DynCcoord_t & nb_grid_pts,
+                            const Index_t & nb_components) {
+  const std::string file_name{"benchmark_netcdf_write.nc"};
+  const Index_t nb_fields{4};
+  GlobalFieldCollection collection{nb_grid_pts, nb_grid_pts};
+  for (Index_t i{0}; i < nb_fields; ++i) {
+    collection
+        .register_real_field("field " + std::to_string(i), nb_components)
+        .eigen_vec()
+        .setRandom();
+  }
+  const Index_t nb_pixels{collection.get_nb_pixels()};
+  const Real bytes{
+      static_cast<Real>(sizeof(Real) * nb_fields * nb_components * nb_pixels)};
+  harness.run("netcdf_write", grid_parameters(nb_grid_pts, nb_components),
+              bytes, static_cast<Real>(nb_pixels), [&]() {
+                muGrid::FileIONetCDF file{
+                    file_name, muGrid::FileIOBase::OpenMode::Overwrite};
+                file.register_field_collection(collection);
+                file.append_frame().write();
+                file.close();
+              });
+  std::remove(file_name.c_str());
+}
+#endif
+
+int main(int argc, char * argv[]) {
+#ifdef WITH_MPI
+  MPI_Init(&argc, &argv);
+#endif
+  Harness harness{"core muGrid kernels", argc, argv};
+#ifdef WITH_MPI
+  const muGrid::Communicator comm{MPI_COMM_WORLD};
+#else
+  const muGrid::Communicator comm{};
+#endif
+  for (auto && nb_grid_pts :
+       {DynCcoord_t{128, 128}, DynCcoord_t{512, 512}, DynCcoord_t{32, 32, 32},
+        DynCcoord_t{64, 64, 64}}) {
+    for (Index_t nb_components : {1, 3, 9}) {
+      benchmark_apply_gradient(harness, nb_grid_pts, nb_components);
+      benchmark_ghosted_gradient(harness, nb_grid_pts, nb_components, comm);
+      benchmark_field_map(harness, nb_grid_pts, nb_components);
+      benchmark_axpy(harness, nb_grid_pts, nb_components);
+      benchmark_field_expression(harness, nb_grid_pts, nb_components);
+      benchmark_strided_copy(harness, nb_grid_pts, nb_components);
+      benchmark_register_field(harness, nb_grid_pts, nb_components);
+#ifdef WITH_NETCDF_IO
+      benchmark_netcdf_write(harness, nb_grid_pts, nb_components);
+#endif
+    }
+    for (auto && storage_order :
+         {muGrid::StorageOrder::ColMajor, muGrid::StorageOrder::RowMajor}) {
+      if (nb_grid_pts.get_dim() == muGrid::twoD) {
+        benchmark_tensmult<muGrid::twoD>(harness, nb_grid_pts, storage_order);
+      } else {
+        benchmark_tensmult<muGrid::threeD>(harness, nb_grid_pts,
+                                           storage_order);
+      }
+    }
+  }
+  const int exit_code{harness.finalise()};
+#ifdef WITH_MPI
+  MPI_Finalize();
+#endif
+  return exit_code;
+}
@@ -0,0 +1,123 @@
+/**
+ * @file   benchmark_transpose.cc
+ *
+ * @author Lars Pastewka <lars.pastewka@imtek.uni-freiburg.de>
+ *
+ * @date   16 Oct 2026
+ *
+ * @brief  Compares the scatter and gather forms of the transpose of the
+ *         default gradient operator
+ *
+ * Copyright © 2026 Lars Pastewka
+ *
+ * µGrid is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * µGrid is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with µGrid; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * Additional permission under GNU GPL version 3 section 7
+ *
+ * If you modify this Program, or any covered work, by linking or combining it
+ * with proprietary FFT implementations or numerical libraries, containing parts
+ * covered by the terms of those libraries' licenses, the licensors of this
+ * Program grant you additional permission to convey the resulting work.
+ *
+ */
+
+
+#include "benchmarks.hh"
+
+#include "libmugrid/gradient_operator_default.hh"
+#include "libmugrid/field_collection_global.hh"
+#include "libmugrid/field_typed.hh"
+
+#include <algorithm>
+#include <iostream>
+
+using muGrid::DynCcoord_t;
+using muGrid::GlobalFieldCollection;
+using muGrid::Index_t;
+using muGrid::Real;
+using muGrid::TransposeAlgorithm;
+using muGrid::benchmarks::Harness;
+using muGrid::benchmarks::Parameters_t;
+
+/**
+ * times the scatter and gather forms of the transpose on `nb_grid_pts` and
+ * returns the largest relative difference of their results
+ */
+Real benchmark_transpose(Harness & harness, const DynCcoord_t & nb_grid_pts,
+                         const Index_t & nb_threads) {
+  const Index_t dim{nb_grid_pts.get_dim()};
+  const Index_t nb_components{1};
+  auto && op{muGrid::benchmarks::make_multilinear_operator(dim)};
+  op.set_nb_threads(nb_threads);
+
+  GlobalFieldCollection collection{nb_grid_pts, nb_grid_pts};
+  collection.set_nb_sub_pts("quad", op.get_nb_pixel_quad_pts());
+  collection.set_nb_sub_pts("nodal", op.get_nb_pixel_nodal_pts());
+  auto & quad_field{
+      collection.register_real_field("quad", dim * nb_components, "quad")};
+  auto & scattered{
+      collection.register_real_field("scatter", nb_components, "nodal")};
+  auto & gathered{
+      collection.register_real_field("gather", nb_components, "nodal")};
+  quad_field.eigen_vec().setRandom();
+
+  std::stringstream grid{};
+  grid << nb_grid_pts;
+  const Real nb_pixels{static_cast<Real>(collection.get_nb_pixels())};
+  const Real bytes{static_cast<Real>(
+      sizeof(Real) *
+      (quad_field.get_buffer_size() + scattered.get_buffer_size()))};
+  for (auto && algorithm :
+       {TransposeAlgorithm::Scatter, TransposeAlgorithm::Gather}) {
+    const bool scatter{algorithm == TransposeAlgorithm::Scatter};
+    const Parameters_t parameters{{"dim", std::to_string(dim) + "D"},
+                                  {"grid", grid.str()},
+                                  {"algorithm", scatter ? "scatter" : "gather"},
+                                  {"threads", std::to_string(nb_threads)}};
+    auto & nodal_field{scatter ? scattered : gathered};
+    op.set_transpose_algorithm(algorithm);
+    harness.run("apply_transpose", parameters, bytes, nb_pixels,
+                [&]() { op.apply_transpose(quad_field, nodal_field); });
+  }
+  // with a filter, only one of the forms may have been evaluated
+  if (scattered.eigen_vec().isZero(0.) or gathered.eigen_vec().isZero(0.)) {
+    return 0.;
+  }
+  return (gathered.eigen_vec() - scattered.eigen_vec())
+             .lpNorm<Eigen::Infinity>() /
+         scattered.eigen_vec().lpNorm<Eigen::Infinity>();
+}
+
+int main(int argc, char * argv[]) {
+  Harness harness{"transpose of the default gradient operator", argc, argv};
+  // both forms compute the same sums, merely in a different order
+  const Real tol{1e-12};
+  int exit_code{0};
+  for (auto && nb_grid_pts :
+       {DynCcoord_t{256, 256}, DynCcoord_t{1024, 1024}, DynCcoord_t{32, 32, 32},
+        DynCcoord_t{96, 96, 96}}) {
+    for (Index_t nb_threads : {1, 4}) {
+      const Real difference{
+          benchmark_transpose(harness, nb_grid_pts, nb_threads)};
+      if (not(difference <= tol)) {
+        std::cerr << "Scatter and gather transposes differ by " << difference
+                  << " on " << nb_grid_pts << std::endl;
+        exit_code = 1;
+      }
+    }
+  }
+  return std::max(harness.finalise(), exit_code);
+}
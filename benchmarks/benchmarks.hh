@@ -0,0 +1,294 @@
+/**
+ * @file   benchmarks.hh
+ *
+ * @author Lars Pastewka <lars.pastewka@imtek.uni-freiburg.de>
+ *
+ * @date   16 Oct 2026
+ *
+ * @brief  Minimal harness for timing muGrid kernels and reporting their
+ *         throughput as JSON
+ *
+ * Copyright © 2026 Lars Pastewka
+ *
+ * µGrid is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * µGrid is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with µGrid; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * Additional permission under GNU GPL version 3 section 7
+ *
+ * If you modify this Program, or any covered work, by linking or combining it
+ * with proprietary FFT implementations or numerical libraries, containing parts
+ * covered by the terms of those libraries' licenses, the licensors of this
+ * Program grant you additional permission to convey the resulting work.
+ *
+ */
+
+#include "libmugrid/gradient_operator_default.hh"
+#include "libmugrid/grid_common.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifndef BENCHMARKS_BENCHMARKS_HH_
+#define BENCHMARKS_BENCHMARKS_HH_
+
+namespace muGrid {
+
+  namespace benchmarks {
+
+    /**
+     * multilinear element (bilinear quadrilateral in 2D, trilinear
+     * hexahedron in 3D) on a unit pixel with a single quadrature point in
+     * its centre
+     */
+    inline GradientOperatorDefault
+    make_multilinear_operator(const Index_t & dim) {
+      const Index_t nb_nodes{ipow(2, dim)};
+      Eigen::MatrixXd B(dim, nb_nodes);
+      Eigen::MatrixXi pixel_offsets(nb_nodes, dim);
+      for (Index_t node{0}; node < nb_nodes; ++node) {
+        for (Index_t direction{0}; direction < dim; ++direction) {
+          const Index_t offset{(node >> direction) & 1};
+          pixel_offsets(node, direction) = offset;
+          B(direction, node) = (2. * offset - 1.) / ipow(2, dim - 1);
+        }
+      }
+      const Index_t nb_quad_pts{1}, nb_elements{1}, nb_pixelnodal_pts{1};
+      return GradientOperatorDefault{
+          dim,
+          nb_quad_pts,
+          nb_elements,
+          nb_nodes,
+          nb_pixelnodal_pts,
+          {{B}},
+          {std::make_tuple(Eigen::VectorXi{Eigen::VectorXi::Zero(nb_nodes)},
+                           pixel_offsets)}};
+    }
+
+    //! named parameters of a benchmark, e.g. the grid size, in the order in
+    //! which they are reported
+    using Parameters_t = std::vector<std::pair<std::string, std::string>>;
+
+    //! timings and throughput of a single benchmark
+    struct Result {
+      //! name of the benchmark followed by the values of its parameters
+      std::string name;
+      Parameters_t parameters;
+      Index_t nb_repetitions;
+      //! shortest and mean wall time of a repetition in seconds
+      Real min_time, mean_time;
+      //! bytes moved and items (e.g. pixels) processed per repetition
+      Real bytes, items;
+    };
+
+    /**
+     * Minimal benchmark harness: times callables over several repetitions,
+     * prints a table of the results and writes them as JSON for tracking
+     * the throughput over time.
+     *
+     * Command line arguments:
+     *   --json=<file>        write the results as JSON to <file> ('-' for
+     *                        standard output, which moves the table to
+     *                        standard error)
+     *   --repetitions=<n>    number of timed repetitions (default 10)
+     *   --filter=<string>    only run benchmarks whose name contains
+     *                        <string>
+     *
+     * Throughput is computed from the shortest repetition.
+     */
+    class Harness {
+     public:
+      //! Default constructor
+      Harness() = delete;
+
+      //! constructor from the command line arguments of the benchmark
+      Harness(const std::string & suite, int argc, char * argv[])
+          : suite{suite} {
+        for (int i{1}; i < argc; ++i) {
+          const std::string argument{argv[i]};
+          auto && value{argument.substr(argument.find('=') + 1)};
+          if (argument.rfind("--json=", 0) == 0) {
+            this->json_file = value;
+          } else if (argument.rfind("--repetitions=", 0) == 0) {
+            this->nb_repetitions = std::max(std::atoi(value.c_str()), 1);
+          } else if (argument.rfind("--filter=", 0) == 0) {
+            this->filter = value;
+          } else {
+            std::cerr << "Ignoring unknown argument '" << argument << "'"
+                      << std::endl;
+          }
+        }
+        this->log() << "# " << this->suite << ", best of "
+                    << this->nb_repetitions << " repetitions" << std::endl
+                    << "# " << std::setw(46) << std::left << "benchmark"
+                    << std::right << std::setw(12) << "time (ms)"
+                    << std::setw(12) << "GB/s" << std::setw(14) << "Mitems/s"
+                    << std::endl;
+      }
+
+      //! Copy constructor
+      Harness(const Harness & other) = delete;
+
+      //! Move constructor
+      Harness(Harness && other) = default;
+
+      //! Destructor
+      virtual ~Harness() = default;
+
+      //! Copy assignment operator
+      Harness & operator=(const Harness & other) = delete;
+
+      //! Move assignment operator
+      Harness & operator=(Harness && other) = delete;
+
+      /**
+       * times `nb_repetitions` calls of `kernel` after an untimed warm-up
+       * call. `bytes` and `items` are the bytes moved and the items
+       * processed per call; pass zero if a throughput is meaningless.
+       */
+      template <class Kernel>
+      void run(const std::string & name, const Parameters_t & parameters,
+               const Real & bytes, const Real & items, Kernel && kernel) {
+        std::stringstream full_name{};
+        full_name << name;
+        for (auto && parameter : parameters) {
+          full_name << "/" << parameter.second;
+        }
+        if (full_name.str().find(this->filter) == std::string::npos) {
+          return;
+        }
+        kernel();
+        Real min_time{std::numeric_limits<Real>::max()}, total_time{0.};
+        for (Index_t i{0}; i < this->nb_repetitions; ++i) {
+          auto && start{std::chrono::steady_clock::now()};
+          kernel();
+          std::chrono::duration<Real> elapsed{
+              std::chrono::steady_clock::now() - start};
+          min_time = std::min(min_time, elapsed.count());
+          total_time += elapsed.count();
+        }
+        Result result{full_name.str(), parameters,
+                      this->nb_repetitions, min_time,
+                      total_time / this->nb_repetitions, bytes,
+                      items};
+        this->log() << "  " << std::setw(46) << std::left << result.name
+                    << std::right << std::setw(12) << 1e3 * result.min_time
+                    << std::setw(12) << result.bytes / result.min_time / 1e9
+                    << std::setw(14) << result.items / result.min_time / 1e6
+                    << std::endl;
+        this->results.push_back(std::move(result));
+      }
+
+      //! writes the results as JSON, if requested, and returns the exit code
+      //! of the benchmark
+      int finalise() const {
+        if (this->json_file.empty()) {
+          return 0;
+        }
+        if (this->json_file == "-") {
+          this->write_json(std::cout);
+          return 0;
+        }
+        std::ofstream file{this->json_file};
+        if (not file) {
+          std::cerr << "Cannot open '" << this->json_file << "' for writing"
+                    << std::endl;
+          return 1;
+        }
+        this->write_json(file);
+        return 0;
+      }
+
+      //! writes the results as JSON to `stream`
+      void write_json(std::ostream & stream) const {
+        char date[32];
+        const std::time_t now{std::time(nullptr)};
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S",
+                      std::localtime(&now));
+        stream << std::setprecision(9) << "{\n  \"context\": {\n"
+               << "    \"suite\": " << quoted(this->suite) << ",\n"
+               << "    \"date\": " << quoted(date) << ",\n"
+               << "    \"repetitions\": " << this->nb_repetitions << "\n"
+               << "  },\n  \"benchmarks\": [";
+        for (size_t i{0}; i < this->results.size(); ++i) {
+          auto && result{this->results[i]};
+          stream << (i == 0 ? "\n" : ",\n") << "    {\n"
+                 << "      \"name\": " << quoted(result.name) << ",\n"
+                 << "      \"parameters\": {";
+          for (size_t j{0}; j < result.parameters.size(); ++j) {
+            stream << (j == 0 ? "" : ", ")
+                   << quoted(result.parameters[j].first) << ": "
+                   << quoted(result.parameters[j].second);
+          }
+          stream << "},\n"
+                 << "      \"repetitions\": " << result.nb_repetitions
+                 << ",\n"
+                 << "      \"min_time\": " << result.min_time << ",\n"
+                 << "      \"mean_time\": " << result.mean_time << ",\n"
+                 << "      \"time_unit\": \"s\",\n"
+                 << "      \"bytes_per_second\": "
+                 << result.bytes / result.min_time << ",\n"
+                 << "      \"items_per_second\": "
+                 << result.items / result.min_time << "\n"
+                 << "    }";
+        }
+        stream << "\n  ]\n}" << std::endl;
+      }
+
+      //! returns the results collected so far
+      const std::vector<Result> & get_results() const {
+        return this->results;
+      }
+
+     protected:
+      //! stream for the table of results, standard error for JSON on stdout
+      std::ostream & log() const {
+        return this->json_file == "-" ? std::cerr : std::cout;
+      }
+
+      //! JSON string literal, the names of the benchmarks are plain ASCII
+      //! but may contain quotes
+      static std::string quoted(const std::string & value) {
+        std::string result{"\""};
+        for (auto && character : value) {
+          if (character == '"' or character == '\\') {
+            result += '\\';
+          }
+          result += character;
+        }
+        return result + "\"";
+      }
+
+      std::string suite;
+      std::string json_file{};
+      std::string filter{};
+      Index_t nb_repetitions{10};
+      std::vector<Result> results{};
+    };
+
+  }  // namespace benchmarks
+
+}  // namespace muGrid
+
+#endif  // BENCHMARKS_BENCHMARKS_HH_
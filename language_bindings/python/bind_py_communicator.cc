@@ -48,7 +48,20 @@ using muGrid::Complex;
 using muGrid::Index_t;
 namespace py = pybind11;
 
+template <typename T>
+void add_collective_request(py::module & mod, const std::string & name) {
+  using Request_t = muGrid::CollectiveRequest<T>;
+  py::class_<Request_t>(mod, name.c_str())
+      .def("test", &Request_t::test)
+      .def("wait", &Request_t::wait);
+}
+
 void add_communicator(py::module & mod) {
+  add_collective_request<Int>(mod, "CollectiveRequestInt");
+  add_collective_request<Real>(mod, "CollectiveRequestReal");
+  add_collective_request<muGrid::DynMatrix_t<Real>>(
+      mod, "CollectiveRequestRealMatrix");
+
   py::class_<muGrid::Communicator>(mod, "Communicator")
 #ifdef WITH_MPI
       .def(py::init([](size_t comm) {
@@ -96,6 +109,24 @@ void add_communicator(py::module & mod) {
               const Eigen::Ref<muGrid::DynMatrix_t<Complex>> & arg) {
              return comm.sum(arg);
            })
+      .def("isum", [](muGrid::Communicator & comm,
+                      const Int & arg) { return comm.isum(arg); })
+      .def("isum", [](muGrid::Communicator & comm,
+                      const Real & arg) { return comm.isum(arg); })
+      .def("isum",
+           [](muGrid::Communicator & comm,
+              const Eigen::Ref<muGrid::DynMatrix_t<Real>> & arg) {
+             return comm.isum(arg);
+           })
+      .def("imax", [](muGrid::Communicator & comm,
+                      const Int & arg) { return comm.imax(arg); })
+      .def("imax", [](muGrid::Communicator & comm,
+                      const Real & arg) { return comm.imax(arg); })
+      .def("igather",
+           [](muGrid::Communicator & comm,
+              const Eigen::Ref<muGrid::DynMatrix_t<Real>> & arg) {
+             return comm.igather(arg);
+           })
       .def("cumulative_sum", &muGrid::Communicator::cumulative_sum<Int>)
       .def("cumulative_sum", &muGrid::Communicator::cumulative_sum<Real>)
       .def("cumulative_sum", &muGrid::Communicator::cumulative_sum<Uint>)
@@ -82,6 +82,9 @@ void add_field(py::module & mod) {
       .def_property_readonly("nb_entries", &Field::get_nb_entries)
       .def_property_readonly("nb_buffer_entries", &Field::get_nb_buffer_entries)
       .def_property_readonly("is_global", &Field::is_global)
+      .def_property_readonly("storage_order", &Field::get_storage_order)
+      .def("convert_storage_order", &Field::convert_storage_order,
+           "storage_order"_a)
       .def_property_readonly("sub_division", &Field::get_sub_division_tag);
 }
 
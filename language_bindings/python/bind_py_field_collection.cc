@@ -388,7 +388,16 @@ void add_field_collection(py::module & mod) {
       .def("set_nb_sub_pts", &FieldCollection::set_nb_sub_pts, "tag"_a,
            "nb_sub_pts"_a)
       .def_property_readonly("domain", &FieldCollection::get_domain)
+      .def_property_readonly("storage_order",
+                             &FieldCollection::get_storage_order)
+      .def("convert_storage_order", &FieldCollection::convert_storage_order,
+           "storage_order"_a)
       .def_property_readonly("is_initialised", &FieldCollection::is_initialised)
+      .def("set_arena_allocation", &FieldCollection::set_arena_allocation,
+           "enable"_a, "huge_pages"_a = false)
+      .def_property_readonly("arena_allocation",
+                             &FieldCollection::get_arena_allocation)
+      .def_property_readonly("arena_size", &FieldCollection::get_arena_size)
       .def("get_field", &FieldCollection::get_field,
            py::return_value_policy::reference_internal)
       .def(
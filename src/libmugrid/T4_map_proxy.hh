@@ -90,10 +90,10 @@ namespace muGrid {
   inline auto get(const Eigen::MatrixBase<T4> & t4, Dim_t i, Dim_t j, Dim_t k,
                   Dim_t l) -> decltype(auto) {
     constexpr Dim_t Dim{DimCounter<Eigen::MatrixBase<T4>>::value};
-    const auto myColStride{(t4.colStride() == 1) ? t4.colStride()
-                                                 : t4.colStride() / Dim};
-    const auto myRowStride{(t4.rowStride() == 1) ? t4.rowStride()
-                                                 : t4.rowStride() / Dim};
+    // the index pairs follow the storage order of the matrix type rather
+    // than its strides, which are arbitrary for strided maps
+    constexpr Dim_t myColStride{T4::IsRowMajor ? 1 : Dim};
+    constexpr Dim_t myRowStride{T4::IsRowMajor ? Dim : 1};
     return t4(i * myRowStride + j * myColStride,
               k * myRowStride + l * myColStride);
   }
@@ -106,10 +106,8 @@ namespace muGrid {
   inline auto get(Eigen::MatrixBase<T4> & t4, Dim_t i, Dim_t j, Dim_t k,
                   Dim_t l) -> decltype(t4.coeffRef(i, j)) {
     constexpr Dim_t Dim{DimCounter<Eigen::MatrixBase<T4>>::value};
-    const auto myColStride{(t4.colStride() == 1) ? t4.colStride()
-                                                 : t4.colStride() / Dim};
-    const auto myRowStride{(t4.rowStride() == 1) ? t4.rowStride()
-                                                 : t4.rowStride() / Dim};
+    constexpr Dim_t myColStride{T4::IsRowMajor ? 1 : Dim};
+    constexpr Dim_t myRowStride{T4::IsRowMajor ? Dim : 1};
     return t4.coeffRef(i * myRowStride + j * myColStride,
                        k * myRowStride + l * myColStride);
   }
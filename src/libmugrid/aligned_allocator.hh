@@ -0,0 +1,192 @@
+/**
+ * @file   aligned_allocator.hh
+ *
+ * @author Lars Pastewka <lars.pastewka@imtek.uni-freiburg.de>
+ *
+ * @date   16 Oct 2026
+ *
+ * @brief  Allocator for memory aligned to cache lines or SIMD registers
+ *
+ * Copyright © 2026 Lars Pastewka
+ *
+ * µGrid is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * µGrid is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with µGrid; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * Additional permission under GNU GPL version 3 section 7
+ *
+ * If you modify this Program, or any covered work, by linking or combining it
+ * with proprietary FFT implementations or numerical libraries, containing parts
+ * covered by the terms of those libraries' licenses, the licensors of this
+ * Program grant you additional permission to convey the resulting work.
+ *
+ */
+
+#ifndef SRC_LIBMUGRID_ALIGNED_ALLOCATOR_HH_
+#define SRC_LIBMUGRID_ALIGNED_ALLOCATOR_HH_
+
+#include "grid_common.hh"
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace muGrid {
+
+  /**
+   * alignment (in bytes) of the data of the fields owned by a
+   * `FieldCollection`: one cache line, which is also the widest SIMD register
+   * (AVX-512)
+   */
+  constexpr std::size_t FieldAlignment{64};
+
+  /**
+   * Standard-conforming allocator returning memory aligned to `Alignment`
+   * bytes, e.g. for `std::vector`s whose data is accessed through aligned
+   * Eigen maps or SIMD loads.
+   *
+   * @tparam T type of the allocated objects
+   * @tparam Alignment alignment in bytes, a power of two that is at least
+   * the natural alignment of `T`
+   */
+  template <typename T, std::size_t Alignment = FieldAlignment>
+  class AlignedAllocator {
+    static_assert((Alignment & (Alignment - 1)) == 0,
+                  "The alignment must be a power of two");
+    static_assert(Alignment >= alignof(T),
+                  "The alignment must be at least the natural alignment of "
+                  "the allocated type");
+
+   public:
+    //! stl
+    using value_type = T;
+
+    //! allocators of other types with the same alignment
+    template <typename U>
+    struct rebind {
+      //! stl
+      using other = AlignedAllocator<U, Alignment>;
+    };
+
+    //! Default constructor
+    AlignedAllocator() = default;
+
+    //! conversion from allocators of other types
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment> &) noexcept {}
+
+    //! allocate aligned storage for `nb_elements` objects
+    T * allocate(std::size_t nb_elements) {
+      if (nb_elements == 0) {
+        return nullptr;
+      }
+      return static_cast<T *>(::operator new(
+          nb_elements * sizeof(T), std::align_val_t{Alignment}));
+    }
+
+    //! release storage obtained through `allocate`
+    void deallocate(T * ptr, std::size_t /*nb_elements*/) noexcept {
+      ::operator delete(ptr, std::align_val_t{Alignment});
+    }
+
+    //! return the alignment in bytes
+    constexpr static std::size_t alignment() { return Alignment; }
+  };
+
+  //! all aligned allocators of the same alignment are interchangeable
+  template <typename T, typename U, std::size_t Alignment>
+  bool operator==(const AlignedAllocator<T, Alignment> &,
+                  const AlignedAllocator<U, Alignment> &) {
+    return true;
+  }
+
+  //! all aligned allocators of the same alignment are interchangeable
+  template <typename T, typename U, std::size_t Alignment>
+  bool operator!=(const AlignedAllocator<T, Alignment> &,
+                  const AlignedAllocator<U, Alignment> &) {
+    return false;
+  }
+
+  /**
+   * `AlignedAllocator` whose containers default-initialise the elements they
+   * add without a value (e.g. in `std::vector::resize`) instead of
+   * value-initialising them. For fundamental types, the memory is hence not
+   * written and the caller chooses which thread touches every page first,
+   * which places the page on the NUMA node of that thread. Types with a
+   * default constructor (e.g. `std::complex`) are still constructed.
+   */
+  template <typename T, std::size_t Alignment = FieldAlignment>
+  class FirstTouchAllocator : public AlignedAllocator<T, Alignment> {
+   public:
+    //! allocators of other types with the same alignment
+    template <typename U>
+    struct rebind {
+      //! stl
+      using other = FirstTouchAllocator<U, Alignment>;
+    };
+
+    //! Default constructor
+    FirstTouchAllocator() = default;
+
+    //! conversion from allocators of other types
+    template <typename U>
+    FirstTouchAllocator(const FirstTouchAllocator<U, Alignment> &) noexcept {}
+
+    //! default-initialise an object constructed without arguments
+    template <typename U>
+    void construct(U * ptr) {
+      ::new (static_cast<void *>(ptr)) U;
+    }
+
+    //! construct an object from `args`
+    template <typename U, typename... Args>
+    void construct(U * ptr, Args &&... args) {
+      ::new (static_cast<void *>(ptr)) U(std::forward<Args>(args)...);
+    }
+  };
+
+  //! all first-touch allocators of the same alignment are interchangeable
+  template <typename T, typename U, std::size_t Alignment>
+  bool operator==(const FirstTouchAllocator<T, Alignment> &,
+                  const FirstTouchAllocator<U, Alignment> &) {
+    return true;
+  }
+
+  //! all first-touch allocators of the same alignment are interchangeable
+  template <typename T, typename U, std::size_t Alignment>
+  bool operator!=(const FirstTouchAllocator<T, Alignment> &,
+                  const FirstTouchAllocator<U, Alignment> &) {
+    return false;
+  }
+
+  //! deleter for memory obtained from the aligned `operator new`, e.g. for
+  //! `std::unique_ptr`s to buffers whose alignment is chosen at runtime
+  struct AlignedDeleter {
+    //! alignment the memory was allocated with
+    std::size_t alignment;
+
+    //! release the memory
+    void operator()(void * ptr) const {
+      ::operator delete(ptr, std::align_val_t{this->alignment});
+    }
+  };
+
+  //! `std::vector` with aligned data
+  template <typename T, std::size_t Alignment = FieldAlignment>
+  using AlignedVector_t = std::vector<T, AlignedAllocator<T, Alignment>>;
+
+}  // namespace muGrid
+
+#endif  // SRC_LIBMUGRID_ALIGNED_ALLOCATOR_HH_
@@ -0,0 +1,224 @@
+/**
+ * @file   cartesian_decomposition.cc
+ *
+ * @author Lars Pastewka <lars.pastewka@imtek.uni-freiburg.de>
+ *
+ * @date   16 Oct 2026
+ *
+ * @brief  Automatic Cartesian decomposition of the global grid onto
+ *         the processes of a communicator
+ *
+ * Copyright © 2026 Lars Pastewka
+ *
+ * µGrid is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * µGrid is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with µGrid; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * Additional permission under GNU GPL version 3 section 7
+ *
+ * If you modify this Program, or any covered work, by linking or combining it
+ * with proprietary FFT implementations or numerical libraries, containing parts
+ * covered by the terms of those libraries' licenses, the licensors of this
+ * Program grant you additional permission to convey the resulting work.
+ *
+ */
+
+#include "cartesian_decomposition.hh"
+#include "exception.hh"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <sstream>
+
+namespace muGrid {
+
+  /* ---------------------------------------------------------------------- */
+  CartesianDecomposition::CartesianDecomposition(
+      const DynCcoord_t & nb_domain_grid_pts, const Communicator & comm,
+      const DynCcoord_t & nb_subdivisions)
+      : nb_domain_grid_pts{nb_domain_grid_pts}, comm{comm},
+        nb_subdivisions{compute_process_grid(nb_domain_grid_pts, comm.size(),
+                                             nb_subdivisions)} {
+    const Index_t dim{nb_domain_grid_pts.get_dim()};
+    this->coordinates = DynCcoord_t(dim);
+    this->left_neighbour_ranks.assign(dim, comm.rank());
+    this->right_neighbour_ranks.assign(dim, comm.rank());
+#ifdef WITH_MPI
+    MPI_Comm parent_comm{this->comm.get_mpi_comm()};
+    if (parent_comm != MPI_COMM_NULL) {
+      std::vector<int> dims(dim), periods(dim, 1), coords(dim);
+      for (Index_t d{0}; d < dim; ++d) {
+        dims[d] = static_cast<int>(this->nb_subdivisions[d]);
+      }
+      // the ranks are not reordered, such that the ranks in the Cartesian
+      // communicator are the ones of the communicator of the decomposition
+      MPI_Comm cart_comm{MPI_COMM_NULL};
+      auto message{MPI_Cart_create(parent_comm, static_cast<int>(dim),
+                                   dims.data(), periods.data(), 0,
+                                   &cart_comm)};
+      if (message != 0) {
+        std::stringstream error{};
+        error << "MPI_Cart_create failed with " << message << " on rank "
+              << this->comm.rank();
+        throw RuntimeError(error.str());
+      }
+      MPI_Cart_coords(cart_comm, this->comm.rank(), static_cast<int>(dim),
+                      coords.data());
+      for (Index_t d{0}; d < dim; ++d) {
+        this->coordinates[d] = coords[d];
+        MPI_Cart_shift(cart_comm, static_cast<int>(d), 1,
+                       &this->left_neighbour_ranks[d],
+                       &this->right_neighbour_ranks[d]);
+      }
+      MPI_Comm_free(&cart_comm);
+    }
+#else
+    // ranks of a thread group are laid out on the process grid in row-major
+    // order, as by MPI_Cart_create, and the grid is periodic
+    Index_t stride{1};
+    for (Index_t d{dim - 1}; d >= 0; --d) {
+      const Index_t & nb{this->nb_subdivisions[d]};
+      const Index_t coord{(comm.rank() / stride) % nb};
+      this->coordinates[d] = coord;
+      this->left_neighbour_ranks[d] = static_cast<int>(
+          comm.rank() + ((coord + nb - 1) % nb - coord) * stride);
+      this->right_neighbour_ranks[d] = static_cast<int>(
+          comm.rank() + ((coord + 1) % nb - coord) * stride);
+      stride *= nb;
+    }
+#endif
+    // distribute the grid points of each direction as evenly as possible
+    this->nb_subdomain_grid_pts = DynCcoord_t(dim);
+    this->subdomain_locations = DynCcoord_t(dim);
+    for (Index_t d{0}; d < dim; ++d) {
+      const Index_t nb_base{nb_domain_grid_pts[d] / this->nb_subdivisions[d]};
+      const Index_t nb_remainder{nb_domain_grid_pts[d] %
+                                 this->nb_subdivisions[d]};
+      const Index_t & coord{this->coordinates[d]};
+      this->nb_subdomain_grid_pts[d] = nb_base + (coord < nb_remainder);
+      this->subdomain_locations[d] =
+          coord * nb_base + std::min(coord, nb_remainder);
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  DynCcoord_t CartesianDecomposition::compute_process_grid(
+      const DynCcoord_t & nb_domain_grid_pts, const Index_t & nb_procs,
+      const DynCcoord_t & nb_subdivisions) {
+    const Index_t dim{nb_domain_grid_pts.get_dim()};
+    const DynCcoord_t prescribed{nb_subdivisions.get_dim() == 0
+                                     ? DynCcoord_t(dim)
+                                     : nb_subdivisions};
+    if (prescribed.get_dim() != dim) {
+      std::stringstream error{};
+      error << "The process grid " << nb_subdivisions << " must have "
+            << dim << " entries, one for each spatial direction.";
+      throw RuntimeError(error.str());
+    }
+    for (Index_t d{0}; d < dim; ++d) {
+      if (prescribed[d] < 0 or prescribed[d] > nb_domain_grid_pts[d]) {
+        std::stringstream error{};
+        error << "Invalid process grid " << nb_subdivisions
+              << " for a grid of " << nb_domain_grid_pts << " points.";
+        throw RuntimeError(error.str());
+      }
+    }
+
+    // the surface of the largest subdomain along subdivided directions,
+    // i.e. the number of grid points exchanged with its neighbours
+    auto && surface{[&nb_domain_grid_pts, dim](const DynCcoord_t & grid) {
+      Index_t area{0};
+      for (Index_t d{0}; d < dim; ++d) {
+        if (grid[d] == 1) {
+          continue;
+        }
+        Index_t face{2};
+        for (Index_t e{0}; e < dim; ++e) {
+          if (e != d) {
+            face *= (nb_domain_grid_pts[e] + grid[e] - 1) / grid[e];
+          }
+        }
+        area += face;
+      }
+      return area;
+    }};
+    auto && nb_subdivided{[](const DynCcoord_t & grid) {
+      return std::count_if(grid.begin(), grid.end(),
+                           [](const Index_t & n) { return n > 1; });
+    }};
+    // whether `a` is preferable to `b`
+    auto && is_better{[&](const DynCcoord_t & a, const DynCcoord_t & b) {
+      const Index_t surface_a{surface(a)}, surface_b{surface(b)};
+      if (surface_a != surface_b) {
+        return surface_a < surface_b;
+      }
+      if (nb_subdivided(a) != nb_subdivided(b)) {
+        return nb_subdivided(a) < nb_subdivided(b);
+      }
+      for (Index_t d{dim - 1}; d >= 0; --d) {
+        if (a[d] != b[d]) {
+          return a[d] > b[d];
+        }
+      }
+      return false;
+    }};
+
+    // enumerate all factorisations of the number of processes that are
+    // compatible with the prescribed entries and the size of the grid
+    DynCcoord_t best{}, grid(dim);
+    std::function<void(Index_t, Index_t)> enumerate{
+        [&](Index_t d, Index_t nb_remaining) {
+          if (d == dim) {
+            if (nb_remaining == 1 and
+                (best.get_dim() == 0 or is_better(grid, best))) {
+              best = grid;
+            }
+            return;
+          }
+          for (Index_t n{1}; n <= nb_remaining; ++n) {
+            if (nb_remaining % n != 0 or n > nb_domain_grid_pts[d] or
+                (prescribed[d] != 0 and n != prescribed[d])) {
+              continue;
+            }
+            grid[d] = n;
+            enumerate(d + 1, nb_remaining / n);
+          }
+        }};
+    enumerate(0, nb_procs);
+    if (best.get_dim() == 0) {
+      std::stringstream error{};
+      error << "Unable to decompose a grid of " << nb_domain_grid_pts
+            << " points onto " << nb_procs << " processes";
+      if (nb_subdivisions.get_dim() != 0) {
+        error << " with the process grid " << nb_subdivisions;
+      }
+      error << ".";
+      throw RuntimeError(error.str());
+    }
+    return best;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void CartesianDecomposition::initialise(
+      GlobalFieldCollection & collection, const DynCcoord_t & nb_ghosts_left,
+      const DynCcoord_t & nb_ghosts_right,
+      StorageOrder pixels_storage_order) const {
+    collection.initialise(this->nb_domain_grid_pts,
+                          this->nb_subdomain_grid_pts,
+                          this->subdomain_locations, nb_ghosts_left,
+                          nb_ghosts_right, this->comm, pixels_storage_order);
+  }
+
+}  // namespace muGrid
@@ -0,0 +1,185 @@
+/**
+ * @file   cartesian_decomposition.hh
+ *
+ * @author Lars Pastewka <lars.pastewka@imtek.uni-freiburg.de>
+ *
+ * @date   16 Oct 2026
+ *
+ * @brief  Automatic Cartesian decomposition of the global grid onto
+ *         the processes of a communicator
+ *
+ * Copyright © 2026 Lars Pastewka
+ *
+ * µGrid is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * µGrid is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with µGrid; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * Additional permission under GNU GPL version 3 section 7
+ *
+ * If you modify this Program, or any covered work, by linking or combining it
+ * with proprietary FFT implementations or numerical libraries, containing parts
+ * covered by the terms of those libraries' licenses, the licensors of this
+ * Program grant you additional permission to convey the resulting work.
+ *
+ */
+
+#ifndef SRC_LIBMUGRID_CARTESIAN_DECOMPOSITION_HH_
+#define SRC_LIBMUGRID_CARTESIAN_DECOMPOSITION_HH_
+
+#include "communicator.hh"
+#include "field_collection_global.hh"
+#include "grid_common.hh"
+
+#include <vector>
+
+namespace muGrid {
+
+  /**
+   * Cartesian decomposition of a (periodic) global grid onto the processes
+   * of a communicator. The processes are arranged in a process grid with
+   * `get_nb_subdivisions()[d]` processes along direction `d`. Unless it is
+   * prescribed, the process grid is chosen such that the surface of the
+   * subdomains, i.e. the amount of data exchanged with the neighbours, is
+   * minimal. Depending on the shape of the grid and the number of
+   * processes, this yields a slab (one subdivided direction), pencil (two
+   * subdivided directions) or block (three subdivided directions)
+   * decomposition. The grid points along each direction are distributed as
+   * evenly as possible over the processes. The process grid is set up with
+   * `MPI_Cart_create` (without reordering the ranks), which also provides the
+   * neighbour ranks.
+   */
+  class CartesianDecomposition {
+   public:
+    //! Default constructor
+    CartesianDecomposition() = delete;
+
+    /**
+     * Constructor
+     * @param nb_domain_grid_pts number of grid points of the global grid
+     * @param comm communicator whose processes share the grid
+     * @param nb_subdivisions number of processes along each direction. Zero
+     * entries (or an empty process grid) are chosen automatically, nonzero
+     * entries are kept.
+     */
+    CartesianDecomposition(const DynCcoord_t & nb_domain_grid_pts,
+                           const Communicator & comm = Communicator{},
+                           const DynCcoord_t & nb_subdivisions = {});
+
+    //! Copy constructor
+    CartesianDecomposition(const CartesianDecomposition & other) = default;
+
+    //! Move constructor
+    CartesianDecomposition(CartesianDecomposition && other) = default;
+
+    //! Destructor
+    virtual ~CartesianDecomposition() = default;
+
+    //! Copy assignment operator
+    CartesianDecomposition &
+    operator=(const CartesianDecomposition & other) = delete;
+
+    //! Move assignment operator
+    CartesianDecomposition &
+    operator=(CartesianDecomposition && other) = delete;
+
+    /**
+     * choose the process grid for `nb_procs` processes that minimises the
+     * surface of the largest subdomain. Nonzero entries of `nb_subdivisions`
+     * are prescribed. Among process grids with equal surface, the one with
+     * fewer subdivided directions and then the one that subdivides the
+     * slower (higher-index) directions more is chosen, which keeps the
+     * subdomains contiguous in memory.
+     */
+    static DynCcoord_t
+    compute_process_grid(const DynCcoord_t & nb_domain_grid_pts,
+                         const Index_t & nb_procs,
+                         const DynCcoord_t & nb_subdivisions = {});
+
+    /**
+     * initialise `collection` with the subdomain of this process, padded by
+     * `nb_ghosts_left` and `nb_ghosts_right` ghost layers which are
+     * exchanged on the communicator of the decomposition
+     */
+    void initialise(GlobalFieldCollection & collection,
+                    const DynCcoord_t & nb_ghosts_left = {},
+                    const DynCcoord_t & nb_ghosts_right = {},
+                    StorageOrder pixels_storage_order =
+                        StorageOrder::Automatic) const;
+
+    //! returns the global (domain) number of grid points in each direction
+    const DynCcoord_t & get_nb_domain_grid_pts() const {
+      return this->nb_domain_grid_pts;
+    }
+
+    //! returns the number of processes along each direction
+    const DynCcoord_t & get_nb_subdivisions() const {
+      return this->nb_subdivisions;
+    }
+
+    //! returns the coordinates of this process in the process grid
+    const DynCcoord_t & get_coordinates() const { return this->coordinates; }
+
+    //! returns the number of grid points of the subdomain of this process
+    const DynCcoord_t & get_nb_subdomain_grid_pts() const {
+      return this->nb_subdomain_grid_pts;
+    }
+
+    //! returns the location of the subdomain of this process
+    const DynCcoord_t & get_subdomain_locations() const {
+      return this->subdomain_locations;
+    }
+
+    /**
+     * returns the ranks of the processes holding the neighbouring subdomain
+     * on the left side (low index) of the subdomain in each direction
+     * (periodic)
+     */
+    const std::vector<int> & get_left_neighbour_ranks() const {
+      return this->left_neighbour_ranks;
+    }
+
+    /**
+     * returns the ranks of the processes holding the neighbouring subdomain
+     * on the right side (high index) of the subdomain in each direction
+     * (periodic)
+     */
+    const std::vector<int> & get_right_neighbour_ranks() const {
+      return this->right_neighbour_ranks;
+    }
+
+    //! returns the communicator the grid is decomposed on
+    const Communicator & get_communicator() const { return this->comm; }
+
+   protected:
+    //! global number of grid points
+    const DynCcoord_t nb_domain_grid_pts;
+    //! communicator the grid is decomposed on
+    Communicator comm;
+    //! number of processes along each direction
+    DynCcoord_t nb_subdivisions{};
+    //! coordinates of this process in the process grid
+    DynCcoord_t coordinates{};
+    //! number of grid points of the subdomain of this process
+    DynCcoord_t nb_subdomain_grid_pts{};
+    //! location of the subdomain of this process
+    DynCcoord_t subdomain_locations{};
+    //! ranks of the left neighbours in each direction
+    std::vector<int> left_neighbour_ranks{};
+    //! ranks of the right neighbours in each direction
+    std::vector<int> right_neighbour_ranks{};
+  };
+
+}  // namespace muGrid
+
+#endif  // SRC_LIBMUGRID_CARTESIAN_DECOMPOSITION_HH_
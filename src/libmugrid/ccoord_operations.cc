@@ -37,6 +37,9 @@
 #include "exception.hh"
 #include "ccoord_operations.hh"
 
+#include <algorithm>
+#include <sstream>
+
 namespace muGrid {
 
   namespace CcoordOps {
@@ -235,6 +238,22 @@ namespace muGrid {
       return Enumerator(*this);
     }
 
+    /* ---------------------------------------------------------------------- */
+    NeighbourTable DynamicPixels::get_neighbour_table(
+        const std::vector<DynCcoord_t> & offsets) const {
+      return NeighbourTable{*this, offsets, this->nb_subdomain_grid_pts,
+                            this->subdomain_locations, true};
+    }
+
+    /* ---------------------------------------------------------------------- */
+    NeighbourTable DynamicPixels::get_neighbour_table(
+        const std::vector<DynCcoord_t> & offsets,
+        const DynCcoord_t & nb_region_grid_pts,
+        const DynCcoord_t & region_locations, const bool & periodic) const {
+      return NeighbourTable{*this, offsets, nb_region_grid_pts,
+                            region_locations, periodic};
+    }
+
     /* ----------------------------------------------------------------------*/
     template <size_t Dim>
     const Pixels<Dim> & DynamicPixels::get_dimensioned_pixels() const {
@@ -248,6 +267,86 @@ namespace muGrid {
       return static_cast<const Pixels<Dim> &>(*this);
     }
 
+    /* ---------------------------------------------------------------------- */
+    NeighbourTable::NeighbourTable(const DynamicPixels & pixels,
+                                   const std::vector<DynCcoord_t> & offsets,
+                                   const DynCcoord_t & nb_region_grid_pts,
+                                   const DynCcoord_t & region_locations,
+                                   const bool & periodic)
+        : dim{pixels.get_dim()}, first_index{0},
+          nb_pixels{static_cast<Index_t>(get_size(nb_region_grid_pts))},
+          deltas(offsets.size(), 0),
+          periodic{periodic} {
+      if (nb_region_grid_pts.get_dim() != this->dim or
+          region_locations.get_dim() != this->dim) {
+        std::stringstream error{};
+        error << "The region of " << nb_region_grid_pts << " grid points at "
+              << region_locations << " does not match the spatial dimension "
+              << this->dim << " of the grid";
+        throw RuntimeError(error.str());
+      }
+      auto && nb_grid_pts{pixels.get_nb_subdomain_grid_pts()};
+      auto && locations{pixels.get_subdomain_locations()};
+      const Index_t nb_offsets{this->get_nb_offsets()};
+      for (Index_t d{0}; d < this->dim; ++d) {
+        const Index_t n{nb_region_grid_pts[d]};
+        this->nb_region_grid_pts[d] = n;
+        this->strides[d] = pixels.get_strides()[d];
+        this->first_index +=
+            (region_locations[d] - locations[d]) * this->strides[d];
+
+        // range of the neighbours of the region in this direction
+        Index_t min_offset{0}, max_offset{0};
+        for (auto && offset : offsets) {
+          if (offset.get_dim() != this->dim) {
+            std::stringstream error{};
+            error << "The offset " << offset
+                  << " does not match the spatial dimension " << this->dim
+                  << " of the grid";
+            throw RuntimeError(error.str());
+          }
+          min_offset = std::min(min_offset, offset[d]);
+          max_offset = std::max(max_offset, offset[d]);
+        }
+        const Index_t lower{periodic ? 0 : min_offset};
+        const Index_t upper{periodic ? 0 : max_offset};
+        if (n > 0 and (region_locations[d] + lower < locations[d] or
+                       region_locations[d] + n + upper >
+                           locations[d] + nb_grid_pts[d])) {
+          std::stringstream error{};
+          error << "The region of " << nb_region_grid_pts
+                << " grid points at " << region_locations
+                << " and its neighbours (offsets " << min_offset << " to "
+                << max_offset << " in direction " << d
+                << ") do not fit into the grid of " << nb_grid_pts
+                << " grid points at " << locations;
+          throw RuntimeError(error.str());
+        }
+
+        if (periodic) {
+          this->interior_begin[d] = std::min(n, -min_offset);
+          this->interior_end[d] = std::max(this->interior_begin[d],
+                                           n - max_offset);
+          auto & wrap{this->wraps[d]};
+          wrap.assign(n * nb_offsets, 0);
+          for (Index_t x{0}; x < n; ++x) {
+            for (Index_t k{0}; k < nb_offsets; ++k) {
+              const Index_t neighbour{x + offsets[k][d]};
+              const Index_t wrapped{(neighbour % n + n) % n};
+              wrap[x * nb_offsets + k] =
+                  (wrapped - neighbour) * this->strides[d];
+            }
+          }
+        }
+      }
+      for (Index_t k{0}; k < nb_offsets; ++k) {
+        for (Index_t d{0}; d < this->dim; ++d) {
+          this->deltas[k] += offsets[k][d] * this->strides[d];
+        }
+      }
+    }
+
+    /* ---------------------------------------------------------------------- */
     template DynamicPixels::DynamicPixels(const Ccoord_t<oneD> &,
                                           const Ccoord_t<oneD> &);
     template DynamicPixels::DynamicPixels(const Ccoord_t<twoD> &,
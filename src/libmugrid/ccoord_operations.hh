@@ -33,9 +33,11 @@
  *
  */
 
+#include <array>
 #include <functional>
 #include <numeric>
 #include <utility>
+#include <vector>
 
 #include "Eigen/Dense"
 
@@ -625,6 +627,9 @@ namespace muGrid {
     template <size_t Dim>
     class Pixels;
 
+    //! forward declaration
+    class NeighbourTable;
+
     /**
      * Iteration over square (or cubic) discretisation grids. Duplicates
      * capabilities of `muGrid::CcoordOps::Pixels` without needing to be
@@ -745,6 +750,28 @@ namespace muGrid {
        */
       Enumerator enumerate() const;
 
+      /**
+       * returns the storage indices of the neighbours `ccoord + offset` of
+       * all pixels, for each of the `offsets`. Neighbours outside the grid
+       * are wrapped around periodically.
+       */
+      NeighbourTable
+      get_neighbour_table(const std::vector<DynCcoord_t> & offsets) const;
+
+      /**
+       * returns the storage indices of the neighbours `ccoord + offset` of
+       * the pixels of the region of `nb_region_grid_pts` at
+       * `region_locations`, for each of the `offsets`. If `periodic`, the
+       * neighbours outside the region are wrapped around periodically within
+       * the region, otherwise they must lie within this grid (e.g. in ghost
+       * layers).
+       */
+      NeighbourTable
+      get_neighbour_table(const std::vector<DynCcoord_t> & offsets,
+                          const DynCcoord_t & nb_region_grid_pts,
+                          const DynCcoord_t & region_locations,
+                          const bool & periodic) const;
+
      protected:
       Dim_t dim;                          //!< spatial dimension
       DynCcoord_t nb_subdomain_grid_pts;  //!< nb_grid_pts of this domain
@@ -894,6 +921,130 @@ namespace muGrid {
       const DynamicPixels & pixels;
     };
 
+    /**
+     * Storage indices of the neighbours `ccoord + offset` of the pixels of a
+     * rectangular region of a `DynamicPixels` grid, for a fixed set of
+     * offsets (a stencil). Instead of evaluating coordinates for every pixel
+     * and offset, the table holds one linear-index delta per offset, which is
+     * valid whenever none of the neighbours wraps around. For periodic
+     * regions, it additionally holds per-direction corrections for the
+     * pixels close to the boundary. Its size is proportional to the sum (not
+     * the product) of the number of grid points per direction.
+     */
+    class NeighbourTable {
+     public:
+      //! Default constructor
+      NeighbourTable() = delete;
+
+      //! constructor, see `DynamicPixels::get_neighbour_table`
+      NeighbourTable(const DynamicPixels & pixels,
+                     const std::vector<DynCcoord_t> & offsets,
+                     const DynCcoord_t & nb_region_grid_pts,
+                     const DynCcoord_t & region_locations,
+                     const bool & periodic);
+
+      //! Copy constructor
+      NeighbourTable(const NeighbourTable & other) = default;
+
+      //! Move constructor
+      NeighbourTable(NeighbourTable && other) = default;
+
+      //! Destructor
+      ~NeighbourTable() = default;
+
+      //! Copy assignment operator
+      NeighbourTable & operator=(const NeighbourTable & other) = default;
+
+      //! Move assignment operator
+      NeighbourTable & operator=(NeighbourTable && other) = default;
+
+      //! number of pixels in the region
+      const Index_t & size() const { return this->nb_pixels; }
+
+      //! number of offsets in the stencil
+      Index_t get_nb_offsets() const { return this->deltas.size(); }
+
+      /**
+       * calls `kernel(index, neighbours)` for the pixels `begin` to `end` (in
+       * column-major order) of the region, where `index` is the storage index
+       * of the pixel and `neighbours` points to the storage indices of its
+       * neighbours in the order of the offsets
+       */
+      template <class Kernel>
+      void for_each(const Index_t & begin, const Index_t & end,
+                    Kernel && kernel) const;
+
+     protected:
+      Index_t dim;                                       //!< spatial dimension
+      std::array<Index_t, threeD> nb_region_grid_pts{};  //!< region shape
+      std::array<Index_t, threeD> strides{};             //!< storage strides
+      Index_t first_index;  //!< storage index of the first region pixel
+      Index_t nb_pixels;    //!< number of pixels in the region
+      std::vector<Index_t> deltas{};  //!< index offsets of the neighbours
+      bool periodic;                  //!< whether neighbours wrap around
+      //! per direction, the first coordinate without wrapping neighbours
+      std::array<Index_t, threeD> interior_begin{};
+      //! per direction, the end of the coordinates without wrapping neighbours
+      std::array<Index_t, threeD> interior_end{};
+      /**
+       * per direction and coordinate (relative to the region), the index
+       * corrections of the wrapping neighbours for all offsets
+       */
+      std::array<std::vector<Index_t>, threeD> wraps{};
+    };
+
+    /* ---------------------------------------------------------------------- */
+    template <class Kernel>
+    void NeighbourTable::for_each(const Index_t & begin, const Index_t & end,
+                                  Kernel && kernel) const {
+      if (begin >= end) {
+        return;
+      }
+      // coordinates (relative to the region) and storage index of the first
+      // pixel, the following ones are reached by counting up
+      std::array<Index_t, threeD> x{};
+      Index_t index{this->first_index};
+      Index_t rest{begin};
+      for (Index_t d{0}; d < this->dim; ++d) {
+        x[d] = rest % this->nb_region_grid_pts[d];
+        rest /= this->nb_region_grid_pts[d];
+        index += x[d] * this->strides[d];
+      }
+      const Index_t nb_offsets{this->get_nb_offsets()};
+      std::vector<Index_t> neighbours(nb_offsets);
+      for (Index_t i{begin}; i < end; ++i) {
+        bool interior{true};
+        if (this->periodic) {
+          for (Index_t d{0}; d < this->dim; ++d) {
+            interior &= (x[d] >= this->interior_begin[d]) and
+                        (x[d] < this->interior_end[d]);
+          }
+        }
+        for (Index_t k{0}; k < nb_offsets; ++k) {
+          neighbours[k] = index + this->deltas[k];
+        }
+        if (not interior) {
+          for (Index_t d{0}; d < this->dim; ++d) {
+            const Index_t * wrap{this->wraps[d].data() + x[d] * nb_offsets};
+            for (Index_t k{0}; k < nb_offsets; ++k) {
+              neighbours[k] += wrap[k];
+            }
+          }
+        }
+        kernel(index, neighbours.data());
+
+        ++x[0];
+        index += this->strides[0];
+        for (Index_t d{0};
+             d < this->dim - 1 and x[d] == this->nb_region_grid_pts[d]; ++d) {
+          x[d] = 0;
+          index -= this->nb_region_grid_pts[d] * this->strides[d];
+          ++x[d + 1];
+          index += this->strides[d + 1];
+        }
+      }
+    }
+
     /**
      * Centralised iteration over square (or cubic) discretisation grids.
      */
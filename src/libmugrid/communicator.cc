@@ -35,8 +35,12 @@
 
 #include "communicator.hh"
 
+#include <thread>
+
 namespace muGrid {
 
+#ifdef WITH_MPI
+
   Communicator::Communicator(MPI_Comm comm) : comm{comm} {}
 
   Communicator::Communicator(const Communicator & other) : comm(other.comm) {}
@@ -48,4 +52,42 @@ namespace muGrid {
     return *this;
   }
 
+#else  // WITH_MPI
+
+  /* ---------------------------------------------------------------------- */
+  Communicator::Communicator(std::shared_ptr<ThreadGroup> group,
+                             const int & rank)
+      : group{std::move(group)}, thread_rank{rank} {
+    if (this->group == nullptr or rank < 0 or rank >= this->group->size()) {
+      std::stringstream error{};
+      error << "Rank " << rank << " is not part of the thread group";
+      throw RuntimeError(error.str());
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void Communicator::run_on_threads(
+      const int & nb_ranks, const std::function<void(Communicator &)> & task) {
+    auto group{std::make_shared<ThreadGroup>(nb_ranks)};
+    std::vector<std::thread> threads{};
+    auto && run_rank{[&group, &task](const int & rank) {
+      try {
+        Communicator comm{group, rank};
+        task(comm);
+      } catch (...) {
+        group->abort(std::current_exception());
+      }
+    }};
+    for (int rank{1}; rank < nb_ranks; ++rank) {
+      threads.emplace_back(run_rank, rank);
+    }
+    run_rank(0);
+    for (auto && thread : threads) {
+      thread.join();
+    }
+    group->rethrow_error();
+  }
+
+#endif  // WITH_MPI
+
 }  // namespace muGrid
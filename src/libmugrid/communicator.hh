@@ -36,10 +36,17 @@
 #ifndef SRC_LIBMUGRID_COMMUNICATOR_HH_
 #define SRC_LIBMUGRID_COMMUNICATOR_HH_
 
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <string>
 #include <type_traits>
+#include <vector>
 
 #ifdef WITH_MPI
 #include <mpi.h>
+#else
+#include "thread_group.hh"
 #endif
 
 #include "Eigen/Dense"
@@ -51,6 +58,42 @@ namespace muGrid {
   template <typename T>
   using DynMatrix_t = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>;
 
+  namespace internal {
+
+    /**
+     * storage type, scalar type, data pointer and number of values of the
+     * arguments of reductions, which are either scalars or Eigen types
+     */
+    template <typename T,
+              bool IsEigen = std::is_base_of<Eigen::EigenBase<T>, T>::value>
+    struct ReductionTraits {
+      //! type in which the argument and the result are stored
+      using Plain_t = T;
+      //! type of the values that are reduced
+      using Scalar_t = T;
+      //! pointer to the first value
+      static Scalar_t * data(Plain_t & arg) { return &arg; }
+      //! number of values
+      static int size(const Plain_t &) { return 1; }
+    };
+
+    //! Eigen types are reduced coefficient-wise
+    template <typename T>
+    struct ReductionTraits<T, true> {
+      //! type in which the argument and the result are stored
+      using Plain_t = typename T::PlainObject;
+      //! type of the values that are reduced
+      using Scalar_t = typename T::Scalar;
+      //! pointer to the first value
+      static Scalar_t * data(Plain_t & arg) { return arg.data(); }
+      //! number of values
+      static int size(const Plain_t & arg) {
+        return static_cast<int>(arg.size());
+      }
+    };
+
+  }  // namespace internal
+
 #ifdef WITH_MPI
 
   template <typename T, typename T2 = T>
@@ -110,6 +153,102 @@ namespace muGrid {
     return MPI_DOUBLE_COMPLEX;
   }
 
+  class Communicator;
+
+  /**
+   * handle of a non-blocking collective operation of `muGrid::Communicator`
+   * (see `Communicator::isum`, `Communicator::imax` and
+   * `Communicator::igather`). The handle owns the send and receive buffers of
+   * the operation, so the argument of the operation may go out of scope
+   * while the operation is pending. The result is available once `test()`
+   * returned true or after `wait()`. Destroying a pending handle waits for
+   * the operation to complete, as MPI has to be done with the buffers.
+   */
+  template <typename T>
+  class CollectiveRequest {
+    friend Communicator;
+
+   public:
+    //! Default constructor
+    CollectiveRequest() = delete;
+
+    //! Copy constructor
+    CollectiveRequest(const CollectiveRequest & other) = delete;
+
+    //! Move constructor
+    CollectiveRequest(CollectiveRequest && other) = default;
+
+    //! Destructor
+    ~CollectiveRequest() {
+      if (this->state != nullptr and not this->state->complete) {
+        MPI_Wait(&this->state->request, MPI_STATUS_IGNORE);
+      }
+    }
+
+    //! Copy assignment operator
+    CollectiveRequest & operator=(const CollectiveRequest & other) = delete;
+
+    //! Move assignment operator
+    CollectiveRequest & operator=(CollectiveRequest && other) = delete;
+
+    //! check whether the operation has completed, without blocking
+    bool test() {
+      this->check_state();
+      if (not this->state->complete) {
+        int flag{0};
+        auto message{
+            MPI_Test(&this->state->request, &flag, MPI_STATUS_IGNORE)};
+        if (message != 0) {
+          std::stringstream error{};
+          error << "MPI_Test failed with " << message;
+          throw RuntimeError(error.str());
+        }
+        this->state->complete = flag != 0;
+      }
+      return this->state->complete;
+    }
+
+    //! block until the operation has completed and return its result
+    const T & wait() {
+      this->check_state();
+      if (not this->state->complete) {
+        auto message{MPI_Wait(&this->state->request, MPI_STATUS_IGNORE)};
+        if (message != 0) {
+          std::stringstream error{};
+          error << "MPI_Wait failed with " << message;
+          throw RuntimeError(error.str());
+        }
+        this->state->complete = true;
+      }
+      return this->state->result;
+    }
+
+   protected:
+    //! buffers and MPI handle of the operation, at a fixed address
+    struct State {
+      T send_buf;                      //!< copy of the argument
+      T result;                        //!< receive buffer
+      std::vector<int> counts;         //!< receive counts (gathers)
+      std::vector<int> displacements;  //!< receive displacements (gathers)
+      MPI_Request request{MPI_REQUEST_NULL};  //!< MPI handle
+      bool complete{false};  //!< whether the operation has completed
+    };
+
+    //! Constructor from the state of a started operation
+    explicit CollectiveRequest(std::unique_ptr<State> state)
+        : state{std::move(state)} {}
+
+    //! throws if the request has been moved from
+    void check_state() const {
+      if (this->state == nullptr) {
+        throw RuntimeError("The collective request has been moved from and no "
+                           "longer refers to an operation");
+      }
+    }
+
+    std::unique_ptr<State> state;  //!< state of the operation
+  };
+
   //! lightweight abstraction for the MPI communicator object
   class Communicator {
    public:
@@ -219,6 +358,27 @@ namespace muGrid {
       return res;
     }
 
+    /**
+     * non-blocking sum reduction on scalar and Eigen::Matrix types
+     * (`MPI_Iallreduce`). The result is available from the returned handle
+     * once the reduction has completed, see `muGrid::CollectiveRequest`.
+     * This allows hiding the latency of the reduction behind computations
+     * that do not depend on its result.
+     */
+    template <typename T>
+    CollectiveRequest<typename internal::ReductionTraits<T>::Plain_t>
+    isum(const T & arg) const {
+      return this->iallreduce<T>(arg, MPI_SUM);
+    }
+
+    //! non-blocking max reduction on scalar and Eigen::Matrix types, see
+    //! `isum`
+    template <typename T>
+    CollectiveRequest<typename internal::ReductionTraits<T>::Plain_t>
+    imax(const T & arg) const {
+      return this->iallreduce<T>(arg, MPI_MAX);
+    }
+
     //! ordered partial cumulative sum on scalar types. With the nomenclatur p0
     //! = the processor with rank = 0 and so on the following example
     //! demonstrates the cumulative sum of arg='a' returned on res='b'
@@ -256,77 +416,62 @@ namespace muGrid {
       if (this->comm == MPI_COMM_NULL)
         return arg;
 
-      int comm_size = this->size();
-
-      // gather the number of rows on each core to define the output shape
-      // (nb_rows_default = max(nb_rows_all) of the result
-      Index_t nb_rows_loc{arg.rows()};
-      Index_t nb_rows_max{0};
-      auto message{MPI_Allreduce(&nb_rows_loc, &nb_rows_max, 1,
-                                 mpi_type<Index_t>(), MPI_MAX, this->comm)};
-      if (message != 0) {
-        std::stringstream error{};
-        error << "MPI_Allreduce MPI_MAX failed with " << message << " on rank "
-              << this->rank();
-        throw RuntimeError(error.str());
+      std::vector<int> arg_sizes{};
+      std::vector<int> displs{};
+      DynMatrix_t<T> res{this->gather_layout<T>(arg, arg_sizes, displs)};
+      if (res.size() == 0) {
+        // If there is no data to collect return a 0x0 matrix.
+        return res;
       }
 
-      // It is only allowed to have matrices with a fixed number of rows or
-      // empty matrices. Hence either nb_rows_loc == nb_rows_max or nb_rows_loc
-      // == 0. Otherwise you might have undefined behaviour because the output
-      // gathered matrix might have a wrong shape.
-      assert((nb_rows_loc == nb_rows_max) or (nb_rows_loc == 0));
-
-      // gather the number of elements on each core to define the output shape
-      // (nb_cols = nb_entries/nb_rows_max) of the result
-      Index_t send_buf_size(arg.size());
-      std::vector<int> arg_sizes(comm_size, 0);
-      message = MPI_Allgather(&send_buf_size, 1, mpi_type<int>(),
-                              arg_sizes.data(), 1, mpi_type<int>(), this->comm);
+      auto message{MPI_Allgatherv(arg.data(), static_cast<int>(arg.size()),
+                                  mpi_type<T>(), res.data(), arg_sizes.data(),
+                                  displs.data(), mpi_type<T>(), this->comm)};
       if (message != 0) {
         std::stringstream error{};
-        error << "MPI_Allgather failed with " << message << " on rank "
+        error << "MPI_Allgatherv failed with " << message << " on rank "
               << this->rank();
         throw RuntimeError(error.str());
       }
+      return res;
+    }
 
-      int nb_entries = 0;
-      for (auto i = 0; i < comm_size; ++i) {
-        nb_entries += arg_sizes[i];
-      }
-
-      // check if by accident a vector was handed over, rows=0, cols!=0. Thus
-      // nb_rows is zero everywhere and so nb_rows_max is zero. However, there
-      // are columns != 0, which leads to nb_entries != 0 and would lead in the
-      // following to a zero division.
-      assert(!((nb_rows_max == 0) and (nb_entries != 0)));
-
-      // compute the offset at which the data from each processor is written
-      // into the result
-      std::vector<int> displs(comm_size, 0);
-      for (auto i = 0; i < comm_size - 1; ++i) {
-        displs[i + 1] = displs[i] + arg_sizes[i];
+    /**
+     * non-blocking gather on EigenMatrix types (`MPI_Iallgatherv`), the
+     * result is the same as that of `gather` and is available from the
+     * returned handle once the gather has completed. Only the shapes of the
+     * arguments are exchanged on call, which blocks until all processes have
+     * called `igather`.
+     */
+    template <typename T>
+    CollectiveRequest<DynMatrix_t<T>>
+    igather(const Eigen::Ref<DynMatrix_t<T>> & arg) const {
+      using State_t = typename CollectiveRequest<DynMatrix_t<T>>::State;
+      auto state{std::make_unique<State_t>()};
+      if (this->comm == MPI_COMM_NULL) {
+        state->result = arg;
+        state->complete = true;
+        return CollectiveRequest<DynMatrix_t<T>>{std::move(state)};
       }
-
-      // initialise the result matrix with zeros
-      if ((nb_rows_max == 0) and (nb_entries == 0)) {
-        // If there is no data to collect return a 0x0 matrix.
-        DynMatrix_t<T> res(0, 0);
-        return res;
+      state->result =
+          this->gather_layout<T>(arg, state->counts, state->displacements);
+      if (state->result.size() == 0) {
+        state->complete = true;
+        return CollectiveRequest<DynMatrix_t<T>>{std::move(state)};
       }
-      DynMatrix_t<T> res(nb_rows_max, nb_entries / nb_rows_max);
-      res.setZero();
-
-      message = MPI_Allgatherv(arg.data(), send_buf_size, mpi_type<T>(),
-                               res.data(), arg_sizes.data(), displs.data(),
-                               mpi_type<T>(), this->comm);
+      state->send_buf = arg;
+      auto message{MPI_Iallgatherv(
+          state->send_buf.data(), static_cast<int>(state->send_buf.size()),
+          mpi_type<T>(), state->result.data(), state->counts.data(),
+          state->displacements.data(), mpi_type<T>(), this->comm,
+          &state->request)};
       if (message != 0) {
         std::stringstream error{};
-        error << "MPI_Allgatherv failed with " << message << " on rank "
+        error << "MPI_Iallgatherv failed with " << message << " on rank "
               << this->rank();
         throw RuntimeError(error.str());
       }
-      return res;
+      return CollectiveRequest<DynMatrix_t<T>>{std::move(state)};
     }
 
     //! broadcast of scalar types
@@ -343,6 +488,93 @@ namespace muGrid {
         return res;
       }
     }
+
+    //! combined blocking send to rank `dest` and receive from rank `source`.
+    //! This is the point-to-point primitive underlying the ghost (halo)
+    //! exchange of global fields. Sending to and receiving from the own rank
+    //! is allowed (periodic images on a single process).
+    template <typename T>
+    void sendrecv(const T * send_buf, const Index_t & send_count,
+                  const int & dest, T * recv_buf, const Index_t & recv_count,
+                  const int & source, const int & tag = 0) const {
+      if (this->comm == MPI_COMM_NULL) {
+        if (send_count != recv_count) {
+          std::stringstream error{};
+          error << "sendrecv without communicator needs matching send ("
+                << send_count << ") and receive (" << recv_count
+                << ") counts";
+          throw RuntimeError(error.str());
+        }
+        std::copy(send_buf, send_buf + send_count, recv_buf);
+        return;
+      }
+      auto message{MPI_Sendrecv(send_buf, send_count, mpi_type<T>(), dest,
+                                tag, recv_buf, recv_count, mpi_type<T>(),
+                                source, tag, this->comm, MPI_STATUS_IGNORE)};
+      if (message != 0) {
+        std::stringstream error{};
+        error << "MPI_Sendrecv failed with " << message << " on rank "
+              << this->rank();
+        throw RuntimeError(error.str());
+      }
+    }
+
+    //! handle of a non-blocking operation
+    using Request = MPI_Request;
+
+    //! non-blocking send to rank `dest`, the send buffer must not be touched
+    //! until the returned request has been completed with `wait_all`
+    template <typename T>
+    Request isend(const T * send_buf, const Index_t & count, const int & dest,
+                  const int & tag = 0) const {
+      this->check_point_to_point("isend");
+      Request request{};
+      auto message{MPI_Isend(send_buf, count, mpi_type<T>(), dest, tag,
+                             this->comm, &request)};
+      if (message != 0) {
+        std::stringstream error{};
+        error << "MPI_Isend failed with " << message << " on rank "
+              << this->rank();
+        throw RuntimeError(error.str());
+      }
+      return request;
+    }
+
+    //! non-blocking receive from rank `source`, the receive buffer holds the
+    //! message only after the returned request has been completed with
+    //! `wait_all`
+    template <typename T>
+    Request irecv(T * recv_buf, const Index_t & count, const int & source,
+                  const int & tag = 0) const {
+      this->check_point_to_point("irecv");
+      Request request{};
+      auto message{MPI_Irecv(recv_buf, count, mpi_type<T>(), source, tag,
+                             this->comm, &request)};
+      if (message != 0) {
+        std::stringstream error{};
+        error << "MPI_Irecv failed with " << message << " on rank "
+              << this->rank();
+        throw RuntimeError(error.str());
+      }
+      return request;
+    }
+
+    //! complete all non-blocking operations in `requests` and clear it
+    void wait_all(std::vector<Request> & requests) const {
+      if (requests.empty()) {
+        return;
+      }
+      auto message{MPI_Waitall(static_cast<int>(requests.size()),
+                               requests.data(), MPI_STATUSES_IGNORE)};
+      if (message != 0) {
+        std::stringstream error{};
+        error << "MPI_Waitall failed with " << message << " on rank "
+              << this->rank();
+        throw RuntimeError(error.str());
+      }
+      requests.clear();
+    }
+
     //! return logical and
     bool logical_and(const bool & arg) const {
       if (this->comm == MPI_COMM_NULL) {
@@ -365,71 +597,399 @@ namespace muGrid {
       }
     }
 
-    MPI_Comm get_mpi_comm() { return this->comm; }
+    MPI_Comm get_mpi_comm() const { return this->comm; }
 
     //! find whether the underlying communicator is mpi
     static bool has_mpi() { return true; }
 
    private:
+    //! start a non-blocking reduction of `arg` with the MPI operation `op`
+    template <typename T>
+    CollectiveRequest<typename internal::ReductionTraits<T>::Plain_t>
+    iallreduce(const T & arg, MPI_Op op) const {
+      using Traits = internal::ReductionTraits<T>;
+      using Request_t = CollectiveRequest<typename Traits::Plain_t>;
+      auto state{std::make_unique<typename Request_t::State>()};
+      state->send_buf = arg;
+      state->result = state->send_buf;
+      if (this->comm == MPI_COMM_NULL) {
+        state->complete = true;
+        return Request_t{std::move(state)};
+      }
+      auto message{MPI_Iallreduce(
+          Traits::data(state->send_buf), Traits::data(state->result),
+          Traits::size(state->send_buf),
+          mpi_type<typename Traits::Scalar_t>(), op, this->comm,
+          &state->request)};
+      if (message != 0) {
+        std::stringstream error{};
+        error << "MPI_Iallreduce failed with " << message << " on rank "
+              << this->rank();
+        throw RuntimeError(error.str());
+      }
+      return Request_t{std::move(state)};
+    }
+
+    /**
+     * exchange the shapes of the arguments of a gather, fill the number of
+     * values received from each process and the offsets at which they are
+     * written and return the zero-initialised result
+     */
+    template <typename T>
+    DynMatrix_t<T> gather_layout(const Eigen::Ref<DynMatrix_t<T>> & arg,
+                                 std::vector<int> & arg_sizes,
+                                 std::vector<int> & displs) const {
+      int comm_size = this->size();
+
+      // gather the number of rows on each core to define the output shape
+      // (nb_rows_default = max(nb_rows_all) of the result
+      Index_t nb_rows_loc{arg.rows()};
+      Index_t nb_rows_max{0};
+      auto message{MPI_Allreduce(&nb_rows_loc, &nb_rows_max, 1,
+                                 mpi_type<Index_t>(), MPI_MAX, this->comm)};
+      if (message != 0) {
+        std::stringstream error{};
+        error << "MPI_Allreduce MPI_MAX failed with " << message << " on rank "
+              << this->rank();
+        throw RuntimeError(error.str());
+      }
+
+      // It is only allowed to have matrices with a fixed number of rows or
+      // empty matrices. Hence either nb_rows_loc == nb_rows_max or nb_rows_loc
+      // == 0. Otherwise you might have undefined behaviour because the output
+      // gathered matrix might have a wrong shape.
+      assert((nb_rows_loc == nb_rows_max) or (nb_rows_loc == 0));
+
+      // gather the number of elements on each core to define the output shape
+      // (nb_cols = nb_entries/nb_rows_max) of the result
+      int send_buf_size(arg.size());
+      arg_sizes.assign(comm_size, 0);
+      message = MPI_Allgather(&send_buf_size, 1, mpi_type<int>(),
+                              arg_sizes.data(), 1, mpi_type<int>(), this->comm);
+      if (message != 0) {
+        std::stringstream error{};
+        error << "MPI_Allgather failed with " << message << " on rank "
+              << this->rank();
+        throw RuntimeError(error.str());
+      }
+
+      int nb_entries = 0;
+      for (auto i = 0; i < comm_size; ++i) {
+        nb_entries += arg_sizes[i];
+      }
+
+      // check if by accident a vector was handed over, rows=0, cols!=0. Thus
+      // nb_rows is zero everywhere and so nb_rows_max is zero. However, there
+      // are columns != 0, which leads to nb_entries != 0 and would lead in the
+      // following to a zero division.
+      assert(!((nb_rows_max == 0) and (nb_entries != 0)));
+
+      // compute the offset at which the data from each processor is written
+      // into the result
+      displs.assign(comm_size, 0);
+      for (auto i = 0; i < comm_size - 1; ++i) {
+        displs[i + 1] = displs[i] + arg_sizes[i];
+      }
+
+      // initialise the result matrix with zeros
+      if ((nb_rows_max == 0) and (nb_entries == 0)) {
+        return DynMatrix_t<T>(0, 0);
+      }
+      return DynMatrix_t<T>::Zero(nb_rows_max, nb_entries / nb_rows_max);
+    }
+
+    //! non-blocking point-to-point communication needs an actual communicator
+    void check_point_to_point(const std::string & operation) const {
+      if (this->comm == MPI_COMM_NULL) {
+        throw RuntimeError("Can't " + operation +
+                           " without communicator, data for the own rank "
+                           "needs to be copied directly.");
+      }
+    }
+
     MPI_Comm comm;
   };
 
 #else  // WITH_MPI
 
-  //! stub communicator object that doesn't communicate anything
+  /**
+   * handle of a non-blocking collective operation of the stub communicator,
+   * which completes all operations immediately (see the parallel
+   * implementation)
+   */
+  template <typename T>
+  class CollectiveRequest {
+   public:
+    //! Default constructor
+    CollectiveRequest() = delete;
+
+    //! Constructor from the result of the completed operation
+    explicit CollectiveRequest(const T & result) : result{result} {}
+
+    //! the operation has completed
+    bool test() { return true; }
+
+    //! return the result of the operation
+    const T & wait() { return this->result; }
+
+   protected:
+    T result;  //!< result of the operation
+  };
+
+  /**
+   * stub communicator object that doesn't communicate anything, unless it
+   * represents a rank of a `ThreadGroup`. In that case the ranks are threads
+   * of the present process (see `run_on_threads`) and all operations are
+   * implemented through shared memory, with the same semantics as the
+   * parallel implementation.
+   */
   class Communicator {
    public:
     Communicator() {}
+
+    //! communicator of the rank `rank` of a group of threads
+    Communicator(std::shared_ptr<ThreadGroup> group, const int & rank);
+
     ~Communicator() {}
 
+    /**
+     * run `task` on `nb_ranks` threads, each of which is passed the
+     * communicator of its rank in a new `ThreadGroup`, and return once all
+     * ranks have finished. The first exception thrown by any rank aborts the
+     * group and is rethrown on the calling thread.
+     *
+     * The ranks run concurrently and share the thread pool of the linear
+     * algebra (see `linalg::set_nb_threads`): while one rank uses it, the
+     * operations of the others run serially on their own thread.
+     */
+    static void
+    run_on_threads(const int & nb_ranks,
+                   const std::function<void(Communicator & comm)> & task);
+
     //! get rank of present process
-    int rank() const { return 0; }
+    int rank() const { return this->thread_rank; }
 
     //! get total number of processes
-    int size() const { return 1; }
+    int size() const {
+      return this->group == nullptr ? 1 : this->group->size();
+    }
 
     //! Barrier syncronization, nothing to be done in serial
-    void barrier() { return; }
+    void barrier() {
+      if (this->group != nullptr) {
+        this->group->barrier();
+      }
+    }
 
     //! sum reduction on scalar types
     template <typename T>
-    T sum(const T & arg) const {
-      return arg;
+    typename internal::ReductionTraits<T>::Plain_t sum(const T & arg) const {
+      return this->allreduce(
+          arg, [](const auto & in, auto & inout) { inout += in; });
     }
 
     //! max reduction on scalar types
     template <typename T>
-    T max(const T & arg) const {
-      return arg;
+    typename internal::ReductionTraits<T>::Plain_t max(const T & arg) const {
+      return this->allreduce(arg, [](const auto & in, auto & inout) {
+        inout = std::max(inout, in);
+      });
+    }
+
+    //! non-blocking sum reduction, completes immediately in serial
+    template <typename T>
+    CollectiveRequest<typename internal::ReductionTraits<T>::Plain_t>
+    isum(const T & arg) const {
+      return CollectiveRequest<
+          typename internal::ReductionTraits<T>::Plain_t>{this->sum(arg)};
+    }
+
+    //! non-blocking max reduction, completes immediately in serial
+    template <typename T>
+    CollectiveRequest<typename internal::ReductionTraits<T>::Plain_t>
+    imax(const T & arg) const {
+      return CollectiveRequest<
+          typename internal::ReductionTraits<T>::Plain_t>{this->max(arg)};
     }
 
     //! ordered partial cumulative sum on scalar types. Find more details in the
     //! doc of the into the parallel implementation.
     template <typename T>
     T cumulative_sum(const T & arg) const {
-      return arg;
+      if (this->group == nullptr) {
+        return arg;
+      }
+      this->group->publish(this->thread_rank, &arg);
+      T res{*this->group->template get_published<T>(0)};
+      for (int peer{1}; peer <= this->thread_rank; ++peer) {
+        res += *this->group->template get_published<T>(peer);
+      }
+      this->group->barrier();
+      return res;
     }
 
-    //! gather on EigenMatrix types
+    //! gather on EigenMatrix types, the arguments of all ranks are
+    //! concatenated along the column index (see the parallel implementation)
+    template <typename T>
+    DynMatrix_t<T> gather(const Eigen::Ref<DynMatrix_t<T>> & arg) const {
+      if (this->group == nullptr) {
+        return arg;
+      }
+      using Arg_t = Eigen::Ref<DynMatrix_t<T>>;
+      this->group->publish(this->thread_rank, &arg);
+      Index_t nb_rows{0}, nb_cols{0};
+      for (int peer{0}; peer < this->size(); ++peer) {
+        auto && peer_arg{*this->group->template get_published<Arg_t>(peer)};
+        nb_rows = std::max(nb_rows, Index_t{peer_arg.rows()});
+        nb_cols += peer_arg.size() == 0 ? 0 : peer_arg.cols();
+      }
+      DynMatrix_t<T> res(nb_rows, nb_cols);
+      Index_t col{0};
+      for (int peer{0}; peer < this->size(); ++peer) {
+        auto && peer_arg{*this->group->template get_published<Arg_t>(peer)};
+        if (peer_arg.size() == 0) {
+          continue;
+        }
+        // as in the parallel implementation, all nonempty arguments need the
+        // same number of rows
+        assert(peer_arg.rows() == nb_rows);
+        res.middleCols(col, peer_arg.cols()) = peer_arg;
+        col += peer_arg.cols();
+      }
+      this->group->barrier();
+      return res;
+    }
+
+    //! non-blocking gather on EigenMatrix types, completes immediately in
+    //! serial
     template <typename T>
-    T gather(const T & arg) const {
-      return arg;
+    CollectiveRequest<DynMatrix_t<T>>
+    igather(const Eigen::Ref<DynMatrix_t<T>> & arg) const {
+      return CollectiveRequest<DynMatrix_t<T>>{this->gather(arg)};
     }
 
     //! broadcast of scalar types
     template <typename T>
-    T bcast(T & arg, const Int &) {
-      return arg;
+    T bcast(T & arg, const Int & root) {
+      if (this->group == nullptr) {
+        return arg;
+      }
+      this->group->publish(this->thread_rank, &arg);
+      const T res{*this->group->template get_published<T>(root)};
+      this->group->barrier();
+      arg = res;
+      return res;
+    }
+
+    //! combined send and receive, can only talk to the own rank in serial
+    template <typename T>
+    void sendrecv(const T * send_buf, const Index_t & send_count,
+                  const int & dest, T * recv_buf, const Index_t & recv_count,
+                  const int & source, const int & tag = 0) const {
+      if (this->group != nullptr) {
+        this->group->post(this->thread_rank, dest, tag, send_buf,
+                          send_count * sizeof(T));
+        this->group->fetch(source, this->thread_rank, tag, recv_buf,
+                           recv_count * sizeof(T));
+        return;
+      }
+      if (dest != 0 or source != 0 or send_count != recv_count) {
+        std::stringstream error{};
+        error << "The serial communicator can only send " << send_count
+              << " values to and receive " << recv_count
+              << " values from itself (rank 0), but dest = " << dest
+              << " and source = " << source << " were requested";
+        throw RuntimeError(error.str());
+      }
+      std::copy(send_buf, send_buf + send_count, recv_buf);
     }
 
-    //! return logical and
-    bool logical_or(const bool & arg) const { return arg; }
+    /**
+     * handle of a non-blocking operation. Sends to other threads are
+     * buffered and complete immediately, receives are completed by
+     * `wait_all` (there are no non-blocking operations in serial)
+     */
+    struct Request {
+      void * recv_buf{nullptr};  //!< receive buffer, nullptr for sends
+      size_t nb_bytes{0};        //!< size of the receive buffer
+      int source{0};             //!< rank the message is received from
+      int tag{0};                //!< tag of the message
+    };
+
+    //! non-blocking send, there is nobody to send to in serial
+    template <typename T>
+    Request isend(const T * send_buf, const Index_t & count, const int & dest,
+                  const int & tag = 0) const {
+      if (this->group == nullptr) {
+        throw RuntimeError("The serial communicator can't isend, data for "
+                           "the own rank needs to be copied directly.");
+      }
+      this->group->post(this->thread_rank, dest, tag, send_buf,
+                        count * sizeof(T));
+      return Request{};
+    }
 
-    //! return logical and
-    bool logical_and(const bool & arg) const { return arg; }
+    //! non-blocking receive, there is nobody to receive from in serial
+    template <typename T>
+    Request irecv(T * recv_buf, const Index_t & count, const int & source,
+                  const int & tag = 0) const {
+      if (this->group == nullptr) {
+        throw RuntimeError("The serial communicator can't irecv, data for "
+                           "the own rank needs to be copied directly.");
+      }
+      return Request{recv_buf, count * sizeof(T), source, tag};
+    }
+
+    //! complete all non-blocking operations in `requests` and clear it
+    void wait_all(std::vector<Request> & requests) const {
+      for (auto && request : requests) {
+        if (request.recv_buf != nullptr) {
+          this->group->fetch(request.source, this->thread_rank, request.tag,
+                             request.recv_buf, request.nb_bytes);
+        }
+      }
+      requests.clear();
+    }
+
+    //! return logical or (reduced as `Int`, as `std::vector<bool>` can't
+    //! hold the partial results)
+    bool logical_or(const bool & arg) const {
+      return this->allreduce(Int{arg}, [](const Int & in, Int & inout) {
+        inout = inout or in;
+      });
+    }
+
+    //! return logical and (reduced as `Int`)
+    bool logical_and(const bool & arg) const {
+      return this->allreduce(Int{arg}, [](const Int & in, Int & inout) {
+        inout = inout and in;
+      });
+    }
+
+    //! group of threads this communicator belongs to, nullptr in serial
+    const std::shared_ptr<ThreadGroup> & get_thread_group() const {
+      return this->group;
+    }
 
     //! find whether the underlying communicator is mpi
     static bool has_mpi() { return false; }
+
+   private:
+    //! reduce `arg` (scalar or Eigen type) coefficient-wise with `operation`
+    template <typename T, typename Operation>
+    typename internal::ReductionTraits<T>::Plain_t
+    allreduce(const T & arg, Operation && operation) const {
+      using Traits = internal::ReductionTraits<T>;
+      typename Traits::Plain_t res(arg);
+      if (this->group != nullptr) {
+        this->group->allreduce(this->thread_rank, Traits::data(res),
+                               Traits::size(res), operation);
+      }
+      return res;
+    }
+
+    std::shared_ptr<ThreadGroup> group{};  //!< ranks of the group, if any
+    int thread_rank{0};                    //!< rank within the group
   };
 
 #endif
@@ -0,0 +1,532 @@
+/**
+ * @file   convolution_operator.cc
+ *
+ * @author Lars Pastewka <lars.pastewka@imtek.uni-freiburg.de>
+ *
+ * @date   16 Oct 2026
+ *
+ * @brief  implementation of the convolution operator
+ *
+ * Copyright © 2026 Lars Pastewka
+ *
+ * µGrid is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * µGrid is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with µGrid; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * Additional permission under GNU GPL version 3 section 7
+ *
+ * If you modify this Program, or any covered work, by linking or combining it
+ * with proprietary FFT implementations or numerical libraries, containing parts
+ * covered by the terms of those libraries' licenses, the licensors of this
+ * Program grant you additional permission to convey the resulting work.
+ *
+ */
+
+#include "convolution_operator.hh"
+#include "field_collection_global.hh"
+#include "exception.hh"
+
+#include <algorithm>
+#include <sstream>
+
+namespace muGrid {
+
+  /* ---------------------------------------------------------------------- */
+  ConvolutionOperator::ConvolutionOperator(
+      const Index_t & spatial_dim, const std::vector<DynCcoord_t> & offsets,
+      const std::vector<Eigen::MatrixXd> & coefficients,
+      const Index_t & nb_pixel_input_pts, const Index_t & nb_pixel_output_pts)
+      : Parent{}, min_offsets(spatial_dim), max_offsets(spatial_dim),
+        spatial_dim{spatial_dim}, offsets{offsets},
+        coefficients{coefficients}, nb_pixel_input_pts{nb_pixel_input_pts},
+        nb_pixel_output_pts{nb_pixel_output_pts}, nb_output_dofs{0},
+        nb_input_dofs{0} {
+    if (offsets.size() != coefficients.size() or offsets.size() == 0) {
+      std::stringstream err_msg{};
+      err_msg << "Size mismatch: Expected one coefficient matrix per stencil "
+                 "point, but received "
+              << offsets.size() << " offsets and " << coefficients.size()
+              << " coefficient matrices";
+      throw RuntimeError{err_msg.str()};
+    }
+    if (nb_pixel_input_pts < 1 or nb_pixel_output_pts < 1) {
+      std::stringstream err_msg{};
+      err_msg << "The numbers of input and output sub-points per pixel must "
+                 "be positive, but received "
+              << nb_pixel_input_pts << " and " << nb_pixel_output_pts;
+      throw RuntimeError{err_msg.str()};
+    }
+    this->nb_output_dofs = coefficients.front().rows();
+    this->nb_input_dofs = coefficients.front().cols();
+    if (this->nb_output_dofs % nb_pixel_output_pts != 0 or
+        this->nb_input_dofs % nb_pixel_input_pts != 0) {
+      std::stringstream err_msg{};
+      err_msg << "Size mismatch: The coefficient matrices of shape "
+              << this->nb_output_dofs << " × " << this->nb_input_dofs
+              << " do not fit " << nb_pixel_output_pts
+              << " output and " << nb_pixel_input_pts
+              << " input sub-points per pixel";
+      throw RuntimeError{err_msg.str()};
+    }
+    for (size_t k{0}; k < offsets.size(); ++k) {
+      auto && offset{offsets[k]};
+      auto && matrix{coefficients[k]};
+      if (offset.get_dim() != spatial_dim) {
+        std::stringstream err_msg{};
+        err_msg << "Size mismatch: Expected an offset with " << spatial_dim
+                << " entries (spatial dimension), but received " << offset;
+        throw RuntimeError{err_msg.str()};
+      }
+      if (matrix.rows() != this->nb_output_dofs or
+          matrix.cols() != this->nb_input_dofs) {
+        std::stringstream err_msg{};
+        err_msg << "Size mismatch: Expected coefficient matrices of shape "
+                << this->nb_output_dofs << " × " << this->nb_input_dofs
+                << ", but the matrix of offset " << offset << " has shape "
+                << matrix.rows() << " × " << matrix.cols();
+        throw RuntimeError{err_msg.str()};
+      }
+      for (Index_t d{0}; d < spatial_dim; ++d) {
+        this->min_offsets[d] = std::min(this->min_offsets[d], offset[d]);
+        this->max_offsets[d] = std::max(this->max_offsets[d], offset[d]);
+      }
+      this->flat_coefficients.insert(this->flat_coefficients.end(),
+                                     matrix.data(),
+                                     matrix.data() + matrix.size());
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  void ConvolutionOperator::apply(const TypedFieldBase<T> & input_field,
+                                  TypedFieldBase<T> & output_field) const {
+    output_field.set_zero();
+    this->apply_increment(input_field, GradientAccumulator_t<T>{1.},
+                          output_field);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  void ConvolutionOperator::apply_increment(
+      const TypedFieldBase<T> & input_field,
+      const GradientAccumulator_t<T> & alpha,
+      TypedFieldBase<T> & output_field) const {
+    this->apply_increment_impl(input_field, alpha, output_field, nullptr);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  PendingApplication
+  ConvolutionOperator::begin_apply(TypedFieldBase<T> & input_field,
+                                   TypedFieldBase<T> & output_field) const {
+    // check before zeroing the output
+    this->check_fields(input_field, output_field);
+    output_field.set_zero();
+    return this->begin_apply_increment(
+        input_field, GradientAccumulator_t<T>{1.}, output_field);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  PendingApplication ConvolutionOperator::begin_apply_increment(
+      TypedFieldBase<T> & input_field, const GradientAccumulator_t<T> & alpha,
+      TypedFieldBase<T> & output_field) const {
+    return this->apply_increment_impl<T>(input_field, alpha, output_field,
+                                         &input_field);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  PendingApplication ConvolutionOperator::apply_increment_impl(
+      const TypedFieldBase<T> & input_field,
+      const GradientAccumulator_t<T> & alpha, TypedFieldBase<T> & output_field,
+      Field * exchanged_field) const {
+    using Accumulator_t = GradientAccumulator_t<T>;
+    this->check_fields(input_field, output_field);
+
+    const T * input_data{input_field.data()};
+    T * output_data{output_field.data()};
+
+    // every pixel only writes its own output values, so the pixels can be
+    // evaluated in any order. Each output entry is summed up in the
+    // accumulator type and only stored once. The sweep may be evaluated
+    // after returning (see `begin_apply`), hence it captures by value.
+    Sweep_t sweep{[this, input_data, output_data,
+                   alpha](const CcoordOps::NeighbourTable & table) {
+      const Real * flat_coefficients{this->flat_coefficients.data()};
+      const Index_t nb_offsets{static_cast<Index_t>(this->offsets.size())};
+      const Index_t nb_in{this->nb_input_dofs};
+      const Index_t nb_out{this->nb_output_dofs};
+      this->for_each_pixel(table, [&](const Index_t & index,
+                                      const Index_t * neighbours) {
+        T * output{output_data + index * nb_out};
+        for (Index_t i{0}; i < nb_out; ++i) {
+          Accumulator_t value{0.};
+          for (Index_t k{0}; k < nb_offsets; ++k) {
+            const T * input{input_data + neighbours[k] * nb_in};
+            const Real * row{flat_coefficients + k * nb_out * nb_in + i};
+            for (Index_t j{0}; j < nb_in; ++j) {
+              value += row[j * nb_out] * static_cast<Accumulator_t>(input[j]);
+            }
+          }
+          output[i] = static_cast<T>(output[i] + alpha * value);
+        }
+      });
+    }};
+
+    auto & collection{dynamic_cast<GlobalFieldCollection &>(
+        output_field.get_collection())};
+    if (not collection.has_ghosts()) {
+      sweep(this->get_neighbour_table(collection.get_pixels(),
+                                      this->offsets));
+      return finished_application();
+    }
+    // the neighbours within reach of the stencil of the subdomain boundaries
+    // are in the ghost layers
+    const DynCcoord_t nb_left{DynCcoord_t(this->spatial_dim) -
+                              this->min_offsets};
+    if (exchanged_field == nullptr) {
+      this->apply_with_ghosts({&input_field}, this->offsets, nb_left,
+                              this->max_offsets, sweep);
+      return finished_application();
+    }
+    return this->begin_apply_with_ghosts({exchanged_field}, this->offsets,
+                                         nb_left, this->max_offsets, sweep);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void ConvolutionOperator::apply_gradient(
+      const TypedFieldBase<Real> & input_field,
+      TypedFieldBase<Real> & output_field) const {
+    this->apply<Real>(input_field, output_field);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void ConvolutionOperator::apply_gradient_increment(
+      const TypedFieldBase<Real> & input_field, const Real & alpha,
+      TypedFieldBase<Real> & output_field) const {
+    this->apply_increment<Real>(input_field, alpha, output_field);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void ConvolutionOperator::apply_transpose(
+      const TypedFieldBase<Real> & output_field,
+      TypedFieldBase<Real> & input_field,
+      const std::vector<Real> & weights) const {
+    this->apply_transpose<Real>(output_field, input_field, weights);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void ConvolutionOperator::apply_transpose_increment(
+      const TypedFieldBase<Real> & output_field, const Real & alpha,
+      TypedFieldBase<Real> & input_field,
+      const std::vector<Real> & weights) const {
+    this->apply_transpose_increment<Real>(output_field, alpha, input_field,
+                                          weights);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  void ConvolutionOperator::apply_transpose(
+      const TypedFieldBase<T> & output_field, TypedFieldBase<T> & input_field,
+      const std::vector<Real> & weights) const {
+    input_field.set_zero();
+    this->apply_transpose_increment(output_field, GradientAccumulator_t<T>{1.},
+                                    input_field, weights);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  void ConvolutionOperator::apply_transpose_increment(
+      const TypedFieldBase<T> & output_field,
+      const GradientAccumulator_t<T> & alpha, TypedFieldBase<T> & input_field,
+      const std::vector<Real> & weights) const {
+    this->apply_transpose_increment_impl(output_field, alpha, input_field,
+                                         weights, nullptr);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  PendingApplication ConvolutionOperator::begin_apply_transpose(
+      TypedFieldBase<T> & output_field, TypedFieldBase<T> & input_field,
+      const std::vector<Real> & weights) const {
+    // check before zeroing the input
+    this->check_fields(input_field, output_field);
+    input_field.set_zero();
+    return this->begin_apply_transpose_increment(
+        output_field, GradientAccumulator_t<T>{1.}, input_field, weights);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  PendingApplication ConvolutionOperator::begin_apply_transpose_increment(
+      TypedFieldBase<T> & output_field, const GradientAccumulator_t<T> & alpha,
+      TypedFieldBase<T> & input_field,
+      const std::vector<Real> & weights) const {
+    return this->apply_transpose_increment_impl<T>(
+        output_field, alpha, input_field, weights, &output_field);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  PendingApplication ConvolutionOperator::apply_transpose_increment_impl(
+      const TypedFieldBase<T> & output_field,
+      const GradientAccumulator_t<T> & alpha, TypedFieldBase<T> & input_field,
+      const std::vector<Real> & weights, Field * exchanged_field) const {
+    using Accumulator_t = GradientAccumulator_t<T>;
+    this->check_fields(input_field, output_field);
+    if (weights.size() != 0 and
+        static_cast<Index_t>(weights.size()) != this->nb_pixel_output_pts) {
+      std::stringstream err_msg{};
+      err_msg << "Size mismatch: Expected " << this->nb_pixel_output_pts
+              << " weights (one per output sub-point), but received "
+              << weights.size();
+      throw RuntimeError{err_msg.str()};
+    }
+
+    const Index_t nb_out{this->nb_output_dofs};
+    const Index_t nb_out_components{this->get_nb_output_components()};
+
+    // scale the rows of the coefficients by the weights of their output
+    // sub-points once, rather than on every pixel
+    std::vector<Real> scaled_coefficients(this->flat_coefficients);
+    if (weights.size() != 0) {
+      for (size_t entry{0}; entry < scaled_coefficients.size(); ++entry) {
+        const Index_t sub_pt{static_cast<Index_t>(entry % nb_out) /
+                             nb_out_components};
+        scaled_coefficients[entry] *= weights[sub_pt];
+      }
+    }
+    const T * output_data{output_field.data()};
+    T * input_data{input_field.data()};
+
+    // gather the contributions of the pixels `base - offset`, such that
+    // every pixel only writes its own input values. The sweep owns the
+    // scaled coefficients, see `apply_increment_impl`.
+    Sweep_t sweep{[this, output_data, input_data, alpha,
+                   matrices = std::move(scaled_coefficients)](
+                      const CcoordOps::NeighbourTable & table) {
+      const Index_t nb_offsets{static_cast<Index_t>(this->offsets.size())};
+      const Index_t nb_in{this->nb_input_dofs};
+      const Index_t nb_out{this->nb_output_dofs};
+      this->for_each_pixel(table, [&](const Index_t & index,
+                                      const Index_t * neighbours) {
+        T * input{input_data + index * nb_in};
+        for (Index_t j{0}; j < nb_in; ++j) {
+          Accumulator_t value{0.};
+          for (Index_t k{0}; k < nb_offsets; ++k) {
+            const T * output{output_data + neighbours[k] * nb_out};
+            const Real * column{matrices.data() + (k * nb_in + j) * nb_out};
+            for (Index_t i{0}; i < nb_out; ++i) {
+              value += column[i] * static_cast<Accumulator_t>(output[i]);
+            }
+          }
+          input[j] = static_cast<T>(input[j] + alpha * value);
+        }
+      });
+    }};
+
+    std::vector<DynCcoord_t> mirrored_offsets{};
+    for (auto && offset : this->offsets) {
+      mirrored_offsets.push_back(DynCcoord_t(this->spatial_dim) - offset);
+    }
+
+    auto & collection{dynamic_cast<GlobalFieldCollection &>(
+        input_field.get_collection())};
+    if (not collection.has_ghosts()) {
+      sweep(this->get_neighbour_table(collection.get_pixels(),
+                                      mirrored_offsets));
+      return finished_application();
+    }
+    const DynCcoord_t nb_right{DynCcoord_t(this->spatial_dim) -
+                               this->min_offsets};
+    if (exchanged_field == nullptr) {
+      this->apply_with_ghosts({&output_field}, mirrored_offsets,
+                              this->max_offsets, nb_right, sweep);
+      return finished_application();
+    }
+    return this->begin_apply_with_ghosts({exchanged_field}, mirrored_offsets,
+                                         this->max_offsets, nb_right, sweep);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void ConvolutionOperator::check_fields(
+      const Field & input_field, const Field & output_field) const {
+    for (auto * field : {&input_field, &output_field}) {
+      if (not field->is_global()) {
+        std::stringstream err_msg{};
+        err_msg << "Field type error: field '" << field->get_name()
+                << "' must be a global field (registered in a global "
+                   "FieldCollection)";
+        throw RuntimeError{err_msg.str()};
+      }
+      if (field->get_storage_order() != StorageOrder::ArrayOfStructures) {
+        std::stringstream err_msg{};
+        err_msg << "The convolution operator requires array-of-structures "
+                   "storage order, but the storage order of field '"
+                << field->get_name() << "' is " << field->get_storage_order();
+        throw RuntimeError{err_msg.str()};
+      }
+    }
+    // both fields are indexed through the same neighbour tables
+    if (&input_field.get_collection() != &output_field.get_collection()) {
+      std::stringstream err_msg{};
+      err_msg << "The input and output fields of the convolution operator "
+                 "must live in the same collection, but fields '"
+              << input_field.get_name() << "' and '"
+              << output_field.get_name() << "' do not";
+      throw RuntimeError{err_msg.str()};
+    }
+    if (input_field.get_nb_components() != this->get_nb_input_components() or
+        input_field.get_nb_dof_per_pixel() != this->nb_input_dofs or
+        output_field.get_nb_components() != this->get_nb_output_components() or
+        output_field.get_nb_dof_per_pixel() != this->nb_output_dofs) {
+      std::stringstream err_msg{};
+      err_msg << "Size mismatch: Expected an input field with "
+              << this->get_nb_input_components() << " components on "
+              << this->nb_pixel_input_pts
+              << " sub-points per pixel and an output field with "
+              << this->get_nb_output_components() << " components on "
+              << this->nb_pixel_output_pts
+              << " sub-points per pixel, but the input field '"
+              << input_field.get_name() << "' stores "
+              << input_field.get_nb_dof_per_pixel() << " entries of "
+              << input_field.get_nb_components()
+              << " components and the output field '"
+              << output_field.get_name() << "' stores "
+              << output_field.get_nb_dof_per_pixel() << " entries of "
+              << output_field.get_nb_components()
+              << " components per pixel";
+      throw RuntimeError{err_msg.str()};
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  Index_t ConvolutionOperator::get_nb_pixel_quad_pts() const {
+    return this->nb_pixel_output_pts;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  Index_t ConvolutionOperator::get_nb_pixel_nodal_pts() const {
+    return this->nb_pixel_input_pts;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  Index_t ConvolutionOperator::get_spatial_dim() const {
+    return this->spatial_dim;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  const std::vector<DynCcoord_t> & ConvolutionOperator::get_offsets() const {
+    return this->offsets;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  const std::vector<Eigen::MatrixXd> &
+  ConvolutionOperator::get_coefficients() const {
+    return this->coefficients;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  Index_t ConvolutionOperator::get_nb_input_components() const {
+    return this->nb_input_dofs / this->nb_pixel_input_pts;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  Index_t ConvolutionOperator::get_nb_output_components() const {
+    return this->nb_output_dofs / this->nb_pixel_output_pts;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template void ConvolutionOperator::apply(const TypedFieldBase<Real> &,
+                                           TypedFieldBase<Real> &) const;
+  template void ConvolutionOperator::apply(const TypedFieldBase<Complex> &,
+                                           TypedFieldBase<Complex> &) const;
+  template void ConvolutionOperator::apply(const TypedFieldBase<Float> &,
+                                           TypedFieldBase<Float> &) const;
+
+  template void
+  ConvolutionOperator::apply_increment(const TypedFieldBase<Real> &,
+                                       const Real &,
+                                       TypedFieldBase<Real> &) const;
+  template void
+  ConvolutionOperator::apply_increment(const TypedFieldBase<Complex> &,
+                                       const Complex &,
+                                       TypedFieldBase<Complex> &) const;
+  template void
+  ConvolutionOperator::apply_increment(const TypedFieldBase<Float> &,
+                                       const Real &,
+                                       TypedFieldBase<Float> &) const;
+
+  template void ConvolutionOperator::apply_transpose(
+      const TypedFieldBase<Complex> &, TypedFieldBase<Complex> &,
+      const std::vector<Real> &) const;
+  template void ConvolutionOperator::apply_transpose(
+      const TypedFieldBase<Float> &, TypedFieldBase<Float> &,
+      const std::vector<Real> &) const;
+
+  template void ConvolutionOperator::apply_transpose_increment(
+      const TypedFieldBase<Complex> &, const Complex &,
+      TypedFieldBase<Complex> &, const std::vector<Real> &) const;
+  template void ConvolutionOperator::apply_transpose_increment(
+      const TypedFieldBase<Float> &, const Real &, TypedFieldBase<Float> &,
+      const std::vector<Real> &) const;
+
+  template PendingApplication
+  ConvolutionOperator::begin_apply(TypedFieldBase<Real> &,
+                                   TypedFieldBase<Real> &) const;
+  template PendingApplication
+  ConvolutionOperator::begin_apply(TypedFieldBase<Complex> &,
+                                   TypedFieldBase<Complex> &) const;
+  template PendingApplication
+  ConvolutionOperator::begin_apply(TypedFieldBase<Float> &,
+                                   TypedFieldBase<Float> &) const;
+
+  template PendingApplication
+  ConvolutionOperator::begin_apply_increment(TypedFieldBase<Real> &,
+                                             const Real &,
+                                             TypedFieldBase<Real> &) const;
+  template PendingApplication
+  ConvolutionOperator::begin_apply_increment(TypedFieldBase<Complex> &,
+                                             const Complex &,
+                                             TypedFieldBase<Complex> &) const;
+  template PendingApplication
+  ConvolutionOperator::begin_apply_increment(TypedFieldBase<Float> &,
+                                             const Real &,
+                                             TypedFieldBase<Float> &) const;
+
+  template PendingApplication ConvolutionOperator::begin_apply_transpose(
+      TypedFieldBase<Real> &, TypedFieldBase<Real> &,
+      const std::vector<Real> &) const;
+  template PendingApplication ConvolutionOperator::begin_apply_transpose(
+      TypedFieldBase<Complex> &, TypedFieldBase<Complex> &,
+      const std::vector<Real> &) const;
+  template PendingApplication ConvolutionOperator::begin_apply_transpose(
+      TypedFieldBase<Float> &, TypedFieldBase<Float> &,
+      const std::vector<Real> &) const;
+
+  template PendingApplication
+  ConvolutionOperator::begin_apply_transpose_increment(
+      TypedFieldBase<Real> &, const Real &, TypedFieldBase<Real> &,
+      const std::vector<Real> &) const;
+  template PendingApplication
+  ConvolutionOperator::begin_apply_transpose_increment(
+      TypedFieldBase<Complex> &, const Complex &, TypedFieldBase<Complex> &,
+      const std::vector<Real> &) const;
+  template PendingApplication
+  ConvolutionOperator::begin_apply_transpose_increment(
+      TypedFieldBase<Float> &, const Real &, TypedFieldBase<Float> &,
+      const std::vector<Real> &) const;
+
+}  // namespace muGrid
@@ -0,0 +1,279 @@
+/**
+ * @file   convolution_operator.hh
+ *
+ * @author Lars Pastewka <lars.pastewka@imtek.uni-freiburg.de>
+ *
+ * @date   16 Oct 2026
+ *
+ * @brief  matrix-free operator applying an arbitrary pixel stencil
+ *
+ * Copyright © 2026 Lars Pastewka
+ *
+ * µGrid is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * µGrid is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with µGrid; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * Additional permission under GNU GPL version 3 section 7
+ *
+ * If you modify this Program, or any covered work, by linking or combining it
+ * with proprietary FFT implementations or numerical libraries, containing parts
+ * covered by the terms of those libraries' licenses, the licensors of this
+ * Program grant you additional permission to convey the resulting work.
+ *
+ */
+
+#include "stencil_operator_base.hh"
+#include "gradient_kernel.hh"
+
+#include "Eigen/Dense"
+
+#include <vector>
+
+#ifndef SRC_LIBMUGRID_CONVOLUTION_OPERATOR_HH_
+#define SRC_LIBMUGRID_CONVOLUTION_OPERATOR_HH_
+
+namespace muGrid {
+
+  /**
+   * Matrix-free linear operator defined by an arbitrary stencil, e.g. a
+   * finite-difference Laplacian, a filter or a higher-order difference.
+   *
+   * The stencil is a list of pixel offsets o_k and one coefficient matrix C_k
+   * per offset. The operator maps an input field u to an output field v with
+   *
+   *     v(x) = Σ_k C_k u(x + o_k).
+   *
+   * Per pixel, u and v are stacked as the vectors of all their entries in
+   * array-of-structures order, i.e. the component index runs fastest and the
+   * sub-point index slowest. C_k hence has nb_output_components ×
+   * nb_pixel_output_pts rows and nb_input_components × nb_pixel_input_pts
+   * columns; the numbers of components are deduced from these shapes.
+   *
+   * In the vocabulary of `GradientOperatorBase`, the input field lives on
+   * the "nodal" points and the output field on the "quadrature" points.
+   *
+   * The operator applies to `Real`, `Complex` and `Float` fields. The
+   * coefficients are always double precision and the sums over the stencil
+   * are accumulated in `GradientAccumulator_t`, i.e. in double precision for
+   * single-precision fields.
+   */
+  class ConvolutionOperator : public StencilOperatorBase {
+   public:
+    using Parent = StencilOperatorBase;
+    //! Default constructor
+    ConvolutionOperator() = delete;
+
+    /**
+     * constructor
+     *
+     * @param spatial_dim spatial dimension of the stencil
+     * @param offsets pixel offsets of the stencil points
+     * @param coefficients per stencil point, the matrix mapping the entries
+     * of the input field at the offset pixel to the output field
+     * @param nb_pixel_input_pts number of input sub-points per pixel
+     * @param nb_pixel_output_pts number of output sub-points per pixel
+     */
+    ConvolutionOperator(const Index_t & spatial_dim,
+                        const std::vector<DynCcoord_t> & offsets,
+                        const std::vector<Eigen::MatrixXd> & coefficients,
+                        const Index_t & nb_pixel_input_pts = 1,
+                        const Index_t & nb_pixel_output_pts = 1);
+
+    //! Copy constructor
+    ConvolutionOperator(const ConvolutionOperator & other) = delete;
+
+    //! Move constructor
+    ConvolutionOperator(ConvolutionOperator && other) = default;
+
+    //! Destructor
+    virtual ~ConvolutionOperator() = default;
+
+    //! Copy assignment operator
+    ConvolutionOperator & operator=(const ConvolutionOperator & other) = delete;
+
+    //! Move assignment operator
+    ConvolutionOperator & operator=(ConvolutionOperator && other) = default;
+
+    /**
+     * Applies the operator to input_field and writes the result into
+     * output_field.
+     *
+     * If the fields live in a collection with ghost layers, the operator is
+     * only evaluated on the pixels of the subdomain and the neighbouring
+     * input values are read from the ghost layers. The caller fills these
+     * ghosts (see `Field::communicate_ghosts`), or lets `begin_apply` fill
+     * them while the interior is evaluated. Otherwise, the subdomain is
+     * treated as periodic.
+     */
+    template <typename T>
+    void apply(const TypedFieldBase<T> & input_field,
+               TypedFieldBase<T> & output_field) const;
+
+    //! Applies the operator to input_field and adds alpha times the result
+    //! to output_field
+    template <typename T>
+    void apply_increment(const TypedFieldBase<T> & input_field,
+                         const GradientAccumulator_t<T> & alpha,
+                         TypedFieldBase<T> & output_field) const;
+
+    //! same as `apply`
+    void apply_gradient(const TypedFieldBase<Real> & input_field,
+                        TypedFieldBase<Real> & output_field) const final;
+
+    //! same as `apply_increment`
+    void apply_gradient_increment(
+        const TypedFieldBase<Real> & input_field, const Real & alpha,
+        TypedFieldBase<Real> & output_field) const final;
+
+    /**
+     * Applies the transpose of the operator to output_field and writes the
+     * result into input_field,
+     *
+     *     u(x) = Σ_k C_kᵀ W v(x - o_k),
+     *
+     * where W is the diagonal matrix of the weights of the output sub-points
+     * (the identity if weights are omitted). With ghost layers, the output
+     * values of the neighbouring pixels are read from the ghosts, which the
+     * caller fills, or lets `begin_apply_transpose` fill.
+     */
+    void apply_transpose(const TypedFieldBase<Real> & output_field,
+                         TypedFieldBase<Real> & input_field,
+                         const std::vector<Real> & weights = {}) const final;
+
+    //! Applies the transpose of the operator to output_field and adds alpha
+    //! times the result to input_field
+    void apply_transpose_increment(
+        const TypedFieldBase<Real> & output_field, const Real & alpha,
+        TypedFieldBase<Real> & input_field,
+        const std::vector<Real> & weights = {}) const final;
+
+    //! `apply_transpose` for `Complex` and `Float` fields
+    template <typename T>
+    void apply_transpose(const TypedFieldBase<T> & output_field,
+                         TypedFieldBase<T> & input_field,
+                         const std::vector<Real> & weights = {}) const;
+
+    //! `apply_transpose_increment` for `Complex` and `Float` fields
+    template <typename T>
+    void apply_transpose_increment(
+        const TypedFieldBase<T> & output_field,
+        const GradientAccumulator_t<T> & alpha, TypedFieldBase<T> & input_field,
+        const std::vector<Real> & weights = {}) const;
+
+    /**
+     * Begins `apply` on fields with ghost layers: starts filling the ghosts
+     * of the input field, evaluates the pixels that do not read from the
+     * ghosts while the messages are in flight and returns the evaluation of
+     * the remaining shell of pixels as a pending application, see
+     * `PendingApplication`. Without ghost layers, all pixels are evaluated
+     * and the returned application has already finished.
+     */
+    template <typename T>
+    PendingApplication begin_apply(TypedFieldBase<T> & input_field,
+                                   TypedFieldBase<T> & output_field) const;
+
+    //! increment form of `begin_apply`
+    template <typename T>
+    PendingApplication
+    begin_apply_increment(TypedFieldBase<T> & input_field,
+                          const GradientAccumulator_t<T> & alpha,
+                          TypedFieldBase<T> & output_field) const;
+
+    //! begins `apply_transpose`, filling the ghosts of the output field, see
+    //! `begin_apply`
+    template <typename T>
+    PendingApplication
+    begin_apply_transpose(TypedFieldBase<T> & output_field,
+                          TypedFieldBase<T> & input_field,
+                          const std::vector<Real> & weights = {}) const;
+
+    //! increment form of `begin_apply_transpose`
+    template <typename T>
+    PendingApplication begin_apply_transpose_increment(
+        TypedFieldBase<T> & output_field,
+        const GradientAccumulator_t<T> & alpha, TypedFieldBase<T> & input_field,
+        const std::vector<Real> & weights = {}) const;
+
+    //! return the number of output sub-points per pixel
+    Index_t get_nb_pixel_quad_pts() const final;
+
+    //! return the number of input sub-points per pixel
+    Index_t get_nb_pixel_nodal_pts() const final;
+
+    //! return the spatial dimension of the stencil
+    Index_t get_spatial_dim() const final;
+
+    //! return the pixel offsets of the stencil points
+    const std::vector<DynCcoord_t> & get_offsets() const;
+
+    //! return the coefficient matrices of the stencil points
+    const std::vector<Eigen::MatrixXd> & get_coefficients() const;
+
+    //! return the number of components of the input field
+    Index_t get_nb_input_components() const;
+
+    //! return the number of components of the output field
+    Index_t get_nb_output_components() const;
+
+   protected:
+    /**
+     * `apply_increment`. With ghost layers, the ghosts of `exchanged_field`
+     * (the input field, or none if the caller has filled the ghosts) are
+     * filled while the interior is evaluated, and the evaluation of the
+     * shell is returned as a pending application.
+     */
+    template <typename T>
+    PendingApplication
+    apply_increment_impl(const TypedFieldBase<T> & input_field,
+                         const GradientAccumulator_t<T> & alpha,
+                         TypedFieldBase<T> & output_field,
+                         Field * exchanged_field) const;
+
+    //! `apply_transpose_increment`, see `apply_increment_impl`
+    template <typename T>
+    PendingApplication apply_transpose_increment_impl(
+        const TypedFieldBase<T> & output_field,
+        const GradientAccumulator_t<T> & alpha, TypedFieldBase<T> & input_field,
+        const std::vector<Real> & weights, Field * exchanged_field) const;
+
+    /**
+     * check that the fields are global, live in the same collection, are
+     * stored as array of structures and match the shapes of the coefficient
+     * matrices
+     */
+    void check_fields(const Field & input_field,
+                      const Field & output_field) const;
+
+    //! smallest and largest offsets per direction
+    DynCcoord_t min_offsets{}, max_offsets{};
+
+    Index_t spatial_dim;
+    std::vector<DynCcoord_t> offsets;
+    std::vector<Eigen::MatrixXd> coefficients;
+    //! number of input sub-points per pixel
+    Index_t nb_pixel_input_pts;
+    //! number of output sub-points per pixel
+    Index_t nb_pixel_output_pts;
+    //! number of entries of the output field per pixel
+    Index_t nb_output_dofs;
+    //! number of entries of the input field per pixel
+    Index_t nb_input_dofs;
+    //! entries of all coefficient matrices, one after another in
+    //! column-major order, for the pixel loops
+    std::vector<Real> flat_coefficients{};
+  };
+
+}  // namespace muGrid
+
+#endif  // SRC_LIBMUGRID_CONVOLUTION_OPERATOR_HH_
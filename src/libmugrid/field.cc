@@ -278,7 +278,7 @@ namespace muGrid {
     } else {
       std::stringstream s;
       s << "Don't know how to construct strides for storage order "
-        << this->collection.get_storage_order();
+        << this->get_storage_order();
       throw FieldError(s.str());
     }
     return strides;
@@ -286,7 +286,10 @@ namespace muGrid {
 
   /* ---------------------------------------------------------------------- */
   StorageOrder Field::get_storage_order() const {
-    return this->collection.get_storage_order();
+    if (this->storage_order == StorageOrder::Automatic) {
+      return this->collection.get_storage_order();
+    }
+    return this->storage_order;
   }
 
   /* ---------------------------------------------------------------------- */
@@ -312,8 +315,13 @@ namespace muGrid {
 
   /* ---------------------------------------------------------------------- */
   bool Field::has_same_memory_layout(const Field & other) const {
-    return this->get_collection().has_same_memory_layout(
-               other.get_collection()) &&
+    auto && collection{this->get_collection()};
+    auto && other_collection{other.get_collection()};
+    return collection.get_pixels_shape() ==
+               other_collection.get_pixels_shape() &&
+           collection.get_pixels_strides() ==
+               other_collection.get_pixels_strides() &&
+           this->get_storage_order() == other.get_storage_order() &&
            this->get_nb_sub_pts() == other.get_nb_sub_pts() &&
            this->get_components_strides() == other.get_components_strides();
   }
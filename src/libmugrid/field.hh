@@ -221,6 +221,43 @@ namespace muGrid {
      */
     virtual StorageOrder get_storage_order() const;
 
+    /**
+     * Convert the values of the field in place to the given storage order,
+     * i.e., transpose them between an array of structures
+     * (`StorageOrder::ColMajor`) and a structure of arrays
+     * (`StorageOrder::RowMajor`). From then on, the field keeps this storage
+     * order independently of its collection. `StorageOrder::Automatic`
+     * converts the field back to the storage order of its collection. The
+     * transposition uses the blocked kernel of `raw_mem_ops::strided_copy`
+     * and a temporary buffer of the size of the field, the data pointer of
+     * the field does not change. Maps created before the conversion are not
+     * updated and must not be used afterwards.
+     */
+    virtual void convert_storage_order(const StorageOrder & storage_order) = 0;
+
+    /**
+     * throws a `FieldError` if `convert_storage_order(storage_order)` would
+     * fail, without touching the values. This lets a collection validate all
+     * of its fields before converting any of them.
+     */
+    virtual void check_storage_order_conversion(
+        const StorageOrder & storage_order) const = 0;
+
+    //! whether the values of the field are stored in the arena of its
+    //! collection (see `FieldCollection::set_arena_allocation`)
+    virtual bool is_in_arena() const { return false; }
+
+    /**
+     * move the values of the field out of the arena of its collection into
+     * memory of its own (nothing happens for fields outside the arena). This
+     * is required before a field can grow through `push_back`, hand out its
+     * storage through `TypedField::get_values` or be removed from its
+     * collection through `FieldCollection::pop_field`. The data pointer of the
+     * field changes, hence all pointers, maps and Eigen views of its values
+     * obtained before are invalidated.
+     */
+    virtual void leave_arena() {}
+
     /**
      * evaluate and return the number of components in an iterate when iterating
      * over this field
@@ -283,6 +320,30 @@ namespace muGrid {
      */
     virtual void set_zero() = 0;
 
+    /**
+     * fill the ghost layers of a global field with the values of the
+     * neighbouring subdomains (or of the periodic image of the own subdomain).
+     * This is a collective operation, all processes of the collection's
+     * communicator need to call it. Does nothing if the collection has no
+     * ghost layers.
+     */
+    virtual void communicate_ghosts() = 0;
+
+    /**
+     * start filling the ghost layers without waiting for the communication
+     * to complete. The ghost layers hold valid values only after the
+     * matching call to `finish_communicate_ghosts`, while the values of the
+     * subdomain can be read in between (but must not be modified). This
+     * allows overlapping the communication with computations on the interior
+     * of the subdomain. Only the ghost layers are written, but they are part
+     * of the field's values, hence this is not a const operation.
+     */
+    virtual void begin_communicate_ghosts() = 0;
+
+    //! wait for the communication started by `begin_communicate_ghosts` and
+    //! fill the ghost layers with the received values
+    virtual void finish_communicate_ghosts() = 0;
+
     /**
      * checks whether this field is registered in a global FieldCollection
      */
@@ -331,6 +392,12 @@ namespace muGrid {
      */
     Shape_t get_pixels_strides(Index_t element_size = 1) const;
 
+    /**
+     * storage order of the values of this field, `StorageOrder::Automatic`
+     * if it is the one of the collection (see `convert_storage_order`)
+     */
+    StorageOrder storage_order{StorageOrder::Automatic};
+
     /**
      * maintains a tally of the current size, as it cannot be reliably
      * determined from `values` alone.
@@ -340,6 +407,19 @@ namespace muGrid {
     //! resizes the field to the given size
     virtual void resize() = 0;
 
+    /**
+     * return the number of bytes the field needs in the arena of its
+     * collection (see `FieldCollection::set_arena_allocation`), or zero if
+     * the field does not own its memory and is not placed in the arena
+     */
+    virtual size_t get_arena_bytes() const { return 0; }
+
+    /**
+     * store the field's data in `get_arena_bytes()` bytes of the arena,
+     * starting at `arena_ptr`. Values the field already holds are copied
+     */
+    virtual void place_in_arena(void * /*arena_ptr*/) {}
+
     const std::string name;  //!< the field's unique name
 
     //! reference to the collection this field belongs to
@@ -38,8 +38,17 @@
 #include "state_field.hh"
 #include "field_typed.hh"
 
+#include <cstring>
+
+#if __has_include(<sys/mman.h>)
+#include <sys/mman.h>
+#endif
+
 namespace muGrid {
 
+  //! size of the huge pages the arena of a collection may be aligned to
+  constexpr size_t HugePageSize{2 * 1024 * 1024};
+
   /* ---------------------------------------------------------------------- */
   template <class DefaultDestroyable>
   void
@@ -93,6 +102,22 @@ namespace muGrid {
                                                 sub_division_tag, unit);
   }
 
+  /* ---------------------------------------------------------------------- */
+  TypedField<Float> & FieldCollection::register_float_field(
+      const std::string & unique_name, const Index_t & nb_components,
+      const std::string & sub_division_tag, const Unit & unit) {
+    return this->register_field_helper<Float>(unique_name, nb_components,
+                                              sub_division_tag, unit);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  TypedField<Float> & FieldCollection::register_float_field(
+      const std::string & unique_name, const Shape_t & components_shape,
+      const std::string & sub_division_tag, const Unit & unit) {
+    return this->register_field_helper<Float>(unique_name, components_shape,
+                                              sub_division_tag, unit);
+  }
+
   /* ---------------------------------------------------------------------- */
   TypedField<Int> & FieldCollection::register_int_field(
       const std::string & unique_name, const Index_t & nb_components,
@@ -193,6 +218,22 @@ namespace muGrid {
                                                 sub_division_tag, unit, true);
   }
 
+  /* ---------------------------------------------------------------------- */
+  TypedField<Float> & FieldCollection::float_field(
+      const std::string & unique_name, const Index_t & nb_components,
+      const std::string & sub_division_tag, const Unit & unit) {
+    return this->register_field_helper<Float>(unique_name, nb_components,
+                                              sub_division_tag, unit, true);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  TypedField<Float> & FieldCollection::float_field(
+      const std::string & unique_name, const Shape_t & components_shape,
+      const std::string & sub_division_tag, const Unit & unit) {
+    return this->register_field_helper<Float>(unique_name, components_shape,
+                                              sub_division_tag, unit, true);
+  }
+
   /* ---------------------------------------------------------------------- */
   TypedField<Int> & FieldCollection::int_field(
       const std::string & unique_name, const Index_t & nb_components,
@@ -356,6 +397,41 @@ namespace muGrid {
            this->get_pixels_strides() == other.get_pixels_strides();
   }
 
+  /* ---------------------------------------------------------------------- */
+  void FieldCollection::convert_storage_order(
+      const StorageOrder & storage_order) {
+    if (storage_order != StorageOrder::ColMajor and
+        storage_order != StorageOrder::RowMajor) {
+      std::stringstream error{};
+      error << "Field collections can only be converted to the storage "
+               "orders ColMajor and RowMajor, not to "
+            << storage_order;
+      throw FieldCollectionError(error.str());
+    }
+    // validate all fields first, such that a failure leaves the collection
+    // untouched rather than partially converted
+    for (auto && name_field : this->fields) {
+      name_field.second->check_storage_order_conversion(storage_order);
+    }
+    for (auto && scratch : this->scratch_fields) {
+      scratch.field->check_storage_order_conversion(storage_order);
+    }
+    for (auto && name_field : this->fields) {
+      name_field.second->convert_storage_order(storage_order);
+    }
+    for (auto && scratch : this->scratch_fields) {
+      scratch.field->convert_storage_order(storage_order);
+    }
+    this->storage_order = storage_order;
+    // the fields follow the storage order of the collection again
+    for (auto && name_field : this->fields) {
+      name_field.second->storage_order = StorageOrder::Automatic;
+    }
+    for (auto && scratch : this->scratch_fields) {
+      scratch.field->storage_order = StorageOrder::Automatic;
+    }
+  }
+
   /* ---------------------------------------------------------------------- */
   bool FieldCollection::is_initialised() const { return this->initialised; }
 
@@ -372,6 +448,9 @@ namespace muGrid {
 
   /* ---------------------------------------------------------------------- */
   void FieldCollection::allocate_fields() {
+    // fields in the arena and their offsets into it
+    std::vector<std::pair<Field *, size_t>> arena_slots{};
+    size_t arena_size{0};
     for (auto && item : this->fields) {
       auto && field{*item.second};
       const auto field_size{field.get_current_nb_entries()};
@@ -386,12 +465,71 @@ namespace muGrid {
                    << " entries.";
         throw FieldCollectionError(err_stream.str());
       }
-      // resize is being called unconditionally, because it alone guarantees
-      // the validity of the field's `data_ptr`
-      field.resize();
+      const size_t nb_bytes{this->arena_allocation ? field.get_arena_bytes()
+                                                   : 0};
+      if (nb_bytes > 0) {
+        arena_slots.emplace_back(&field, arena_size);
+        arena_size += (nb_bytes + FieldAlignment - 1) / FieldAlignment *
+                      FieldAlignment;
+      } else {
+        // resize is being called unconditionally, because it alone
+        // guarantees the validity of the field's `data_ptr`
+        field.resize();
+      }
+    }
+    if (arena_size == 0) {
+      return;
+    }
+
+    const size_t alignment{this->arena_huge_pages ? HugePageSize
+                                                  : FieldAlignment};
+    this->arena_size = (arena_size + alignment - 1) / alignment * alignment;
+    this->arena = std::unique_ptr<char[], AlignedDeleter>{
+        static_cast<char *>(
+            ::operator new(this->arena_size, std::align_val_t{alignment})),
+        AlignedDeleter{alignment}};
+#ifdef MADV_HUGEPAGE
+    if (this->arena_huge_pages) {
+      // only advice, the arena is usable whether or not it is followed
+      madvise(this->arena.get(), this->arena_size, MADV_HUGEPAGE);
     }
+#endif
+    // the fields initialise their slots on the threads that later update
+    // them (first touch), only the alignment gaps between them are zeroed
+    // here, such that the whole arena can be checkpointed
+    for (size_t i{0}; i < arena_slots.size(); ++i) {
+      auto && slot{arena_slots[i]};
+      slot.first->place_in_arena(this->arena.get() + slot.second);
+      const size_t end{slot.second + slot.first->get_arena_bytes()};
+      const size_t next{i + 1 < arena_slots.size() ? arena_slots[i + 1].second
+                                                   : this->arena_size};
+      std::memset(this->arena.get() + end, 0, next - end);
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void FieldCollection::set_arena_allocation(const bool & enable,
+                                             const bool & huge_pages) {
+    if (this->initialised) {
+      throw FieldCollectionError(
+          "The arena allocation can only be chosen before the collection is "
+          "initialised");
+    }
+    this->arena_allocation = enable;
+    this->arena_huge_pages = huge_pages;
   }
 
+  /* ---------------------------------------------------------------------- */
+  bool FieldCollection::get_arena_allocation() const {
+    return this->arena_allocation;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void * FieldCollection::get_arena_data() const { return this->arena.get(); }
+
+  /* ---------------------------------------------------------------------- */
+  size_t FieldCollection::get_arena_size() const { return this->arena_size; }
+
   /* ---------------------------------------------------------------------- */
   void FieldCollection::initialise_maps() {
     for (auto & weak_callback : this->init_callbacks) {
@@ -421,11 +559,60 @@ namespace muGrid {
       err_stream << "The field '" << unique_name << "' does not exist";
       throw FieldCollectionError(err_stream.str());
     }
+    // the arena does not outlive the collection
+    if (this->fields[unique_name]->is_in_arena()) {
+      std::stringstream err_stream{};
+      err_stream << "The field '" << unique_name
+                 << "' is stored in the arena of the collection and cannot be "
+                    "popped. Call leave_arena() on it first, which "
+                    "invalidates all pointers to and maps of its values";
+      throw FieldCollectionError(err_stream.str());
+    }
     auto field_ptr{std::move(this->fields[unique_name])};
     this->fields.erase(unique_name);
     return field_ptr;
   }
 
+  /* ---------------------------------------------------------------------- */
+  ScratchField<Real>
+  FieldCollection::borrow_real_field(const Index_t & nb_components,
+                                     const std::string & sub_division_tag) {
+    return this->borrow_field<Real>(nb_components, sub_division_tag);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  ScratchField<Complex>
+  FieldCollection::borrow_complex_field(const Index_t & nb_components,
+                                        const std::string & sub_division_tag) {
+    return this->borrow_field<Complex>(nb_components, sub_division_tag);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  ScratchField<Float>
+  FieldCollection::borrow_float_field(const Index_t & nb_components,
+                                      const std::string & sub_division_tag) {
+    return this->borrow_field<Float>(nb_components, sub_division_tag);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  ScratchField<Int>
+  FieldCollection::borrow_int_field(const Index_t & nb_components,
+                                    const std::string & sub_division_tag) {
+    return this->borrow_field<Int>(nb_components, sub_division_tag);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  ScratchField<Uint>
+  FieldCollection::borrow_uint_field(const Index_t & nb_components,
+                                     const std::string & sub_division_tag) {
+    return this->borrow_field<Uint>(nb_components, sub_division_tag);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  size_t FieldCollection::get_nb_scratch_fields() const {
+    return this->scratch_fields.size();
+  }
+
   /* ---------------------------------------------------------------------- */
   StateField &
   FieldCollection::get_state_field(const std::string & unique_prefix) {
@@ -478,6 +665,10 @@ namespace muGrid {
   FieldCollection::register_field<Complex>(const std::string &, const Index_t &,
                                            const std::string &, const Unit &);
 
+  template TypedField<Float> &
+  FieldCollection::register_field<Float>(const std::string &, const Index_t &,
+                                         const std::string &, const Unit &);
+
   template TypedField<Int> &
   FieldCollection::register_field<Int>(const std::string &, const Index_t &,
                                        const std::string &, const Unit &);
@@ -498,6 +689,10 @@ namespace muGrid {
   FieldCollection::detached_field(const std::string &, const Shape_t &,
                                   const std::string &, const Unit &);
 
+  template std::unique_ptr<TypedField<Float>, FieldDestructor<Field>>
+  FieldCollection::detached_field(const std::string &, const Shape_t &,
+                                  const std::string &, const Unit &);
+
   template std::unique_ptr<TypedField<Int>, FieldDestructor<Field>>
   FieldCollection::detached_field(const std::string &, const Shape_t &,
                                   const std::string &, const Unit &);
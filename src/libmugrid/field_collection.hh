@@ -36,6 +36,7 @@
 #ifndef SRC_LIBMUGRID_FIELD_COLLECTION_HH_
 #define SRC_LIBMUGRID_FIELD_COLLECTION_HH_
 
+#include "aligned_allocator.hh"
 #include "exception.hh"
 #include "grid_common.hh"
 #include "units.hh"
@@ -56,6 +57,10 @@ namespace muGrid {
   template <typename T>
   class TypedField;
 
+  //! forward declaration of the scratch field handle
+  template <typename T>
+  class ScratchField;
+
   //! forward declaration of the state field
   class StateField;
 
@@ -171,7 +176,7 @@ namespace muGrid {
                    const Unit & unit = Unit::unitless()) {
       static_assert(std::is_scalar<T>::value or std::is_same<T, Complex>::value,
                     "You can only register fields templated with one of the "
-                    "numeric types Real, Complex, Int, or UInt");
+                    "numeric types Real, Complex, Float, Int, or UInt");
       return this->register_field_helper<T>(unique_name, nb_components,
                                             sub_division_tag, unit);
     }
@@ -194,7 +199,7 @@ namespace muGrid {
                    const Unit & unit = Unit::unitless()) {
       static_assert(std::is_scalar<T>::value or std::is_same<T, Complex>::value,
                     "You can only register fields templated with one of the "
-                    "numeric types Real, Complex, Int, or Uint");
+                    "numeric types Real, Complex, Float, Int, or Uint");
       return this->register_field_helper<T>(unique_name, components_shape,
                                             sub_division_tag, unit);
     }
@@ -288,6 +293,38 @@ namespace muGrid {
                            const std::string & sub_division_tag = PixelTag,
                            const Unit & unit = Unit::unitless());
 
+    /**
+     * place a new single-precision real-valued field in the responsibility of
+     * this collection (Note, because fields have protected constructors, users
+     * can't create them
+     * @param unique_name unique identifier for this field
+     * @param nb_components number of components to be stored per sub-point
+     * (e.g., 4 for a two-dimensional second-rank tensor, or 1 for a scalar
+     * field)
+     * @param sub_division_tag unique identifier of the subdivision scheme
+     * @param unit phyiscal unit of this field
+     */
+    TypedField<Float> &
+    register_float_field(const std::string & unique_name,
+                         const Index_t & nb_components,
+                         const std::string & sub_division_tag = PixelTag,
+                         const Unit & unit = Unit::unitless());
+
+    /**
+     * place a new field in the responsibility of this collection (Note, because
+     * fields have protected constructors, users can't create them
+     * @param unique_name unique identifier for this field
+     * @param components_shape number of components to store per quadrature
+     * point
+     * @param sub_division_tag unique identifier of the subdivision scheme
+     * @param unit phyiscal unit of this field
+     */
+    TypedField<Float> &
+    register_float_field(const std::string & unique_name,
+                         const Shape_t & components_shape,
+                         const std::string & sub_division_tag = PixelTag,
+                         const Unit & unit = Unit::unitless());
+
     /**
      * place a new integer-valued field  in the responsibility of this
      * collection (Note, because fields have protected constructors, users can't
@@ -368,7 +405,7 @@ namespace muGrid {
       static_assert(
           std::is_scalar<T>::value or std::is_same<T, Complex>::value,
           "You can only register state fields templated with one of the "
-          "numeric types Real, Complex, Int, or UInt");
+          "numeric types Real, Complex, Float, Int, or UInt");
       return this->register_state_field_helper<T>(
           unique_prefix, nb_memory, nb_components, sub_division_tag, unit);
     }
@@ -457,7 +494,7 @@ namespace muGrid {
                           const Unit & unit = Unit::unitless()) {
       static_assert(std::is_scalar<T>::value or std::is_same<T, Complex>::value,
                     "You can only register fields templated with one of the "
-                    "numeric types Real, Complex, Int, or Uint");
+                    "numeric types Real, Complex, Float, Int, or Uint");
       return this->register_field_helper<T>(unique_name, components_shape,
                                             sub_division_tag, unit, true);
     }
@@ -527,6 +564,38 @@ namespace muGrid {
                   const std::string & sub_division_tag = PixelTag,
                   const Unit & unit = Unit::unitless());
 
+    /**
+     * return the single-precision real-valued field `unique_name`, placing a
+     * new one in the responsibility of this collection if it does not exist
+     * yet
+     * @param unique_name unique identifier for this field
+     * @param nb_components number of components to be stored per sub-point
+     * (e.g., 4 for a two-dimensional second-rank tensor, or 1 for a scalar
+     * field)
+     * @param sub_division_tag unique identifier of the subdivision scheme
+     * @param unit phyiscal unit of this field
+     */
+    TypedField<Float> &
+    float_field(const std::string & unique_name, const Index_t & nb_components,
+                const std::string & sub_division_tag = PixelTag,
+                const Unit & unit = Unit::unitless());
+
+    /**
+     * return the single-precision real-valued field `unique_name`, placing a
+     * new one in the responsibility of this collection if it does not exist
+     * yet
+     * @param unique_name unique identifier for this field
+     * @param components_shape number of components to store per quadrature
+     * point
+     * @param sub_division_tag unique identifier of the subdivision scheme
+     * @param unit phyiscal unit of this field
+     */
+    TypedField<Float> &
+    float_field(const std::string & unique_name,
+                const Shape_t & components_shape,
+                const std::string & sub_division_tag = PixelTag,
+                const Unit & unit = Unit::unitless());
+
     /**
      * place a new integer-valued field  in the responsibility of this
      * collection (Note, because fields have protected constructors, users can't
@@ -603,7 +672,7 @@ namespace muGrid {
       static_assert(
           std::is_scalar<T>::value or std::is_same<T, Complex>::value,
           "You can only register state fields templated with one of the "
-          "numeric types Real, Complex, Int, or UInt");
+          "numeric types Real, Complex, Float, Int, or UInt");
       return this->register_state_field_helper<T>(unique_prefix, nb_memory,
                                                   nb_components,
                                                   sub_division_tag, unit, true);
@@ -738,12 +807,49 @@ namespace muGrid {
     //! check whether two field collections have the same memory layout
     bool has_same_memory_layout(const FieldCollection & other) const;
 
+    /**
+     * convert all fields of the collection (including the scratch pool) to
+     * the given storage order (`StorageOrder::ColMajor` or
+     * `StorageOrder::RowMajor`), which also becomes the storage order of
+     * fields registered later on. The storage order of the pixels, fixed at
+     * initialisation, is not affected. All fields are validated before any
+     * values are moved, so if one of them cannot be converted (e.g. while a
+     * ghost exchange is pending), a `FieldError` is thrown and no field is
+     * modified. See `Field::convert_storage_order`.
+     */
+    void convert_storage_order(const StorageOrder & storage_order);
+
     /**
      * whether the collection has been properly initialised (i.e., it knows the
      * number of quadrature points and all its pixels/voxels
      */
     bool is_initialised() const;
 
+    /**
+     * Place all fields registered before initialisation in a single
+     * contiguous allocation (the arena) instead of one allocation per field.
+     * Every field starts at a multiple of `FieldAlignment` bytes into the
+     * arena. Fields registered after initialisation, or resized later, get
+     * memory of their own. Must be set before `initialise`.
+     *
+     * @param enable whether to use the arena
+     * @param huge_pages whether to align the arena to huge pages (2 MiB) and
+     * advise the operating system to back it with them (Linux only, the
+     * advice may be ignored)
+     */
+    void set_arena_allocation(const bool & enable,
+                              const bool & huge_pages = false);
+
+    //! whether the fields are placed in an arena at initialisation
+    bool get_arena_allocation() const;
+
+    //! return the start of the arena, or `nullptr` if there is none, e.g.
+    //! to checkpoint or `madvise` all fields at once
+    void * get_arena_data() const;
+
+    //! return the size of the arena in bytes
+    size_t get_arena_size() const;
+
     /**
      * return an iterable proxy to the collection which allows to efficiently
      * iterate over the indices fo the collection's pixels
@@ -767,10 +873,64 @@ namespace muGrid {
     /**
      * returns the unique ptr holding the field named unique_name. Warning: note
      * that this effectively removes the field from the collection. You can use
-     * this to delete fields to free memory
+     * this to delete fields to free memory. Fields stored in the arena of the
+     * collection need to `Field::leave_arena` first, as the arena does not
+     * outlive the collection.
      */
     Field_ptr pop_field(const std::string & unique_name);
 
+    /**
+     * Borrow a temporary field from the scratch pool of this collection. The
+     * field is returned to the pool when the returned handle goes out of
+     * scope and lent again to the next borrower asking for the same type,
+     * number of components and sub-division. Borrowing hence only allocates
+     * if all matching fields of the pool are in use, and never touches the
+     * registry of named fields. The values of a reused field are those its
+     * previous borrower left, in the storage order of the collection even if
+     * the previous borrower converted the field (see
+     * `Field::convert_storage_order`). The collection must be initialised
+     * and must outlive the handle.
+     *
+     * @param nb_components number of components to be stored per sub-point
+     * @param sub_division_tag unique identifier of the subdivision scheme
+     */
+    template <typename T>
+    ScratchField<T> borrow_field(const Index_t & nb_components,
+                                 const std::string & sub_division_tag =
+                                     PixelTag);
+
+    //! borrow a real-valued field from the scratch pool, see `borrow_field`
+    ScratchField<Real>
+    borrow_real_field(const Index_t & nb_components,
+                      const std::string & sub_division_tag = PixelTag);
+
+    //! borrow a complex-valued field from the scratch pool, see
+    //! `borrow_field`
+    ScratchField<Complex>
+    borrow_complex_field(const Index_t & nb_components,
+                         const std::string & sub_division_tag = PixelTag);
+
+    //! borrow a single-precision real-valued field from the scratch pool, see
+    //! `borrow_field`
+    ScratchField<Float>
+    borrow_float_field(const Index_t & nb_components,
+                       const std::string & sub_division_tag = PixelTag);
+
+    //! borrow an integer-valued field from the scratch pool, see
+    //! `borrow_field`
+    ScratchField<Int>
+    borrow_int_field(const Index_t & nb_components,
+                     const std::string & sub_division_tag = PixelTag);
+
+    //! borrow an unsigned integer-valued field from the scratch pool, see
+    //! `borrow_field`
+    ScratchField<Uint>
+    borrow_uint_field(const Index_t & nb_components,
+                      const std::string & sub_division_tag = PixelTag);
+
+    //! return the number of fields in the scratch pool, lent or not
+    size_t get_nb_scratch_fields() const;
+
     /**
      * returns a (base-type) reference to the state field identified by
      * `unique_prefix`. Throws a `muGrid::FieldCollectionError` if the state
@@ -847,15 +1007,41 @@ namespace muGrid {
      */
     void allocate_fields();
 
+    //! handles give their fields back to the scratch pool
+    template <typename T>
+    friend class ScratchField;
+
+    //! field of the scratch pool
+    struct ScratchSlot {
+      Field_ptr field;  //!< the pooled field
+      bool in_use;      //!< whether the field is currently lent out
+    };
+
     /**
      * initialise all preregistered maps
      */
     void initialise_maps();
 
+    //! whether the fields are placed in an arena at initialisation
+    bool arena_allocation{false};
+    //! whether the arena is aligned to and advised to use huge pages
+    bool arena_huge_pages{false};
+    //! size of the arena in bytes
+    size_t arena_size{0};
+    /**
+     * single allocation holding the fields registered before initialisation,
+     * if `arena_allocation` is set. Declared before the fields, such that it
+     * outlives them
+     */
+    std::unique_ptr<char[], AlignedDeleter> arena{nullptr,
+                                                  AlignedDeleter{0}};
+
     //! storage container for fields
     std::map<std::string, Field_ptr> fields{};
     //! storage container for state fields
     std::map<std::string, StateField_ptr> state_fields{};
+    //! scratch pool of fields for `borrow_field`
+    std::vector<ScratchSlot> scratch_fields{};
 
     //! Maps registered before initialisation which will need their data_ptr set
     std::vector<std::weak_ptr<std::function<void()>>> init_callbacks{};
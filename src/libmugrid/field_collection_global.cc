@@ -82,12 +82,115 @@ namespace muGrid {
                      subdomain_locations, pixels_storage_order);
   }
 
+  /* ---------------------------------------------------------------------- */
+  GlobalFieldCollection::GlobalFieldCollection(
+      const DynCcoord_t & nb_domain_grid_pts,
+      const DynCcoord_t & nb_subdomain_grid_pts,
+      const DynCcoord_t & subdomain_locations,
+      const DynCcoord_t & nb_ghosts_left, const DynCcoord_t & nb_ghosts_right,
+      const Communicator & comm, const SubPtMap_t & nb_sub_pts,
+      StorageOrder storage_order)
+      : Parent{ValidityDomain::Global, nb_domain_grid_pts.get_dim(), nb_sub_pts,
+               storage_order} {
+    this->initialise(nb_domain_grid_pts, nb_subdomain_grid_pts,
+                     subdomain_locations, nb_ghosts_left, nb_ghosts_right,
+                     comm);
+  }
+
   /* ---------------------------------------------------------------------- */
   void
   GlobalFieldCollection::initialise(const DynCcoord_t & nb_domain_grid_pts,
                                     const DynCcoord_t & nb_subdomain_grid_pts,
                                     const DynCcoord_t & subdomain_locations,
                                     const DynCcoord_t & pixels_strides) {
+    if (this->initialised) {
+      throw FieldCollectionError("double initialisation");
+    }
+    const Index_t dim{nb_domain_grid_pts.get_dim()};
+    this->nb_subdomain_grid_pts = nb_subdomain_grid_pts.get_dim() == 0
+                                      ? nb_domain_grid_pts
+                                      : nb_subdomain_grid_pts;
+    this->subdomain_locations = subdomain_locations.get_dim() == 0
+                                    ? DynCcoord_t(dim)
+                                    : subdomain_locations;
+    this->nb_ghosts_left = DynCcoord_t(dim);
+    this->nb_ghosts_right = DynCcoord_t(dim);
+    this->initialise_pixels(nb_domain_grid_pts, this->nb_subdomain_grid_pts,
+                            this->subdomain_locations, pixels_strides);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void GlobalFieldCollection::initialise(
+      const DynCcoord_t & nb_domain_grid_pts,
+      const DynCcoord_t & nb_subdomain_grid_pts,
+      const DynCcoord_t & subdomain_locations,
+      const DynCcoord_t & nb_ghosts_left, const DynCcoord_t & nb_ghosts_right,
+      const Communicator & comm, StorageOrder pixels_storage_order) {
+    if (this->initialised) {
+      throw FieldCollectionError("double initialisation");
+    }
+    const Index_t dim{nb_domain_grid_pts.get_dim()};
+    auto && check_ghosts{[dim](const DynCcoord_t & ghosts,
+                               const std::string & side) {
+      if (ghosts.get_dim() == 0) {
+        return DynCcoord_t(dim);
+      }
+      if (ghosts.get_dim() != dim) {
+        std::stringstream s;
+        s << "The number of " << side << " ghost layers " << ghosts
+          << " must be given for each of the " << dim << " spatial directions.";
+        throw FieldCollectionError(s.str());
+      }
+      for (auto && n : ghosts) {
+        if (n < 0) {
+          std::stringstream s;
+          s << "Invalid number of " << side << " ghost layers " << ghosts
+            << ".";
+          throw FieldCollectionError(s.str());
+        }
+      }
+      return ghosts;
+    }};
+    this->nb_ghosts_left = check_ghosts(nb_ghosts_left, "left");
+    this->nb_ghosts_right = check_ghosts(nb_ghosts_right, "right");
+    this->nb_subdomain_grid_pts = nb_subdomain_grid_pts.get_dim() == 0
+                                      ? nb_domain_grid_pts
+                                      : nb_subdomain_grid_pts;
+    this->subdomain_locations = subdomain_locations.get_dim() == 0
+                                    ? DynCcoord_t(dim)
+                                    : subdomain_locations;
+    this->comm = comm;
+    this->nb_domain_grid_pts = nb_domain_grid_pts;
+
+    if (this->has_ghosts()) {
+      this->find_neighbour_ranks();
+    }
+
+    // the pixels of the collection cover the subdomain plus its ghost layers
+    auto && nb_subdomain_grid_pts_with_ghosts{this->nb_subdomain_grid_pts +
+                                              this->nb_ghosts_left +
+                                              this->nb_ghosts_right};
+    auto && subdomain_locations_with_ghosts{this->subdomain_locations -
+                                            this->nb_ghosts_left};
+    if (pixels_storage_order == StorageOrder::Automatic) {
+      pixels_storage_order = this->get_storage_order();
+    }
+    this->initialise_pixels(
+        nb_domain_grid_pts, nb_subdomain_grid_pts_with_ghosts,
+        subdomain_locations_with_ghosts,
+        pixels_storage_order == StorageOrder::ColMajor
+            ? CcoordOps::get_col_major_strides(
+                  nb_subdomain_grid_pts_with_ghosts)
+            : CcoordOps::get_row_major_strides(
+                  nb_subdomain_grid_pts_with_ghosts));
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void GlobalFieldCollection::initialise_pixels(
+      const DynCcoord_t & nb_domain_grid_pts,
+      const DynCcoord_t & nb_subdomain_grid_pts,
+      const DynCcoord_t & subdomain_locations,
+      const DynCcoord_t & pixels_strides) {
     // sanity check 1
     auto nb_domain_grid_pts_total{
         std::accumulate(nb_domain_grid_pts.begin(), nb_domain_grid_pts.end(),
@@ -163,12 +266,171 @@ namespace muGrid {
     return this->pixels;
   }
 
+  /* ---------------------------------------------------------------------- */
+  bool GlobalFieldCollection::has_ghosts() const {
+    for (auto && n : this->nb_ghosts_left) {
+      if (n != 0) {
+        return true;
+      }
+    }
+    for (auto && n : this->nb_ghosts_right) {
+      if (n != 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void GlobalFieldCollection::find_neighbour_ranks() {
+    const Index_t dim{this->nb_domain_grid_pts.get_dim()};
+    // every process needs to know all subdomains to find its neighbours
+    DynMatrix_t<Index_t> subdomain(2 * dim, 1);
+    for (Index_t d{0}; d < dim; ++d) {
+      subdomain(d, 0) = this->subdomain_locations[d];
+      subdomain(dim + d, 0) = this->nb_subdomain_grid_pts[d];
+    }
+    DynMatrix_t<Index_t> subdomains{
+        this->comm.gather(Eigen::Ref<DynMatrix_t<Index_t>>(subdomain))};
+    const Index_t nb_procs{subdomains.cols()};
+
+    // all processes must agree on whether the decomposition is valid,
+    // otherwise the ones that did not fail would hang in the ghost exchange
+    bool is_valid{true};
+    std::stringstream error{};
+    for (Index_t p{0}; p < nb_procs; ++p) {
+      for (Index_t d{0}; d < dim; ++d) {
+        const auto & n{subdomains(dim + d, p)};
+        if (n < this->nb_ghosts_left[d] or n < this->nb_ghosts_right[d] or
+            n == 0) {
+          if (is_valid) {
+            error << "The subdomain of rank " << p << " has " << n
+                  << " grid points in direction " << d
+                  << ", which is fewer than the number of ghost layers "
+                  << "(left: " << this->nb_ghosts_left
+                  << ", right: " << this->nb_ghosts_right << ").";
+          }
+          is_valid = false;
+        }
+      }
+    }
+
+    // relation of the subdomain of every process to the own subdomain along
+    // each direction: whether it is the same slab (0), the left (-1) or the
+    // right (+1) neighbour, accounting for periodicity. With one or two
+    // subdomains along a direction, several relations hold at once.
+    const Index_t me{this->comm.rank()};
+    auto && is_related{[&subdomains, &me, dim, this](
+                           Index_t p, Index_t d, Index_t relation) {
+      const auto & nb_grid_pts{this->nb_domain_grid_pts[d]};
+      switch (relation) {
+      case -1:
+        return (subdomains(d, p) + subdomains(dim + d, p)) % nb_grid_pts ==
+               subdomains(d, me);
+      case 0:
+        return subdomains(d, p) == subdomains(d, me) and
+               subdomains(dim + d, p) == subdomains(dim + d, me);
+      default:
+        return (subdomains(d, me) + subdomains(dim + d, me)) % nb_grid_pts ==
+               subdomains(d, p);
+      }
+    }};
+
+    // find the neighbour for every offset in {-1, 0, 1}^dim, including the
+    // edge and corner neighbours
+    this->neighbour_ranks.assign(ipow(3, dim), -1);
+    CcoordOps::DynamicPixels offsets{
+        CcoordOps::get_cube(dim, 3),
+        DynCcoord_t(std::vector<Index_t>(dim, -1))};
+    for (auto && offset : offsets) {
+      if (not is_valid) {
+        break;
+      }
+      auto & neighbour{
+          this->neighbour_ranks[this->get_neighbour_index(offset)]};
+      for (Index_t p{0}; p < nb_procs and neighbour < 0; ++p) {
+        bool is_neighbour{true};
+        for (Index_t d{0}; d < dim; ++d) {
+          is_neighbour = is_neighbour and is_related(p, d, offset[d]);
+        }
+        if (is_neighbour) {
+          neighbour = p;
+        }
+      }
+      if (neighbour < 0) {
+        error << "Could not find the neighbour at offset " << offset
+              << " of the subdomain at " << this->subdomain_locations
+              << " with " << this->nb_subdomain_grid_pts
+              << " grid points. Ghost layers require a Cartesian "
+              << "decomposition of the domain.";
+        is_valid = false;
+      }
+    }
+    this->left_neighbour_ranks.assign(dim, -1);
+    this->right_neighbour_ranks.assign(dim, -1);
+    for (Index_t d{0}; is_valid and d < dim; ++d) {
+      DynCcoord_t offset(dim);
+      offset[d] = -1;
+      this->left_neighbour_ranks[d] = this->get_neighbour_rank(offset);
+      offset[d] = 1;
+      this->right_neighbour_ranks[d] = this->get_neighbour_rank(offset);
+    }
+
+    if (not this->comm.logical_and(is_valid)) {
+      if (is_valid) {
+        error << "The domain decomposition is invalid on another rank.";
+      }
+      throw FieldCollectionError(error.str());
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  Index_t
+  GlobalFieldCollection::get_neighbour_index(const DynCcoord_t & offset) {
+    Index_t index{0};
+    Index_t stride{1};
+    for (auto && o : offset) {
+      index += (o + 1) * stride;
+      stride *= 3;
+    }
+    return index;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  int GlobalFieldCollection::get_neighbour_rank(
+      const DynCcoord_t & offset) const {
+    if (this->neighbour_ranks.empty()) {
+      throw FieldCollectionError(
+          "Neighbour ranks are only known for collections with ghost layers.");
+    }
+    if (offset.get_dim() != this->get_spatial_dim()) {
+      std::stringstream s;
+      s << "The offset " << offset << " must have " << this->get_spatial_dim()
+        << " entries.";
+      throw FieldCollectionError(s.str());
+    }
+    for (auto && o : offset) {
+      if (o < -1 or o > 1) {
+        std::stringstream s;
+        s << "Invalid neighbour offset " << offset
+          << ", all entries must be -1, 0 or 1.";
+        throw FieldCollectionError(s.str());
+      }
+    }
+    return this->neighbour_ranks[get_neighbour_index(offset)];
+  }
+
   /* ---------------------------------------------------------------------- */
   GlobalFieldCollection GlobalFieldCollection::get_empty_clone() const {
     GlobalFieldCollection ret_val{this->get_spatial_dim(), this->nb_sub_pts};
-    ret_val.initialise(this->nb_domain_grid_pts,
-                       this->pixels.get_nb_subdomain_grid_pts(),
-                       this->pixels.get_subdomain_locations());
+    if (this->has_ghosts()) {
+      ret_val.initialise(this->nb_domain_grid_pts, this->nb_subdomain_grid_pts,
+                         this->subdomain_locations, this->nb_ghosts_left,
+                         this->nb_ghosts_right, this->comm);
+    } else {
+      ret_val.initialise(this->nb_domain_grid_pts, this->nb_subdomain_grid_pts,
+                         this->subdomain_locations);
+    }
     return ret_val;
   }
 
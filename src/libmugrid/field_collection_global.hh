@@ -38,6 +38,7 @@
 
 #include "field_collection.hh"
 #include "ccoord_operations.hh"
+#include "communicator.hh"
 
 namespace muGrid {
 
@@ -134,6 +135,28 @@ namespace muGrid {
                           StorageOrder storage_order =
                               StorageOrder::ArrayOfStructures);
 
+    /**
+     * Constructor with initialisation of a subdomain padded by ghost layers
+     * @param nb_subdomain_grid_pts number of grid points on the current MPI
+     * process (subdomain), not counting the ghost layers
+     * @param subdomain_locations location of the current subdomain within the
+     * global grid
+     * @param nb_ghosts_left number of ghost layers on the left (low-index)
+     * side of the subdomain in each direction
+     * @param nb_ghosts_right number of ghost layers on the right (high-index)
+     * side of the subdomain in each direction
+     * @param comm communicator used to fill the ghost layers
+     */
+    GlobalFieldCollection(const DynCcoord_t & nb_domain_grid_pts,
+                          const DynCcoord_t & nb_subdomain_grid_pts,
+                          const DynCcoord_t & subdomain_locations,
+                          const DynCcoord_t & nb_ghosts_left,
+                          const DynCcoord_t & nb_ghosts_right,
+                          const Communicator & comm = Communicator{},
+                          const SubPtMap_t & nb_sub_pts = {},
+                          StorageOrder storage_order =
+                              StorageOrder::ArrayOfStructures);
+
     //! Copy constructor
     GlobalFieldCollection(const GlobalFieldCollection & other) = delete;
 
@@ -150,7 +173,11 @@ namespace muGrid {
     //! Move assignment operator
     GlobalFieldCollection & operator=(GlobalFieldCollection && other) = delete;
 
-    //! Return the pixels class that allows to iterator over pixels
+    /**
+     * Return the pixels class that allows to iterator over pixels. If the
+     * collection has ghost layers, these pixels include the ghosts (i.e., they
+     * describe the full memory buffer of the fields)
+     */
     const DynamicPixels & get_pixels() const;
 
     //! evaluate and return the linear index corresponding to dynamic `ccoord`
@@ -223,6 +250,23 @@ namespace muGrid {
                        pixels_storage_order);
     }
 
+    /**
+     * freeze the problem size and allocate memory for all fields of the
+     * collection, padding the subdomain with ghost layers. The ghost layers
+     * are filled from the neighbouring subdomains (or from the periodic image
+     * of the domain) by `Field::communicate_ghosts`. The subdomains of all
+     * processes must form a Cartesian decomposition of the domain and all
+     * processes need to specify the same number of ghost layers.
+     */
+    void initialise(const DynCcoord_t & nb_domain_grid_pts,
+                    const DynCcoord_t & nb_subdomain_grid_pts,
+                    const DynCcoord_t & subdomain_locations,
+                    const DynCcoord_t & nb_ghosts_left,
+                    const DynCcoord_t & nb_ghosts_right,
+                    const Communicator & comm = Communicator{},
+                    StorageOrder pixels_storage_order =
+                        StorageOrder::Automatic);
+
     /**
      * obtain a new field collection with the same domain and pixels
      */
@@ -240,19 +284,101 @@ namespace muGrid {
     }
 
     //! returns the process-local (subdomain) number of grid points in each
-    //! direction
+    //! direction, not counting the ghost layers
     const DynCcoord_t & get_nb_subdomain_grid_pts() const {
-      return this->get_pixels().get_nb_subdomain_grid_pts();
+      return this->nb_subdomain_grid_pts;
     }
 
     //! returns the process-local (subdomain) locations of subdomain grid
     const DynCcoord_t & get_subdomain_locations() const {
+      return this->subdomain_locations;
+    }
+
+    //! returns the process-local number of grid points in each direction,
+    //! including the ghost layers
+    const DynCcoord_t & get_nb_subdomain_grid_pts_with_ghosts() const {
+      return this->get_pixels().get_nb_subdomain_grid_pts();
+    }
+
+    //! returns the location of the first ghost pixel of the subdomain
+    const DynCcoord_t & get_subdomain_locations_with_ghosts() const {
       return this->get_pixels().get_subdomain_locations();
     }
 
+    //! returns the number of ghost layers on the left side of the subdomain
+    const DynCcoord_t & get_nb_ghosts_left() const {
+      return this->nb_ghosts_left;
+    }
+
+    //! returns the number of ghost layers on the right side of the subdomain
+    const DynCcoord_t & get_nb_ghosts_right() const {
+      return this->nb_ghosts_right;
+    }
+
+    //! whether the subdomain is padded with ghost layers
+    bool has_ghosts() const;
+
+    //! returns the communicator used for filling the ghost layers
+    const Communicator & get_communicator() const { return this->comm; }
+
+    /**
+     * returns the ranks of the processes holding the neighbouring subdomain on
+     * the left side (low index) of the subdomain in each direction. Only
+     * available for collections with ghost layers.
+     */
+    const std::vector<int> & get_left_neighbour_ranks() const {
+      return this->left_neighbour_ranks;
+    }
+
+    /**
+     * returns the ranks of the processes holding the neighbouring subdomain on
+     * the right side (high index) of the subdomain in each direction. Only
+     * available for collections with ghost layers.
+     */
+    const std::vector<int> & get_right_neighbour_ranks() const {
+      return this->right_neighbour_ranks;
+    }
+
+    /**
+     * returns the rank of the process holding the neighbouring subdomain at
+     * `offset`, where every entry of `offset` is -1 (left), 0 or 1 (right).
+     * This includes the edge and corner neighbours. Only available for
+     * collections with ghost layers.
+     */
+    int get_neighbour_rank(const DynCcoord_t & offset) const;
+
+    //! linear index of a neighbour offset in {-1, 0, 1}^dim
+    static Index_t get_neighbour_index(const DynCcoord_t & offset);
+
    protected:
+    /**
+     * set up the pixels and allocate the fields, the subdomain passed here
+     * includes the ghost layers
+     */
+    void initialise_pixels(const DynCcoord_t & nb_domain_grid_pts,
+                           const DynCcoord_t & nb_subdomain_grid_pts,
+                           const DynCcoord_t & subdomain_locations,
+                           const DynCcoord_t & pixels_strides);
+
+    //! determine the neighbouring subdomains in a Cartesian decomposition
+    void find_neighbour_ranks();
+
     DynamicPixels pixels{};  //!< helper to iterate over the grid
     DynCcoord_t nb_domain_grid_pts{};  // number of domain (global) grid points
+    //! number of subdomain grid points, without ghost layers
+    DynCcoord_t nb_subdomain_grid_pts{};
+    //! location of the subdomain, without ghost layers
+    DynCcoord_t subdomain_locations{};
+    DynCcoord_t nb_ghosts_left{};   //!< ghost layers on the low-index side
+    DynCcoord_t nb_ghosts_right{};  //!< ghost layers on the high-index side
+    //! communicator for the ghost exchange
+    Communicator comm{};
+    //! ranks of the neighbours for all offsets in {-1, 0, 1}^dim
+    std::vector<int> neighbour_ranks{};
+    //! ranks of the left neighbours in each direction
+    std::vector<int> left_neighbour_ranks{};
+    //! ranks of the right neighbours in each direction
+    std::vector<int> right_neighbour_ranks{};
   };
 
 }  // namespace muGrid
@@ -0,0 +1,485 @@
+/**
+ * @file   field_expression.hh
+ *
+ * @author Lars Pastewka <lars.pastewka@imtek.uni-freiburg.de>
+ *
+ * @date   16 Oct 2026
+ *
+ * @brief  lazy, fused evaluation of element-wise expressions of fields
+ *
+ * Copyright © 2026 Lars Pastewka
+ *
+ * µGrid is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * µGrid is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with µGrid; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * Additional permission under GNU GPL version 3 section 7
+ *
+ * If you modify this Program, or any covered work, by linking or combining it
+ * with proprietary FFT implementations or numerical libraries, containing parts
+ * covered by the terms of those libraries' licenses, the licensors of this
+ * Program grant you additional permission to convey the resulting work.
+ *
+ */
+
+#ifndef SRC_LIBMUGRID_FIELD_EXPRESSION_HH_
+#define SRC_LIBMUGRID_FIELD_EXPRESSION_HH_
+
+#include "grid_common.hh"
+#include "field_linalg.hh"
+#include "field_typed.hh"
+#include "units.hh"
+
+#include <sstream>
+#include <type_traits>
+#include <utility>
+
+namespace muGrid {
+
+  /**
+   * Base class of the lazy element-wise expressions of fields and scalars,
+   * as in `c = a + alpha * b - d`. Building an expression does not touch the
+   * data of the fields; it is evaluated when it is assigned to a field
+   * (`=`, `+=` or `-=`), in a single pass over memory on the threads of the
+   * `linalg` operations (see `linalg::set_nb_threads`). The memory layout of
+   * all fields and the physical units are checked once, at assignment.
+   *
+   * An expression only stores references to its fields and must be
+   * evaluated within the statement that creates it. The operands of `+` and
+   * `-` need to have the same unit, unless one of them is a scalar, which
+   * takes the unit of the other operand. Scalars are dimensionless factors in
+   * products and quotients.
+   */
+  template <class Derived>
+  class FieldExpression {
+   public:
+    //! the actual expression
+    const Derived & derived() const {
+      return static_cast<const Derived &>(*this);
+    }
+  };
+
+  namespace internal {
+
+    /* ---------------------------------------------------------------------- */
+    //! a field as operand of an expression
+    template <typename T>
+    class FieldOperand : public FieldExpression<FieldOperand<T>> {
+     public:
+      using Scalar = T;                  //!< value type of the expression
+      static constexpr bool IsScalar{false};  //!< whether this is a scalar
+
+      //! constructor
+      explicit FieldOperand(const TypedFieldBase<T> & field)
+          : operand{field}, data{field.data()} {}
+
+      //! check the memory layout against the assigned field
+      void check(const Field & target) const {
+        linalg::check_same_layout(target, this->operand, "field expression");
+      }
+
+      //! physical unit of the expression
+      const Unit & get_unit() const {
+        return this->operand.get_physical_unit();
+      }
+
+      //! value of the `index`-th entry of the buffer
+      const T & coeff(const Index_t & index) const {
+        return this->data[index];
+      }
+
+     protected:
+      const TypedFieldBase<T> & operand;  //!< the field
+      const T * data;                     //!< its data
+    };
+
+    /* ---------------------------------------------------------------------- */
+    //! a scalar as operand of an expression
+    template <typename T>
+    class ScalarOperand : public FieldExpression<ScalarOperand<T>> {
+     public:
+      using Scalar = T;                      //!< value type of the expression
+      static constexpr bool IsScalar{true};  //!< whether this is a scalar
+
+      //! constructor
+      explicit ScalarOperand(const T & value) : value{value} {}
+
+      //! nothing to check for scalars
+      void check(const Field & /*target*/) const {}
+
+      //! value of the `index`-th entry of the buffer
+      const T & coeff(const Index_t & /*index*/) const { return this->value; }
+
+     protected:
+      T value;  //!< the scalar
+    };
+
+    /* ---------------------------------------------------------------------- */
+    //! negative of an expression
+    template <class Operand>
+    class NegatedExpression
+        : public FieldExpression<NegatedExpression<Operand>> {
+     public:
+      using Scalar = typename Operand::Scalar;  //!< value type
+      static constexpr bool IsScalar{false};    //!< whether this is a scalar
+
+      //! constructor
+      explicit NegatedExpression(const Operand & operand) : operand{operand} {}
+
+      //! check the memory layout against the assigned field
+      void check(const Field & target) const { this->operand.check(target); }
+
+      //! physical unit of the expression
+      decltype(auto) get_unit() const { return this->operand.get_unit(); }
+
+      //! value of the `index`-th entry of the buffer
+      Scalar coeff(const Index_t & index) const {
+        return -this->operand.coeff(index);
+      }
+
+     protected:
+      Operand operand;  //!< the negated expression
+    };
+
+    /* ---------------------------------------------------------------------- */
+    //! element-wise sum
+    struct SumOp {
+      //! evaluate
+      template <typename T>
+      static T apply(const T & lhs, const T & rhs) {
+        return lhs + rhs;
+      }
+      //! unit of the result
+      static Unit get_unit(const Unit & lhs, const Unit & rhs) {
+        return lhs + rhs;
+      }
+    };
+
+    //! element-wise difference
+    struct DifferenceOp {
+      //! evaluate
+      template <typename T>
+      static T apply(const T & lhs, const T & rhs) {
+        return lhs - rhs;
+      }
+      //! unit of the result
+      static Unit get_unit(const Unit & lhs, const Unit & rhs) {
+        return lhs - rhs;
+      }
+    };
+
+    //! element-wise product
+    struct ProductOp {
+      //! evaluate
+      template <typename T>
+      static T apply(const T & lhs, const T & rhs) {
+        return lhs * rhs;
+      }
+      //! unit of the result
+      static Unit get_unit(const Unit & lhs, const Unit & rhs) {
+        return lhs * rhs;
+      }
+    };
+
+    //! element-wise quotient
+    struct QuotientOp {
+      //! evaluate
+      template <typename T>
+      static T apply(const T & lhs, const T & rhs) {
+        return lhs / rhs;
+      }
+      //! unit of the result
+      static Unit get_unit(const Unit & lhs, const Unit & rhs) {
+        return lhs / rhs;
+      }
+    };
+
+    /* ---------------------------------------------------------------------- */
+    //! element-wise binary operation `Op` on two expressions
+    template <class Op, class Lhs, class Rhs>
+    class BinaryExpression
+        : public FieldExpression<BinaryExpression<Op, Lhs, Rhs>> {
+      static_assert(std::is_same<typename Lhs::Scalar,
+                                 typename Rhs::Scalar>::value,
+                    "All fields of an expression need to have the same "
+                    "scalar type");
+
+     public:
+      using Scalar = typename Lhs::Scalar;     //!< value type
+      static constexpr bool IsScalar{false};  //!< whether this is a scalar
+
+      //! constructor
+      BinaryExpression(const Lhs & lhs, const Rhs & rhs)
+          : lhs{lhs}, rhs{rhs} {}
+
+      //! check the memory layout against the assigned field
+      void check(const Field & target) const {
+        this->lhs.check(target);
+        this->rhs.check(target);
+      }
+
+      //! physical unit of the expression
+      Unit get_unit() const {
+        if constexpr (Lhs::IsScalar) {
+          if constexpr (std::is_same<Op, QuotientOp>::value) {
+            // dimensionless over the unit of the divisor
+            return this->rhs.get_unit().reciprocal();
+          } else {
+            return this->rhs.get_unit();
+          }
+        } else if constexpr (Rhs::IsScalar) {
+          return this->lhs.get_unit();
+        } else {
+          return Op::get_unit(this->lhs.get_unit(), this->rhs.get_unit());
+        }
+      }
+
+      //! value of the `index`-th entry of the buffer
+      Scalar coeff(const Index_t & index) const {
+        return Op::apply(this->lhs.coeff(index), this->rhs.coeff(index));
+      }
+
+     protected:
+      Lhs lhs;  //!< left operand
+      Rhs rhs;  //!< right operand
+    };
+
+    /* ---------------------------------------------------------------------- */
+    //! whether `X` is a scalar that can appear in an expression
+    template <class X>
+    constexpr bool IsExpressionScalar{std::is_arithmetic<X>::value or
+                                      std::is_same<X, Complex>::value};
+
+    //! whether `X` is a field
+    template <class X>
+    constexpr bool IsExpressionField{std::is_base_of<Field, X>::value};
+
+    //! whether `X` is an expression
+    template <class X>
+    constexpr bool IsExpression{
+        std::is_base_of<FieldExpression<X>, X>::value};
+
+    //! whether `X` is the lazy negative of a field (`-field`)
+    template <class X, class = void>
+    struct IsNegativeField : std::false_type {};
+
+    //! whether `X` is the lazy negative of a field (`-field`)
+    template <class X>
+    struct IsNegativeField<
+        X, std::void_t<typename std::decay_t<
+               decltype(std::declval<X>().field)>::Scalar>>
+        : std::is_same<X, typename TypedFieldBase<typename std::decay_t<
+                              decltype(std::declval<X>().field)>::Scalar>::
+                              Negative> {};
+
+    //! whether `X` can be a non-scalar operand of an expression
+    template <class X>
+    constexpr bool IsNonScalarOperand{IsExpression<X> or
+                                      IsExpressionField<X> or
+                                      IsNegativeField<X>::value};
+
+    //! whether `L` and `R` can be combined into an expression
+    template <class L, class R>
+    constexpr bool AreOperands{
+        (IsNonScalarOperand<L> and IsNonScalarOperand<R>) or
+        (IsNonScalarOperand<L> and IsExpressionScalar<R>) or
+        (IsExpressionScalar<L> and IsNonScalarOperand<R>)};
+
+    /* ---------------------------------------------------------------------- */
+    //! convert an operand of scalar type `T` into an expression node
+    template <typename T, class X>
+    auto make_operand(const X & x) {
+      if constexpr (IsExpression<X>) {
+        return x;
+      } else if constexpr (IsExpressionField<X>) {
+        return FieldOperand<T>{x};
+      } else if constexpr (IsNegativeField<X>::value) {
+        return NegatedExpression<FieldOperand<T>>{FieldOperand<T>{x.field}};
+      } else {
+        return ScalarOperand<T>{static_cast<T>(x)};
+      }
+    }
+
+    //! scalar type of a non-scalar operand
+    template <class X, class = void>
+    struct OperandScalar {
+      using type = typename X::Scalar;  //!< scalar type
+    };
+
+    //! scalar type of a negated field
+    template <class X>
+    struct OperandScalar<X, std::enable_if_t<IsNegativeField<X>::value>> {
+      //! scalar type
+      using type =
+          typename std::decay_t<decltype(std::declval<X>().field)>::Scalar;
+    };
+
+    //! scalar type of a non-scalar operand
+    template <class X>
+    using OperandScalar_t = typename OperandScalar<X>::type;
+
+    //! build the expression `lhs Op rhs`
+    template <class Op, class L, class R>
+    auto make_binary(const L & lhs, const R & rhs) {
+      using T = OperandScalar_t<
+          std::conditional_t<IsExpressionScalar<L>, R, L>>;
+      auto && lhs_operand{make_operand<T>(lhs)};
+      auto && rhs_operand{make_operand<T>(rhs)};
+      return BinaryExpression<Op, std::decay_t<decltype(lhs_operand)>,
+                              std::decay_t<decltype(rhs_operand)>>{
+          lhs_operand, rhs_operand};
+    }
+
+    /* ---------------------------------------------------------------------- */
+    //! assignment of an expression
+    struct AssignUpdate {
+      //! update
+      template <typename T>
+      static void apply(T & target, const T & value) {
+        target = value;
+      }
+    };
+
+    //! increment by an expression
+    struct IncrementUpdate {
+      //! update
+      template <typename T>
+      static void apply(T & target, const T & value) {
+        target += value;
+      }
+    };
+
+    //! decrement by an expression
+    struct DecrementUpdate {
+      //! update
+      template <typename T>
+      static void apply(T & target, const T & value) {
+        target -= value;
+      }
+    };
+
+    /* ---------------------------------------------------------------------- */
+    //! check `expression` against `target` and evaluate `Update` in one pass
+    template <class Update, typename T, class Expression>
+    void evaluate(TypedFieldBase<T> & target, const Expression & expression) {
+      static_assert(std::is_same<typename Expression::Scalar, T>::value,
+                    "An expression can only be assigned to a field of the "
+                    "same scalar type");
+      const Index_t nb_values{
+          linalg::get_nb_buffer_values(target, "field expression")};
+      expression.check(target);
+      const Unit unit{expression.get_unit()};
+      if (unit != target.get_physical_unit()) {
+        std::stringstream error{};
+        error << "field expression: cannot assign an expression of " << unit
+              << " to field '" << target.get_name() << "' of "
+              << target.get_physical_unit();
+        throw UnitError(error.str());
+      }
+      T * data{target.data()};
+      linalg::parallel_for(
+          nb_values, sizeof(T),
+          [data, &expression](const Index_t & begin, const Index_t & end) {
+            for (Index_t index{begin}; index < end; ++index) {
+              Update::apply(data[index], expression.coeff(index));
+            }
+          });
+    }
+
+  }  // namespace internal
+
+  /* ---------------------------------------------------------------------- */
+  //! element-wise sum of fields, expressions and scalars
+  template <class L, class R,
+            std::enable_if_t<internal::AreOperands<L, R>, int> = 0>
+  auto operator+(const L & lhs, const R & rhs) {
+    return internal::make_binary<internal::SumOp>(lhs, rhs);
+  }
+
+  //! element-wise difference of fields, expressions and scalars
+  template <class L, class R,
+            std::enable_if_t<internal::AreOperands<L, R>, int> = 0>
+  auto operator-(const L & lhs, const R & rhs) {
+    return internal::make_binary<internal::DifferenceOp>(lhs, rhs);
+  }
+
+  //! element-wise product of fields, expressions and scalars
+  template <class L, class R,
+            std::enable_if_t<internal::AreOperands<L, R>, int> = 0>
+  auto operator*(const L & lhs, const R & rhs) {
+    return internal::make_binary<internal::ProductOp>(lhs, rhs);
+  }
+
+  //! element-wise quotient of fields, expressions and scalars
+  template <class L, class R,
+            std::enable_if_t<internal::AreOperands<L, R>, int> = 0>
+  auto operator/(const L & lhs, const R & rhs) {
+    return internal::make_binary<internal::QuotientOp>(lhs, rhs);
+  }
+
+  //! negative of an expression (the negative of a field is
+  //! `TypedFieldBase::Negative`)
+  template <class Derived>
+  auto operator-(const FieldExpression<Derived> & expression) {
+    return internal::NegatedExpression<Derived>{expression.derived()};
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  template <class Derived>
+  TypedFieldBase<T> &
+  TypedFieldBase<T>::operator=(const FieldExpression<Derived> & expression) {
+    internal::evaluate<internal::AssignUpdate>(*this, expression.derived());
+    return *this;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  template <class Derived>
+  TypedFieldBase<T> &
+  TypedFieldBase<T>::operator+=(const FieldExpression<Derived> & expression) {
+    internal::evaluate<internal::IncrementUpdate>(*this, expression.derived());
+    return *this;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  template <class Derived>
+  TypedFieldBase<T> &
+  TypedFieldBase<T>::operator-=(const FieldExpression<Derived> & expression) {
+    internal::evaluate<internal::DecrementUpdate>(*this, expression.derived());
+    return *this;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  template <class Derived>
+  TypedField<T> &
+  TypedField<T>::operator=(const FieldExpression<Derived> & expression) {
+    Parent::operator=(expression);
+    return *this;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  template <class Derived>
+  WrappedField<T> &
+  WrappedField<T>::operator=(const FieldExpression<Derived> & expression) {
+    Parent::operator=(expression);
+    return *this;
+  }
+
+}  // namespace muGrid
+
+#endif  // SRC_LIBMUGRID_FIELD_EXPRESSION_HH_
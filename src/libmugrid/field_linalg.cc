@@ -0,0 +1,713 @@
+/**
+ * @file   field_linalg.cc
+ *
+ * @author Lars Pastewka <lars.pastewka@imtek.uni-freiburg.de>
+ *
+ * @date   16 Oct 2026
+ *
+ * @brief  implementation of the BLAS-1 operations on fields
+ *
+ * Copyright © 2026 Lars Pastewka
+ *
+ * µGrid is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * µGrid is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with µGrid; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * Additional permission under GNU GPL version 3 section 7
+ *
+ * If you modify this Program, or any covered work, by linking or combining it
+ * with proprietary FFT implementations or numerical libraries, containing parts
+ * covered by the terms of those libraries' licenses, the licensors of this
+ * Program grant you additional permission to convey the resulting work.
+ *
+ */
+
+#include "field_linalg.hh"
+#include "aligned_allocator.hh"
+#include "field_collection_global.hh"
+#include "thread_pool.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <sstream>
+#include <string>
+
+namespace muGrid {
+  namespace linalg {
+    namespace internal {
+
+      //! buffers shorter than this (per thread) are not worth splitting
+      constexpr Index_t MinEntriesPerThread{1 << 14};
+
+      /* ------------------------------------------------------------------ */
+      //! the thread pool shared by all operations, nullptr if serial
+      std::unique_ptr<ThreadPool> & get_thread_pool() {
+        static std::unique_ptr<ThreadPool> thread_pool{};
+        return thread_pool;
+      }
+
+      /* ------------------------------------------------------------------ */
+      //! number of values of `a` after checking that `b` has the same layout
+      Index_t get_nb_values(const Field & a, const Field & b,
+                            const std::string & op) {
+        check_same_layout(a, b, op);
+        return get_nb_buffer_values(a, op);
+      }
+
+      /* ------------------------------------------------------------------ */
+      /**
+       * chunk of [0, nb_values) processed by `thread_id`. The chunk
+       * boundaries are multiples of a cache line (relative to the start of
+       * the buffer), and a given thread always gets the same chunk for a
+       * given `nb_values`.
+       */
+      std::tuple<Index_t, Index_t> get_chunk(const Index_t & nb_values,
+                                             const size_t & value_size,
+                                             const Index_t & nb_threads,
+                                             const Index_t & thread_id) {
+        const Index_t line_size{
+            std::max(Index_t{1}, Index_t(FieldAlignment / value_size))};
+        const Index_t nb_lines{(nb_values + line_size - 1) / line_size};
+        auto && chunk{
+            ThreadPool::get_chunk(0, nb_lines, nb_threads, thread_id)};
+        return std::make_tuple(
+            std::min(std::get<0>(chunk) * line_size, nb_values),
+            std::min(std::get<1>(chunk) * line_size, nb_values));
+      }
+
+      /* ------------------------------------------------------------------ */
+      //! call `kernel(begin, end)` on the static chunks of [0, nb_values)
+      template <typename T, class Kernel>
+      void for_each_chunk(const Index_t & nb_values, const Kernel & kernel) {
+        parallel_for(nb_values, sizeof(T), kernel);
+      }
+
+      //! contiguous ranges [begin, end) of values in a field buffer
+      using Ranges_t = std::vector<std::pair<Index_t, Index_t>>;
+
+      /* ------------------------------------------------------------------ */
+      /**
+       * the contiguous ranges of the buffer of `field` that hold the values
+       * of the subdomain pixels, i.e. without the pad region and without the
+       * ghost layers of a global collection
+       */
+      Ranges_t get_subdomain_ranges(const Field & field,
+                                    const std::string & op) {
+        const Index_t nb_values{get_nb_buffer_values(field, op)};
+        auto * global{dynamic_cast<const GlobalFieldCollection *>(
+            &field.get_collection())};
+        if (global == nullptr or not global->has_ghosts()) {
+          return Ranges_t{{0, nb_values}};
+        }
+
+        // runs of subdomain pixels that are consecutive in memory
+        const Shape_t nb_grid_pts{global->get_pixels_shape()};
+        const Shape_t strides{global->get_pixels_strides()};
+        const auto & nb_ghosts_left{global->get_nb_ghosts_left()};
+        const auto & nb_ghosts_right{global->get_nb_ghosts_right()};
+        const Index_t dim{static_cast<Index_t>(nb_grid_pts.size())};
+        Shape_t nb_runs(dim);
+        for (Index_t i{0}; i < dim; ++i) {
+          nb_runs[i] = nb_grid_pts[i] - nb_ghosts_left[i] - nb_ghosts_right[i];
+          if (nb_runs[i] <= 0) {
+            return Ranges_t{};
+          }
+        }
+        const Index_t fast{static_cast<Index_t>(
+            std::min_element(strides.begin(), strides.end()) -
+            strides.begin())};
+        const Index_t run_length{strides[fast] == 1 ? nb_runs[fast] : 1};
+        nb_runs[fast] /= run_length;
+
+        Ranges_t pixel_runs{};
+        Shape_t run(dim, 0);
+        while (run.back() < nb_runs.back()) {
+          Index_t begin{0};
+          for (Index_t i{0}; i < dim; ++i) {
+            begin += (nb_ghosts_left[i] + run[i]) * strides[i];
+          }
+          pixel_runs.emplace_back(begin, begin + run_length);
+          for (Index_t i{0}; i < dim; ++i) {
+            if (++run[i] < nb_runs[i] or i == dim - 1) {
+              break;
+            }
+            run[i] = 0;
+          }
+        }
+
+        // translate pixel runs into value ranges
+        const Index_t nb_dof{field.get_nb_dof_per_pixel()};
+        const Index_t nb_buffer_pixels{global->get_nb_buffer_pixels()};
+        Ranges_t ranges{};
+        if (field.get_storage_order() == StorageOrder::ArrayOfStructures) {
+          for (auto && pixels : pixel_runs) {
+            ranges.emplace_back(pixels.first * nb_dof,
+                                pixels.second * nb_dof);
+          }
+        } else {
+          for (Index_t dof{0}; dof < nb_dof; ++dof) {
+            for (auto && pixels : pixel_runs) {
+              ranges.emplace_back(dof * nb_buffer_pixels + pixels.first,
+                                  dof * nb_buffer_pixels + pixels.second);
+            }
+          }
+        }
+
+        // merge adjacent ranges
+        std::sort(ranges.begin(), ranges.end());
+        Ranges_t merged{};
+        for (auto && range : ranges) {
+          if (not merged.empty() and merged.back().second == range.first) {
+            merged.back().second = range.second;
+          } else {
+            merged.push_back(range);
+          }
+        }
+        return merged;
+      }
+
+      //! partial results of a reduction
+      template <typename T>
+      using Partial_t = Eigen::Array<T, Eigen::Dynamic, 1>;
+
+      /* ------------------------------------------------------------------ */
+      /**
+       * call `kernel(begin, end, partial)` on the values in `ranges`, split
+       * into static chunks as in `for_each_chunk`, and return the
+       * `nb_results` partial results of every thread (in the order of the
+       * threads).
+       */
+      template <typename T, typename Acc, class Kernel>
+      std::vector<Partial_t<Acc>> reduce_chunks(const Ranges_t & ranges,
+                                                const Index_t & nb_results,
+                                                const Kernel & kernel) {
+        Index_t nb_values{0};
+        for (auto && range : ranges) {
+          nb_values += range.second - range.first;
+        }
+        auto & thread_pool{get_thread_pool()};
+        const Index_t nb_threads{
+            (thread_pool == nullptr or
+             nb_values < thread_pool->get_nb_threads() * MinEntriesPerThread)
+                ? 1
+                : thread_pool->get_nb_threads()};
+        std::vector<Partial_t<Acc>> partials(
+            nb_threads, Partial_t<Acc>::Zero(nb_results));
+
+        // visit the part [begin, end) of the concatenation of the ranges
+        auto && visit{[&ranges, &kernel](const Index_t & begin,
+                                         const Index_t & end,
+                                         Partial_t<Acc> & partial) {
+          Index_t offset{0};
+          for (auto && range : ranges) {
+            const Index_t length{range.second - range.first};
+            const Index_t first{std::max(begin, offset)};
+            const Index_t last{std::min(end, offset + length)};
+            if (first < last) {
+              kernel(range.first + first - offset, range.first + last - offset,
+                     partial);
+            }
+            offset += length;
+            if (offset >= end) {
+              break;
+            }
+          }
+        }};
+
+        if (nb_threads == 1) {
+          visit(0, nb_values, partials.front());
+          return partials;
+        }
+        thread_pool->run([&](const Index_t & thread_id) {
+          auto && chunk{
+              get_chunk(nb_values, sizeof(T), nb_threads, thread_id)};
+          visit(std::get<0>(chunk), std::get<1>(chunk), partials[thread_id]);
+        });
+        return partials;
+      }
+
+      /* ------------------------------------------------------------------ */
+      //! sum of the partial results of all threads and processes
+      template <typename Acc>
+      Partial_t<Acc> sum_partials(const std::vector<Partial_t<Acc>> & partials,
+                                  const Communicator & comm) {
+        DynMatrix_t<Acc> local{partials.front().matrix()};
+        for (size_t i{1}; i < partials.size(); ++i) {
+          local += partials[i].matrix();
+        }
+        return comm.sum(local).array();
+      }
+
+      /* ------------------------------------------------------------------ */
+      /**
+       * communicator of the collection of `field`, serial for local
+       * collections. Throws a `FieldError` naming `operation` if the global
+       * collection is distributed (its subdomain is smaller than the domain)
+       * but stores no communicator, as a serial reduction would silently
+       * return the result of the calling process only.
+       */
+      Communicator get_communicator(const Field & field,
+                                    const std::string & operation) {
+        auto * global{dynamic_cast<const GlobalFieldCollection *>(
+            &field.get_collection())};
+        if (global == nullptr) {
+          return Communicator{};
+        }
+        auto && comm{global->get_communicator()};
+        if (comm.size() == 1 and global->is_initialised() and
+            not(global->get_nb_subdomain_grid_pts() ==
+                global->get_nb_domain_grid_pts())) {
+          std::stringstream error{};
+          error << operation << ": the collection of field '"
+                << field.get_name()
+                << "' is a subdomain of a larger domain but has no "
+                   "communicator; pass the communicator to reduce over "
+                   "explicitly";
+          throw FieldError(error.str());
+        }
+        return comm;
+      }
+
+      //! Eigen vector view on a chunk of a field buffer
+      template <typename T>
+      using Vector_cmap =
+          Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, 1>>;
+
+      /* ------------------------------------------------------------------ */
+      //! inner product of two chunks, accumulated in `Accumulator_t<T>`
+      template <typename T>
+      Accumulator_t<T> chunk_dot(const T * x, const T * y,
+                                 const Index_t & size) {
+        return Vector_cmap<T>(x, size)
+            .template cast<Accumulator_t<T>>()
+            .dot(Vector_cmap<T>(y, size).template cast<Accumulator_t<T>>());
+      }
+
+      //! Eigen array view on a chunk of a field buffer
+      template <typename T>
+      using Array_map = Eigen::Map<Eigen::Array<T, Eigen::Dynamic, 1>>;
+
+      //! constant Eigen array view on a chunk of a field buffer
+      template <typename T>
+      using Array_cmap =
+          Eigen::Map<const Eigen::Array<T, Eigen::Dynamic, 1>>;
+
+    }  // namespace internal
+
+    /* -------------------------------------------------------------------- */
+    void set_nb_threads(const Index_t & nb_threads) {
+      if (nb_threads < 1) {
+        std::stringstream error{};
+        error << "The number of threads must be positive, but " << nb_threads
+              << " were requested";
+        throw RuntimeError{error.str()};
+      }
+      if (nb_threads == get_nb_threads()) {
+        return;
+      }
+      internal::get_thread_pool() =
+          nb_threads == 1 ? nullptr : std::make_unique<ThreadPool>(nb_threads);
+    }
+
+    /* -------------------------------------------------------------------- */
+    Index_t get_nb_threads() {
+      auto & thread_pool{internal::get_thread_pool()};
+      return thread_pool == nullptr ? 1 : thread_pool->get_nb_threads();
+    }
+
+    /* -------------------------------------------------------------------- */
+    ThreadPool * get_thread_pool() {
+      return internal::get_thread_pool().get();
+    }
+
+    /* -------------------------------------------------------------------- */
+    Index_t get_nb_buffer_values(const Field & field,
+                                 const std::string & operation) {
+      if (not field.get_collection().is_initialised()) {
+        std::stringstream error{};
+        error << operation << ": the collection of field '"
+              << field.get_name() << "' has not been initialised";
+        throw FieldError(error.str());
+      }
+      if (field.get_nb_buffer_entries() == Unknown) {
+        std::stringstream error{};
+        error << operation << ": field '" << field.get_name()
+              << "' has an unknown number of entries";
+        throw FieldError(error.str());
+      }
+      return field.get_nb_buffer_entries() * field.get_nb_components();
+    }
+
+    /* -------------------------------------------------------------------- */
+    void check_same_layout(const Field & a, const Field & b,
+                           const std::string & operation) {
+      const Index_t nb_values{get_nb_buffer_values(a, operation)};
+      if (a.get_nb_components() != b.get_nb_components() or
+          not a.has_same_memory_layout(b) or
+          nb_values != get_nb_buffer_values(b, operation)) {
+        std::stringstream error{};
+        error << operation << ": fields '" << a.get_name() << "' ("
+              << a.get_nb_components() << " components, "
+              << a.get_nb_sub_pts() << " sub-points, "
+              << a.get_nb_buffer_entries() << " buffer entries) and '"
+              << b.get_name() << "' (" << b.get_nb_components()
+              << " components, " << b.get_nb_sub_pts() << " sub-points, "
+              << b.get_nb_buffer_entries()
+              << " buffer entries) do not have the same memory layout";
+        throw FieldError(error.str());
+      }
+    }
+
+    /* -------------------------------------------------------------------- */
+    void parallel_for(const Index_t & nb_values, const size_t & value_size,
+                      const ThreadPool::Range_t & body) {
+      auto & thread_pool{internal::get_thread_pool()};
+      if (thread_pool == nullptr or
+          nb_values <
+              thread_pool->get_nb_threads() * internal::MinEntriesPerThread) {
+        body(Index_t{0}, nb_values);
+        return;
+      }
+      const Index_t nb_threads{thread_pool->get_nb_threads()};
+      thread_pool->run([&](const Index_t & thread_id) {
+        auto && chunk{internal::get_chunk(nb_values, value_size, nb_threads,
+                                          thread_id)};
+        if (std::get<0>(chunk) < std::get<1>(chunk)) {
+          body(std::get<0>(chunk), std::get<1>(chunk));
+        }
+      });
+    }
+
+    /* -------------------------------------------------------------------- */
+    template <typename T>
+    void fill(const T & value, TypedFieldBase<T> & x) {
+      T * x_ptr{x.data()};
+      internal::for_each_chunk<T>(
+          get_nb_buffer_values(x, "fill"),
+          [&](const Index_t & begin, const Index_t & end) {
+            internal::Array_map<T>(x_ptr + begin, end - begin).setConstant(
+                value);
+          });
+    }
+
+    /* -------------------------------------------------------------------- */
+    template <typename T>
+    void copy(const TypedFieldBase<T> & x, TypedFieldBase<T> & y) {
+      const T * x_ptr{x.data()};
+      T * y_ptr{y.data()};
+      internal::for_each_chunk<T>(
+          internal::get_nb_values(x, y, "copy"),
+          [&](const Index_t & begin, const Index_t & end) {
+            std::copy(x_ptr + begin, x_ptr + end, y_ptr + begin);
+          });
+    }
+
+    /* -------------------------------------------------------------------- */
+    template <typename T>
+    void scale(const T & alpha, TypedFieldBase<T> & x) {
+      T * x_ptr{x.data()};
+      internal::for_each_chunk<T>(
+          get_nb_buffer_values(x, "scale"),
+          [&](const Index_t & begin, const Index_t & end) {
+            internal::Array_map<T>(x_ptr + begin, end - begin) *= alpha;
+          });
+    }
+
+    /* -------------------------------------------------------------------- */
+    template <typename T>
+    void axpy(const T & alpha, const TypedFieldBase<T> & x,
+              TypedFieldBase<T> & y) {
+      const T * x_ptr{x.data()};
+      T * y_ptr{y.data()};
+      internal::for_each_chunk<T>(
+          internal::get_nb_values(x, y, "axpy"),
+          [&](const Index_t & begin, const Index_t & end) {
+            const Index_t size{end - begin};
+            internal::Array_map<T>(y_ptr + begin, size) +=
+                alpha * internal::Array_cmap<T>(x_ptr + begin, size);
+          });
+    }
+
+    /* -------------------------------------------------------------------- */
+    template <typename T>
+    void axpby(const T & alpha, const TypedFieldBase<T> & x, const T & beta,
+               TypedFieldBase<T> & y) {
+      const T * x_ptr{x.data()};
+      T * y_ptr{y.data()};
+      internal::for_each_chunk<T>(
+          internal::get_nb_values(x, y, "axpby"),
+          [&](const Index_t & begin, const Index_t & end) {
+            const Index_t size{end - begin};
+            internal::Array_map<T> y_chunk(y_ptr + begin, size);
+            y_chunk = alpha * internal::Array_cmap<T>(x_ptr + begin, size) +
+                      beta * y_chunk;
+          });
+    }
+
+    /* -------------------------------------------------------------------- */
+    template <typename T>
+    void multiply(const TypedFieldBase<T> & x, const TypedFieldBase<T> & y,
+                  TypedFieldBase<T> & z) {
+      const T * x_ptr{x.data()};
+      const T * y_ptr{y.data()};
+      T * z_ptr{z.data()};
+      const Index_t nb_values{internal::get_nb_values(x, y, "multiply")};
+      check_same_layout(x, z, "multiply");
+      internal::for_each_chunk<T>(
+          nb_values, [&](const Index_t & begin, const Index_t & end) {
+            const Index_t size{end - begin};
+            internal::Array_map<T>(z_ptr + begin, size) =
+                internal::Array_cmap<T>(x_ptr + begin, size) *
+                internal::Array_cmap<T>(y_ptr + begin, size);
+          });
+    }
+
+    /* -------------------------------------------------------------------- */
+    template <typename T>
+    void divide(const TypedFieldBase<T> & x, const TypedFieldBase<T> & y,
+                TypedFieldBase<T> & z) {
+      const T * x_ptr{x.data()};
+      const T * y_ptr{y.data()};
+      T * z_ptr{z.data()};
+      const Index_t nb_values{internal::get_nb_values(x, y, "divide")};
+      check_same_layout(x, z, "divide");
+      internal::for_each_chunk<T>(
+          nb_values, [&](const Index_t & begin, const Index_t & end) {
+            const Index_t size{end - begin};
+            internal::Array_map<T>(z_ptr + begin, size) =
+                internal::Array_cmap<T>(x_ptr + begin, size) /
+                internal::Array_cmap<T>(y_ptr + begin, size);
+          });
+    }
+
+    /* -------------------------------------------------------------------- */
+    template <typename T>
+    Accumulator_t<T> dot(const TypedFieldBase<T> & x,
+                         const TypedFieldBase<T> & y,
+                         const Communicator & comm) {
+      using Acc = Accumulator_t<T>;
+      check_same_layout(x, y, "dot");
+      const T * x_ptr{x.data()};
+      const T * y_ptr{y.data()};
+      auto && partials{internal::reduce_chunks<T, Acc>(
+          internal::get_subdomain_ranges(x, "dot"), 1,
+          [&](const Index_t & begin, const Index_t & end,
+              internal::Partial_t<Acc> & partial) {
+            partial(0) +=
+                internal::chunk_dot(x_ptr + begin, y_ptr + begin, end - begin);
+          })};
+      return internal::sum_partials(partials, comm)(0);
+    }
+
+    /* -------------------------------------------------------------------- */
+    template <typename T>
+    Accumulator_t<T> dot(const TypedFieldBase<T> & x,
+                         const TypedFieldBase<T> & y) {
+      return dot(x, y, internal::get_communicator(x, "dot"));
+    }
+
+    /* -------------------------------------------------------------------- */
+    template <typename T>
+    Real norm2(const TypedFieldBase<T> & x, const Communicator & comm) {
+      const T * x_ptr{x.data()};
+      auto && partials{internal::reduce_chunks<T, Real>(
+          internal::get_subdomain_ranges(x, "norm2"), 1,
+          [&](const Index_t & begin, const Index_t & end,
+              internal::Partial_t<Real> & partial) {
+            partial(0) += internal::Vector_cmap<T>(x_ptr + begin, end - begin)
+                              .template cast<Accumulator_t<T>>()
+                              .squaredNorm();
+          })};
+      return std::sqrt(internal::sum_partials(partials, comm)(0));
+    }
+
+    /* -------------------------------------------------------------------- */
+    template <typename T>
+    Real norm2(const TypedFieldBase<T> & x) {
+      return norm2(x, internal::get_communicator(x, "norm2"));
+    }
+
+    /* -------------------------------------------------------------------- */
+    template <typename T>
+    typename Eigen::NumTraits<T>::Real max_abs(const TypedFieldBase<T> & x,
+                                               const Communicator & comm) {
+      using Abs_t = typename Eigen::NumTraits<T>::Real;
+      const T * x_ptr{x.data()};
+      auto && partials{internal::reduce_chunks<T, Abs_t>(
+          internal::get_subdomain_ranges(x, "max_abs"), 1,
+          [&](const Index_t & begin, const Index_t & end,
+              internal::Partial_t<Abs_t> & partial) {
+            partial(0) = std::max(
+                partial(0), internal::Vector_cmap<T>(x_ptr + begin, end - begin)
+                                .cwiseAbs()
+                                .maxCoeff());
+          })};
+      Abs_t local{0};
+      for (auto && partial : partials) {
+        local = std::max(local, partial(0));
+      }
+      return comm.max(local);
+    }
+
+    /* -------------------------------------------------------------------- */
+    template <typename T>
+    typename Eigen::NumTraits<T>::Real max_abs(const TypedFieldBase<T> & x) {
+      return max_abs(x, internal::get_communicator(x, "max_abs"));
+    }
+
+    /* -------------------------------------------------------------------- */
+    template <typename T>
+    std::vector<Accumulator_t<T>> dot_many(const FieldPairs_t<T> & pairs,
+                                           const Communicator & comm) {
+      using Acc = Accumulator_t<T>;
+      // values per block, small enough for the blocks of all fields to stay
+      // in the L1 cache while the inner products of all pairs are evaluated
+      constexpr Index_t BlockSize{1024};
+      if (pairs.empty()) {
+        return {};
+      }
+      const Field & reference{pairs.front().first.get()};
+      std::vector<std::pair<const T *, const T *>> pointers{};
+      for (auto && pair : pairs) {
+        check_same_layout(reference, pair.first.get(), "dot_many");
+        check_same_layout(reference, pair.second.get(), "dot_many");
+        pointers.emplace_back(pair.first.get().data(),
+                              pair.second.get().data());
+      }
+      const Index_t nb_pairs{static_cast<Index_t>(pairs.size())};
+      auto && partials{internal::reduce_chunks<T, Acc>(
+          internal::get_subdomain_ranges(reference, "dot_many"), nb_pairs,
+          [&](const Index_t & begin, const Index_t & end,
+              internal::Partial_t<Acc> & partial) {
+            for (Index_t block{begin}; block < end; block += BlockSize) {
+              const Index_t size{std::min(BlockSize, end - block)};
+              for (Index_t i{0}; i < nb_pairs; ++i) {
+                partial(i) += internal::chunk_dot(pointers[i].first + block,
+                                                  pointers[i].second + block,
+                                                  size);
+              }
+            }
+          })};
+      auto && result{internal::sum_partials(partials, comm)};
+      return std::vector<Acc>(result.data(), result.data() + result.size());
+    }
+
+    /* -------------------------------------------------------------------- */
+    template <typename T>
+    std::vector<Accumulator_t<T>> dot_many(const FieldPairs_t<T> & pairs) {
+      if (pairs.empty()) {
+        return {};
+      }
+      return dot_many(pairs, internal::get_communicator(
+                                    pairs.front().first, "dot_many"));
+    }
+
+    /* -------------------------------------------------------------------- */
+    template void fill(const Real &, TypedFieldBase<Real> &);
+    template void fill(const Complex &, TypedFieldBase<Complex> &);
+    template void fill(const Float &, TypedFieldBase<Float> &);
+    template void fill(const Int &, TypedFieldBase<Int> &);
+    template void fill(const Uint &, TypedFieldBase<Uint> &);
+
+    template void copy(const TypedFieldBase<Real> &, TypedFieldBase<Real> &);
+    template void copy(const TypedFieldBase<Complex> &,
+                       TypedFieldBase<Complex> &);
+    template void copy(const TypedFieldBase<Float> &,
+                       TypedFieldBase<Float> &);
+    template void copy(const TypedFieldBase<Int> &, TypedFieldBase<Int> &);
+    template void copy(const TypedFieldBase<Uint> &, TypedFieldBase<Uint> &);
+
+    template void scale(const Real &, TypedFieldBase<Real> &);
+    template void scale(const Complex &, TypedFieldBase<Complex> &);
+    template void scale(const Float &, TypedFieldBase<Float> &);
+
+    template void axpy(const Real &, const TypedFieldBase<Real> &,
+                       TypedFieldBase<Real> &);
+    template void axpy(const Complex &, const TypedFieldBase<Complex> &,
+                       TypedFieldBase<Complex> &);
+    template void axpy(const Float &, const TypedFieldBase<Float> &,
+                       TypedFieldBase<Float> &);
+
+    template void axpby(const Real &, const TypedFieldBase<Real> &,
+                        const Real &, TypedFieldBase<Real> &);
+    template void axpby(const Complex &, const TypedFieldBase<Complex> &,
+                        const Complex &, TypedFieldBase<Complex> &);
+    template void axpby(const Float &, const TypedFieldBase<Float> &,
+                        const Float &, TypedFieldBase<Float> &);
+
+    template void multiply(const TypedFieldBase<Real> &,
+                           const TypedFieldBase<Real> &,
+                           TypedFieldBase<Real> &);
+    template void multiply(const TypedFieldBase<Complex> &,
+                           const TypedFieldBase<Complex> &,
+                           TypedFieldBase<Complex> &);
+    template void multiply(const TypedFieldBase<Float> &,
+                           const TypedFieldBase<Float> &,
+                           TypedFieldBase<Float> &);
+
+    template void divide(const TypedFieldBase<Real> &,
+                         const TypedFieldBase<Real> &,
+                         TypedFieldBase<Real> &);
+    template void divide(const TypedFieldBase<Complex> &,
+                         const TypedFieldBase<Complex> &,
+                         TypedFieldBase<Complex> &);
+    template void divide(const TypedFieldBase<Float> &,
+                         const TypedFieldBase<Float> &,
+                         TypedFieldBase<Float> &);
+
+
+    template Real dot(const TypedFieldBase<Real> &,
+                      const TypedFieldBase<Real> &, const Communicator &);
+    template Complex dot(const TypedFieldBase<Complex> &,
+                         const TypedFieldBase<Complex> &,
+                         const Communicator &);
+    template Real dot(const TypedFieldBase<Float> &,
+                      const TypedFieldBase<Float> &, const Communicator &);
+    template Real dot(const TypedFieldBase<Real> &,
+                      const TypedFieldBase<Real> &);
+    template Complex dot(const TypedFieldBase<Complex> &,
+                         const TypedFieldBase<Complex> &);
+    template Real dot(const TypedFieldBase<Float> &,
+                      const TypedFieldBase<Float> &);
+
+    template Real norm2(const TypedFieldBase<Real> &, const Communicator &);
+    template Real norm2(const TypedFieldBase<Complex> &,
+                        const Communicator &);
+    template Real norm2(const TypedFieldBase<Float> &, const Communicator &);
+    template Real norm2(const TypedFieldBase<Real> &);
+    template Real norm2(const TypedFieldBase<Complex> &);
+    template Real norm2(const TypedFieldBase<Float> &);
+
+    template Real max_abs(const TypedFieldBase<Real> &, const Communicator &);
+    template Real max_abs(const TypedFieldBase<Complex> &,
+                          const Communicator &);
+    template Float max_abs(const TypedFieldBase<Float> &,
+                           const Communicator &);
+    template Real max_abs(const TypedFieldBase<Real> &);
+    template Real max_abs(const TypedFieldBase<Complex> &);
+    template Float max_abs(const TypedFieldBase<Float> &);
+
+    template std::vector<Real> dot_many(const FieldPairs_t<Real> &,
+                                        const Communicator &);
+    template std::vector<Complex> dot_many(const FieldPairs_t<Complex> &,
+                                           const Communicator &);
+    template std::vector<Real> dot_many(const FieldPairs_t<Float> &,
+                                        const Communicator &);
+    template std::vector<Real> dot_many(const FieldPairs_t<Real> &);
+    template std::vector<Complex> dot_many(const FieldPairs_t<Complex> &);
+    template std::vector<Real> dot_many(const FieldPairs_t<Float> &);
+
+  }  // namespace linalg
+}  // namespace muGrid
@@ -0,0 +1,215 @@
+/**
+ * @file   field_linalg.hh
+ *
+ * @author Lars Pastewka <lars.pastewka@imtek.uni-freiburg.de>
+ *
+ * @date   16 Oct 2026
+ *
+ * @brief  multithreaded, vectorised BLAS-1 operations on fields
+ *
+ * Copyright © 2026 Lars Pastewka
+ *
+ * µGrid is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * µGrid is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with µGrid; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * Additional permission under GNU GPL version 3 section 7
+ *
+ * If you modify this Program, or any covered work, by linking or combining it
+ * with proprietary FFT implementations or numerical libraries, containing parts
+ * covered by the terms of those libraries' licenses, the licensors of this
+ * Program grant you additional permission to convey the resulting work.
+ *
+ */
+
+#ifndef SRC_LIBMUGRID_FIELD_LINALG_HH_
+#define SRC_LIBMUGRID_FIELD_LINALG_HH_
+
+#include "grid_common.hh"
+#include "communicator.hh"
+#include "field_typed.hh"
+#include "thread_pool.hh"
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace muGrid {
+
+  /**
+   * Level-1 BLAS-type operations on whole fields. The element-wise
+   * operations act on the complete buffer of a field (including ghost
+   * layers, but excluding the pad region) and treat it as a flat vector,
+   * hence the fields involved in one operation need to have the same memory
+   * layout (same collection layout, number of sub-points and components).
+   *
+   * The buffer is split statically into one contiguous chunk per thread of a
+   * process-wide thread pool (see `set_nb_threads`). Chunk boundaries are
+   * rounded to cache lines, so threads never write to the same line, and
+   * every thread always processes the same part of a field of given size.
+   * Fields initialise their memory (in their own allocation or in the arena
+   * of their collection) and `set_zero` it with the same chunking, so every
+   * page is first touched by, and hence local to the NUMA node of, the
+   * thread that later updates it. This requires the number of threads to be
+   * set before the fields are allocated; the values of complex fields are
+   * constructed, and hence touched, by the allocating thread unless they
+   * live in an arena.
+   * Within a chunk, the operations are evaluated through Eigen array
+   * expressions, which use the SIMD instructions the library was compiled
+   * for. Buffers that are too short to benefit from threading are processed
+   * on the calling thread.
+   *
+   * The reductions (`dot`, `norm2`, `max_abs`, `dot_many`) only visit the
+   * pixels of the subdomain, i.e. neither the pad region nor the ghost
+   * layers, and reduce over a communicator. By default this is the
+   * communicator of the field's collection, which is only set for global
+   * collections with ghost layers (or initialised by a
+   * `CartesianDecomposition`). For a global collection whose subdomain is
+   * smaller than the domain but which has no communicator, these overloads
+   * throw a `FieldError`; pass the communicator explicitly in that case.
+   * Local collections are reduced on the calling process only.
+   * Single-precision fields are accumulated in double precision. The partial
+   * results of the threads are combined in a fixed order, hence results are
+   * reproducible for a fixed number of threads and processes.
+   *
+   * The thread pool is shared. Calls from several threads at a time are
+   * safe: while the pool is busy, further calls run serially on their own
+   * thread (with the same split, hence the same results). Only
+   * `set_nb_threads` must not be called while another thread uses the pool.
+   */
+  namespace linalg {
+
+    /**
+     * number of values in the buffer of `field` without the pad region.
+     * Throws a `FieldError` naming `operation` if the collection of the field
+     * is not initialised.
+     */
+    Index_t get_nb_buffer_values(const Field & field,
+                                 const std::string & operation);
+
+    //! throws a `FieldError` naming `operation` unless `a` and `b` have the
+    //! same memory layout
+    void check_same_layout(const Field & a, const Field & b,
+                           const std::string & operation);
+
+    /**
+     * call `body(begin, end)` on the static, cache-line aligned chunks of
+     * [0, nb_values) on the threads of the operations, for values of
+     * `value_size` bytes. This is the loop underlying all operations of this
+     * namespace and can be used to implement further element-wise kernels.
+     */
+    void parallel_for(const Index_t & nb_values, const size_t & value_size,
+                      const ThreadPool::Range_t & body);
+
+    //! set the number of threads used by the operations (default 1)
+    void set_nb_threads(const Index_t & nb_threads);
+
+    //! number of threads used by the operations
+    Index_t get_nb_threads();
+
+    //! thread pool used by the operations, `nullptr` if they run serially
+    ThreadPool * get_thread_pool();
+
+    //! x ← value
+    template <typename T>
+    void fill(const T & value, TypedFieldBase<T> & x);
+
+    //! y ← x
+    template <typename T>
+    void copy(const TypedFieldBase<T> & x, TypedFieldBase<T> & y);
+
+    //! x ← αx
+    template <typename T>
+    void scale(const T & alpha, TypedFieldBase<T> & x);
+
+    //! y ← αx + y
+    template <typename T>
+    void axpy(const T & alpha, const TypedFieldBase<T> & x,
+              TypedFieldBase<T> & y);
+
+    //! y ← αx + βy
+    template <typename T>
+    void axpby(const T & alpha, const TypedFieldBase<T> & x, const T & beta,
+               TypedFieldBase<T> & y);
+
+    //! z ← x ∘ y (element-wise product)
+    template <typename T>
+    void multiply(const TypedFieldBase<T> & x, const TypedFieldBase<T> & y,
+                  TypedFieldBase<T> & z);
+
+    //! z ← x ⊘ y (element-wise quotient)
+    template <typename T>
+    void divide(const TypedFieldBase<T> & x, const TypedFieldBase<T> & y,
+                TypedFieldBase<T> & z);
+
+    //! scalar type of the result of a reduction over fields of type `T`
+    template <typename T>
+    using Accumulator_t = GradientAccumulator_t<T>;
+
+    //! pairs of fields whose inner products `dot_many` evaluates
+    template <typename T>
+    using FieldPairs_t =
+        std::vector<std::pair<std::reference_wrapper<const TypedFieldBase<T>>,
+                              std::reference_wrapper<const TypedFieldBase<T>>>>;
+
+    //! inner product xᴴy, reduced over `comm`
+    template <typename T>
+    Accumulator_t<T> dot(const TypedFieldBase<T> & x,
+                         const TypedFieldBase<T> & y,
+                         const Communicator & comm);
+
+    //! inner product xᴴy, reduced over the communicator of the collection
+    template <typename T>
+    Accumulator_t<T> dot(const TypedFieldBase<T> & x,
+                         const TypedFieldBase<T> & y);
+
+    //! Euclidean norm ‖x‖₂, reduced over `comm`
+    template <typename T>
+    Real norm2(const TypedFieldBase<T> & x, const Communicator & comm);
+
+    //! Euclidean norm ‖x‖₂, reduced over the communicator of the collection
+    template <typename T>
+    Real norm2(const TypedFieldBase<T> & x);
+
+    //! largest absolute value ‖x‖∞, reduced over `comm`
+    template <typename T>
+    typename Eigen::NumTraits<T>::Real max_abs(const TypedFieldBase<T> & x,
+                                               const Communicator & comm);
+
+    //! largest absolute value ‖x‖∞, reduced over the communicator of the
+    //! collection
+    template <typename T>
+    typename Eigen::NumTraits<T>::Real max_abs(const TypedFieldBase<T> & x);
+
+    /**
+     * inner products of several pairs of fields, evaluated in a single sweep
+     * over the memory (a field that appears in several pairs is read once
+     * from main memory) and reduced with a single collective operation over
+     * `comm`. All fields need to have the same memory layout.
+     */
+    template <typename T>
+    std::vector<Accumulator_t<T>> dot_many(const FieldPairs_t<T> & pairs,
+                                           const Communicator & comm);
+
+    //! inner products of several pairs of fields, reduced over the
+    //! communicator of the collection of the first field
+    template <typename T>
+    std::vector<Accumulator_t<T>> dot_many(const FieldPairs_t<T> & pairs);
+
+  }  // namespace linalg
+
+}  // namespace muGrid
+
+#endif  // SRC_LIBMUGRID_FIELD_LINALG_HH_
@@ -49,14 +49,9 @@ namespace muGrid {
       : field{field}, iteration{iter_type}, stride{this->field.get_stride(
                                                 iter_type)},
         nb_rows{this->field.get_default_nb_rows(iter_type)},
-        nb_cols{this->field.get_default_nb_cols(iter_type)} {
-    if (field.get_storage_order() != StorageOrder::ColMajor) {
-      std::stringstream s;
-      s << "FieldMap requires column-major storage order, but storage order of "
-        << "field '" << field.get_name() << "' is "
-        << field.get_storage_order();
-      throw RuntimeError(s.str());
-    }
+        nb_cols{this->field.get_default_nb_cols(iter_type)},
+        strided_iterates{false} {
+    this->check_storage_order();
     auto & collection{this->field.get_collection()};
     if (collection.is_initialised()) {
       this->set_data_ptr();
@@ -71,15 +66,25 @@ namespace muGrid {
   template <typename T, Mapping Mutability>
   FieldMap<T, Mutability>::FieldMap(Field_t & field, Index_t nb_rows_,
                                     const IterUnit & iter_type)
+      : FieldMap{field, nb_rows_, iter_type, false} {}
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T, Mapping Mutability>
+  FieldMap<T, Mutability>::FieldMap(Field_t & field, Index_t nb_rows_,
+                                    const IterUnit & iter_type,
+                                    const bool & strided_iterates)
       : field{field}, iteration{iter_type}, stride{this->field.get_stride(
                                                 iter_type)},
-        nb_rows{nb_rows_}, nb_cols{this->stride / nb_rows_} {
-    if (field.get_storage_order() != StorageOrder::ColMajor) {
-      std::stringstream s;
-      s << "FieldMap requires column-major storage order, but storage order of "
-        << "field '" << field.get_name() << "' is "
-        << field.get_storage_order();
-      throw RuntimeError(s.str());
+        nb_rows{nb_rows_}, nb_cols{this->stride / nb_rows_},
+        strided_iterates{strided_iterates} {
+    this->check_storage_order();
+    if (this->nb_rows * this->nb_cols != this->stride) {
+      std::stringstream error{};
+      error << "You chose an iterate with " << this->nb_rows
+            << " rows, but it is not a divisor of the number of scalars stored "
+               "in this field per iteration ("
+            << this->stride << ")";
+      throw FieldMapError(error.str());
     }
     auto & collection{this->field.get_collection()};
     if (collection.is_initialised()) {
@@ -89,14 +94,6 @@ namespace muGrid {
           [this]() { this->set_data_ptr(); });
       collection.preregister_map(this->callback);
     }
-    if (this->nb_rows * this->nb_cols != this->stride) {
-      std::stringstream error{};
-      error << "You chose an iterate with " << this->nb_rows
-            << " rows, but it is not a divisor of the number of scalars stored "
-               "in this field per iteration ("
-            << this->stride << ")";
-      throw FieldMapError(error.str());
-    }
   }
 
   /* ---------------------------------------------------------------------- */
@@ -104,14 +101,13 @@ namespace muGrid {
   FieldMap<T, Mutability>::FieldMap(FieldMap && other)
       : field{other.field}, iteration{other.iteration}, stride{other.stride},
         nb_rows{other.nb_rows}, nb_cols{other.nb_cols},
-        data_ptr{other.data_ptr}, is_initialised{other.is_initialised} {
-    if (field.get_storage_order() != StorageOrder::ColMajor) {
-      std::stringstream s;
-      s << "FieldMap requires column-major storage order, but storage order of "
-        << "field '" << field.get_name() << "' is "
-        << field.get_storage_order();
-      throw RuntimeError(s.str());
-    }
+        strided_iterates{other.strided_iterates}, data_ptr{other.data_ptr},
+        contiguous{other.contiguous},
+        nb_iterates_per_pixel{other.nb_iterates_per_pixel},
+        sub_pt_step{other.sub_pt_step}, pixel_step{other.pixel_step},
+        outer_stride{other.outer_stride}, inner_stride{other.inner_stride},
+        is_initialised{other.is_initialised} {
+    this->check_storage_order();
     auto & collection{this->field.get_collection()};
     if (not collection.is_initialised()) {
       this->callback = std::make_shared<std::function<void()>>(
@@ -120,6 +116,24 @@ namespace muGrid {
     }
   }
 
+  /* ---------------------------------------------------------------------- */
+  template <typename T, Mapping Mutability>
+  void FieldMap<T, Mutability>::check_storage_order() const {
+    const auto storage_order{this->field.get_storage_order()};
+    if (storage_order == StorageOrder::ColMajor or
+        (this->strided_iterates and storage_order == StorageOrder::RowMajor)) {
+      return;
+    }
+    std::stringstream s;
+    s << "FieldMap requires column-major storage order, but storage order of "
+      << "field '" << this->field.get_name() << "' is " << storage_order;
+    if (storage_order == StorageOrder::RowMajor) {
+      s << ". Use a map with strided iterates (e.g., "
+        << "`StridedMatrixFieldMap`) or convert the storage order of the field";
+    }
+    throw RuntimeError(s.str());
+  }
+
   /* ---------------------------------------------------------------------- */
   template <typename T, Mapping Mutability>
   auto FieldMap<T, Mutability>::begin() -> iterator {
@@ -194,9 +208,69 @@ namespace muGrid {
                           "has been initialised");
     }
     this->data_ptr = this->field.data();
+    this->set_strides();
     this->is_initialised = true;
   }
 
+  /* ---------------------------------------------------------------------- */
+  template <typename T, Mapping Mutability>
+  void FieldMap<T, Mutability>::set_strides() {
+    const Index_t nb_sub_pts{this->field.get_nb_sub_pts()};
+    this->nb_iterates_per_pixel =
+        this->iteration == IterUnit::SubPt ? nb_sub_pts : 1;
+    this->contiguous =
+        this->field.get_storage_order() == StorageOrder::ColMajor;
+    if (this->contiguous) {
+      this->outer_stride = this->nb_rows;
+      this->inner_stride = 1;
+      return;
+    }
+    // structure of arrays: each component of each sub-point is a contiguous
+    // array over the buffer pixels and the components are in row-major order
+    const Index_t nb_buffer_pixels{
+        this->field.get_collection().get_nb_buffer_pixels()};
+    this->sub_pt_step = nb_buffer_pixels;
+    this->pixel_step = 1;
+
+    const Shape_t components_shape{this->field.get_components_shape()};
+    Shape_t components_strides(components_shape.size());
+    Index_t accumulator{nb_sub_pts * nb_buffer_pixels};
+    for (Index_t dim{static_cast<Index_t>(components_shape.size()) - 1};
+         dim >= 0; --dim) {
+      components_strides[dim] = accumulator;
+      accumulator *= components_shape[dim];
+    }
+    // offset of the flat (column-major) index within an iterate
+    auto && offset{[&](Index_t index) {
+      Index_t offset{0};
+      for (size_t dim{0}; dim < components_shape.size(); ++dim) {
+        offset += (index % components_shape[dim]) * components_strides[dim];
+        index /= components_shape[dim];
+      }
+      // remaining index is the sub-point for pixel iterates
+      return offset + index * nb_buffer_pixels;
+    }};
+
+    this->inner_stride = this->nb_rows > 1 ? offset(1) : 1;
+    this->outer_stride = this->nb_cols > 1 ? offset(this->nb_rows)
+                                           : this->nb_rows * this->inner_stride;
+    for (Index_t col{0}; col < this->nb_cols; ++col) {
+      for (Index_t row{0}; row < this->nb_rows; ++row) {
+        if (offset(row + col * this->nb_rows) !=
+            row * this->inner_stride + col * this->outer_stride) {
+          std::stringstream error{};
+          error << "The field '" << this->field.get_name()
+                << "' is stored as a structure of arrays with components of "
+                   "shape "
+                << components_shape << ", which cannot be mapped to strided "
+                << "iterates of shape (" << this->nb_rows << " × "
+                << this->nb_cols << ")";
+          throw FieldMapError(error.str());
+        }
+      }
+    }
+  }
+
   /* ---------------------------------------------------------------------- */
   template <typename T, Mapping Mutability>
   auto FieldMap<T, Mutability>::enumerate_pixel_indices_fast()
@@ -255,6 +329,8 @@ namespace muGrid {
   template class FieldMap<Real, Mapping::Mut>;
   template class FieldMap<Complex, Mapping::Const>;
   template class FieldMap<Complex, Mapping::Mut>;
+  template class FieldMap<Float, Mapping::Const>;
+  template class FieldMap<Float, Mapping::Mut>;
   template class FieldMap<Int, Mapping::Const>;
   template class FieldMap<Int, Mapping::Mut>;
   template class FieldMap<Uint, Mapping::Const>;
@@ -61,11 +61,23 @@ namespace muGrid {
   template <typename T>
   class TypedFieldBase;
 
+  /**
+   * (outer, inner) strides of the iterates of field maps. The values of an
+   * iterate are contiguous in fields stored as an array of structures
+   * (`StorageOrder::ColMajor`) and strided by the number of buffer pixels in
+   * fields stored as a structure of arrays (`StorageOrder::RowMajor`).
+   */
+  using IterateStride_t = Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>;
+
   /**
    * Dynamically sized field map. Field maps allow iterating over the pixels or
    * quadrature points of a field and to select the shape (in a matrix sense) of
    * the iterate. For example, it allows to iterate in 2×2 matrices over the
-   * quadrature points of a strain field for a two-dimensional problem.
+   * quadrature points of a strain field for a two-dimensional problem. The
+   * iterates of dynamically sized maps are contiguous in memory, hence they
+   * require fields stored as an array of structures (`StorageOrder::ColMajor`,
+   * see `muGrid::StridedMatrixFieldMap` for fields stored as a structure of
+   * arrays).
    */
   template <typename T, Mapping Mutability>
   class FieldMap {
@@ -308,6 +320,28 @@ namespace muGrid {
                                       this->nb_rows, this->nb_cols};
     }
 
+    /**
+     * return the offset of the first value of the iterate `index` from the
+     * start of the field's data (the iterates of fields in structure-of-arrays
+     * storage order are not equidistant if there are several sub-points per
+     * pixel)
+     */
+    Index_t get_offset(size_t index) const {
+      if (this->contiguous) {
+        return index * this->stride;
+      }
+      return (index % this->nb_iterates_per_pixel) * this->sub_pt_step +
+             (index / this->nb_iterates_per_pixel) * this->pixel_step;
+    }
+
+    //! return the (outer, inner) strides of the values within an iterate
+    IterateStride_t get_iterate_strides() const {
+      return IterateStride_t{this->outer_stride, this->inner_stride};
+    }
+
+    //! whether the iterates are contiguous and equidistant in memory
+    bool is_contiguous() const { return this->contiguous; }
+
     //! query the size from the field's collection and set data_ptr
     void set_data_ptr();
 
@@ -338,12 +372,25 @@ namespace muGrid {
     const Field_t & get_field() const;
 
    protected:
+    /**
+     * Constructor for maps whose iterates may be strided in memory (used by
+     * `muGrid::StaticFieldMap`), which can map fields stored as a structure
+     * of arrays
+     */
+    FieldMap(Field_t & field, Index_t nb_rows, const IterUnit & iter_type,
+             const bool & strided_iterates);
+
+    //! throw if the iterates of this map cannot represent the field's layout
+    void check_storage_order() const;
+
     //! mapped field. Needed for query at initialisations
     const Field_t & field;
     const IterUnit iteration;  //!< type of map iteration
     const Index_t stride;      //!< precomputed stride
     const Index_t nb_rows;     //!< number of rows of the iterate
     const Index_t nb_cols;     //!< number of columns fo the iterate
+    //! whether the iterates may be strided (i.e., not contiguous) in memory
+    const bool strided_iterates;
 
     /**
      * Pointer to mapped data; is also unknown at construction and set in the
@@ -351,6 +398,22 @@ namespace muGrid {
      */
     T * data_ptr{nullptr};
 
+    //! whether the iterates are contiguous and equidistant in memory
+    bool contiguous{true};
+    //! number of consecutive iterates per pixel
+    Index_t nb_iterates_per_pixel{1};
+    //! distance between the iterates of consecutive sub-points of a pixel
+    Index_t sub_pt_step{};
+    //! distance between the iterates of consecutive pixels
+    Index_t pixel_step{};
+    //! distance between the columns of an iterate
+    Index_t outer_stride{};
+    //! distance between the rows of an iterate
+    Index_t inner_stride{1};
+
+    //! set up the strides of the iterates from the field's storage order
+    void set_strides();
+
     //! keeps track of whether the map has been initialised.
     bool is_initialised{false};
     //! shared_ptr used for latent initialisation
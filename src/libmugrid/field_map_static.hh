@@ -41,7 +41,9 @@
 #include "field_typed.hh"
 #include "field_map.hh"
 #include "T4_map_proxy.hh"
+#include "tensor_batch.hh"
 
+#include <algorithm>
 #include <sstream>
 
 namespace muGrid {
@@ -49,7 +51,9 @@ namespace muGrid {
   /**
    * Statically sized field map. Static field maps reproduce the capabilities of
    * the (dynamically sized) `muGrid::FieldMap`, but iterate much more
-   * efficiently.
+   * efficiently. Fields stored as a structure of arrays can only be mapped
+   * by map types that support strided iterates (scalar maps and the
+   * `Strided...FieldMap` aliases).
    */
   template <typename T, Mapping Mutability, class MapType,
             IterUnit IterationType = IterUnit::SubPt>
@@ -86,6 +90,12 @@ namespace muGrid {
     constexpr static size_t Stride() { return MapType::stride(); }
     //! determine whether this map has statically sized iterates at compile time
     constexpr static bool IsStatic() { return true; }
+    //! determine the number of rows of the iterate at compile time
+    constexpr static Dim_t NbRow() { return MapType::NbRow(); }
+    //! determine the number of columns of the iterate at compile time
+    constexpr static Dim_t NbCol() {
+      return MapType::stride() / MapType::NbRow();
+    }
 
     /**
      * iterable proxy type to iterate over the quad point/pixel indices and
@@ -108,7 +118,8 @@ namespace muGrid {
 
     //! Constructor from typed field ref.
     explicit StaticFieldMap(Field_t & field)
-        : Parent{field, MapType::NbRow(), IterationType} {
+        : Parent{field, MapType::NbRow(), IterationType,
+                 MapType::SupportsStrides()} {
       if (this->stride != MapType::stride()) {
         std::stringstream error{};
         error << "Incompatible number of components in the field '"
@@ -118,6 +129,21 @@ namespace muGrid {
               << MapType::stride() << ".";
         throw FieldMapError(error.str());
       }
+      // aligned iterates require aligned data and a stride that is a
+      // multiple of the alignment
+      constexpr size_t Alignment{MapType::Alignment()};
+      if (Alignment > 0 and
+          (this->field.get_alignment() < Alignment or
+           (MapType::stride() * sizeof(T)) % Alignment != 0)) {
+        std::stringstream error{};
+        error << "Misaligned field '" << this->field.get_name()
+              << "': The field map has iterates aligned to " << Alignment
+              << " bytes, but the data of the field is aligned to "
+              << this->field.get_alignment() << " bytes and the iterates of "
+              << "shape " << MapType::shape() << " are "
+              << MapType::stride() * sizeof(T) << " bytes apart.";
+        throw FieldMapError(error.str());
+      }
     }
 
     //! Copy constructor
@@ -239,7 +265,8 @@ namespace muGrid {
       assert(this->is_initialised);
       assert(index <= static_cast<size_t>(this->field.get_nb_entries()));
       return MapType::template from_data_ptr<Mutability>(
-          this->data_ptr + index * MapType::stride());
+          this->data_ptr + this->get_offset(index),
+          this->get_iterate_strides());
     }
 
     //! random const access operator
@@ -247,12 +274,54 @@ namespace muGrid {
       assert(this->is_initialised);
       assert(index <= static_cast<size_t>(this->field.get_nb_entries()));
       return MapType::template from_data_ptr<Mapping::Const>(
-          this->data_ptr + index * MapType::stride());
+          this->data_ptr + this->get_offset(index),
+          this->get_iterate_strides());
+    }
+
+    /**
+     * return the offset of the first value of the iterate `index` from the
+     * start of the field's data. Maps with contiguous iterates know the
+     * distance between iterates at compile time.
+     */
+    Index_t get_offset(size_t index) const {
+      if (MapType::SupportsStrides()) {
+        return Parent::get_offset(index);
+      }
+      return index * MapType::stride();
     }
 
     //! evaluate the average of the field
     inline PlainType mean() const;
 
+    template <Dim_t Width>
+    class Batch;
+
+    template <Dim_t Width>
+    class BatchIterable;
+
+    /**
+     * iterate over the map in batches of `Width` iterates (see `Batch`),
+     * which allows evaluating pointwise kernels on `Width` points per SIMD
+     * instruction. The batches cover every iterate exactly once. If there
+     * are several sub-points per iterated pixel, a batch holds the same
+     * sub-point of `Width` consecutive pixels, and the batches of the first
+     * sub-point come before those of the second one, etc. The last batch of
+     * every sub-point may be incomplete. Batches of maps over the same
+     * collection and sub-division are in the same order, so they can be
+     * zipped.
+     */
+    template <Dim_t Width = simd_width<T>()>
+    BatchIterable<Width> batches() {
+      if (not this->is_initialised) {
+        std::stringstream error{};
+        error << "This map on field " << this->field.get_name()
+              << " cannot yet be iterated over, as the collection is not "
+                 "initialised";
+        throw FieldMapError(error.str());
+      }
+      return BatchIterable<Width>{*this};
+    }
+
     //! stl
     iterator begin() { return iterator{*this, false}; }
 
@@ -312,7 +381,9 @@ namespace muGrid {
 
     //! Constructor to beginning, or to end
     Iterator(const StaticFieldMap & map, bool end)
-        : map{map}, index{end ? map.size() : 0}, iterate{map.data_ptr} {}
+        : map{map}, index{end ? map.size() : 0},
+          iterate{MapType::template storage_from_data_ptr<MutIter>(
+              map.data_ptr, map.get_iterate_strides())} {}
 
     //! Copy constructor
     Iterator(const Iterator & other) = default;
@@ -333,7 +404,9 @@ namespace muGrid {
     Iterator & operator++() {
       this->index++;
       new (&this->iterate)
-          storage_type(this->map.data_ptr + this->index * Stride());
+          storage_type(MapType::template storage_from_data_ptr<MutIter>(
+              this->map.data_ptr + this->map.get_offset(this->index),
+              this->map.get_iterate_strides()));
       return *this;
     }
     //! dereference
@@ -362,13 +435,209 @@ namespace muGrid {
     storage_type iterate;
   };
 
+  /**
+   * `Width` iterates of a `muGrid::StaticFieldMap`, handed out by
+   * `StaticFieldMap::batches`. The values are loaded into (and stored from)
+   * a `muGrid::TensorBatch`, which holds every component of the iterates as
+   * an `Eigen::Array<T, Width, 1>`. Fields stored as a structure of arrays
+   * are loaded directly, the values of fields stored as an array of
+   * structures are gathered (and scattered on store).
+   */
+  template <typename T, Mapping Mutability, class MapType,
+            IterUnit IterationType>
+  template <Dim_t Width>
+  class StaticFieldMap<T, Mutability, MapType, IterationType>::Batch {
+   public:
+    //! values of the iterates of the batch
+    using Value_t = TensorBatch<T, NbRow(), NbCol(), Width>;
+
+    //! Default constructor
+    Batch() = delete;
+
+    /**
+     * Constructor from the map, the sub-point and the first pixel of the
+     * batch and the number of valid points in the batch
+     */
+    Batch(StaticFieldMap & map, const Index_t & sub_pt,
+          const Index_t & first_pixel, const Index_t & nb_points)
+        : map{map}, sub_pt{sub_pt}, first_pixel{first_pixel},
+          nb_points{nb_points} {}
+
+    //! number of valid points in the batch (at most `Width`)
+    const Index_t & size() const { return this->nb_points; }
+
+    //! index of the iterate at point `point` of the batch
+    size_t get_index(const Index_t & point) const {
+      return (this->first_pixel + point) * this->map.nb_iterates_per_pixel +
+             this->sub_pt;
+    }
+
+    //! load the iterates of the batch, points beyond `size()` are zero
+    Value_t load() const {
+      Value_t batch{};
+      using Lane_t = typename Value_t::Lane_t;
+      using Dynamic_t = Eigen::Array<T, Eigen::Dynamic, 1>;
+      using Stride_t = Eigen::InnerStride<Eigen::Dynamic>;
+      const T * data{this->get_data()};
+      const Index_t point_step{this->get_point_step()};
+      const IterateStride_t strides{this->map.get_iterate_strides()};
+      for (Dim_t col{0}; col < NbCol(); ++col) {
+        for (Dim_t row{0}; row < NbRow(); ++row) {
+          const T * component{data + row * strides.inner() +
+                              col * strides.outer()};
+          auto && lane{batch(row, col)};
+          if (this->nb_points < Width) {
+            lane.setZero();
+            lane.head(this->nb_points) =
+                Eigen::Map<const Dynamic_t, Eigen::Unaligned, Stride_t>(
+                    component, this->nb_points, Stride_t{point_step});
+          } else if (point_step == 1) {
+            lane = Eigen::Map<const Lane_t>(component);
+          } else {
+            lane = Eigen::Map<const Lane_t, Eigen::Unaligned, Stride_t>(
+                component, Stride_t{point_step});
+          }
+        }
+      }
+      return batch;
+    }
+
+    //! store the valid points of `batch` in the iterates of the batch
+    template <bool IsMutableField = Mutability == Mapping::Mut>
+    std::enable_if_t<IsMutableField> store(const Value_t & batch) const {
+      using Lane_t = typename Value_t::Lane_t;
+      using Dynamic_t = Eigen::Array<T, Eigen::Dynamic, 1>;
+      using Stride_t = Eigen::InnerStride<Eigen::Dynamic>;
+      T * data{this->get_data()};
+      const Index_t point_step{this->get_point_step()};
+      const IterateStride_t strides{this->map.get_iterate_strides()};
+      for (Dim_t col{0}; col < NbCol(); ++col) {
+        for (Dim_t row{0}; row < NbRow(); ++row) {
+          T * component{data + row * strides.inner() + col * strides.outer()};
+          auto && lane{batch(row, col)};
+          if (this->nb_points < Width) {
+            Eigen::Map<Dynamic_t, Eigen::Unaligned, Stride_t>(
+                component, this->nb_points, Stride_t{point_step}) =
+                lane.head(this->nb_points);
+          } else if (point_step == 1) {
+            Eigen::Map<Lane_t>{component} = lane;
+          } else {
+            Eigen::Map<Lane_t, Eigen::Unaligned, Stride_t>(
+                component, Stride_t{point_step}) = lane;
+          }
+        }
+      }
+    }
+
+   protected:
+    //! pointer to the first value of the batch's first iterate
+    T * get_data() const {
+      return this->map.data_ptr + this->map.get_offset(this->get_index(0));
+    }
+
+    //! distance between the iterates of consecutive points of the batch
+    Index_t get_point_step() const {
+      return this->map.get_offset(this->get_index(1)) -
+             this->map.get_offset(this->get_index(0));
+    }
+
+    StaticFieldMap & map;      //!< map the batch belongs to
+    const Index_t sub_pt;      //!< sub-point of the iterates of the batch
+    const Index_t first_pixel;  //!< pixel of the first point of the batch
+    const Index_t nb_points;   //!< number of valid points in the batch
+  };
+
+  /**
+   * iterable proxy over the batches of a `muGrid::StaticFieldMap`, see
+   * `StaticFieldMap::batches`
+   */
+  template <typename T, Mapping Mutability, class MapType,
+            IterUnit IterationType>
+  template <Dim_t Width>
+  class StaticFieldMap<T, Mutability, MapType, IterationType>::BatchIterable {
+   public:
+    //! type of the batches
+    using Batch_t = Batch<Width>;
+
+    //! Default constructor
+    BatchIterable() = delete;
+
+    //! Constructor from the map
+    explicit BatchIterable(StaticFieldMap & map)
+        : map{map}, nb_pixels{static_cast<Index_t>(map.size()) /
+                              map.nb_iterates_per_pixel},
+          nb_batches_per_sub_pt{(this->nb_pixels + Width - 1) / Width} {}
+
+    //! iterator over the batches
+    class Iterator {
+     public:
+      //! Constructor from the iterable and the batch index
+      Iterator(const BatchIterable & batches, const Index_t & index)
+          : batches{batches}, index{index} {}
+
+      //! dereference
+      Batch_t operator*() const {
+        const Index_t first_pixel{
+            (this->index % this->batches.nb_batches_per_sub_pt) * Width};
+        return Batch_t{
+            this->batches.map,
+            this->index / this->batches.nb_batches_per_sub_pt, first_pixel,
+            std::min(Index_t{Width}, this->batches.nb_pixels - first_pixel)};
+      }
+
+      //! pre-increment
+      Iterator & operator++() {
+        ++this->index;
+        return *this;
+      }
+
+      //! equality
+      bool operator==(const Iterator & other) const {
+        return this->index == other.index;
+      }
+
+      //! inequality
+      bool operator!=(const Iterator & other) const {
+        return not(*this == other);
+      }
+
+     protected:
+      const BatchIterable & batches;  //!< batches being iterated over
+      Index_t index;                  //!< current batch index
+    };
+
+    //! stl
+    Iterator begin() const { return Iterator{*this, 0}; }
+
+    //! stl
+    Iterator end() const { return Iterator{*this, this->size()}; }
+
+    //! number of batches
+    Index_t size() const {
+      return this->nb_batches_per_sub_pt * this->map.nb_iterates_per_pixel;
+    }
+
+   protected:
+    StaticFieldMap & map;                 //!< map being iterated over
+    const Index_t nb_pixels;              //!< number of iterated pixels
+    const Index_t nb_batches_per_sub_pt;  //!< batches per sub-point
+  };
+
   namespace internal {
 
     /**
      * Internal struct for handling the matrix-shaped iterates of
      * `muGrid::FieldMap`
+     *
+     * @tparam MapOptions alignment of the `Eigen::Map`s of the iterates,
+     * `Eigen::Unaligned` or one of `Eigen::Aligned16`, ...,
+     * `Eigen::AlignedMax`
+     * @tparam StrideType `Eigen::Stride<0, 0>` for contiguous iterates or
+     * `muGrid::IterateStride_t` for iterates with run-time strides (required
+     * for fields stored as a structure of arrays)
      */
-    template <typename T, class EigenPlain>
+    template <typename T, class EigenPlain, int MapOptions = Eigen::Unaligned,
+              class StrideType = Eigen::Stride<0, 0>>
     struct EigenMap {
       /**
        * check at compile time whether the type is meant to be a map with
@@ -381,14 +650,22 @@ namespace muGrid {
        */
       constexpr static bool IsScalarMapType() { return false; }
 
+      /**
+       * check at compile time whether the iterates may be strided in memory
+       */
+      constexpr static bool SupportsStrides() {
+        return std::is_same<StrideType, IterateStride_t>::value;
+      }
+
       //! Eigen type of the iterate
       using PlainType = EigenPlain;
 
       //! stl (const-correct)
       template <Mapping MutIter>
-      using value_type = std::conditional_t<MutIter == Mapping::Const,
-                                            Eigen::Map<const PlainType>,
-                                            Eigen::Map<PlainType>>;
+      using value_type = std::conditional_t<
+          MutIter == Mapping::Const,
+          Eigen::Map<const PlainType, MapOptions, StrideType>,
+          Eigen::Map<PlainType, MapOptions, StrideType>>;
 
       //! stl (const-correct)
       template <Mapping MutIter>
@@ -430,6 +707,36 @@ namespace muGrid {
         return Return_t<MutIter>(data);
       }
 
+      /**
+       * return a return_type version of the iterate from its pointer and
+       * strides (which are ignored for contiguous iterates)
+       */
+      template <Mapping MutIter>
+      static Return_t<MutIter> from_data_ptr(
+          std::conditional_t<MutIter == Mapping::Const, const T *, T *> data,
+          const IterateStride_t & strides) {
+        if constexpr (SupportsStrides()) {
+          if constexpr (PlainType::IsRowMajor) {
+            // row vectors are row-major, their inner stride is between columns
+            return Return_t<MutIter>(
+                data, IterateStride_t{strides.inner(), strides.outer()});
+          } else {
+            return Return_t<MutIter>(data, strides);
+          }
+        } else {
+          static_cast<void>(strides);
+          return Return_t<MutIter>(data);
+        }
+      }
+
+      //! return a storage_type version of the iterate from its pointer
+      template <Mapping MutIter>
+      static storage_type<MutIter> storage_from_data_ptr(
+          std::conditional_t<MutIter == Mapping::Const, const T *, T *> data,
+          const IterateStride_t & strides) {
+        return from_data_ptr<MutIter>(data, strides);
+      }
+
       //! return a storage_type version of the iterate from its value
       template <Mapping MutIter>
       constexpr static storage_type<MutIter>
@@ -450,6 +757,10 @@ namespace muGrid {
         return shape_stream.str();
       }
       constexpr static Index_t NbRow() { return PlainType::RowsAtCompileTime; }
+
+      //! return the alignment in bytes the iterates require (the values of
+      //! Eigen's alignment options are their alignments in bytes)
+      constexpr static size_t Alignment() { return MapOptions; }
     };
 
     /**
@@ -459,6 +770,22 @@ namespace muGrid {
     template <typename T, Dim_t NbRow, Dim_t NbCol>
     using MatrixMap = EigenMap<T, Eigen::Matrix<T, NbRow, NbCol>>;
 
+    /**
+     * internal convenience alias for creating maps iterating over statically
+     * sized `Eigen::Matrix`s whose data is aligned to `MapOptions`
+     */
+    template <typename T, Dim_t NbRow, Dim_t NbCol, int MapOptions>
+    using AlignedMatrixMap =
+        EigenMap<T, Eigen::Matrix<T, NbRow, NbCol>, MapOptions>;
+
+    /**
+     * internal convenience alias for creating maps iterating over statically
+     * sized `Eigen::Matrix`s with run-time strides
+     */
+    template <typename T, Dim_t NbRow, Dim_t NbCol>
+    using StridedMatrixMap = EigenMap<T, Eigen::Matrix<T, NbRow, NbCol>,
+                                      Eigen::Unaligned, IterateStride_t>;
+
     /**
      * returns number of rows a dim-dimensional tensor of rank rank has in
      * matrix representation
@@ -544,6 +871,14 @@ namespace muGrid {
     template <typename T, Dim_t NbRow, Dim_t NbCol>
     using ArrayMap = EigenMap<T, Eigen::Array<T, NbRow, NbCol>>;
 
+    /**
+     * internal convenience alias for creating maps iterating over statically
+     * sized `Eigen::Array`s with run-time strides
+     */
+    template <typename T, Dim_t NbRow, Dim_t NbCol>
+    using StridedArrayMap = EigenMap<T, Eigen::Array<T, NbRow, NbCol>,
+                                     Eigen::Unaligned, IterateStride_t>;
+
     /**
      * Internal struct for handling the scalar iterates of `muGrid::FieldMap`
      */
@@ -560,6 +895,11 @@ namespace muGrid {
        */
       constexpr static bool IsScalarMapType() { return true; }
 
+      /**
+       * scalar iterates consist of a single value and can be placed anywhere
+       */
+      constexpr static bool SupportsStrides() { return true; }
+
       /**
        * Scalar maps don't have an eigen type representing the iterate, just the
        * raw stored type itsef
@@ -612,6 +952,21 @@ namespace muGrid {
         return *data;
       }
 
+      //! return a return_type version of the iterate from its pointer
+      template <Mapping MutIter>
+      constexpr static Return_t<MutIter> from_data_ptr(
+          std::conditional_t<MutIter == Mapping::Const, const T *, T *> data,
+          const IterateStride_t & /*strides*/) {
+        return *data;
+      }
+
+      //! return a storage_type version of the iterate from its pointer
+      template <Mapping MutIter>
+      constexpr static storage_type<MutIter> storage_from_data_ptr(
+          storage_type<MutIter> data, const IterateStride_t & /*strides*/) {
+        return data;
+      }
+
       //! return a storage_type version of the iterate from its value
       template <Mapping MutIter>
       constexpr static storage_type<MutIter> to_storage(ref_type<MutIter> ref) {
@@ -624,6 +979,9 @@ namespace muGrid {
       //! return the iterate's shape as text, mostly for error messages
       static std::string shape() { return "scalar"; }
       constexpr static Index_t NbRow() { return 1; }
+
+      //! scalar iterates have no alignment requirement
+      constexpr static size_t Alignment() { return 0; }
     };
 
   }  // namespace internal
@@ -676,6 +1034,28 @@ namespace muGrid {
       StaticFieldMap<T, Mutability, internal::MatrixMap<T, NbRow, NbCol>,
                      IterationType>;
 
+  /**
+   * Alias of `muGrid::StaticFieldMap` you wish to iterate over pixel by pixel
+   * or quadrature point by quadrature point with statically sized, aligned
+   * `Eigen::Matrix` iterates. Eigen uses aligned loads and stores on these.
+   * The constructor throws a `FieldMapError` if the data of the field or the
+   * distance between iterates is not a multiple of the alignment.
+   *
+   * @tparam T scalar type stored in the field
+   * @tparam Mutability whether or not the map allows to modify the content of
+   * the field
+   * @tparam NbRow number of rows of the iterate
+   * @tparam NbCol number of columns of the iterate
+   * @tparam IterationType describes the pixel-subdivision
+   * @tparam MapOptions alignment of the iterates, by default the alignment
+   * of Eigen's vectorised code
+   */
+  template <typename T, Mapping Mutability, Dim_t NbRow, Dim_t NbCol,
+            IterUnit IterationType, int MapOptions = Eigen::AlignedMax>
+  using AlignedMatrixFieldMap = StaticFieldMap<
+      T, Mutability, internal::AlignedMatrixMap<T, NbRow, NbCol, MapOptions>,
+      IterationType>;
+
   /**
    * Alias of `muGrid::StaticFieldMap` you wish to iterate over pixel by pixel
    * or quadrature point by quadrature point with* statically sized
@@ -695,6 +1075,36 @@ namespace muGrid {
       StaticFieldMap<T, Mutability, internal::ArrayMap<T, NbRow, NbCol>,
                      IterationType>;
 
+  /**
+   * Alias of `muGrid::StaticFieldMap` with statically sized `Eigen::Matrix`
+   * iterates whose values may be strided in memory. These maps iterate over
+   * fields in both storage orders, in particular over fields stored as a
+   * structure of arrays (`StorageOrder::RowMajor`) without converting them.
+   *
+   * @tparam T scalar type stored in the field
+   * @tparam Mutability whether or not the map allows to modify the content of
+   * the field
+   * @tparam NbRow number of rows of the iterate
+   * @tparam NbCol number of columns of the iterate
+   * @tparam IterationType describes the pixel-subdivision
+   */
+  template <typename T, Mapping Mutability, Dim_t NbRow, Dim_t NbCol,
+            IterUnit IterationType>
+  using StridedMatrixFieldMap = StaticFieldMap<
+      T, Mutability, internal::StridedMatrixMap<T, NbRow, NbCol>,
+      IterationType>;
+
+  /**
+   * Alias of `muGrid::StaticFieldMap` with statically sized `Eigen::Array`
+   * iterates whose values may be strided in memory (see
+   * `StridedMatrixFieldMap`)
+   */
+  template <typename T, Mapping Mutability, Dim_t NbRow, Dim_t NbCol,
+            IterUnit IterationType>
+  using StridedArrayFieldMap =
+      StaticFieldMap<T, Mutability, internal::StridedArrayMap<T, NbRow, NbCol>,
+                     IterationType>;
+
   /**
    * Alias of `muGrid::StaticFieldMap` over a scalar field you wish to iterate
    * over
@@ -776,6 +1186,30 @@ namespace muGrid {
                      internal::MatrixMap<T, Dim * Dim, Dim * Dim>,
                      IterationType>;
 
+  /**
+   * Alias of `muGrid::StaticFieldMap` over a first-rank tensor field with
+   * strided iterates (see `StridedMatrixFieldMap`)
+   */
+  template <typename T, Mapping Mutability, Dim_t Dim, IterUnit IterationType>
+  using StridedT1FieldMap =
+      StridedMatrixFieldMap<T, Mutability, Dim, 1, IterationType>;
+
+  /**
+   * Alias of `muGrid::StaticFieldMap` over a second-rank tensor field with
+   * strided iterates (see `StridedMatrixFieldMap`)
+   */
+  template <typename T, Mapping Mutability, Dim_t Dim, IterUnit IterationType>
+  using StridedT2FieldMap =
+      StridedMatrixFieldMap<T, Mutability, Dim, Dim, IterationType>;
+
+  /**
+   * Alias of `muGrid::StaticFieldMap` over a fourth-rank tensor field with
+   * strided iterates (see `StridedMatrixFieldMap`)
+   */
+  template <typename T, Mapping Mutability, Dim_t Dim, IterUnit IterationType>
+  using StridedT4FieldMap =
+      StridedMatrixFieldMap<T, Mutability, Dim * Dim, Dim * Dim, IterationType>;
+
 }  // namespace muGrid
 
 #endif  // SRC_LIBMUGRID_FIELD_MAP_STATIC_HH_
@@ -0,0 +1,282 @@
+/**
+ * @file   field_redistribution.cc
+ *
+ * @author Lars Pastewka <lars.pastewka@imtek.uni-freiburg.de>
+ *
+ * @date   16 Oct 2026
+ *
+ * @brief  Redistribution of global fields between two decompositions
+ *         of the same domain
+ *
+ * Copyright © 2026 Lars Pastewka
+ *
+ * µGrid is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * µGrid is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with µGrid; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * Additional permission under GNU GPL version 3 section 7
+ *
+ * If you modify this Program, or any covered work, by linking or combining it
+ * with proprietary FFT implementations or numerical libraries, containing parts
+ * covered by the terms of those libraries' licenses, the licensors of this
+ * Program grant you additional permission to convey the resulting work.
+ *
+ */
+
+#include "field_redistribution.hh"
+#include "ccoord_operations.hh"
+#include "exception.hh"
+#include "field_collection.hh"
+
+#include <algorithm>
+#include <sstream>
+
+namespace muGrid {
+
+  /* ---------------------------------------------------------------------- */
+  FieldRedistribution::FieldRedistribution(
+      const GlobalFieldCollection & source,
+      const GlobalFieldCollection & target)
+      : FieldRedistribution{source, target, source.get_communicator()} {}
+
+  /* ---------------------------------------------------------------------- */
+  FieldRedistribution::FieldRedistribution(
+      const GlobalFieldCollection & source,
+      const GlobalFieldCollection & target, const Communicator & comm)
+      : source{source}, target{target}, comm{comm} {
+    if (not source.is_initialised() or not target.is_initialised()) {
+      throw FieldCollectionError(
+          "Fields can only be redistributed between initialised collections");
+    }
+    if (not(source.get_nb_domain_grid_pts() ==
+            target.get_nb_domain_grid_pts())) {
+      std::stringstream error{};
+      error << "Can't redistribute fields from a domain of "
+            << source.get_nb_domain_grid_pts() << " grid points onto one of "
+            << target.get_nb_domain_grid_pts() << " grid points.";
+      throw FieldCollectionError(error.str());
+    }
+
+    // every process needs to know the source and target subdomains of all
+    // processes to find what to send to and receive from them
+    const Index_t dim{source.get_nb_domain_grid_pts().get_dim()};
+    DynMatrix_t<Index_t> subdomain(4 * dim, 1);
+    for (Index_t d{0}; d < dim; ++d) {
+      subdomain(d, 0) = source.get_subdomain_locations()[d];
+      subdomain(dim + d, 0) = source.get_nb_subdomain_grid_pts()[d];
+      subdomain(2 * dim + d, 0) = target.get_subdomain_locations()[d];
+      subdomain(3 * dim + d, 0) = target.get_nb_subdomain_grid_pts()[d];
+    }
+    DynMatrix_t<Index_t> subdomains{
+        this->comm.gather(Eigen::Ref<DynMatrix_t<Index_t>>(subdomain))};
+    const Index_t nb_procs{subdomains.cols()};
+    const Index_t me{this->comm.rank()};
+
+    // the overlap of the subdomain with locations in row `from` and that
+    // with locations in row `to`, iterated in the same (column-major) order
+    // by the sending and the receiving process
+    auto && overlap{[&subdomains, dim](Index_t p, Index_t from, Index_t q,
+                                       Index_t to) {
+      DynCcoord_t locations(dim), nb_grid_pts(dim);
+      for (Index_t d{0}; d < dim; ++d) {
+        const Index_t begin{
+            std::max(subdomains(from + d, p), subdomains(to + d, q))};
+        const Index_t end{std::min(
+            subdomains(from + d, p) + subdomains(from + dim + d, p),
+            subdomains(to + d, q) + subdomains(to + dim + d, q))};
+        locations[d] = begin;
+        nb_grid_pts[d] = std::max(end - begin, Index_t{0});
+      }
+      return CcoordOps::DynamicPixels{nb_grid_pts, locations};
+    }};
+
+    this->send_counts.assign(nb_procs, 0);
+    this->recv_counts.assign(nb_procs, 0);
+    for (Index_t p{0}; p < nb_procs; ++p) {
+      for (auto && ccoord : overlap(me, 0, p, 2 * dim)) {
+        this->send_pixels.push_back(source.get_index(ccoord));
+        ++this->send_counts[p];
+      }
+      for (auto && ccoord : overlap(p, 0, me, 2 * dim)) {
+        this->recv_pixels.push_back(target.get_index(ccoord));
+        ++this->recv_counts[p];
+      }
+    }
+
+    // all pixels of the target subdomain need to be covered by the source
+    // subdomains exactly once
+    const Index_t nb_target_pixels{static_cast<Index_t>(
+        CcoordOps::get_size(target.get_nb_subdomain_grid_pts()))};
+    if (this->get_nb_recv_pixels() != nb_target_pixels) {
+      std::stringstream error{};
+      error << "The source subdomains cover " << this->get_nb_recv_pixels()
+            << " of the " << nb_target_pixels
+            << " pixels of the target subdomain on rank " << me
+            << ", they need to tile the domain.";
+      throw FieldCollectionError(error.str());
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  std::vector<Index_t>
+  FieldRedistribution::get_dof_offsets(const Field & field,
+                                       Index_t & pixel_step) {
+    const Index_t nb_dof{field.get_nb_dof_per_pixel()};
+    pixel_step =
+        field.get_storage_order() == StorageOrder::ColMajor ? nb_dof : 1;
+    std::vector<Index_t> offsets(nb_dof, 0);
+    if (nb_dof <= 1) {
+      return offsets;
+    }
+    // the leading entries of shape and strides describe the components and
+    // the sub-points, the trailing ones the pixels
+    const Shape_t shape{field.get_shape(IterUnit::SubPt)};
+    const Shape_t strides{field.get_strides(IterUnit::SubPt)};
+    const Index_t nb_dof_dims{
+        static_cast<Index_t>(shape.size()) -
+        field.get_collection().get_spatial_dim()};
+    for (Index_t dof{0}; dof < nb_dof; ++dof) {
+      Index_t remainder{dof};
+      for (Index_t i{0}; i < nb_dof_dims; ++i) {
+        offsets[dof] += (remainder % shape[i]) * strides[i];
+        remainder /= shape[i];
+      }
+    }
+    return offsets;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void FieldRedistribution::check_field(
+      const Field & field, const GlobalFieldCollection & collection,
+      const std::string & role) {
+    if (&field.get_collection() != &collection) {
+      std::stringstream error{};
+      error << "The " << role << " field '" << field.get_name()
+            << "' does not live on the " << role
+            << " collection of this redistribution.";
+      throw FieldError(error.str());
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  void FieldRedistribution::redistribute(const TypedFieldBase<T> & source,
+                                         TypedFieldBase<T> & target) const {
+    check_field(source, this->source, "source");
+    check_field(target, this->target, "target");
+    if (source.get_components_shape() != target.get_components_shape() or
+        source.get_nb_sub_pts() != target.get_nb_sub_pts()) {
+      std::stringstream error{};
+      error << "Can't redistribute field '" << source.get_name() << "' with "
+            << source.get_nb_sub_pts() << " sub-points of shape "
+            << source.get_components_shape() << " into field '"
+            << target.get_name() << "' with " << target.get_nb_sub_pts()
+            << " sub-points of shape " << target.get_components_shape();
+      throw FieldError(error.str());
+    }
+    Index_t source_step{}, target_step{};
+    const auto source_offsets{get_dof_offsets(source, source_step)};
+    const auto target_offsets{get_dof_offsets(target, target_step)};
+    const Index_t nb_dof{source.get_nb_dof_per_pixel()};
+
+    // pack the values pixel by pixel in the column-major order of the
+    // components and sub-points, independently of the storage order
+    std::vector<T> send_buffer(this->send_pixels.size() * nb_dof);
+    const T * source_data{source.data()};
+    for (size_t k{0}; k < this->send_pixels.size(); ++k) {
+      const T * pixel{source_data + this->send_pixels[k] * source_step};
+      for (Index_t dof{0}; dof < nb_dof; ++dof) {
+        send_buffer[k * nb_dof + dof] = pixel[source_offsets[dof]];
+      }
+    }
+
+    std::vector<T> recv_buffer{};
+#ifdef WITH_MPI
+    MPI_Comm mpi_comm{this->comm.get_mpi_comm()};
+    if (mpi_comm != MPI_COMM_NULL) {
+      const Index_t nb_procs{static_cast<Index_t>(this->send_counts.size())};
+      std::vector<int> send_counts(nb_procs), send_displacements(nb_procs, 0),
+          recv_counts(nb_procs), recv_displacements(nb_procs, 0);
+      for (Index_t p{0}; p < nb_procs; ++p) {
+        send_counts[p] = static_cast<int>(this->send_counts[p] * nb_dof);
+        recv_counts[p] = static_cast<int>(this->recv_counts[p] * nb_dof);
+        if (p > 0) {
+          send_displacements[p] =
+              send_displacements[p - 1] + send_counts[p - 1];
+          recv_displacements[p] =
+              recv_displacements[p - 1] + recv_counts[p - 1];
+        }
+      }
+      recv_buffer.resize(this->recv_pixels.size() * nb_dof);
+      auto message{MPI_Alltoallv(
+          send_buffer.data(), send_counts.data(), send_displacements.data(),
+          mpi_type<T>(), recv_buffer.data(), recv_counts.data(),
+          recv_displacements.data(), mpi_type<T>(), mpi_comm)};
+      if (message != 0) {
+        std::stringstream error{};
+        error << "MPI_Alltoallv failed with " << message << " on rank "
+              << this->comm.rank();
+        throw RuntimeError(error.str());
+      }
+    } else {
+      recv_buffer = std::move(send_buffer);
+    }
+#else
+    auto && group{this->comm.get_thread_group()};
+    if (group != nullptr) {
+      recv_buffer.resize(this->recv_pixels.size() * nb_dof);
+      std::vector<int> send_counts(this->send_counts.size()),
+          recv_counts(this->recv_counts.size());
+      for (size_t p{0}; p < send_counts.size(); ++p) {
+        send_counts[p] = static_cast<int>(this->send_counts[p] * nb_dof);
+        recv_counts[p] = static_cast<int>(this->recv_counts[p] * nb_dof);
+      }
+      group->alltoallv(this->comm.rank(), send_buffer.data(), send_counts,
+                       recv_buffer.data(), recv_counts);
+    } else {
+      // a single process sends everything to itself
+      recv_buffer = std::move(send_buffer);
+    }
+#endif
+
+    T * target_data{target.data()};
+    for (size_t k{0}; k < this->recv_pixels.size(); ++k) {
+      T * pixel{target_data + this->recv_pixels[k] * target_step};
+      for (Index_t dof{0}; dof < nb_dof; ++dof) {
+        pixel[target_offsets[dof]] = recv_buffer[k * nb_dof + dof];
+      }
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template void
+  FieldRedistribution::redistribute(const TypedFieldBase<Real> &,
+                                    TypedFieldBase<Real> &) const;
+  template void
+  FieldRedistribution::redistribute(const TypedFieldBase<Complex> &,
+                                    TypedFieldBase<Complex> &) const;
+  template void
+  FieldRedistribution::redistribute(const TypedFieldBase<Float> &,
+                                    TypedFieldBase<Float> &) const;
+  template void
+  FieldRedistribution::redistribute(const TypedFieldBase<Int> &,
+                                    TypedFieldBase<Int> &) const;
+  template void
+  FieldRedistribution::redistribute(const TypedFieldBase<Uint> &,
+                                    TypedFieldBase<Uint> &) const;
+  template void
+  FieldRedistribution::redistribute(const TypedFieldBase<Index_t> &,
+                                    TypedFieldBase<Index_t> &) const;
+
+}  // namespace muGrid
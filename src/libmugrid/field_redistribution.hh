@@ -0,0 +1,139 @@
+/**
+ * @file   field_redistribution.hh
+ *
+ * @author Lars Pastewka <lars.pastewka@imtek.uni-freiburg.de>
+ *
+ * @date   16 Oct 2026
+ *
+ * @brief  Redistribution of global fields between two decompositions
+ *         of the same domain
+ *
+ * Copyright © 2026 Lars Pastewka
+ *
+ * µGrid is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * µGrid is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with µGrid; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * Additional permission under GNU GPL version 3 section 7
+ *
+ * If you modify this Program, or any covered work, by linking or combining it
+ * with proprietary FFT implementations or numerical libraries, containing parts
+ * covered by the terms of those libraries' licenses, the licensors of this
+ * Program grant you additional permission to convey the resulting work.
+ *
+ */
+
+#ifndef SRC_LIBMUGRID_FIELD_REDISTRIBUTION_HH_
+#define SRC_LIBMUGRID_FIELD_REDISTRIBUTION_HH_
+
+#include "communicator.hh"
+#include "field_collection_global.hh"
+#include "field_typed.hh"
+#include "grid_common.hh"
+
+#include <vector>
+
+namespace muGrid {
+
+  /**
+   * Moves the values of global fields from one decomposition of a domain
+   * onto another one, e.g. from slabs to pencils for FFT-based solvers or
+   * onto a different number of processes on restart. The exchange plan,
+   * i.e. which pixels go to which process, is built once on construction
+   * from the subdomains of the two collections and is replayed by
+   * `redistribute` for every pair of fields on the two collections with the
+   * same components and sub-division. The values are packed directly from
+   * the source field and unpacked directly into the target field in either
+   * storage order (array of structures or structure of arrays) and
+   * exchanged with a single `MPI_Alltoallv`. Ghost layers are neither sent
+   * nor filled.
+   */
+  class FieldRedistribution {
+   public:
+    //! Default constructor
+    FieldRedistribution() = delete;
+
+    /**
+     * Constructor, collective on `comm`
+     * @param source collection holding the fields to redistribute
+     * @param target collection that receives the redistributed fields
+     * @param comm communicator spanning the processes of both collections
+     */
+    FieldRedistribution(const GlobalFieldCollection & source,
+                        const GlobalFieldCollection & target,
+                        const Communicator & comm);
+
+    //! Constructor on the communicator of the source collection
+    FieldRedistribution(const GlobalFieldCollection & source,
+                        const GlobalFieldCollection & target);
+
+    //! Copy constructor
+    FieldRedistribution(const FieldRedistribution & other) = delete;
+
+    //! Move constructor
+    FieldRedistribution(FieldRedistribution && other) = default;
+
+    //! Destructor
+    virtual ~FieldRedistribution() = default;
+
+    //! Copy assignment operator
+    FieldRedistribution & operator=(const FieldRedistribution & other) = delete;
+
+    //! Move assignment operator
+    FieldRedistribution & operator=(FieldRedistribution && other) = delete;
+
+    /**
+     * copy the values of `source` (on the source collection) into `target`
+     * (on the target collection), collective on the communicator
+     */
+    template <typename T>
+    void redistribute(const TypedFieldBase<T> & source,
+                      TypedFieldBase<T> & target) const;
+
+    //! number of pixels this process sends (including those to itself)
+    Index_t get_nb_send_pixels() const { return this->send_pixels.size(); }
+
+    //! number of pixels this process receives (including those from itself)
+    Index_t get_nb_recv_pixels() const { return this->recv_pixels.size(); }
+
+   protected:
+    /**
+     * offsets of the degrees of freedom of a pixel in the data of `field`,
+     * in column-major order of the components and sub-points, and the
+     * distance between the values of consecutive buffer pixels
+     */
+    static std::vector<Index_t> get_dof_offsets(const Field & field,
+                                                Index_t & pixel_step);
+
+    //! check that `field` lives on `collection`
+    static void check_field(const Field & field,
+                            const GlobalFieldCollection & collection,
+                            const std::string & role);
+
+    const GlobalFieldCollection & source;  //!< collection sending the values
+    const GlobalFieldCollection & target;  //!< collection receiving them
+    Communicator comm;  //!< communicator spanning both collections
+    //! buffer pixels of the source collection, grouped by destination rank
+    std::vector<Index_t> send_pixels{};
+    //! number of pixels sent to each rank
+    std::vector<int> send_counts{};
+    //! buffer pixels of the target collection, grouped by source rank
+    std::vector<Index_t> recv_pixels{};
+    //! number of pixels received from each rank
+    std::vector<int> recv_counts{};
+  };
+
+}  // namespace muGrid
+
+#endif  // SRC_LIBMUGRID_FIELD_REDISTRIBUTION_HH_
@@ -33,17 +33,52 @@
  *
  */
 
+#include <algorithm>
+#include <cstdint>
 #include <sstream>
 
 #include "ccoord_operations.hh"
 #include "field_typed.hh"
 #include "field_collection.hh"
+#include "field_collection_global.hh"
+#include "field_linalg.hh"
 #include "field_map.hh"
 #include "raw_memory_operations.hh"
 #include "tensor_algebra.hh"
 
 namespace muGrid {
 
+  namespace internal {
+
+    /**
+     * initialise the `nb_values` values at `values` with the `nb_initial`
+     * values at `initial`, followed by zeros. All but the trailing
+     * `pad_size` values are written on the threads of the field operations
+     * with their static chunking (see `linalg::parallel_for`), such that
+     * every page is first touched by, and hence placed on the NUMA node of,
+     * the thread that updates it in the element-wise operations. Without
+     * initial values, this zeroes the values on the same threads.
+     */
+    template <typename T>
+    void first_touch(T * values, const size_t & nb_values,
+                     const size_t & pad_size, const T * initial,
+                     const size_t & nb_initial) {
+      auto && initialise{[&](const Index_t & begin, const Index_t & end) {
+        const Index_t nb_copied{
+            std::clamp(static_cast<Index_t>(nb_initial), begin, end)};
+        if (nb_copied > begin) {
+          std::copy(initial + begin, initial + nb_copied, values + begin);
+        }
+        std::fill(values + nb_copied, values + end, T{});
+      }};
+      const Index_t nb_chunked{
+          static_cast<Index_t>(nb_values - std::min(pad_size, nb_values))};
+      linalg::parallel_for(nb_chunked, sizeof(T), initialise);
+      initialise(nb_chunked, static_cast<Index_t>(nb_values));
+    }
+
+  }  // namespace internal
+
   /* ---------------------------------------------------------------------- */
   template <typename T>
   void TypedFieldBase<T>::set_data_ptr(T * ptr) {
@@ -69,6 +104,273 @@ namespace muGrid {
     return static_cast<void *>(this->data_ptr);
   }
 
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  size_t TypedFieldBase<T>::get_alignment() const {
+    const auto address{reinterpret_cast<std::uintptr_t>(this->data_ptr)};
+    size_t alignment{FieldAlignment};
+    while (address % alignment != 0) {
+      alignment /= 2;
+    }
+    return alignment;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  void TypedFieldBase<T>::communicate_ghosts() {
+    this->begin_communicate_ghosts();
+    this->finish_communicate_ghosts();
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  void TypedFieldBase<T>::begin_communicate_ghosts() {
+    if (not this->is_global()) {
+      std::stringstream error{};
+      error << "The field '" << this->get_name()
+            << "' is not global and hence has no ghost layers.";
+      throw FieldError(error.str());
+    }
+    if (this->ghost_exchange_pending) {
+      std::stringstream error{};
+      error << "The ghost exchange of field '" << this->get_name()
+            << "' has already been started, finish it before starting a new "
+               "one.";
+      throw FieldError(error.str());
+    }
+    auto & collection{
+        static_cast<const GlobalFieldCollection &>(this->get_collection())};
+    if (not collection.has_ghosts()) {
+      return;
+    }
+    const auto & comm{collection.get_communicator()};
+    const auto & nb_grid_pts{collection.get_nb_subdomain_grid_pts()};
+    const auto & nb_ghosts_left{collection.get_nb_ghosts_left()};
+    const auto & nb_ghosts_right{collection.get_nb_ghosts_right()};
+
+    const Shape_t shape{this->get_shape(IterUnit::SubPt)};
+    const Shape_t strides{this->get_strides(IterUnit::SubPt)};
+    const Index_t dim{this->get_spatial_dim()};
+    // the pixel dimensions are the trailing dimensions of the shape
+    const Index_t pixels_offset{static_cast<Index_t>(shape.size()) - dim};
+
+    // returns the position in the field and the shape of the slab of values
+    // sent to the neighbour at `neighbour` (the layers of the subdomain
+    // adjacent to it) or received from it (the ghosts adjacent to it). Every
+    // neighbour, including the edge and corner neighbours, is communicated
+    // with directly, so all messages can be in flight at the same time.
+    auto && get_slab{[&](const DynCcoord_t & neighbour, const bool & is_send) {
+      Shape_t slab_shape{shape};
+      Index_t field_offset{0};
+      for (Index_t d{0}; d < dim; ++d) {
+        Index_t start{}, width{};
+        switch (neighbour[d]) {
+        case -1: {
+          start = is_send ? nb_ghosts_left[d] : 0;
+          width = is_send ? nb_ghosts_right[d] : nb_ghosts_left[d];
+          break;
+        }
+        case 0: {
+          start = nb_ghosts_left[d];
+          width = nb_grid_pts[d];
+          break;
+        }
+        default: {
+          start = is_send ? nb_grid_pts[d]
+                          : nb_ghosts_left[d] + nb_grid_pts[d];
+          width = is_send ? nb_ghosts_left[d] : nb_ghosts_right[d];
+          break;
+        }
+        }
+        slab_shape[pixels_offset + d] = width;
+        field_offset += start * strides[pixels_offset + d];
+      }
+      return std::make_tuple(field_offset, slab_shape);
+    }};
+
+    const int rank{comm.rank()};
+    CcoordOps::DynamicPixels neighbours{
+        CcoordOps::get_cube(dim, 3),
+        DynCcoord_t(std::vector<Index_t>(dim, -1))};
+    auto && is_self{[](const DynCcoord_t & neighbour) {
+      return std::all_of(neighbour.begin(), neighbour.end(),
+                         [](auto && n) { return n == 0; });
+    }};
+
+    // size the buffers for all messages to other processes
+    Index_t send_size{0}, recv_size{0};
+    for (auto && neighbour : neighbours) {
+      if (is_self(neighbour) or
+          collection.get_neighbour_rank(neighbour) == rank) {
+        continue;
+      }
+      send_size += raw_mem_ops::prod(std::get<1>(get_slab(neighbour, true)));
+      recv_size += raw_mem_ops::prod(std::get<1>(get_slab(neighbour, false)));
+    }
+    this->ghost_send_buffer.resize(send_size);
+    this->ghost_recv_buffer.resize(recv_size);
+
+    // post all receives before the sends. The tag identifies the direction
+    // of a message, as the same process can be the neighbour in several
+    // directions
+    Index_t position{0};
+    for (auto && neighbour : neighbours) {
+      const int neighbour_rank{collection.get_neighbour_rank(neighbour)};
+      if (is_self(neighbour) or neighbour_rank == rank) {
+        continue;
+      }
+      auto && slab{get_slab(neighbour, false)};
+      const Index_t size{
+          static_cast<Index_t>(raw_mem_ops::prod(std::get<1>(slab)))};
+      if (size == 0) {
+        continue;
+      }
+      DynCcoord_t opposite(dim);
+      for (Index_t d{0}; d < dim; ++d) {
+        opposite[d] = -neighbour[d];
+      }
+      this->ghost_recv_slabs.push_back(
+          GhostSlab{position, std::get<0>(slab), std::get<1>(slab)});
+      this->ghost_requests.push_back(comm.irecv(
+          this->ghost_recv_buffer.data() + position, size, neighbour_rank,
+          GlobalFieldCollection::get_neighbour_index(opposite)));
+      position += size;
+    }
+
+    // pack and send, periodic images on the own process are copied directly
+    position = 0;
+    for (auto && neighbour : neighbours) {
+      const int neighbour_rank{collection.get_neighbour_rank(neighbour)};
+      if (is_self(neighbour)) {
+        continue;
+      }
+      auto && slab{get_slab(neighbour, true)};
+      const Index_t size{
+          static_cast<Index_t>(raw_mem_ops::prod(std::get<1>(slab)))};
+      if (size == 0) {
+        continue;
+      }
+      if (neighbour_rank == rank) {
+        // the own process is also the neighbour in the opposite direction
+        DynCcoord_t opposite(dim);
+        for (Index_t d{0}; d < dim; ++d) {
+          opposite[d] = -neighbour[d];
+        }
+        raw_mem_ops::strided_copy(
+            std::get<1>(slab), strides, strides,
+            this->data_ptr + std::get<0>(slab),
+            this->data_ptr + std::get<0>(get_slab(opposite, false)));
+        continue;
+      }
+      raw_mem_ops::strided_copy(
+          std::get<1>(slab), strides,
+          raw_mem_ops::col_major_strides(std::get<1>(slab)),
+          this->data_ptr + std::get<0>(slab),
+          this->ghost_send_buffer.data() + position);
+      this->ghost_requests.push_back(comm.isend(
+          this->ghost_send_buffer.data() + position, size, neighbour_rank,
+          GlobalFieldCollection::get_neighbour_index(neighbour)));
+      position += size;
+    }
+    this->ghost_exchange_pending = true;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  void TypedFieldBase<T>::finish_communicate_ghosts() {
+    if (not this->ghost_exchange_pending) {
+      // nothing has been started (e.g. there are no ghosts)
+      return;
+    }
+    auto & collection{
+        static_cast<const GlobalFieldCollection &>(this->get_collection())};
+    collection.get_communicator().wait_all(this->ghost_requests);
+    const Shape_t strides{this->get_strides(IterUnit::SubPt)};
+    for (auto && slab : this->ghost_recv_slabs) {
+      raw_mem_ops::strided_copy(
+          slab.shape, raw_mem_ops::col_major_strides(slab.shape), strides,
+          this->ghost_recv_buffer.data() + slab.buffer_offset,
+          this->data_ptr + slab.field_offset);
+    }
+    this->ghost_recv_slabs.clear();
+    this->ghost_exchange_pending = false;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  void TypedFieldBase<T>::check_storage_order_conversion(
+      const StorageOrder & storage_order) const {
+    const StorageOrder new_order{storage_order == StorageOrder::Automatic
+                                     ? this->collection.get_storage_order()
+                                     : storage_order};
+    if (new_order != StorageOrder::ColMajor and
+        new_order != StorageOrder::RowMajor) {
+      std::stringstream error{};
+      error << "Field '" << this->get_name()
+            << "' can only be converted to the storage orders ColMajor and "
+               "RowMajor, not to "
+            << storage_order;
+      throw FieldError(error.str());
+    }
+    const StorageOrder old_order{this->get_storage_order()};
+    if (old_order != StorageOrder::ColMajor and
+        old_order != StorageOrder::RowMajor) {
+      std::stringstream error{};
+      error << "Field '" << this->get_name() << "' has the storage order "
+            << old_order << ", which cannot be converted";
+      throw FieldError(error.str());
+    }
+    if (this->ghost_exchange_pending) {
+      std::stringstream error{};
+      error << "Cannot convert the storage order of field '" << this->get_name()
+            << "' while a ghost exchange is pending";
+      throw FieldError(error.str());
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  void
+  TypedFieldBase<T>::convert_storage_order(const StorageOrder & storage_order) {
+    this->check_storage_order_conversion(storage_order);
+    const StorageOrder new_order{storage_order == StorageOrder::Automatic
+                                     ? this->collection.get_storage_order()
+                                     : storage_order};
+    const StorageOrder old_order{this->get_storage_order()};
+    if (old_order == new_order or not this->collection.is_initialised()) {
+      // no values need to be moved
+      this->storage_order = storage_order;
+      return;
+    }
+    const Shape_t shape{this->get_shape(IterUnit::SubPt)};
+    const Shape_t old_strides{this->get_strides(IterUnit::SubPt)};
+    this->storage_order = storage_order;
+    const Shape_t new_strides{this->get_strides(IterUnit::SubPt)};
+    const std::vector<T> old_values(
+        this->data_ptr, this->data_ptr + this->get_nb_buffer_entries() *
+                                             this->get_nb_components());
+    raw_mem_ops::strided_copy(shape, old_strides, new_strides,
+                              old_values.data(), this->data_ptr,
+                              linalg::get_thread_pool());
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  void TypedFieldBase<T>::copy_to(TypedFieldBase & other) const {
+    const Shape_t shape{this->get_shape(IterUnit::SubPt)};
+    if (shape != other.get_shape(IterUnit::SubPt)) {
+      std::stringstream error{};
+      error << "Cannot copy field '" << this->get_name() << "' of shape "
+            << shape << " into field '" << other.get_name() << "' of shape "
+            << other.get_shape(IterUnit::SubPt);
+      throw FieldError(error.str());
+    }
+    raw_mem_ops::strided_copy(shape, this->get_strides(IterUnit::SubPt),
+                              other.get_strides(IterUnit::SubPt),
+                              this->data_ptr, other.data_ptr,
+                              linalg::get_thread_pool());
+  }
+
   /* ---------------------------------------------------------------------- */
   template <typename T>
   TypedField<T> & TypedField<T>::operator=(const Parent & other) {
@@ -100,7 +402,9 @@ namespace muGrid {
   /* ---------------------------------------------------------------------- */
   template <typename T>
   void TypedField<T>::set_zero() {
-    std::fill(this->values.begin(), this->values.end(), T{});
+    // with the chunking of the field operations, the pad on the calling thread
+    internal::first_touch<T>(this->data_ptr, this->get_buffer_size(),
+                             this->pad_size, nullptr, 0);
   }
 
   /* ---------------------------------------------------------------------- */
@@ -191,6 +495,38 @@ namespace muGrid {
   /* ---------------------------------------------------------------------- */
   template <typename T>
   void TypedField<T>::resize() {
+    auto && size{this->nb_sub_pts * this->get_nb_buffer_pixels()};
+    const auto expected_size{this->get_expected_buffer_size()};
+    if (this->arena_values != nullptr) {
+      if (this->nb_arena_values == expected_size) {
+        this->current_nb_entries = size;
+        this->set_data_ptr(this->arena_values);
+        return;
+      }
+      // the field outgrew its slot in the arena
+      this->leave_arena();
+    }
+    if (this->values.size() != expected_size or
+        static_cast<Index_t>(this->current_nb_entries) != size) {
+      this->current_nb_entries = size;
+      const size_t nb_old_values{this->values.size()};
+      // new values are left uninitialised by the allocator
+      this->values.resize(expected_size);
+      if (nb_old_values == 0) {
+        internal::first_touch(this->values.data(), expected_size,
+                              this->pad_size, static_cast<const T *>(nullptr),
+                              0);
+      } else if (expected_size > nb_old_values) {
+        std::fill(this->values.begin() + nb_old_values, this->values.end(),
+                  T{});
+      }
+    }
+    this->set_data_ptr(this->values.data());
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  size_t TypedField<T>::get_expected_buffer_size() const {
     if (not this->has_nb_sub_pts()) {
       std::stringstream error_message{};
       error_message << "Can't compute the size of field '" << this->get_name()
@@ -199,21 +535,72 @@ namespace muGrid {
                     << this->get_sub_division_tag() << "' is not yet known.";
       throw FieldError(error_message.str());
     }
+    return this->nb_sub_pts * this->get_nb_buffer_pixels() *
+               this->get_nb_components() +
+           this->pad_size;
+  }
 
-    auto && size{this->nb_sub_pts * this->get_nb_buffer_pixels()};
-    const auto expected_size{size * this->get_nb_components() + this->pad_size};
-    if (this->values.size() != expected_size or
-        static_cast<Index_t>(this->current_nb_entries) != size) {
-      this->current_nb_entries = size;
-      this->values.resize(expected_size);
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  size_t TypedField<T>::get_arena_bytes() const {
+    return this->get_expected_buffer_size() * sizeof(T);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  void TypedField<T>::place_in_arena(void * arena_ptr) {
+    T * arena_values{static_cast<T *>(arena_ptr)};
+    const size_t nb_values{this->get_expected_buffer_size()};
+    // local fields may have been filled before the collection is initialised
+    internal::first_touch(arena_values, nb_values, this->pad_size,
+                          this->values.data(), this->values.size());
+    Values_t{}.swap(this->values);
+    this->arena_values = arena_values;
+    this->nb_arena_values = nb_values;
+    this->current_nb_entries =
+        this->nb_sub_pts * this->get_nb_buffer_pixels();
+    this->set_data_ptr(arena_values);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  bool TypedField<T>::is_in_arena() const {
+    return this->arena_values != nullptr;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  void TypedField<T>::check_not_in_arena(const std::string & operation) const {
+    if (this->is_in_arena()) {
+      std::stringstream error{};
+      error << operation << "(): field '" << this->get_name()
+            << "' is stored in the arena of its collection. Call "
+               "leave_arena() first, which invalidates all pointers to and "
+               "maps of its values";
+      throw FieldError(error.str());
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  void TypedField<T>::leave_arena() {
+    if (this->arena_values == nullptr) {
+      return;
     }
+    this->values.resize(this->nb_arena_values);
+    internal::first_touch(this->values.data(), this->nb_arena_values,
+                          this->pad_size, this->arena_values,
+                          this->nb_arena_values);
+    this->arena_values = nullptr;
+    this->nb_arena_values = 0;
     this->set_data_ptr(this->values.data());
   }
 
   /* ---------------------------------------------------------------------- */
   template <typename T>
   size_t TypedField<T>::get_buffer_size() const {
-    return this->values.size();
+    return this->arena_values == nullptr ? this->values.size()
+                                         : this->nb_arena_values;
   }
 
   /* ---------------------------------------------------------------------- */
@@ -231,6 +618,7 @@ namespace muGrid {
       throw FieldError("This is not a scalar field. push_back an array.");
     }
     const auto & nb_sub{this->get_nb_sub_pts()};
+    this->check_not_in_arena("push_back");
     this->current_nb_entries += nb_sub;
     for (Index_t sub_pt_id{0}; sub_pt_id < nb_sub; ++sub_pt_id) {
       this->values.push_back(value);
@@ -251,6 +639,7 @@ namespace muGrid {
     if (this->nb_components != 1) {
       throw FieldError("This is not a scalar field. push_back an array.");
     }
+    this->check_not_in_arena("push_back_single");
     this->current_nb_entries += 1;
     this->values.push_back(value);
   }
@@ -276,6 +665,7 @@ namespace muGrid {
       throw FieldError(error.str());
     }
     const auto & nb_sub{this->get_nb_sub_pts()};
+    this->check_not_in_arena("push_back");
     this->current_nb_entries += nb_sub;
     for (Index_t sub_pt_id{0}; sub_pt_id < nb_sub; ++sub_pt_id) {
       for (Index_t i{0}; i < this->nb_components; ++i) {
@@ -304,6 +694,7 @@ namespace muGrid {
             << " components.";
       throw FieldError(error.str());
     }
+    this->check_not_in_arena("push_back_single");
     this->current_nb_entries += 1;
     for (Index_t i{0}; i < this->nb_components; ++i) {
       this->values.push_back(value.data()[i]);
@@ -677,8 +1068,8 @@ namespace muGrid {
   /* ---------------------------------------------------------------------- */
   template <typename T>
   void WrappedField<T>::set_zero() {
-    std::fill(static_cast<T *>(this->data_ptr),
-              static_cast<T *>(this->data_ptr) + this->size, T{});
+    internal::first_touch<T>(static_cast<T *>(this->data_ptr), this->size,
+                             this->pad_size, nullptr, 0);
   }
 
   /* ---------------------------------------------------------------------- */
@@ -730,18 +1121,21 @@ namespace muGrid {
   /* ---------------------------------------------------------------------- */
   template class TypedFieldBase<Real>;
   template class TypedFieldBase<Complex>;
+  template class TypedFieldBase<Float>;
   template class TypedFieldBase<Int>;
   template class TypedFieldBase<Uint>;
   template class TypedFieldBase<Index_t>;
 
   template class TypedField<Real>;
   template class TypedField<Complex>;
+  template class TypedField<Float>;
   template class TypedField<Int>;
   template class TypedField<Uint>;
   template class TypedField<Index_t>;
 
   template class WrappedField<Real>;
   template class WrappedField<Complex>;
+  template class WrappedField<Float>;
   template class WrappedField<Int>;
   template class WrappedField<Uint>;
   template class WrappedField<Index_t>;
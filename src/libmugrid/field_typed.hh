@@ -36,8 +36,10 @@
 #ifndef SRC_LIBMUGRID_FIELD_TYPED_HH_
 #define SRC_LIBMUGRID_FIELD_TYPED_HH_
 
+#include "aligned_allocator.hh"
 #include "field.hh"
 #include "field_collection.hh"
+#include "communicator.hh"
 #include "grid_common.hh"
 
 #include "Eigen/Dense"
@@ -53,12 +55,15 @@ namespace muGrid {
   //! forward declaration
   template <typename T>
   class TypedFieldBase;
+  //! forward declaration
+  template <class Derived>
+  class FieldExpression;
 
   template <typename T>
   class TypedFieldBase : public Field {
     static_assert(std::is_scalar<T>::value or std::is_same<T, Complex>::value,
                   "You can only register fields templated with one of the "
-                  "numeric types Real, Complex, Int, or UInt");
+                  "numeric types Real, Complex, Float, Int, or UInt");
 
    protected:
     /**
@@ -161,6 +166,19 @@ namespace muGrid {
     //! subtraction assignment
     TypedFieldBase & operator-=(const TypedFieldBase & other);
 
+    //! evaluate an element-wise expression of fields (see
+    //! `field_expression.hh`) in a single pass
+    template <class Derived>
+    TypedFieldBase & operator=(const FieldExpression<Derived> & expression);
+
+    //! add an element-wise expression of fields in a single pass
+    template <class Derived>
+    TypedFieldBase & operator+=(const FieldExpression<Derived> & expression);
+
+    //! subtract an element-wise expression of fields in a single pass
+    template <class Derived>
+    TypedFieldBase & operator-=(const FieldExpression<Derived> & expression);
+
     //! return type of the stored data
     const std::type_info & get_stored_typeid() const final { return typeid(T); }
 
@@ -247,6 +265,37 @@ namespace muGrid {
      **/
     void * get_void_data_ptr() const final;
 
+    /**
+     * return the alignment in bytes of the data, i.e. the largest power of
+     * two up to `FieldAlignment` that divides its address. Fields owned by a
+     * collection are always aligned to `FieldAlignment`; wrapped fields are
+     * as aligned as the memory they view.
+     */
+    size_t get_alignment() const;
+
+    //! fill the ghost layers from the neighbouring subdomains
+    void communicate_ghosts() final;
+
+    //! start filling the ghost layers (non-blocking)
+    void begin_communicate_ghosts() final;
+
+    //! complete filling the ghost layers
+    void finish_communicate_ghosts() final;
+
+    //! convert the values in place to the given storage order, see `Field`
+    void convert_storage_order(const StorageOrder & storage_order) final;
+
+    //! throws if the conversion to `storage_order` would fail, see `Field`
+    void check_storage_order_conversion(
+        const StorageOrder & storage_order) const final;
+
+    /**
+     * copy the values of this field into `other`, which needs to have the
+     * same shape but may have a different storage order. This is the
+     * out-of-place counterpart of `convert_storage_order`.
+     */
+    void copy_to(TypedFieldBase & other) const;
+
     //! non-const eigen_map with arbitrary sizes
     Eigen_map eigen_map(const Index_t & nb_rows, const Index_t & nb_cols);
     //! const eigen_map with arbitrary sizes
@@ -272,6 +321,23 @@ namespace muGrid {
      * super annoying memory bugs.
      */
     T * data_ptr{};
+
+    //! slab of ghosts received from a neighbour, waiting to be unpacked
+    struct GhostSlab {
+      Index_t buffer_offset;  //!< start of the slab in the receive buffer
+      Index_t field_offset;   //!< start of the slab in the field
+      Shape_t shape;          //!< logical shape of the slab
+    };
+    //! packed values sent to the neighbours during a ghost exchange
+    std::vector<T> ghost_send_buffer{};
+    //! values received from the neighbours during a ghost exchange
+    std::vector<T> ghost_recv_buffer{};
+    //! pending receives of the current ghost exchange
+    std::vector<GhostSlab> ghost_recv_slabs{};
+    //! pending non-blocking operations of the current ghost exchange
+    std::vector<Communicator::Request> ghost_requests{};
+    //! whether a ghost exchange has been started but not finished
+    bool ghost_exchange_pending{false};
   };
 
   /**
@@ -279,7 +345,7 @@ namespace muGrid {
    * type `T` per quadrature point of a `muGrid::FieldCollection`'s domain.
    *
    * @tparam T type of scalar to hold. Must be one of `muGrid::Real`,
-   * `muGrid::Int`, `muGrid::Uint`, `muGrid::Complex`.
+   * `muGrid::Float`, `muGrid::Int`, `muGrid::Uint`, `muGrid::Complex`.
    */
   template <typename T>
   class TypedField : public TypedFieldBase<T> {
@@ -351,6 +417,11 @@ namespace muGrid {
     //! Copy assignment operator
     TypedField & operator=(const EigenRep_t & other);
 
+    //! evaluate an element-wise expression of fields (see
+    //! `field_expression.hh`) in a single pass
+    template <class Derived>
+    TypedField & operator=(const FieldExpression<Derived> & expression);
+
     void set_zero() final;
     void set_pad_size(const size_t & pad_size) final;
 
@@ -381,7 +452,8 @@ namespace muGrid {
      * add a new scalar value at the end of the field (incurs runtime cost, do
      * not use this in any hot loop). If your field has more than one quadrature
      * point per pixel the same scalar value is pushed back on all quadrature
-     * points of the pixel.
+     * points of the pixel. A field stored in the arena of its collection needs
+     * to `leave_arena` first.
      */
     void push_back(const T & value);
 
@@ -390,7 +462,8 @@ namespace muGrid {
      * not use this in any hot loop). Even if you have several quadrature points
      * per pixel you push back only a single value on a single quadrature point.
      * Thus you can push back different values on quadrature points belongign to
-     * the same pixel.
+     * the same pixel. A field stored in the arena of its collection needs to
+     * `leave_arena` first.
      */
     void push_back_single(const T & value);
 
@@ -398,7 +471,8 @@ namespace muGrid {
      * add a new non-scalar value at the end of the field (incurs runtime cost,
      * do not use this in any hot loop) If your field has more than one
      * quadrature point per pixel the same non-scalar value is pushed back on
-     * all quadrature points of the pixel.
+     * all quadrature points of the pixel. A field stored in the arena of its
+     * collection needs to `leave_arena` first.
      */
     void
     push_back(const Eigen::Ref<
@@ -409,7 +483,8 @@ namespace muGrid {
      * do not use this in any hot loop) Even if you have several quadrature
      * points per pixel you push back only a single non-scalar value on a single
      * quadrature point. Thus you can push back different values on quadrature
-     * points belongign to the same pixel.
+     * points belongign to the same pixel. A field stored in the arena of its
+     * collection needs to `leave_arena` first.
      */
     void push_back_single(
         const Eigen::Ref<
@@ -425,10 +500,22 @@ namespace muGrid {
     TypedField & clone(const std::string & new_name,
                        const bool & allow_overwrite = false) const;
 
+    //! aligned storage of the values of the field, which leaves new values
+    //! uninitialised such that they can be first touched in parallel
+    using Values_t = std::vector<T, FirstTouchAllocator<T>>;
+
     /**
-     * return the values of the field
+     * return the storage of the values of the field. Throws a `FieldError`
+     * if the field is stored in the arena of its collection, call
+     * `leave_arena` first in that case
      */
-    std::vector<T> & get_values() { return this->values; }
+    Values_t & get_values() {
+      this->check_not_in_arena("get_values");
+      return this->values;
+    }
+
+    bool is_in_arena() const final;
+    void leave_arena() final;
 
     //! give access to collections
     friend FieldCollection;
@@ -436,8 +523,24 @@ namespace muGrid {
    protected:
     void resize() final;
 
-    //! storage of the raw field data
-    std::vector<T> values{};
+    //! return the number of values the field stores, including padding
+    size_t get_expected_buffer_size() const;
+
+    size_t get_arena_bytes() const final;
+    void place_in_arena(void * arena_ptr) final;
+
+    //! throws a `FieldError` naming `operation` if the field is stored in the
+    //! arena of its collection
+    void check_not_in_arena(const std::string & operation) const;
+
+    //! storage of the raw field data, aligned to `FieldAlignment`
+    Values_t values{};
+
+    //! data in the arena of the collection, if the field is stored there
+    //! rather than in `values`
+    T * arena_values{nullptr};
+    //! number of values stored in the arena
+    size_t nb_arena_values{0};
   };
 
   /**
@@ -511,6 +614,11 @@ namespace muGrid {
     //! Copy assignment operator
     WrappedField & operator=(const Parent & other);
 
+    //! evaluate an element-wise expression of fields (see
+    //! `field_expression.hh`) in a single pass
+    template <class Derived>
+    WrappedField & operator=(const FieldExpression<Derived> & expression);
+
     /**
      * Emulation of a const constructor
      */
@@ -553,6 +661,8 @@ namespace muGrid {
   using RealField = TypedField<Real>;
   //! Alias for complex-valued fields
   using ComplexField = TypedField<Complex>;
+  //! Alias for single-precision real-valued fields
+  using FloatField = TypedField<Float>;
   //! Alias for integer-valued fields
   using IntField = TypedField<Int>;
   //! Alias for unsigned integer-valued fields
@@ -560,6 +670,96 @@ namespace muGrid {
   //! Alias for unsigned integer-valued fields
   using IndexField = TypedField<Index_t>;
 
+  /**
+   * Handle to a field borrowed from the scratch pool of a `FieldCollection`
+   * (see `FieldCollection::borrow_field`). The field goes back to the pool
+   * when the handle is destroyed.
+   */
+  template <typename T>
+  class ScratchField {
+   public:
+    //! Default constructor
+    ScratchField() = delete;
+
+    //! constructor from the pool slot of the lent field
+    ScratchField(FieldCollection & collection, const size_t & slot)
+        : collection{&collection}, slot{slot} {}
+
+    //! Copy constructor
+    ScratchField(const ScratchField & other) = delete;
+
+    //! Move constructor
+    ScratchField(ScratchField && other)
+        : collection{other.collection}, slot{other.slot} {
+      other.collection = nullptr;
+    }
+
+    //! Destructor, returns the field to the pool
+    ~ScratchField() {
+      if (this->collection != nullptr) {
+        this->collection->scratch_fields[this->slot].in_use = false;
+      }
+    }
+
+    //! Copy assignment operator
+    ScratchField & operator=(const ScratchField & other) = delete;
+
+    //! Move assignment operator
+    ScratchField & operator=(ScratchField && other) = delete;
+
+    //! return the borrowed field
+    TypedField<T> & get() const {
+      // static_cast is safe here, as the type is checked when lending
+      return static_cast<TypedField<T> &>(
+          *this->collection->scratch_fields[this->slot].field);
+    }
+
+    //! return the borrowed field
+    TypedField<T> & operator*() const { return this->get(); }
+
+    //! access the borrowed field
+    TypedField<T> * operator->() const { return &this->get(); }
+
+   protected:
+    //! collection holding the scratch pool, `nullptr` once moved from
+    FieldCollection * collection;
+    //! index of the field in the scratch pool
+    size_t slot;
+  };
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  ScratchField<T>
+  FieldCollection::borrow_field(const Index_t & nb_components,
+                                const std::string & sub_division_tag) {
+    if (not this->initialised) {
+      throw FieldCollectionError(
+          "Scratch fields can only be borrowed from initialised collections");
+    }
+    for (size_t slot{0}; slot < this->scratch_fields.size(); ++slot) {
+      auto && scratch{this->scratch_fields[slot]};
+      auto && field{*scratch.field};
+      if (not scratch.in_use and field.get_stored_typeid() == typeid(T) and
+          field.get_nb_components() == nb_components and
+          field.get_sub_division_tag() == sub_division_tag) {
+        // a previous borrower may have converted the field, convert its
+        // values back rather than reinterpreting them
+        if (field.storage_order != StorageOrder::Automatic) {
+          field.convert_storage_order(StorageOrder::Automatic);
+        }
+        scratch.in_use = true;
+        return ScratchField<T>{*this, slot};
+      }
+    }
+    // scratch fields are not registered, so their names need not be unique
+    TypedField<T> * raw_ptr{new TypedField<T>{
+        "scratch field", *this, nb_components, sub_division_tag,
+        Unit::unitless()}};
+    this->scratch_fields.push_back(ScratchSlot{Field_ptr{raw_ptr}, true});
+    raw_ptr->resize();
+    return ScratchField<T>{*this, this->scratch_fields.size() - 1};
+  }
+
   /* ---------------------------------------------------------------------- */
   template <typename T>
   TypedField<T> & FieldCollection::register_field_helper(
@@ -568,7 +768,7 @@ namespace muGrid {
       bool allow_existing) {
     static_assert(std::is_scalar<T>::value or std::is_same<T, Complex>::value,
                   "You can only register fields templated with one of the "
-                  "numeric types Real, Complex, Int, or UInt");
+                  "numeric types Real, Complex, Float, Int, or UInt");
     if (this->field_exists(unique_name)) {
       if (allow_existing) {
         auto & field{*this->fields[unique_name]};
@@ -629,7 +829,7 @@ namespace muGrid {
       bool allow_existing) {
     static_assert(std::is_scalar<T>::value or std::is_same<T, Complex>::value,
                   "You can only register fields templated with one of the "
-                  "numeric types Real, Complex, Int, or UInt");
+                  "numeric types Real, Complex, Float, Int, or UInt");
     if (this->field_exists(unique_name)) {
       if (allow_existing) {
         auto & field{*this->fields[unique_name]};
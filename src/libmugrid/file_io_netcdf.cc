@@ -50,6 +50,13 @@ namespace muGrid {
       : FileIOBase(file_name, open_mode, comm), global_attributes(),
         dimensions(), variables(), nb_sub_pts{{this->pixel, 1}},
         GFC_local_pixels(muGrid::Unknown, nb_sub_pts) {
+#ifndef WITH_MPI
+    if (comm.size() > 1) {
+      throw FileIOError("The serial NetCDF library can't access the file '" +
+                        file_name + "' from " + std::to_string(comm.size()) +
+                        " ranks of a thread group, decomposed I/O needs MPI.");
+    }
+#endif  // not WITH_MPI
     this->open();
   }
 
@@ -468,6 +475,12 @@ namespace muGrid {
       muGrid::GlobalFieldCollection & fc_global,
       const std::vector<std::string> & field_names,
       const std::vector<std::string> & state_field_unique_prefixes) {
+    if (fc_global.has_ghosts()) {
+      throw FileIOError(
+          "Field collections with ghost layers can not be registered for "
+          "NetCDF output. Please copy the fields to a collection without "
+          "ghost layers.");
+    }
     std::vector<std::string> hidden_var_names{
         this->GFC_local_pixels.list_fields()};
 
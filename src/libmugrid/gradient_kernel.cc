@@ -0,0 +1,515 @@
+/**
+ * @file   gradient_kernel.cc
+ *
+ * @author Lars Pastewka <lars.pastewka@imtek.uni-freiburg.de>
+ *
+ * @date   16 Oct 2026
+ *
+ * @brief  implementation of the per-pixel gradient kernels
+ *
+ * Copyright © 2026 Lars Pastewka
+ *
+ * µGrid is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * µGrid is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with µGrid; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * Additional permission under GNU GPL version 3 section 7
+ *
+ * If you modify this Program, or any covered work, by linking or combining it
+ * with proprietary FFT implementations or numerical libraries, containing parts
+ * covered by the terms of those libraries' licenses, the licensors of this
+ * Program grant you additional permission to convey the resulting work.
+ *
+ */
+
+#include "gradient_kernel.hh"
+#include "exception.hh"
+
+#include <sstream>
+#include <type_traits>
+
+namespace muGrid {
+
+  namespace internal {
+
+    /**
+     * sweeps of a kernel over the pixels `begin` to `end` of `table`. The
+     * kernel is passed as its final type, such that the per-pixel calls are
+     * not dispatched virtually.
+     */
+    template <class Kernel, typename T, typename Accumulator_t>
+    void sweep_gradient(const Kernel & kernel,
+                        const CcoordOps::NeighbourTable & table,
+                        const Index_t & begin, const Index_t & end,
+                        const T * nodal_data, T * quad_data,
+                        const Accumulator_t & alpha) {
+      table.for_each(begin, end, [&](const Index_t & pixel,
+                                     const Index_t * neighbours) {
+        kernel.gradient(nodal_data, quad_data, pixel, neighbours, alpha);
+      });
+    }
+
+    /**
+     * scaling factors of the gradient entries of a pixel: `nb_grad` entries,
+     * of which each quadrature point `q` owns `nb_grad / weights.size()`
+     * consecutive ones, all scaled by `alpha * weights[q]`
+     */
+    template <typename Accumulator_t>
+    std::vector<Accumulator_t>
+    quad_point_scales(const Accumulator_t & alpha,
+                      const std::vector<Real> & weights,
+                      const Index_t & nb_grad) {
+      const Index_t nb_weights{static_cast<Index_t>(weights.size())};
+      if (nb_weights == 0 or nb_grad % nb_weights != 0) {
+        std::stringstream err_msg{};
+        err_msg << "Size mismatch: Cannot distribute " << nb_grad
+                << " gradient entries per pixel over " << nb_weights
+                << " quadrature weights";
+        throw RuntimeError{err_msg.str()};
+      }
+      const Index_t nb_entries_per_quad_pt{nb_grad / nb_weights};
+      std::vector<Accumulator_t> scales(nb_grad);
+      for (Index_t g{0}; g < nb_grad; ++g) {
+        scales[g] = alpha * weights[g / nb_entries_per_quad_pt];
+      }
+      return scales;
+    }
+
+    //! see `sweep_gradient`
+    template <class Kernel, typename T, typename Accumulator_t>
+    void sweep_transpose_scatter(const Kernel & kernel,
+                                 const CcoordOps::NeighbourTable & table,
+                                 const Index_t & begin, const Index_t & end,
+                                 const T * quad_data, T * nodal_data,
+                                 const Accumulator_t & alpha,
+                                 const std::vector<Real> & weights,
+                                 const Index_t & nb_grad) {
+      const auto scales{quad_point_scales(alpha, weights, nb_grad)};
+      table.for_each(begin, end, [&](const Index_t & pixel,
+                                     const Index_t * neighbours) {
+        kernel.transpose_scatter(quad_data, nodal_data, pixel, neighbours,
+                                 scales.data());
+      });
+    }
+
+    //! see `sweep_gradient`
+    template <class Kernel, typename T, typename Accumulator_t>
+    void sweep_transpose_gather(const Kernel & kernel,
+                                const CcoordOps::NeighbourTable & table,
+                                const Index_t & begin, const Index_t & end,
+                                const T * quad_data, T * nodal_data,
+                                const Accumulator_t & alpha,
+                                const std::vector<Real> & weights,
+                                const Index_t & nb_grad) {
+      const auto scales{quad_point_scales(alpha, weights, nb_grad)};
+      table.for_each(begin, end, [&](const Index_t & pixel,
+                                     const Index_t * neighbours) {
+        kernel.transpose_gather(quad_data, nodal_data, pixel, neighbours,
+                                scales.data());
+      });
+    }
+
+  }  // namespace internal
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  GradientKernelDynamic<T>::GradientKernelDynamic(
+      const Eigen::MatrixXd & pixel_gradient, const Index_t & spatial_dim,
+      const Index_t & nb_pixelnodal_pts, const Index_t & nb_components)
+      : pixel_gradient{pixel_gradient},
+        nb_neighbours{ipow(2, spatial_dim)},
+        nb_pixelnodal_pts{nb_pixelnodal_pts},
+        nb_grad{pixel_gradient.rows()}, nb_components{nb_components} {
+    if (pixel_gradient.cols() != this->nb_neighbours * nb_pixelnodal_pts) {
+      std::stringstream err_msg{};
+      err_msg << "Size mismatch: Expected a pixel gradient with "
+              << this->nb_neighbours * nb_pixelnodal_pts
+              << " columns, but received one with " << pixel_gradient.cols();
+      throw RuntimeError{err_msg.str()};
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  void GradientKernelDynamic<T>::gradient(const T * nodal_data, T * quad_data,
+                                          const Index_t & pixel,
+                                          const Index_t * neighbours,
+                                          const Accumulator_t & alpha) const {
+    const Index_t nodal_size{this->nb_components * this->nb_pixelnodal_pts};
+    const Index_t quad_size{this->nb_components * this->nb_grad};
+    Eigen::Map<Matrix_t> grad_val{quad_data + pixel * quad_size,
+                                  this->nb_components, this->nb_grad};
+    // without a separate accumulation type, accumulate in place
+    if constexpr (std::is_same<T, Accumulator_t>::value) {
+      for (Index_t k{0}; k < this->nb_neighbours; ++k) {
+        Eigen::Map<const Matrix_t> nodal_vals{
+            nodal_data + neighbours[k] * nodal_size, this->nb_components,
+            this->nb_pixelnodal_pts};
+        auto && B_block{this->pixel_gradient.block(
+            0, k * this->nb_pixelnodal_pts, this->nb_grad,
+            this->nb_pixelnodal_pts)};
+        grad_val += alpha * nodal_vals * B_block.transpose();
+      }
+    } else {
+      AccumulatorMatrix_t grad_acc{grad_val.template cast<Accumulator_t>()};
+      for (Index_t k{0}; k < this->nb_neighbours; ++k) {
+        Eigen::Map<const Matrix_t> nodal_vals{
+            nodal_data + neighbours[k] * nodal_size, this->nb_components,
+            this->nb_pixelnodal_pts};
+        auto && B_block{this->pixel_gradient.block(
+            0, k * this->nb_pixelnodal_pts, this->nb_grad,
+            this->nb_pixelnodal_pts)};
+        grad_acc += alpha * nodal_vals.template cast<Accumulator_t>() *
+                    B_block.transpose();
+      }
+      grad_val = grad_acc.template cast<T>();
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  void GradientKernelDynamic<T>::transpose_scatter(
+      const T * quad_data, T * nodal_data, const Index_t & pixel,
+      const Index_t * neighbours, const Accumulator_t * scales) const {
+    const Index_t nodal_size{this->nb_components * this->nb_pixelnodal_pts};
+    const Index_t quad_size{this->nb_components * this->nb_grad};
+    Eigen::Map<const Matrix_t> grad_val{quad_data + pixel * quad_size,
+                                        this->nb_components, this->nb_grad};
+    Eigen::Map<const Scales_t> grad_scales{scales, this->nb_grad};
+    const AccumulatorMatrix_t grad_acc{grad_val.template cast<Accumulator_t>() *
+                                       grad_scales.asDiagonal()};
+    for (Index_t k{0}; k < this->nb_neighbours; ++k) {
+      Eigen::Map<Matrix_t> nodal_vals{nodal_data + neighbours[k] * nodal_size,
+                                      this->nb_components,
+                                      this->nb_pixelnodal_pts};
+      auto && B_block{this->pixel_gradient.block(
+          0, k * this->nb_pixelnodal_pts, this->nb_grad,
+          this->nb_pixelnodal_pts)};
+      if constexpr (std::is_same<T, Accumulator_t>::value) {
+        nodal_vals += grad_acc * B_block;
+      } else {
+        nodal_vals = (nodal_vals.template cast<Accumulator_t>() +
+                      grad_acc * B_block)
+                         .template cast<T>();
+      }
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  void GradientKernelDynamic<T>::transpose_gather(
+      const T * quad_data, T * nodal_data, const Index_t & pixel,
+      const Index_t * neighbours, const Accumulator_t * scales) const {
+    const Index_t nodal_size{this->nb_components * this->nb_pixelnodal_pts};
+    const Index_t quad_size{this->nb_components * this->nb_grad};
+    Eigen::Map<Matrix_t> nodal_vals{nodal_data + pixel * nodal_size,
+                                    this->nb_components,
+                                    this->nb_pixelnodal_pts};
+    Eigen::Map<const Scales_t> grad_scales{scales, this->nb_grad};
+    // without a separate accumulation type, accumulate in place
+    if constexpr (std::is_same<T, Accumulator_t>::value) {
+      for (Index_t k{0}; k < this->nb_neighbours; ++k) {
+        Eigen::Map<const Matrix_t> grad_val{
+            quad_data + neighbours[k] * quad_size, this->nb_components,
+            this->nb_grad};
+        auto && B_block{this->pixel_gradient.block(
+            0, k * this->nb_pixelnodal_pts, this->nb_grad,
+            this->nb_pixelnodal_pts)};
+        nodal_vals += grad_val * grad_scales.asDiagonal() * B_block;
+      }
+    } else {
+      AccumulatorMatrix_t nodal_acc{
+          nodal_vals.template cast<Accumulator_t>()};
+      for (Index_t k{0}; k < this->nb_neighbours; ++k) {
+        Eigen::Map<const Matrix_t> grad_val{
+            quad_data + neighbours[k] * quad_size, this->nb_components,
+            this->nb_grad};
+        auto && B_block{this->pixel_gradient.block(
+            0, k * this->nb_pixelnodal_pts, this->nb_grad,
+            this->nb_pixelnodal_pts)};
+        nodal_acc += grad_val.template cast<Accumulator_t>() *
+                     grad_scales.asDiagonal() * B_block;
+      }
+      nodal_vals = nodal_acc.template cast<T>();
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  void GradientKernelDynamic<T>::gradient(
+      const CcoordOps::NeighbourTable & table, const Index_t & begin,
+      const Index_t & end, const T * nodal_data, T * quad_data,
+      const Accumulator_t & alpha) const {
+    internal::sweep_gradient(*this, table, begin, end, nodal_data, quad_data,
+                             alpha);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  void GradientKernelDynamic<T>::transpose_scatter(
+      const CcoordOps::NeighbourTable & table, const Index_t & begin,
+      const Index_t & end, const T * quad_data, T * nodal_data,
+      const Accumulator_t & alpha, const std::vector<Real> & weights) const {
+    internal::sweep_transpose_scatter(*this, table, begin, end, quad_data,
+                                      nodal_data, alpha, weights,
+                                      this->nb_grad);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  void GradientKernelDynamic<T>::transpose_gather(
+      const CcoordOps::NeighbourTable & table, const Index_t & begin,
+      const Index_t & end, const T * quad_data, T * nodal_data,
+      const Accumulator_t & alpha, const std::vector<Real> & weights) const {
+    internal::sweep_transpose_gather(*this, table, begin, end, quad_data,
+                                     nodal_data, alpha, weights,
+                                     this->nb_grad);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T, Index_t Dim, Index_t NbQuad, Index_t NbNodal,
+            Index_t NbComp>
+  GradientKernelFixed<T, Dim, NbQuad, NbNodal, NbComp>::GradientKernelFixed(
+      const Eigen::MatrixXd & pixel_gradient) {
+    if (pixel_gradient.rows() != NbGrad or
+        pixel_gradient.cols() != NbNeighbours * NbNodal) {
+      std::stringstream err_msg{};
+      err_msg << "Size mismatch: Expected a " << NbGrad << " × "
+              << NbNeighbours * NbNodal << " pixel gradient, but received a "
+              << pixel_gradient.rows() << " × " << pixel_gradient.cols()
+              << " one";
+      throw RuntimeError{err_msg.str()};
+    }
+    this->pixel_gradient = pixel_gradient;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T, Index_t Dim, Index_t NbQuad, Index_t NbNodal,
+            Index_t NbComp>
+  void GradientKernelFixed<T, Dim, NbQuad, NbNodal, NbComp>::gradient(
+      const T * nodal_data, T * quad_data, const Index_t & pixel,
+      const Index_t * neighbours, const Accumulator_t & alpha) const {
+    Eigen::Map<Quad_t> grad_val{quad_data + pixel * Quad_t::SizeAtCompileTime};
+    QuadAccumulator_t grad_acc{QuadAccumulator_t::Zero()};
+    for (Index_t k{0}; k < NbNeighbours; ++k) {
+      Eigen::Map<const Nodal_t> nodal_vals{
+          nodal_data + neighbours[k] * Nodal_t::SizeAtCompileTime};
+      grad_acc.noalias() +=
+          nodal_vals.template cast<Accumulator_t>() *
+          this->pixel_gradient.template middleCols<NbNodal>(k * NbNodal)
+              .transpose();
+    }
+    grad_val = (grad_val.template cast<Accumulator_t>() + alpha * grad_acc)
+                   .template cast<T>();
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T, Index_t Dim, Index_t NbQuad, Index_t NbNodal,
+            Index_t NbComp>
+  void GradientKernelFixed<T, Dim, NbQuad, NbNodal, NbComp>::transpose_scatter(
+      const T * quad_data, T * nodal_data, const Index_t & pixel,
+      const Index_t * neighbours, const Accumulator_t * scales) const {
+    const QuadAccumulator_t grad_val{
+        Eigen::Map<const Quad_t>{quad_data + pixel * Quad_t::SizeAtCompileTime}
+            .template cast<Accumulator_t>() *
+        Eigen::Map<const Scales_t>{scales}.asDiagonal()};
+    for (Index_t k{0}; k < NbNeighbours; ++k) {
+      Eigen::Map<Nodal_t> nodal_vals{
+          nodal_data + neighbours[k] * Nodal_t::SizeAtCompileTime};
+      const NodalAccumulator_t contribution{
+          grad_val *
+          this->pixel_gradient.template middleCols<NbNodal>(k * NbNodal)};
+      nodal_vals = (nodal_vals.template cast<Accumulator_t>() + contribution)
+                       .template cast<T>();
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T, Index_t Dim, Index_t NbQuad, Index_t NbNodal,
+            Index_t NbComp>
+  void GradientKernelFixed<T, Dim, NbQuad, NbNodal, NbComp>::transpose_gather(
+      const T * quad_data, T * nodal_data, const Index_t & pixel,
+      const Index_t * neighbours, const Accumulator_t * scales) const {
+    Eigen::Map<const Scales_t> grad_scales{scales};
+    NodalAccumulator_t nodal_acc{NodalAccumulator_t::Zero()};
+    for (Index_t k{0}; k < NbNeighbours; ++k) {
+      Eigen::Map<const Quad_t> grad_val{
+          quad_data + neighbours[k] * Quad_t::SizeAtCompileTime};
+      nodal_acc.noalias() +=
+          grad_val.template cast<Accumulator_t>() * grad_scales.asDiagonal() *
+          this->pixel_gradient.template middleCols<NbNodal>(k * NbNodal);
+    }
+    Eigen::Map<Nodal_t> nodal_vals{nodal_data +
+                                   pixel * Nodal_t::SizeAtCompileTime};
+    nodal_vals = (nodal_vals.template cast<Accumulator_t>() + nodal_acc)
+                     .template cast<T>();
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T, Index_t Dim, Index_t NbQuad, Index_t NbNodal,
+            Index_t NbComp>
+  void GradientKernelFixed<T, Dim, NbQuad, NbNodal, NbComp>::gradient(
+      const CcoordOps::NeighbourTable & table, const Index_t & begin,
+      const Index_t & end, const T * nodal_data, T * quad_data,
+      const Accumulator_t & alpha) const {
+    internal::sweep_gradient(*this, table, begin, end, nodal_data, quad_data,
+                             alpha);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T, Index_t Dim, Index_t NbQuad, Index_t NbNodal,
+            Index_t NbComp>
+  void GradientKernelFixed<T, Dim, NbQuad, NbNodal, NbComp>::transpose_scatter(
+      const CcoordOps::NeighbourTable & table, const Index_t & begin,
+      const Index_t & end, const T * quad_data, T * nodal_data,
+      const Accumulator_t & alpha, const std::vector<Real> & weights) const {
+    internal::sweep_transpose_scatter(*this, table, begin, end, quad_data,
+                                      nodal_data, alpha, weights, NbGrad);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T, Index_t Dim, Index_t NbQuad, Index_t NbNodal,
+            Index_t NbComp>
+  void GradientKernelFixed<T, Dim, NbQuad, NbNodal, NbComp>::transpose_gather(
+      const CcoordOps::NeighbourTable & table, const Index_t & begin,
+      const Index_t & end, const T * quad_data, T * nodal_data,
+      const Accumulator_t & alpha, const std::vector<Real> & weights) const {
+    internal::sweep_transpose_gather(*this, table, begin, end, quad_data,
+                                     nodal_data, alpha, weights, NbGrad);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  namespace internal {
+
+    /**
+     * instantiates the fixed-size kernels of a spatial dimension and number
+     * of quadrature points for scalar and vector fields
+     */
+    template <typename T, Index_t Dim, Index_t NbQuad>
+    std::unique_ptr<GradientKernel<T>>
+    make_fixed_kernel(const Eigen::MatrixXd & pixel_gradient,
+                      const Index_t & nb_components) {
+      constexpr Index_t NbNodal{1};
+      switch (nb_components) {
+      case 1: {
+        return std::make_unique<
+            GradientKernelFixed<T, Dim, NbQuad, NbNodal, 1>>(pixel_gradient);
+        break;
+      }
+      case Dim: {
+        return std::make_unique<
+            GradientKernelFixed<T, Dim, NbQuad, NbNodal, Dim>>(pixel_gradient);
+        break;
+      }
+      default:
+        return nullptr;
+        break;
+      }
+    }
+
+  }  // namespace internal
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  std::unique_ptr<GradientKernel<T>>
+  make_gradient_kernel(const Eigen::MatrixXd & pixel_gradient,
+                       const Index_t & spatial_dim, const Index_t & nb_quad_pts,
+                       const Index_t & nb_pixelnodal_pts,
+                       const Index_t & nb_components,
+                       const bool & allow_fixed_size) {
+    std::unique_ptr<GradientKernel<T>> kernel{};
+    if (allow_fixed_size and nb_pixelnodal_pts == 1) {
+      // quadrature points per pixel of linear triangles (2 elements with one
+      // point each), bilinear quadrilaterals (1 or 4 points), linear
+      // tetrahedra (5 or 6 elements with one point each) and trilinear
+      // hexahedra (1 or 8 points)
+      switch (spatial_dim) {
+      case twoD: {
+        switch (nb_quad_pts) {
+        case 1: {
+          kernel = internal::make_fixed_kernel<T, twoD, 1>(pixel_gradient,
+                                                           nb_components);
+          break;
+        }
+        case 2: {
+          kernel = internal::make_fixed_kernel<T, twoD, 2>(pixel_gradient,
+                                                           nb_components);
+          break;
+        }
+        case 4: {
+          kernel = internal::make_fixed_kernel<T, twoD, 4>(pixel_gradient,
+                                                           nb_components);
+          break;
+        }
+        default:
+          break;
+        }
+        break;
+      }
+      case threeD: {
+        switch (nb_quad_pts) {
+        case 1: {
+          kernel = internal::make_fixed_kernel<T, threeD, 1>(pixel_gradient,
+                                                             nb_components);
+          break;
+        }
+        case 5: {
+          kernel = internal::make_fixed_kernel<T, threeD, 5>(pixel_gradient,
+                                                             nb_components);
+          break;
+        }
+        case 6: {
+          kernel = internal::make_fixed_kernel<T, threeD, 6>(pixel_gradient,
+                                                             nb_components);
+          break;
+        }
+        case 8: {
+          kernel = internal::make_fixed_kernel<T, threeD, 8>(pixel_gradient,
+                                                             nb_components);
+          break;
+        }
+        default:
+          break;
+        }
+        break;
+      }
+      default:
+        break;
+      }
+    }
+    if (kernel == nullptr) {
+      kernel = std::make_unique<GradientKernelDynamic<T>>(
+          pixel_gradient, spatial_dim, nb_pixelnodal_pts, nb_components);
+    }
+    return kernel;
+  }
+
+  template class GradientKernelDynamic<Real>;
+  template class GradientKernelDynamic<Complex>;
+  template class GradientKernelDynamic<Float>;
+
+  template std::unique_ptr<GradientKernel<Real>>
+  make_gradient_kernel<Real>(const Eigen::MatrixXd &, const Index_t &,
+                             const Index_t &, const Index_t &,
+                             const Index_t &, const bool &);
+  template std::unique_ptr<GradientKernel<Complex>>
+  make_gradient_kernel<Complex>(const Eigen::MatrixXd &, const Index_t &,
+                                const Index_t &, const Index_t &,
+                                const Index_t &, const bool &);
+  template std::unique_ptr<GradientKernel<Float>>
+  make_gradient_kernel<Float>(const Eigen::MatrixXd &, const Index_t &,
+                              const Index_t &, const Index_t &,
+                              const Index_t &, const bool &);
+
+}  // namespace muGrid
@@ -0,0 +1,311 @@
+/**
+ * @file   gradient_kernel.hh
+ *
+ * @author Lars Pastewka <lars.pastewka@imtek.uni-freiburg.de>
+ *
+ * @date   16 Oct 2026
+ *
+ * @brief  per-pixel kernels of the default gradient operator
+ *
+ * Copyright © 2026 Lars Pastewka
+ *
+ * µGrid is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * µGrid is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with µGrid; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * Additional permission under GNU GPL version 3 section 7
+ *
+ * If you modify this Program, or any covered work, by linking or combining it
+ * with proprietary FFT implementations or numerical libraries, containing parts
+ * covered by the terms of those libraries' licenses, the licensors of this
+ * Program grant you additional permission to convey the resulting work.
+ *
+ */
+
+#ifndef SRC_LIBMUGRID_GRADIENT_KERNEL_HH_
+#define SRC_LIBMUGRID_GRADIENT_KERNEL_HH_
+
+#include "grid_common.hh"
+#include "ccoord_operations.hh"
+
+#include "Eigen/Dense"
+
+#include <memory>
+#include <vector>
+
+namespace muGrid {
+
+  /**
+   * Evaluates the contributions of a single pixel to the gradient and its
+   * transpose for `GradientOperatorDefault`. The kernels work directly on the
+   * (array-of-structures) data of the nodal and quadrature point fields.
+   * Pixels are identified by their storage index and `neighbours` holds the
+   * storage indices of the `2^spatial_dim` pixels of the stencil, ordered
+   * like `CcoordOps::get_cube(spatial_dim, 2)`. The operators evaluate the
+   * kernels through the sweeps over ranges of a `CcoordOps::NeighbourTable`,
+   * such that the (virtual) kernel is only dispatched once per sweep and its
+   * per-pixel evaluation can be inlined.
+   *
+   * @tparam T scalar type of the fields (`Real`, `Complex` or `Float`)
+   */
+  template <typename T>
+  class GradientKernel {
+   public:
+    //! scalar type of the accumulation and of the scaling factors
+    using Accumulator_t = GradientAccumulator_t<T>;
+
+    //! Default constructor
+    GradientKernel() = default;
+
+    //! Copy constructor
+    GradientKernel(const GradientKernel & other) = delete;
+
+    //! Move constructor
+    GradientKernel(GradientKernel && other) = delete;
+
+    //! Destructor
+    virtual ~GradientKernel() = default;
+
+    //! Copy assignment operator
+    GradientKernel & operator=(const GradientKernel & other) = delete;
+
+    //! Move assignment operator
+    GradientKernel & operator=(GradientKernel && other) = delete;
+
+    /**
+     * adds `alpha` times the gradient of the nodal values of the pixels
+     * `base + offset` (given in `neighbours`) to the quadrature point values
+     * of pixel `pixel`
+     */
+    virtual void gradient(const T * nodal_data, T * quad_data,
+                          const Index_t & pixel, const Index_t * neighbours,
+                          const Accumulator_t & alpha) const = 0;
+
+    /**
+     * adds the contributions of the quadrature point values of pixel `pixel`,
+     * with gradient entry `g` scaled by `scales[g]`, to the nodal values of
+     * the pixels `base + offset` (given in `neighbours`)
+     */
+    virtual void transpose_scatter(const T * quad_data, T * nodal_data,
+                                   const Index_t & pixel,
+                                   const Index_t * neighbours,
+                                   const Accumulator_t * scales) const = 0;
+
+    /**
+     * adds the contributions of the quadrature point values of the pixels
+     * `base - offset` (given in `neighbours`), with gradient entry `g` scaled
+     * by `scales[g]`, to the nodal values of pixel `pixel`
+     */
+    virtual void transpose_gather(const T * quad_data, T * nodal_data,
+                                  const Index_t & pixel,
+                                  const Index_t * neighbours,
+                                  const Accumulator_t * scales) const = 0;
+
+    /**
+     * `gradient` of the pixels `begin` to `end` of `table`, whose offsets are
+     * those of the stencil
+     */
+    virtual void gradient(const CcoordOps::NeighbourTable & table,
+                          const Index_t & begin, const Index_t & end,
+                          const T * nodal_data, T * quad_data,
+                          const Accumulator_t & alpha) const = 0;
+
+    /**
+     * `transpose_scatter` of the pixels `begin` to `end` of `table`, whose
+     * offsets are those of the stencil. The gradient entries of quadrature
+     * point `q` of every pixel are scaled by `alpha * weights[q]`.
+     */
+    virtual void transpose_scatter(const CcoordOps::NeighbourTable & table,
+                                   const Index_t & begin, const Index_t & end,
+                                   const T * quad_data, T * nodal_data,
+                                   const Accumulator_t & alpha,
+                                   const std::vector<Real> & weights) const = 0;
+
+    /**
+     * `transpose_gather` of the pixels `begin` to `end` of `table`, whose
+     * offsets are the mirrored ones of the stencil. The gradient entries of
+     * quadrature point `q` of every pixel are scaled by `alpha * weights[q]`.
+     */
+    virtual void transpose_gather(const CcoordOps::NeighbourTable & table,
+                                  const Index_t & begin, const Index_t & end,
+                                  const T * quad_data, T * nodal_data,
+                                  const Accumulator_t & alpha,
+                                  const std::vector<Real> & weights) const = 0;
+  };
+
+  /**
+   * Kernel for any spatial dimension, number of quadrature and nodal points
+   * and number of components
+   */
+  template <typename T>
+  class GradientKernelDynamic final : public GradientKernel<T> {
+   public:
+    using Parent = GradientKernel<T>;  //!< base class
+    //! scalar type of the accumulation and of the scaling factors
+    using Accumulator_t = typename Parent::Accumulator_t;
+    //! matrix of accumulated values
+    using AccumulatorMatrix_t = Eigen::Matrix<Accumulator_t, Eigen::Dynamic,
+                                              Eigen::Dynamic>;
+    //! matrix of stored values
+    using Matrix_t = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>;
+    //! scaling factors of the gradient entries of a pixel
+    using Scales_t = Eigen::Matrix<Accumulator_t, Eigen::Dynamic, 1>;
+
+    //! Default constructor
+    GradientKernelDynamic() = delete;
+
+    /**
+     * constructor
+     *
+     * @param pixel_gradient gradient matrix of
+     * `GradientOperatorDefault::get_pixel_gradient`
+     * @param spatial_dim spatial dimension
+     * @param nb_pixelnodal_pts number of nodal points per pixel
+     * @param nb_components number of components of the nodal field
+     */
+    GradientKernelDynamic(const Eigen::MatrixXd & pixel_gradient,
+                          const Index_t & spatial_dim,
+                          const Index_t & nb_pixelnodal_pts,
+                          const Index_t & nb_components);
+
+    void gradient(const T * nodal_data, T * quad_data, const Index_t & pixel,
+                  const Index_t * neighbours,
+                  const Accumulator_t & alpha) const final;
+
+    void transpose_scatter(const T * quad_data, T * nodal_data,
+                           const Index_t & pixel, const Index_t * neighbours,
+                           const Accumulator_t * scales) const final;
+
+    void transpose_gather(const T * quad_data, T * nodal_data,
+                          const Index_t & pixel, const Index_t * neighbours,
+                          const Accumulator_t * scales) const final;
+
+    void gradient(const CcoordOps::NeighbourTable & table,
+                  const Index_t & begin, const Index_t & end,
+                  const T * nodal_data, T * quad_data,
+                  const Accumulator_t & alpha) const final;
+
+    void transpose_scatter(const CcoordOps::NeighbourTable & table,
+                           const Index_t & begin, const Index_t & end,
+                           const T * quad_data, T * nodal_data,
+                           const Accumulator_t & alpha,
+                           const std::vector<Real> & weights) const final;
+
+    void transpose_gather(const CcoordOps::NeighbourTable & table,
+                          const Index_t & begin, const Index_t & end,
+                          const T * quad_data, T * nodal_data,
+                          const Accumulator_t & alpha,
+                          const std::vector<Real> & weights) const final;
+
+   protected:
+    const Eigen::MatrixXd pixel_gradient;  //!< B-blocks of all neighbours
+    Index_t nb_neighbours;                 //!< 2^spatial_dim
+    Index_t nb_pixelnodal_pts;             //!< nodal points per pixel
+    Index_t nb_grad;                       //!< gradient entries per pixel
+    Index_t nb_components;                 //!< components of the nodal field
+  };
+
+  /**
+   * Kernel with all sizes fixed at compile time, such that the compiler can
+   * unroll the loops over the stencil and the (small) matrix products
+   *
+   * @tparam T scalar type of the fields
+   * @tparam Dim spatial dimension
+   * @tparam NbQuad number of quadrature points per pixel (summed over all
+   * elements of the pixel)
+   * @tparam NbNodal number of nodal points per pixel
+   * @tparam NbComp number of components of the nodal field
+   */
+  template <typename T, Index_t Dim, Index_t NbQuad, Index_t NbNodal,
+            Index_t NbComp>
+  class GradientKernelFixed final : public GradientKernel<T> {
+   public:
+    using Parent = GradientKernel<T>;  //!< base class
+    //! scalar type of the accumulation and of the scaling factors
+    using Accumulator_t = typename Parent::Accumulator_t;
+    //! number of pixels in the stencil
+    constexpr static Index_t NbNeighbours{ipow(2, Dim)};
+    //! number of gradient entries per pixel and component
+    constexpr static Index_t NbGrad{Dim * NbQuad};
+    //! gradient matrix of all neighbours
+    using PixelGradient_t =
+        Eigen::Matrix<Real, NbGrad, NbNeighbours * NbNodal>;
+    //! nodal values of a pixel
+    using Nodal_t = Eigen::Matrix<T, NbComp, NbNodal>;
+    //! quadrature point values of a pixel
+    using Quad_t = Eigen::Matrix<T, NbComp, NbGrad>;
+    //! accumulated nodal values of a pixel
+    using NodalAccumulator_t = Eigen::Matrix<Accumulator_t, NbComp, NbNodal>;
+    //! accumulated quadrature point values of a pixel
+    using QuadAccumulator_t = Eigen::Matrix<Accumulator_t, NbComp, NbGrad>;
+    //! scaling factors of the gradient entries of a pixel
+    using Scales_t = Eigen::Matrix<Accumulator_t, NbGrad, 1>;
+
+    //! Default constructor
+    GradientKernelFixed() = delete;
+
+    //! constructor, see `GradientKernelDynamic`
+    explicit GradientKernelFixed(const Eigen::MatrixXd & pixel_gradient);
+
+    void gradient(const T * nodal_data, T * quad_data, const Index_t & pixel,
+                  const Index_t * neighbours,
+                  const Accumulator_t & alpha) const final;
+
+    void transpose_scatter(const T * quad_data, T * nodal_data,
+                           const Index_t & pixel, const Index_t * neighbours,
+                           const Accumulator_t * scales) const final;
+
+    void transpose_gather(const T * quad_data, T * nodal_data,
+                          const Index_t & pixel, const Index_t * neighbours,
+                          const Accumulator_t * scales) const final;
+
+    void gradient(const CcoordOps::NeighbourTable & table,
+                  const Index_t & begin, const Index_t & end,
+                  const T * nodal_data, T * quad_data,
+                  const Accumulator_t & alpha) const final;
+
+    void transpose_scatter(const CcoordOps::NeighbourTable & table,
+                           const Index_t & begin, const Index_t & end,
+                           const T * quad_data, T * nodal_data,
+                           const Accumulator_t & alpha,
+                           const std::vector<Real> & weights) const final;
+
+    void transpose_gather(const CcoordOps::NeighbourTable & table,
+                          const Index_t & begin, const Index_t & end,
+                          const T * quad_data, T * nodal_data,
+                          const Accumulator_t & alpha,
+                          const std::vector<Real> & weights) const final;
+
+   protected:
+    PixelGradient_t pixel_gradient;  //!< B-blocks of all neighbours
+  };
+
+  /**
+   * returns the fastest kernel for the given sizes: a `GradientKernelFixed`
+   * for the common linear triangle, bilinear quadrilateral, linear
+   * tetrahedron and trilinear hexahedron discretisations of scalar and vector
+   * fields, a `GradientKernelDynamic` otherwise (or if `allow_fixed_size` is
+   * false). Instantiated for `Real`, `Complex` and `Float` fields.
+   */
+  template <typename T>
+  std::unique_ptr<GradientKernel<T>>
+  make_gradient_kernel(const Eigen::MatrixXd & pixel_gradient,
+                       const Index_t & spatial_dim, const Index_t & nb_quad_pts,
+                       const Index_t & nb_pixelnodal_pts,
+                       const Index_t & nb_components,
+                       const bool & allow_fixed_size = true);
+
+}  // namespace muGrid
+
+#endif  // SRC_LIBMUGRID_GRADIENT_KERNEL_HH_
@@ -41,10 +41,42 @@
 #include "iterators.hh"
 #include "exception.hh"
 
+#include <algorithm>
 #include <sstream>
+#include <type_traits>
 
 namespace muGrid {
 
+  /**
+   * offsets of the pixels of the stencil of [ij,i+j,ij+,i+j+] in 2D ..., or
+   * of the opposite ones if `mirrored`
+   */
+  std::vector<DynCcoord_t> get_stencil_offsets(const Index_t & spatial_dim,
+                                               const bool & mirrored) {
+    std::vector<DynCcoord_t> offsets{};
+    for (auto && offset :
+         CcoordOps::DynamicPixels{CcoordOps::get_cube(spatial_dim, 2)}) {
+      offsets.push_back(mirrored ? DynCcoord_t(spatial_dim) - offset
+                                 : offset);
+    }
+    return offsets;
+  }
+
+  //! read-only view of a batch of (possibly already const) fields
+  template <typename Input_t>
+  std::vector<const Input_t *>
+  const_fields(const std::vector<Input_t *> & fields) {
+    return {fields.begin(), fields.end()};
+  }
+
+  //! the batch of fields as untyped fields of the same constness
+  template <typename Input_t>
+  std::vector<std::conditional_t<std::is_const<Input_t>::value, const Field,
+                                 Field> *>
+  untyped_fields(const std::vector<Input_t *> & fields) {
+    return {fields.begin(), fields.end()};
+  }
+
   Eigen::MatrixXd permutation(const Eigen::VectorXi & nodal_indices,
                               const Eigen::MatrixXi & pixel_offsets,
                               const Index_t & nb_pixelnodes) {
@@ -170,75 +202,125 @@ namespace muGrid {
   void GradientOperatorDefault::apply_gradient_increment(
       const TypedFieldBase<Real> & nodal_field, const Real & alpha,
       TypedFieldBase<Real> & quadrature_point_field) const {
-    if (not quadrature_point_field.is_global()) {
-      std::stringstream err_msg{};
-      err_msg << "Field type error: quadrature_point_field must be a global "
-                 "field (registered in a global FieldCollection)";
-      throw RuntimeError{err_msg.str()};
-    }
-    if (not nodal_field.is_global()) {
-      std::stringstream err_msg{};
-      err_msg << "Field type error: nodal_field must be a global "
-                 "field (registered in a global FieldCollection)";
-      throw RuntimeError{err_msg.str()};
-    }
+    this->apply_gradient_increment_batch<Real>({&nodal_field}, alpha,
+                                               {&quadrature_point_field});
+  }
 
-    // number of components in the field we'd like to derive
-    Index_t nb_nodal_component{nodal_field.get_nb_components()};
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  void GradientOperatorDefault::apply_gradient_batch(
+      const std::vector<const TypedFieldBase<T> *> & nodal_fields,
+      const std::vector<TypedFieldBase<T> *> & quadrature_point_fields) const {
+    // check before zeroing the outputs
+    this->make_kernels(nodal_fields, const_fields(quadrature_point_fields));
+    for (auto * quadrature_point_field : quadrature_point_fields) {
+      quadrature_point_field->set_zero();
+    }
+    this->apply_gradient_increment_batch(nodal_fields, 1.,
+                                         quadrature_point_fields);
+  }
 
-    // number of components in the field where we'd like to write the derivative
-    Index_t nb_quad_component{quadrature_point_field.get_nb_components()};
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  void GradientOperatorDefault::apply_gradient_increment_batch(
+      const std::vector<const TypedFieldBase<T> *> & nodal_fields,
+      const GradientAccumulator_t<T> & alpha,
+      const std::vector<TypedFieldBase<T> *> & quadrature_point_fields) const {
+    this->apply_gradient_increment_impl(nodal_fields, alpha,
+                                        quadrature_point_fields, {});
+  }
 
-    // we take a gradient in all directions of every component
-    if (nb_quad_component != this->spatial_dim * nb_nodal_component) {
-      std::stringstream err_msg{};
-      err_msg << "Size mismatch: Expected a vector with "
-              << this->spatial_dim * nb_nodal_component
-              << " entries (number of gradient components in single quad "
-                 "point), but received a "
-                 "vector of size "
-              << nb_quad_component;
-      throw RuntimeError{err_msg.str()};
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  PendingApplication GradientOperatorDefault::begin_apply_gradient(
+      const std::vector<TypedFieldBase<T> *> & nodal_fields,
+      const std::vector<TypedFieldBase<T> *> & quadrature_point_fields) const {
+    // check before zeroing the outputs
+    this->make_kernels(const_fields(nodal_fields),
+                       const_fields(quadrature_point_fields));
+    for (auto * quadrature_point_field : quadrature_point_fields) {
+      quadrature_point_field->set_zero();
     }
+    return this->begin_apply_gradient_increment(nodal_fields, 1.,
+                                                quadrature_point_fields);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  PendingApplication GradientOperatorDefault::begin_apply_gradient_increment(
+      const std::vector<TypedFieldBase<T> *> & nodal_fields,
+      const GradientAccumulator_t<T> & alpha,
+      const std::vector<TypedFieldBase<T> *> & quadrature_point_fields) const {
+    return this->apply_gradient_increment_impl(
+        const_fields(nodal_fields), alpha, quadrature_point_fields,
+        std::vector<Field *>(nodal_fields.begin(), nodal_fields.end()));
+  }
 
-    // nodal field is always represented as a column vector
-    auto nodal_map{nodal_field.get_pixel_map(nb_nodal_component)};
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  PendingApplication GradientOperatorDefault::apply_gradient_increment_impl(
+      const std::vector<const TypedFieldBase<T> *> & nodal_fields,
+      const GradientAccumulator_t<T> & alpha,
+      const std::vector<TypedFieldBase<T> *> & quadrature_point_fields,
+      const std::vector<Field *> & exchanged_fields) const {
     /*
-     * quad field has dim column vectors: each row represents the gradient of
+     * per pixel, the nodal field is represented as a nb_nodal_component ×
+     * nb_pixelnodal_pts matrix and the quad field as a nb_nodal_component ×
+     * nb_grad_component_per_pixel matrix: each row represents the gradient of
      * one component of the nodal field in each direction
      */
-    auto quad_map{quadrature_point_field.get_pixel_map(nb_nodal_component)};
+    // the sweep owns the kernels, as it may be evaluated after returning
+    // (see `begin_apply_gradient`)
+    auto kernels{
+        std::make_shared<std::vector<std::unique_ptr<GradientKernel<T>>>>(
+            this->make_kernels(nodal_fields,
+                               const_fields(quadrature_point_fields)))};
+    std::vector<const T *> nodal_data{};
+    std::vector<T *> quad_data{};
+    for (size_t i{0}; i < kernels->size(); ++i) {
+      nodal_data.push_back(nodal_fields[i]->data());
+      quad_data.push_back(quadrature_point_fields[i]->data());
+    }
 
     auto & collection{dynamic_cast<GlobalFieldCollection &>(
-        quadrature_point_field.get_collection())};
+        quadrature_point_fields.front()->get_collection())};
     auto & pixels{collection.get_pixels()};
-    auto && nb_subdomain_grid_pts{pixels.get_nb_subdomain_grid_pts()};
-
-    CcoordOps::DynamicPixels offsets{CcoordOps::get_cube(this->spatial_dim, 2)};
-    for (auto && id_base_ccoord : pixels.enumerate()) {
-      auto && id{std::get<0>(id_base_ccoord)};
-      auto && base_ccoord{std::get<1>(id_base_ccoord)};
-
-      // get the quadrature point value relative to this pixel
-      auto && grad_val{quad_map[id]};  // [ u_x[q1], u_y[q1], u_x[q2], u_y[q2]]
-
-      for (auto && tup : akantu::enumerate(offsets)) {
-        auto && index{std::get<0>(tup)};
-        auto && offset{std::get<1>(tup)};
-        auto && ccoord{(base_ccoord + offset) % nb_subdomain_grid_pts};
-
-        // get the right chunk of B: This chunk represents the contribution of
-        // the nodal point values in this current offset pixel to the the
-        // gradients of the base pixel
-        auto && B_block{this->pixel_gradient.block(
-            0, index * this->nb_pixelnodal_pts,
-            this->nb_grad_component_per_pixel, this->nb_pixelnodal_pts)};
-        // get the nodal values relative to B-chunk
-        auto && nodal_vals{nodal_map[pixels.get_index(ccoord)]};
-
-        grad_val += alpha * nodal_vals * B_block.transpose();
-      }
+
+    // storage indices of the pixels `base + offset` whose nodal values
+    // contribute to the gradients of the base pixel
+    auto && offsets{get_stencil_offsets(this->spatial_dim, false)};
+
+    // every pixel only writes its own quadrature point values, so the pixels
+    // can be evaluated in any order. Each kernel sweeps over a whole chunk of
+    // pixels, such that it is only dispatched once per chunk and field.
+    Sweep_t sweep{[this, kernels, nodal_data, quad_data,
+                   alpha](const CcoordOps::NeighbourTable & table) {
+      this->for_each_chunk(table, [&](const Index_t & begin,
+                                      const Index_t & end) {
+        for (size_t i{0}; i < kernels->size(); ++i) {
+          (*kernels)[i]->gradient(table, begin, end, nodal_data[i],
+                                  quad_data[i], alpha);
+        }
+      });
+    }};
+
+    if (not collection.has_ghosts()) {
+      sweep(this->get_neighbour_table(pixels, offsets));
+      return finished_application();
     }
+
+    // with ghosts, the neighbours at the right boundary of the subdomain are
+    // in the ghost layers
+    const Index_t dim{this->spatial_dim};
+    const DynCcoord_t nb_left(dim);
+    const DynCcoord_t nb_right{CcoordOps::get_cube(dim, Index_t{1})};
+    if (exchanged_fields.empty()) {
+      this->apply_with_ghosts(untyped_fields(nodal_fields), offsets, nb_left,
+                              nb_right, sweep);
+      return finished_application();
+    }
+    return this->begin_apply_with_ghosts(exchanged_fields, offsets, nb_left,
+                                         nb_right, sweep);
   }
 
   /* ---------------------------------------------------------------------- */
@@ -257,84 +339,288 @@ namespace muGrid {
       const TypedFieldBase<Real> & quadrature_point_field, const Real & alpha,
       TypedFieldBase<Real> & nodal_field,
       const std::vector<Real> & weights) const {
-    auto && nb_pixel_quad_pts{this->get_nb_pixel_quad_pts()};
-    std::vector<Real> use_weights{};
-    bool default_weights{weights.size() == 0};
-    if (default_weights) {
-      use_weights.resize(nb_pixel_quad_pts, 1.);
+    this->apply_transpose_increment_batch<Real>({&quadrature_point_field},
+                                                alpha, {&nodal_field},
+                                                weights);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  void GradientOperatorDefault::apply_transpose_batch(
+      const std::vector<const TypedFieldBase<T> *> & quadrature_point_fields,
+      const std::vector<TypedFieldBase<T> *> & nodal_fields,
+      const std::vector<Real> & weights) const {
+    // check before zeroing the outputs
+    this->make_kernels(const_fields(nodal_fields), quadrature_point_fields);
+    for (auto * nodal_field : nodal_fields) {
+      nodal_field->set_zero();
     }
-    const auto & quad_weights{default_weights ? use_weights : weights};
-    // check quadrature point field type == global
-    if (not quadrature_point_field.is_global()) {
-      std::stringstream err_msg{};
-      err_msg << "Field type error: quadrature_point_field must be a global "
-                 "field (registered in a global FieldCollection)";
-      throw RuntimeError{err_msg.str()};
+    this->apply_transpose_increment_batch(quadrature_point_fields, 1.,
+                                          nodal_fields, weights);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  void GradientOperatorDefault::apply_transpose_increment_batch(
+      const std::vector<const TypedFieldBase<T> *> & quadrature_point_fields,
+      const GradientAccumulator_t<T> & alpha,
+      const std::vector<TypedFieldBase<T> *> & nodal_fields,
+      const std::vector<Real> & weights) const {
+    this->apply_transpose_increment_impl(quadrature_point_fields, alpha,
+                                         nodal_fields, weights, {});
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  PendingApplication GradientOperatorDefault::begin_apply_transpose(
+      const std::vector<TypedFieldBase<T> *> & quadrature_point_fields,
+      const std::vector<TypedFieldBase<T> *> & nodal_fields,
+      const std::vector<Real> & weights) const {
+    // check before zeroing the outputs
+    this->make_kernels(const_fields(nodal_fields),
+                       const_fields(quadrature_point_fields));
+    for (auto * nodal_field : nodal_fields) {
+      nodal_field->set_zero();
     }
-    // check nodal field type == global
-    if (not nodal_field.is_global()) {
+    return this->begin_apply_transpose_increment(quadrature_point_fields, 1.,
+                                                 nodal_fields, weights);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  PendingApplication GradientOperatorDefault::begin_apply_transpose_increment(
+      const std::vector<TypedFieldBase<T> *> & quadrature_point_fields,
+      const GradientAccumulator_t<T> & alpha,
+      const std::vector<TypedFieldBase<T> *> & nodal_fields,
+      const std::vector<Real> & weights) const {
+    return this->apply_transpose_increment_impl(
+        const_fields(quadrature_point_fields), alpha, nodal_fields, weights,
+        std::vector<Field *>(quadrature_point_fields.begin(),
+                             quadrature_point_fields.end()));
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  PendingApplication GradientOperatorDefault::apply_transpose_increment_impl(
+      const std::vector<const TypedFieldBase<T> *> & quadrature_point_fields,
+      const GradientAccumulator_t<T> & alpha,
+      const std::vector<TypedFieldBase<T> *> & nodal_fields,
+      const std::vector<Real> & weights,
+      const std::vector<Field *> & exchanged_fields) const {
+    auto && nb_pixel_quad_pts{this->get_nb_pixel_quad_pts()};
+    if (weights.size() != 0 and
+        static_cast<Index_t>(weights.size()) != nb_pixel_quad_pts) {
       std::stringstream err_msg{};
-      err_msg << "Field type error: nodal_field must be a global "
-                 "field (registered in a global FieldCollection)";
+      err_msg << "Size mismatch: Expected " << nb_pixel_quad_pts
+              << " weights (one per quadrature point), but received "
+              << weights.size();
       throw RuntimeError{err_msg.str()};
     }
+    const std::vector<Real> quad_weights{
+        weights.size() == 0 ? std::vector<Real>(nb_pixel_quad_pts, 1.)
+                            : weights};
+
+    // the sweep owns the kernels, see `apply_gradient_increment_impl`
+    auto kernels{
+        std::make_shared<std::vector<std::unique_ptr<GradientKernel<T>>>>(
+            this->make_kernels(const_fields(nodal_fields),
+                               quadrature_point_fields))};
+    const Index_t nb_fields{static_cast<Index_t>(kernels->size())};
+    std::vector<const T *> quad_data{};
+    std::vector<T *> nodal_data{};
+    for (Index_t i{0}; i < nb_fields; ++i) {
+      quad_data.push_back(quadrature_point_fields[i]->data());
+      nodal_data.push_back(nodal_fields[i]->data());
+    }
 
-    // number of components in the gradient field
-    Index_t nb_quad_component{quadrature_point_field.get_nb_components()};
-
-    // number of components in the nodal field
-    Index_t nb_nodal_component{nodal_field.get_nb_components()};
+    auto & collection{dynamic_cast<const GlobalFieldCollection &>(
+        quadrature_point_fields.front()->get_collection())};
+    auto & pixels{collection.get_pixels()};
+    auto && nb_grid_pts{collection.get_nb_subdomain_grid_pts()};
+
+    // gather the contributions of the pixels `base - offset` sharing the
+    // nodal points of the base pixel, such that every nodal point is only
+    // written once
+    Sweep_t gather{[this, kernels, quad_data, nodal_data, alpha,
+                    quad_weights](const CcoordOps::NeighbourTable & table) {
+      this->for_each_chunk(table, [&](const Index_t & begin,
+                                      const Index_t & end) {
+        for (size_t i{0}; i < kernels->size(); ++i) {
+          (*kernels)[i]->transpose_gather(table, begin, end, quad_data[i],
+                                          nodal_data[i], alpha, quad_weights);
+        }
+      });
+    }};
 
-    if (nb_quad_component != this->spatial_dim * nb_nodal_component) {
-      std::stringstream err_msg{};
-      err_msg << "Size mismatch: Expected a vector with "
-              << this->spatial_dim * nb_nodal_component
-              << " entries (number of gradient components in single quad "
-                 "point), but received a "
-                 "vector of size "
-              << nb_quad_component;
-      throw RuntimeError{err_msg.str()};
+    if (collection.has_ghosts()) {
+      // the quadrature point values of the left neighbouring pixels are in the
+      // ghosts. A scatter would write to the ghosts, hence always gather.
+      const Index_t dim{this->spatial_dim};
+      auto && offsets{get_stencil_offsets(dim, true)};
+      const DynCcoord_t nb_left{CcoordOps::get_cube(dim, Index_t{1})};
+      const DynCcoord_t nb_right(dim);
+      if (exchanged_fields.empty()) {
+        this->apply_with_ghosts(untyped_fields(quadrature_point_fields),
+                                offsets, nb_left, nb_right, gather);
+        return finished_application();
+      }
+      return this->begin_apply_with_ghosts(exchanged_fields, offsets, nb_left,
+                                           nb_right, gather);
     }
 
-    auto nodal_map{nodal_field.get_pixel_map(nb_nodal_component)};
-    auto quad_map{quadrature_point_field.get_pixel_map(nb_nodal_component)};
+    if (this->transpose_algorithm == TransposeAlgorithm::Gather) {
+      gather(this->get_neighbour_table(
+          pixels, get_stencil_offsets(this->spatial_dim, true)));
+      return finished_application();
+    }
 
-    auto & collection{dynamic_cast<GlobalFieldCollection &>(
-        quadrature_point_field.get_collection())};
-    auto & pixels{collection.get_pixels()};
-    auto && nb_subdomain_grid_pts{pixels.get_nb_subdomain_grid_pts()};
+    // scatter the contributions of the base pixel to the nodal points of
+    // all its corners, the pixels `base + offset`
+    auto && table{this->get_neighbour_table(
+        pixels, get_stencil_offsets(this->spatial_dim, false))};
+    auto && scatter{[&](const Index_t & begin, const Index_t & end) {
+      for (Index_t i{0}; i < nb_fields; ++i) {
+        (*kernels)[i]->transpose_scatter(table, begin, end, quad_data[i],
+                                      nodal_data[i], alpha, quad_weights);
+      }
+    }};
 
-    // pixel index offsets for whole stencil of [ij,i+j,ij+,i+j+] in 2D  ...
-    CcoordOps::DynamicPixels offsets{CcoordOps::get_cube(this->spatial_dim, 2)};
+    const Index_t nb_planes{nb_grid_pts[this->spatial_dim - 1]};
+    if (this->thread_pool == nullptr or nb_planes < 2) {
+      scatter(0, table.size());
+      return finished_application();
+    }
 
-    // loop over pixels
-    for (auto && id_base_ccoord : pixels.enumerate()) {
-      auto && id{std::get<0>(id_base_ccoord)};  // linear index of pixel
-      auto && base_ccoord{
-          std::get<1>(id_base_ccoord)};  // ijk spatial coords of pixel
+    // The scatter writes to the base pixel's plane and the next one along the
+    // last direction. Split the planes into an even number of slabs of at
+    // least one plane. Slabs of the same parity never write to the same
+    // plane (not even across the periodic boundary), so all even slabs are
+    // processed in parallel, followed by all odd ones. The split only depends
+    // on the number of threads, so the result is reproducible.
+    const Index_t nb_slabs{
+        2 * std::min(this->thread_pool->get_nb_threads(), nb_planes / 2)};
+    const Index_t nb_pixels_per_plane{table.size() / nb_planes};
+    for (Index_t parity{0}; parity < 2; ++parity) {
+      this->thread_pool->run([&](const Index_t & thread_id) {
+        const Index_t slab{2 * thread_id + parity};
+        if (slab >= nb_slabs) {
+          return;
+        }
+        auto && planes{ThreadPool::get_chunk(0, nb_planes, nb_slabs, slab)};
+        scatter(std::get<0>(planes) * nb_pixels_per_plane,
+                std::get<1>(planes) * nb_pixels_per_plane);
+      });
+    }
+    return finished_application();
+  }
 
-      // get the quadrature point value relative to this pixel
-      auto && grad_val{quad_map[id] * quad_weights[id % nb_pixel_quad_pts]};
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  std::vector<std::unique_ptr<GradientKernel<T>>>
+  GradientOperatorDefault::make_kernels(
+      const std::vector<const TypedFieldBase<T> *> & nodal_fields,
+      const std::vector<const TypedFieldBase<T> *> & quadrature_point_fields)
+      const {
+    if (nodal_fields.size() != quadrature_point_fields.size() or
+        nodal_fields.size() == 0) {
+      std::stringstream err_msg{};
+      err_msg << "Size mismatch: Expected one quadrature point field per "
+                 "nodal field, but received "
+              << nodal_fields.size() << " nodal and "
+              << quadrature_point_fields.size() << " quadrature point fields";
+      throw RuntimeError{err_msg.str()};
+    }
+    std::vector<std::unique_ptr<GradientKernel<T>>> kernels{};
+    for (size_t i{0}; i < nodal_fields.size(); ++i) {
+      auto * nodal_field{nodal_fields[i]};
+      auto * quadrature_point_field{quadrature_point_fields[i]};
+      if (nodal_field == nullptr or quadrature_point_field == nullptr) {
+        throw RuntimeError("The batch of fields contains a null pointer");
+      }
+      // check quadrature point field type == global
+      if (not quadrature_point_field->is_global()) {
+        std::stringstream err_msg{};
+        err_msg << "Field type error: quadrature_point_field must be a "
+                   "global field (registered in a global FieldCollection)";
+        throw RuntimeError{err_msg.str()};
+      }
+      // check nodal field type == global
+      if (not nodal_field->is_global()) {
+        std::stringstream err_msg{};
+        err_msg << "Field type error: nodal_field must be a global "
+                   "field (registered in a global FieldCollection)";
+        throw RuntimeError{err_msg.str()};
+      }
+      // all fields of a batch are evaluated with the same neighbour tables
+      if (&nodal_field->get_collection() !=
+              &nodal_fields.front()->get_collection() or
+          &quadrature_point_field->get_collection() !=
+              &quadrature_point_fields.front()->get_collection()) {
+        std::stringstream err_msg{};
+        err_msg << "All nodal fields and all quadrature point fields of a "
+                   "batch must live in the same collection, but fields '"
+                << nodal_field->get_name() << "' and '"
+                << quadrature_point_field->get_name() << "' do not";
+        throw RuntimeError{err_msg.str()};
+      }
 
-      // loop over offsets
-      for (auto && tup : akantu::enumerate(offsets)) {
-        auto && index{std::get<0>(tup)};
-        auto && offset{std::get<1>(tup)};
-        auto && ccoord{(base_ccoord + offset) % nb_subdomain_grid_pts};
+      // number of components in the field we'd like to derive
+      Index_t nb_nodal_component{nodal_field->get_nb_components()};
 
-        // get the right chunk of B: This chunk represents the contribution of
-        // the gradients of the base pixel to the
-        // in this current offset pixel nodal point values
-        auto && B_block{this->pixel_gradient.block(
-            0, index * this->nb_pixelnodal_pts,
-            this->nb_grad_component_per_pixel, this->nb_pixelnodal_pts)};
+      // number of components in the field where we'd like to write the
+      // derivative
+      Index_t nb_quad_component{quadrature_point_field->get_nb_components()};
 
-        // get the nodal values relative to B-chunk
-        auto && nodal_vals{nodal_map[pixels.get_index(ccoord)]};
+      // we take a gradient in all directions of every component
+      if (nb_quad_component != this->spatial_dim * nb_nodal_component) {
+        std::stringstream err_msg{};
+        err_msg << "Size mismatch: Expected a vector with "
+                << this->spatial_dim * nb_nodal_component
+                << " entries (number of gradient components in single quad "
+                   "point), but received a "
+                   "vector of size "
+                << nb_quad_component;
+        throw RuntimeError{err_msg.str()};
+      }
+      kernels.push_back(
+          this->make_kernel(*nodal_field, *quadrature_point_field));
+    }
+    return kernels;
+  }
 
-        nodal_vals += alpha * grad_val * B_block;
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  std::unique_ptr<GradientKernel<T>> GradientOperatorDefault::make_kernel(
+      const TypedFieldBase<T> & nodal_field,
+      const TypedFieldBase<T> & quadrature_point_field) const {
+    for (auto * field : {&nodal_field, &quadrature_point_field}) {
+      if (field->get_storage_order() != StorageOrder::ArrayOfStructures) {
+        std::stringstream err_msg{};
+        err_msg << "The gradient operator requires array-of-structures "
+                   "storage order, but the storage order of field '"
+                << field->get_name() << "' is " << field->get_storage_order();
+        throw RuntimeError{err_msg.str()};
       }
     }
+    const Index_t nb_components{nodal_field.get_nb_components()};
+    if (nodal_field.get_nb_dof_per_pixel() !=
+            nb_components * this->nb_pixelnodal_pts or
+        quadrature_point_field.get_nb_dof_per_pixel() !=
+            nb_components * this->nb_grad_component_per_pixel) {
+      std::stringstream err_msg{};
+      err_msg << "Size mismatch: Expected " << this->nb_pixelnodal_pts
+              << " nodal and " << this->get_nb_pixel_quad_pts()
+              << " quadrature points per pixel, but the nodal field stores "
+              << nodal_field.get_nb_dof_per_pixel()
+              << " and the quadrature point field "
+              << quadrature_point_field.get_nb_dof_per_pixel()
+              << " entries per pixel for " << nb_components
+              << " nodal components";
+      throw RuntimeError{err_msg.str()};
+    }
+    return make_gradient_kernel<T>(
+        this->pixel_gradient, this->spatial_dim, this->get_nb_pixel_quad_pts(),
+        this->nb_pixelnodal_pts, nb_components, this->use_fixed_size_kernels);
   }
 
   /* ---------------------------------------------------------------------- */
@@ -367,4 +653,124 @@ namespace muGrid {
     return this->nb_elements;
   }
 
+  /* ---------------------------------------------------------------------- */
+  void GradientOperatorDefault::set_fixed_size_kernels(const bool & enable) {
+    this->use_fixed_size_kernels = enable;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  const bool & GradientOperatorDefault::get_fixed_size_kernels() const {
+    return this->use_fixed_size_kernels;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void GradientOperatorDefault::set_transpose_algorithm(
+      const TransposeAlgorithm & algorithm) {
+    this->transpose_algorithm = algorithm;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  const TransposeAlgorithm &
+  GradientOperatorDefault::get_transpose_algorithm() const {
+    return this->transpose_algorithm;
+  }
+
+  template void GradientOperatorDefault::apply_gradient_batch(
+      const std::vector<const TypedFieldBase<Real> *> &,
+      const std::vector<TypedFieldBase<Real> *> &) const;
+  template void GradientOperatorDefault::apply_gradient_batch(
+      const std::vector<const TypedFieldBase<Complex> *> &,
+      const std::vector<TypedFieldBase<Complex> *> &) const;
+  template void GradientOperatorDefault::apply_gradient_batch(
+      const std::vector<const TypedFieldBase<Float> *> &,
+      const std::vector<TypedFieldBase<Float> *> &) const;
+
+  template void GradientOperatorDefault::apply_gradient_increment_batch(
+      const std::vector<const TypedFieldBase<Real> *> &, const Real &,
+      const std::vector<TypedFieldBase<Real> *> &) const;
+  template void GradientOperatorDefault::apply_gradient_increment_batch(
+      const std::vector<const TypedFieldBase<Complex> *> &, const Complex &,
+      const std::vector<TypedFieldBase<Complex> *> &) const;
+  template void GradientOperatorDefault::apply_gradient_increment_batch(
+      const std::vector<const TypedFieldBase<Float> *> &, const Real &,
+      const std::vector<TypedFieldBase<Float> *> &) const;
+
+  template void GradientOperatorDefault::apply_transpose_batch(
+      const std::vector<const TypedFieldBase<Real> *> &,
+      const std::vector<TypedFieldBase<Real> *> &,
+      const std::vector<Real> &) const;
+  template void GradientOperatorDefault::apply_transpose_batch(
+      const std::vector<const TypedFieldBase<Complex> *> &,
+      const std::vector<TypedFieldBase<Complex> *> &,
+      const std::vector<Real> &) const;
+  template void GradientOperatorDefault::apply_transpose_batch(
+      const std::vector<const TypedFieldBase<Float> *> &,
+      const std::vector<TypedFieldBase<Float> *> &,
+      const std::vector<Real> &) const;
+
+  template void GradientOperatorDefault::apply_transpose_increment_batch(
+      const std::vector<const TypedFieldBase<Real> *> &, const Real &,
+      const std::vector<TypedFieldBase<Real> *> &,
+      const std::vector<Real> &) const;
+  template void GradientOperatorDefault::apply_transpose_increment_batch(
+      const std::vector<const TypedFieldBase<Complex> *> &, const Complex &,
+      const std::vector<TypedFieldBase<Complex> *> &,
+      const std::vector<Real> &) const;
+  template void GradientOperatorDefault::apply_transpose_increment_batch(
+      const std::vector<const TypedFieldBase<Float> *> &, const Real &,
+      const std::vector<TypedFieldBase<Float> *> &,
+      const std::vector<Real> &) const;
+
+  template PendingApplication GradientOperatorDefault::begin_apply_gradient(
+      const std::vector<TypedFieldBase<Real> *> &,
+      const std::vector<TypedFieldBase<Real> *> &) const;
+  template PendingApplication GradientOperatorDefault::begin_apply_gradient(
+      const std::vector<TypedFieldBase<Complex> *> &,
+      const std::vector<TypedFieldBase<Complex> *> &) const;
+  template PendingApplication GradientOperatorDefault::begin_apply_gradient(
+      const std::vector<TypedFieldBase<Float> *> &,
+      const std::vector<TypedFieldBase<Float> *> &) const;
+
+  template PendingApplication
+  GradientOperatorDefault::begin_apply_gradient_increment(
+      const std::vector<TypedFieldBase<Real> *> &, const Real &,
+      const std::vector<TypedFieldBase<Real> *> &) const;
+  template PendingApplication
+  GradientOperatorDefault::begin_apply_gradient_increment(
+      const std::vector<TypedFieldBase<Complex> *> &, const Complex &,
+      const std::vector<TypedFieldBase<Complex> *> &) const;
+  template PendingApplication
+  GradientOperatorDefault::begin_apply_gradient_increment(
+      const std::vector<TypedFieldBase<Float> *> &, const Real &,
+      const std::vector<TypedFieldBase<Float> *> &) const;
+
+  template PendingApplication GradientOperatorDefault::begin_apply_transpose(
+      const std::vector<TypedFieldBase<Real> *> &,
+      const std::vector<TypedFieldBase<Real> *> &,
+      const std::vector<Real> &) const;
+  template PendingApplication GradientOperatorDefault::begin_apply_transpose(
+      const std::vector<TypedFieldBase<Complex> *> &,
+      const std::vector<TypedFieldBase<Complex> *> &,
+      const std::vector<Real> &) const;
+  template PendingApplication GradientOperatorDefault::begin_apply_transpose(
+      const std::vector<TypedFieldBase<Float> *> &,
+      const std::vector<TypedFieldBase<Float> *> &,
+      const std::vector<Real> &) const;
+
+  template PendingApplication
+  GradientOperatorDefault::begin_apply_transpose_increment(
+      const std::vector<TypedFieldBase<Real> *> &, const Real &,
+      const std::vector<TypedFieldBase<Real> *> &,
+      const std::vector<Real> &) const;
+  template PendingApplication
+  GradientOperatorDefault::begin_apply_transpose_increment(
+      const std::vector<TypedFieldBase<Complex> *> &, const Complex &,
+      const std::vector<TypedFieldBase<Complex> *> &,
+      const std::vector<Real> &) const;
+  template PendingApplication
+  GradientOperatorDefault::begin_apply_transpose_increment(
+      const std::vector<TypedFieldBase<Float> *> &, const Real &,
+      const std::vector<TypedFieldBase<Float> *> &,
+      const std::vector<Real> &) const;
+
 }  // namespace muGrid
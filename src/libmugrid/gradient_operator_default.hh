@@ -35,10 +35,12 @@
  *
  */
 
-#include "gradient_operator_base.hh"
+#include "stencil_operator_base.hh"
+#include "gradient_kernel.hh"
 
 #include "Eigen/Dense"
 
+#include <memory>
 #include <vector>
 
 #ifndef SRC_LIBMUGRID_GRADIENT_OPERATOR_DEFAULT_HH_
@@ -46,9 +48,27 @@
 
 namespace muGrid {
 
-  class GradientOperatorDefault : public GradientOperatorBase {
+  /**
+   * How `GradientOperatorDefault` evaluates the transpose on periodic
+   * subdomains. Both give the same result up to round-off.
+   */
+  enum class TransposeAlgorithm {
+    /**
+     * loop over the quadrature point pixels and add their contributions to
+     * the nodal points of all their corners
+     */
+    Scatter,
+    /**
+     * loop over the nodal point pixels and collect the contributions of all
+     * quadrature point pixels touching them. Every nodal point is written
+     * only once, hence the pixels are independent.
+     */
+    Gather
+  };
+
+  class GradientOperatorDefault : public StencilOperatorBase {
    public:
-    using Parent = GradientOperatorBase;
+    using Parent = StencilOperatorBase;
     //! Default constructor
     GradientOperatorDefault() = delete;
 
@@ -94,6 +114,13 @@ namespace muGrid {
     /**
      * Evaluates the gradient of nodal_field into quadrature_point_field
      *
+     * If the fields live in a collection with ghost layers, the gradient is
+     * only evaluated on the pixels of the subdomain (not in the ghosts) and
+     * the neighbouring nodal values are read from the right ghost layers.
+     * The caller fills these ghosts (see `Field::communicate_ghosts`), or
+     * lets `begin_apply_gradient` fill them while the interior is evaluated.
+     * Otherwise, the subdomain is treated as periodic.
+     *
      * @param nodal_field input field of which to take gradient. Defined on
      * nodal points
      * @param quadrature_point_field output field to write gradient into.
@@ -121,6 +148,13 @@ namespace muGrid {
      * nodal_field,  weights corrensponds to Gaussian quadrature weights. If
      * weights are omitted, this returns some scaled version of discretised
      * divergence.
+     *
+     * If the fields live in a collection with ghost layers, the divergence
+     * is only evaluated on the nodal points of the subdomain and the
+     * contributions of the left neighbouring quadrature points are read from
+     * the left ghost layers. The caller fills these ghosts, or lets
+     * `begin_apply_transpose` fill them while the interior is evaluated.
+     * Otherwise, the subdomain is treated as periodic.
      * @param quadrature_point_field input field of which to take
      * the divergence. Defined on quadrature points.
      * @param nodal_field ouput field into which divergence is written
@@ -145,6 +179,126 @@ namespace muGrid {
         TypedFieldBase<Real> & nodal_field,
         const std::vector<Real> & weights = {}) const final;
 
+    /**
+     * Evaluates the gradient of a `Complex` or single-precision (`Float`)
+     * nodal field into a quadrature point field of the same type, see the
+     * `Real` overload. Single-precision values are accumulated in double
+     * precision and only rounded when stored.
+     */
+    template <typename T>
+    void apply_gradient(const TypedFieldBase<T> & nodal_field,
+                        TypedFieldBase<T> & quadrature_point_field) const;
+
+    //! `apply_gradient_increment` for `Complex` and `Float` fields
+    template <typename T>
+    void
+    apply_gradient_increment(const TypedFieldBase<T> & nodal_field,
+                             const GradientAccumulator_t<T> & alpha,
+                             TypedFieldBase<T> & quadrature_point_field) const;
+
+    //! `apply_transpose` for `Complex` and `Float` fields
+    template <typename T>
+    void apply_transpose(const TypedFieldBase<T> & quadrature_point_field,
+                         TypedFieldBase<T> & nodal_field,
+                         const std::vector<Real> & weights = {}) const;
+
+    //! `apply_transpose_increment` for `Complex` and `Float` fields
+    template <typename T>
+    void
+    apply_transpose_increment(const TypedFieldBase<T> & quadrature_point_field,
+                              const GradientAccumulator_t<T> & alpha,
+                              TypedFieldBase<T> & nodal_field,
+                              const std::vector<Real> & weights = {}) const;
+
+    /**
+     * Evaluates the gradients of a batch of nodal fields into the
+     * corresponding quadrature point fields in a single sweep over the
+     * pixels. The neighbour indices and the pixel gradient are loaded once
+     * per pixel for the whole batch. All nodal fields, and all quadrature
+     * point fields, must live in the same collection. With ghost layers, the
+     * caller fills the ghosts of the nodal fields, see `apply_gradient`.
+     *
+     * @param nodal_fields input fields of which to take gradients
+     * @param quadrature_point_fields output fields to write the gradients
+     * into, one per nodal field
+     */
+    template <typename T>
+    void apply_gradient_batch(
+        const std::vector<const TypedFieldBase<T> *> & nodal_fields,
+        const std::vector<TypedFieldBase<T> *> & quadrature_point_fields)
+        const;
+
+    //! batched form of `apply_gradient_increment`, see `apply_gradient_batch`
+    template <typename T>
+    void apply_gradient_increment_batch(
+        const std::vector<const TypedFieldBase<T> *> & nodal_fields,
+        const GradientAccumulator_t<T> & alpha,
+        const std::vector<TypedFieldBase<T> *> & quadrature_point_fields)
+        const;
+
+    /**
+     * Evaluates the discretised divergences of a batch of quadrature point
+     * fields into the corresponding nodal fields in a single sweep over the
+     * pixels, see `apply_transpose` and `apply_gradient_batch`. The same
+     * weights apply to all fields, and the caller fills the ghosts of the
+     * quadrature point fields.
+     */
+    template <typename T>
+    void apply_transpose_batch(
+        const std::vector<const TypedFieldBase<T> *> & quadrature_point_fields,
+        const std::vector<TypedFieldBase<T> *> & nodal_fields,
+        const std::vector<Real> & weights = {}) const;
+
+    //! batched form of `apply_transpose_increment`, see
+    //! `apply_transpose_batch`
+    template <typename T>
+    void apply_transpose_increment_batch(
+        const std::vector<const TypedFieldBase<T> *> & quadrature_point_fields,
+        const GradientAccumulator_t<T> & alpha,
+        const std::vector<TypedFieldBase<T> *> & nodal_fields,
+        const std::vector<Real> & weights = {}) const;
+
+    /**
+     * Begins `apply_gradient_batch` on fields with ghost layers: starts
+     * filling the ghosts of all nodal fields, evaluates the pixels that do
+     * not read from the ghosts while the messages are in flight and returns
+     * the evaluation of the remaining shell of pixels as a pending
+     * application, to be completed with `PendingApplication::finish`. This
+     * overlaps the communication with the evaluation of the interior. A
+     * field may appear several times in the batch. Without ghost layers, all
+     * pixels are evaluated and the returned application has already
+     * finished.
+     */
+    template <typename T>
+    PendingApplication begin_apply_gradient(
+        const std::vector<TypedFieldBase<T> *> & nodal_fields,
+        const std::vector<TypedFieldBase<T> *> & quadrature_point_fields)
+        const;
+
+    //! increment form of `begin_apply_gradient`
+    template <typename T>
+    PendingApplication begin_apply_gradient_increment(
+        const std::vector<TypedFieldBase<T> *> & nodal_fields,
+        const GradientAccumulator_t<T> & alpha,
+        const std::vector<TypedFieldBase<T> *> & quadrature_point_fields)
+        const;
+
+    //! begins `apply_transpose_batch`, filling the ghosts of the quadrature
+    //! point fields, see `begin_apply_gradient`
+    template <typename T>
+    PendingApplication begin_apply_transpose(
+        const std::vector<TypedFieldBase<T> *> & quadrature_point_fields,
+        const std::vector<TypedFieldBase<T> *> & nodal_fields,
+        const std::vector<Real> & weights = {}) const;
+
+    //! increment form of `begin_apply_transpose`
+    template <typename T>
+    PendingApplication begin_apply_transpose_increment(
+        const std::vector<TypedFieldBase<T> *> & quadrature_point_fields,
+        const GradientAccumulator_t<T> & alpha,
+        const std::vector<TypedFieldBase<T> *> & nodal_fields,
+        const std::vector<Real> & weights = {}) const;
+
     /**
      * Return the gradient matrix linking the nodal degrees of freedom to their
      * quadrature-point derivatives.
@@ -178,7 +332,67 @@ namespace muGrid {
      */
     const Index_t & get_nb_elements() const;
 
+    /**
+     * set how the transpose is evaluated on collections without ghosts. On
+     * collections with ghosts, the transpose is always gathered.
+     */
+    void set_transpose_algorithm(const TransposeAlgorithm & algorithm);
+
+    //! return how the transpose is evaluated
+    const TransposeAlgorithm & get_transpose_algorithm() const;
+
+    /**
+     * enable or disable the kernels specialised at compile time for the
+     * common element types and scalar or vector fields (enabled by default).
+     * Both give the same result up to round-off.
+     */
+    void set_fixed_size_kernels(const bool & enable);
+
+    //! return whether the kernels specialised at compile time are used
+    const bool & get_fixed_size_kernels() const;
+
    protected:
+    /**
+     * batched gradient increment. With ghost layers, the ghosts of
+     * `exchanged_fields` (the nodal fields, or none if the caller has filled
+     * the ghosts) are filled while the interior is evaluated, and the
+     * evaluation of the shell is returned as a pending application.
+     */
+    template <typename T>
+    PendingApplication apply_gradient_increment_impl(
+        const std::vector<const TypedFieldBase<T> *> & nodal_fields,
+        const GradientAccumulator_t<T> & alpha,
+        const std::vector<TypedFieldBase<T> *> & quadrature_point_fields,
+        const std::vector<Field *> & exchanged_fields) const;
+
+    //! batched transpose increment, see `apply_gradient_increment_impl`
+    template <typename T>
+    PendingApplication apply_transpose_increment_impl(
+        const std::vector<const TypedFieldBase<T> *> & quadrature_point_fields,
+        const GradientAccumulator_t<T> & alpha,
+        const std::vector<TypedFieldBase<T> *> & nodal_fields,
+        const std::vector<Real> & weights,
+        const std::vector<Field *> & exchanged_fields) const;
+
+    /**
+     * check that the batches of fields match each other and the operator and
+     * return the kernels for their numbers of components
+     */
+    template <typename T>
+    std::vector<std::unique_ptr<GradientKernel<T>>> make_kernels(
+        const std::vector<const TypedFieldBase<T> *> & nodal_fields,
+        const std::vector<const TypedFieldBase<T> *> & quadrature_point_fields)
+        const;
+
+    /**
+     * check that the fields match the operator and return the kernel for
+     * their number of components
+     */
+    template <typename T>
+    std::unique_ptr<GradientKernel<T>>
+    make_kernel(const TypedFieldBase<T> & nodal_field,
+                const TypedFieldBase<T> & quadrature_point_field) const;
+
     /**
      * matrix linking the nodal degrees of freedom to their quadrature-point
      * derivatives.
@@ -206,7 +420,51 @@ namespace muGrid {
     // TODO(junge): Check with Martin whether this can be true. Why does it not
     // depend on rank?
     Index_t nb_grad_component_per_pixel;
+    //! how the transpose is evaluated on periodic subdomains
+    TransposeAlgorithm transpose_algorithm{TransposeAlgorithm::Scatter};
+    //! whether to use the kernels specialised at compile time
+    bool use_fixed_size_kernels{true};
   };
 
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  void GradientOperatorDefault::apply_gradient(
+      const TypedFieldBase<T> & nodal_field,
+      TypedFieldBase<T> & quadrature_point_field) const {
+    quadrature_point_field.set_zero();
+    this->apply_gradient_increment(nodal_field, 1., quadrature_point_field);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  void GradientOperatorDefault::apply_gradient_increment(
+      const TypedFieldBase<T> & nodal_field,
+      const GradientAccumulator_t<T> & alpha,
+      TypedFieldBase<T> & quadrature_point_field) const {
+    this->apply_gradient_increment_batch<T>({&nodal_field}, alpha,
+                                            {&quadrature_point_field});
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  void GradientOperatorDefault::apply_transpose(
+      const TypedFieldBase<T> & quadrature_point_field,
+      TypedFieldBase<T> & nodal_field,
+      const std::vector<Real> & weights) const {
+    nodal_field.set_zero();
+    this->apply_transpose_increment(quadrature_point_field, 1., nodal_field,
+                                    weights);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <typename T>
+  void GradientOperatorDefault::apply_transpose_increment(
+      const TypedFieldBase<T> & quadrature_point_field,
+      const GradientAccumulator_t<T> & alpha, TypedFieldBase<T> & nodal_field,
+      const std::vector<Real> & weights) const {
+    this->apply_transpose_increment_batch<T>({&quadrature_point_field}, alpha,
+                                             {&nodal_field}, weights);
+  }
+
 }  // namespace muGrid
 #endif  // SRC_LIBMUGRID_GRADIENT_OPERATOR_DEFAULT_HH_
@@ -82,11 +82,33 @@ namespace muGrid {
   using Uint = unsigned int;  //!< type to use in math for unsigned integers
   using Int = int;            //!< type to use in math for signed integers
   using Real = double;        //!< type to use in math for real numbers
+  using Float = float;        //!< type to store single-precision reals
   using Complex =
       std::complex<Real>;  //!< type to use in math for complex numbers
 
   /**@}*/
 
+  /**
+   * scalar type in which sums over values of scalar type `T` are accumulated,
+   * e.g. by the gradient kernels and the reductions of `linalg`.
+   * Single-precision values are accumulated in double precision and only
+   * rounded when stored.
+   */
+  template <typename T>
+  struct GradientAccumulator {
+    using type = T;  //!< accumulation type
+  };
+
+  //! single-precision values are accumulated in double precision
+  template <>
+  struct GradientAccumulator<Float> {
+    using type = Real;  //!< accumulation type
+  };
+
+  //! convenience alias for `GradientAccumulator`
+  template <typename T>
+  using GradientAccumulator_t = typename GradientAccumulator<T>::type;
+
   constexpr Index_t oneD{1};    //!< constant for a one-dimensional problem
   constexpr Index_t twoD{2};    //!< constant for a two-dimensional problem
   constexpr Index_t threeD{3};  //!< constant for a three-dimensional problem
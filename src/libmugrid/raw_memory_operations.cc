@@ -35,8 +35,10 @@
  */
 
 #include <algorithm>
+#include <cstdlib>
 
 #include "ccoord_operations.hh"
+#include "thread_pool.hh"
 
 #include "raw_memory_operations.hh"
 
@@ -49,5 +51,288 @@ namespace muGrid {
                                            const Shape_t & strides)
         : shape{shape}, axes_order{compute_axes_order(shape, strides)} {}
 
+    namespace internal {
+
+      //! one axis of a copy, with strides in elements
+      struct CopyAxis {
+        Index_t nb;          //!< number of elements along the axis
+        Index_t in_stride;   //!< input stride
+        Index_t out_stride;  //!< output stride
+      };
+
+      //! axes of a copy, ordered by increasing output stride
+      using CopyAxes_t = std::vector<CopyAxis>;
+
+      //! copies smaller than this (in bytes) are not split among threads
+      constexpr size_t MinBytesPerThread{1 << 17};
+
+      /* ------------------------------------------------------------------ */
+      /**
+       * drop axes of extent one, order the axes by increasing output stride
+       * and fuse neighbouring axes that are contiguous in input and output
+       */
+      CopyAxes_t normalise_axes(CopyAxes_t axes) {
+        axes.erase(std::remove_if(axes.begin(), axes.end(),
+                                  [](const CopyAxis & axis) {
+                                    return axis.nb == 1;
+                                  }),
+                   axes.end());
+        std::stable_sort(axes.begin(), axes.end(),
+                         [](const CopyAxis & a, const CopyAxis & b) {
+                           return std::abs(a.out_stride) <
+                                  std::abs(b.out_stride);
+                         });
+        CopyAxes_t fused{};
+        for (auto && axis : axes) {
+          if (not fused.empty() and
+              axis.in_stride == fused.back().in_stride * fused.back().nb and
+              axis.out_stride == fused.back().out_stride * fused.back().nb) {
+            fused.back().nb *= axis.nb;
+          } else {
+            fused.push_back(axis);
+          }
+        }
+        return fused;
+      }
+
+      /* ------------------------------------------------------------------ */
+      //! copy of a single element of `Size` bytes
+      template <size_t Size>
+      inline void copy_element(const char * input, char * output) {
+        std::memcpy(output, input, Size);
+      }
+
+      /**
+       * copy kernels for elements of `Size` bytes. The innermost axes are
+       * handled by the kernel, the outer ones by `copy_outer`.
+       */
+      template <size_t Size>
+      struct CopyKernels {
+        //! side length (in elements) of the tiles of a transpose
+        static constexpr Index_t TileSize{
+            std::min(Index_t{64}, std::max(Index_t{8}, Index_t(256 / Size)))};
+
+        //! innermost run contiguous in input and output
+        static void contiguous(const CopyAxis & axis, const char * input,
+                               char * output) {
+          std::memcpy(output, input, axis.nb * Size);
+        }
+
+        //! innermost run strided in input and/or output
+        static void strided(const CopyAxis & axis, const char * input,
+                            char * output) {
+          const Index_t in_stride{axis.in_stride * Index_t(Size)};
+          const Index_t out_stride{axis.out_stride * Index_t(Size)};
+          for (Index_t i{0}; i < axis.nb; ++i) {
+            copy_element<Size>(input + i * in_stride,
+                               output + i * out_stride);
+          }
+        }
+
+        /**
+         * transpose, `fast_out` is contiguous in the output and `fast_in` in
+         * the input. The two axes are walked in tiles that fit into the L1
+         * cache, so that both the reads and the writes use full cache lines.
+         */
+        static void transpose(const CopyAxis & fast_out,
+                              const CopyAxis & fast_in, const char * input,
+                              char * output) {
+          const Index_t in_stride{fast_out.in_stride * Index_t(Size)};
+          const Index_t out_stride{fast_in.out_stride * Index_t(Size)};
+          for (Index_t j0{0}; j0 < fast_in.nb; j0 += TileSize) {
+            const Index_t j1{std::min(j0 + TileSize, fast_in.nb)};
+            for (Index_t i0{0}; i0 < fast_out.nb; i0 += TileSize) {
+              const Index_t i1{std::min(i0 + TileSize, fast_out.nb)};
+              for (Index_t j{j0}; j < j1; ++j) {
+                const char * in_col{input + j * Index_t(Size)};
+                char * out_col{output + j * out_stride};
+                for (Index_t i{i0}; i < i1; ++i) {
+                  copy_element<Size>(in_col + i * in_stride,
+                                     out_col + i * Index_t(Size));
+                }
+              }
+            }
+          }
+        }
+      };
+
+      /* ------------------------------------------------------------------ */
+      //! nested loops over the outer axes [0, level], calling `inner` on
+      //! every innermost block
+      template <size_t Size, class Inner>
+      void copy_outer(const CopyAxes_t & outer, const Index_t & level,
+                      const char * input, char * output, const Inner & inner) {
+        if (level < 0) {
+          inner(input, output);
+          return;
+        }
+        const CopyAxis & axis{outer[level]};
+        const Index_t in_stride{axis.in_stride * Index_t(Size)};
+        const Index_t out_stride{axis.out_stride * Index_t(Size)};
+        if (level == 0) {
+          for (Index_t i{0}; i < axis.nb; ++i) {
+            inner(input + i * in_stride, output + i * out_stride);
+          }
+          return;
+        }
+        for (Index_t i{0}; i < axis.nb; ++i) {
+          copy_outer<Size>(outer, level - 1, input + i * in_stride,
+                           output + i * out_stride, inner);
+        }
+      }
+
+      /* ------------------------------------------------------------------ */
+      //! serial copy of normalised axes with elements of `Size` bytes
+      template <size_t Size>
+      void copy_axes(const CopyAxes_t & axes, const char * input,
+                     char * output) {
+        using Kernels = CopyKernels<Size>;
+        if (axes.empty()) {
+          copy_element<Size>(input, output);
+          return;
+        }
+        const CopyAxis & fast_out{axes.front()};
+
+        // innermost run contiguous on both sides
+        if (fast_out.in_stride == 1 and fast_out.out_stride == 1) {
+          const CopyAxes_t outer(axes.begin() + 1, axes.end());
+          copy_outer<Size>(outer, Index_t(outer.size()) - 1, input, output,
+                           [&fast_out](const char * in, char * out) {
+                             Kernels::contiguous(fast_out, in, out);
+                           });
+          return;
+        }
+
+        // true transpose: another axis is contiguous in the input
+        auto && fast_in{std::find_if(
+            axes.begin() + 1, axes.end(),
+            [](const CopyAxis & axis) { return axis.in_stride == 1; })};
+        if (fast_out.out_stride == 1 and fast_in != axes.end()) {
+          CopyAxes_t outer(axes.begin() + 1, axes.end());
+          outer.erase(outer.begin() + (fast_in - axes.begin() - 1));
+          const CopyAxis & fast_in_axis{*fast_in};
+          copy_outer<Size>(
+              outer, Index_t(outer.size()) - 1, input, output,
+              [&fast_out, &fast_in_axis](const char * in, char * out) {
+                Kernels::transpose(fast_out, fast_in_axis, in, out);
+              });
+          return;
+        }
+
+        // everything else
+        const CopyAxes_t outer(axes.begin() + 1, axes.end());
+        copy_outer<Size>(outer, Index_t(outer.size()) - 1, input, output,
+                         [&fast_out](const char * in, char * out) {
+                           Kernels::strided(fast_out, in, out);
+                         });
+      }
+
+      /* ------------------------------------------------------------------ */
+      //! dispatch to the kernels specialised for the element size
+      void copy_axes(const CopyAxes_t & axes, const size_t & element_size,
+                     const char * input, char * output) {
+        switch (element_size) {
+        case 1: {
+          copy_axes<1>(axes, input, output);
+          break;
+        }
+        case 2: {
+          copy_axes<2>(axes, input, output);
+          break;
+        }
+        case 4: {
+          copy_axes<4>(axes, input, output);
+          break;
+        }
+        case 8: {
+          copy_axes<8>(axes, input, output);
+          break;
+        }
+        case 16: {
+          copy_axes<16>(axes, input, output);
+          break;
+        }
+        default: {
+          // other sizes: copy bytes, with the element as innermost axis
+          CopyAxes_t byte_axes{CopyAxis{Index_t(element_size), 1, 1}};
+          for (auto && axis : axes) {
+            byte_axes.push_back(
+                CopyAxis{axis.nb, axis.in_stride * Index_t(element_size),
+                         axis.out_stride * Index_t(element_size)});
+          }
+          copy_axes<1>(normalise_axes(byte_axes), input, output);
+          break;
+        }
+        }
+      }
+
+    }  // namespace internal
+
+    /* -------------------------------------------------------------------- */
+    void strided_copy(const Shape_t & logical_shape,
+                      const Shape_t & input_strides,
+                      const Shape_t & output_strides, const void * input_data,
+                      void * output_data, const size_t & element_size,
+                      ThreadPool * thread_pool) {
+      if (logical_shape.size() != input_strides.size()) {
+        std::stringstream message{};
+        message << "Dimension mismatch: The shape " << logical_shape
+                << " is of dimension " << logical_shape.size()
+                << " but the input_strides " << input_strides
+                << " are of dimension " << input_strides.size() << ".";
+        throw RuntimeError{message.str()};
+      }
+      if (logical_shape.size() != output_strides.size()) {
+        std::stringstream message{};
+        message << "Dimension mismatch: The shape " << logical_shape
+                << " is of dimension " << logical_shape.size()
+                << " but the output_strides " << output_strides
+                << " are of dimension " << output_strides.size() << ".";
+        throw RuntimeError{message.str()};
+      }
+      const size_t nb_elements{prod(logical_shape)};
+      if (nb_elements == 0) {
+        return;
+      }
+      internal::CopyAxes_t axes{};
+      for (size_t i{0}; i < logical_shape.size(); ++i) {
+        axes.push_back(internal::CopyAxis{logical_shape[i], input_strides[i],
+                                          output_strides[i]});
+      }
+      axes = internal::normalise_axes(axes);
+      auto * input{static_cast<const char *>(input_data)};
+      auto * output{static_cast<char *>(output_data)};
+      if (thread_pool == nullptr or thread_pool->get_nb_threads() == 1 or
+          axes.empty() or
+          nb_elements * element_size <
+              thread_pool->get_nb_threads() * internal::MinBytesPerThread) {
+        internal::copy_axes(axes, element_size, input, output);
+        return;
+      }
+
+      // split the longest axis among the threads
+      const Index_t split{
+          std::max_element(axes.begin(), axes.end(),
+                           [](const internal::CopyAxis & a,
+                              const internal::CopyAxis & b) {
+                             return a.nb < b.nb;
+                           }) -
+          axes.begin()};
+      const internal::CopyAxis split_axis{axes[split]};
+      thread_pool->parallel_for(
+          0, split_axis.nb, [&](const Index_t & begin, const Index_t & end) {
+            if (begin == end) {
+              return;
+            }
+            auto chunk_axes{axes};
+            chunk_axes[split].nb = end - begin;
+            internal::copy_axes(
+                chunk_axes, element_size,
+                input + begin * split_axis.in_stride * Index_t(element_size),
+                output +
+                    begin * split_axis.out_stride * Index_t(element_size));
+          });
+    }
+
   }  // namespace raw_mem_ops
 }  // namespace muGrid
@@ -39,11 +39,17 @@
 
 #include <cstring>
 #include <numeric>
+#include <type_traits>
 #include <vector>
 
 #ifndef SRC_LIBMUGRID_RAW_MEMORY_OPERATIONS_HH_
 #define SRC_LIBMUGRID_RAW_MEMORY_OPERATIONS_HH_
 
+namespace muGrid {
+  //! forward declaration
+  class ThreadPool;
+}  // namespace muGrid
+
 namespace muGrid::raw_mem_ops {
   /* ---------------------------------------------------------------------- */
   inline size_t prod(const Shape_t & vec) {
@@ -57,6 +63,18 @@ namespace muGrid::raw_mem_ops {
                               size_t{});
   }
 
+  /* ---------------------------------------------------------------------- */
+  //! strides of a contiguous column-major array of the given shape
+  inline Shape_t col_major_strides(const Shape_t & shape) {
+    Shape_t strides{};
+    Index_t stride{1};
+    for (auto && n : shape) {
+      strides.push_back(stride);
+      stride *= n;
+    }
+    return strides;
+  }
+
   class CartesianContainer {
    public:
     //! Default constructor
@@ -126,33 +144,43 @@ namespace muGrid::raw_mem_ops {
   };
 
   /* ---------------------------------------------------------------------- */
+  /**
+   * copy the elements of an array of shape `logical_shape` from `input_data`
+   * (laid out with `input_strides`) to `output_data` (laid out with
+   * `output_strides`). Strides are counted in elements of `element_size`
+   * bytes, and input and output must not overlap.
+   *
+   * The axes are first normalised: axes of extent one are dropped, the
+   * remaining ones are ordered by output stride and axes that are contiguous
+   * in both input and output are fused. Innermost runs that are contiguous
+   * on both sides are copied with `memcpy`, true transposes (the fastest
+   * input and output axes differ) are copied in cache-sized tiles, and
+   * everything else by a strided loop. The outer axes are walked by nested
+   * loops without any index arithmetic per element. The kernels are
+   * specialised for elements of 1, 2, 4, 8 and 16 bytes.
+   *
+   * If a `thread_pool` is given, large copies are split statically among
+   * its threads.
+   */
+  void strided_copy(const Shape_t & logical_shape,
+                    const Shape_t & input_strides,
+                    const Shape_t & output_strides, const void * input_data,
+                    void * output_data, const size_t & element_size,
+                    ThreadPool * thread_pool = nullptr);
+
+  /* ---------------------------------------------------------------------- */
+  //! typed version of the `strided_copy` above
   template <typename T>
   void strided_copy(const Shape_t & logical_shape,
                     const Shape_t & input_strides,
                     const Shape_t & output_strides, const T * input_data,
-                    T * output_data) {
-    if (logical_shape.size() != input_strides.size()) {
-      std::stringstream message{};
-      message << "Dimension mismatch: The shape " << logical_shape
-              << " is of dimension " << logical_shape.size()
-              << " but the input_strides " << input_strides
-              << " are of dimension " << input_strides.size() << ".";
-      throw RuntimeError{message.str()};
-    }
-    if (logical_shape.size() != output_strides.size()) {
-      std::stringstream message{};
-      message << "Dimension mismatch: The shape " << logical_shape
-              << " is of dimension " << logical_shape.size()
-              << " but the output_strides " << output_strides
-              << " are of dimension " << output_strides.size() << ".";
-      throw RuntimeError{message.str()};
-    }
-    CartesianContainer indices{logical_shape, output_strides};
-    for (auto && index : indices) {
-      auto && read_from{linear_index(index, input_strides)};
-      auto && write_to{linear_index(index, output_strides)};
-      output_data[write_to] = input_data[read_from];
-    }
+                    T * output_data, ThreadPool * thread_pool = nullptr) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "strided_copy copies raw memory and requires trivially "
+                  "copyable elements");
+    strided_copy(logical_shape, input_strides, output_strides,
+                 static_cast<const void *>(input_data),
+                 static_cast<void *>(output_data), sizeof(T), thread_pool);
   }
 }  // namespace muGrid::raw_mem_ops
 
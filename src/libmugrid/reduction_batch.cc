@@ -0,0 +1,140 @@
+/**
+ * @file   reduction_batch.cc
+ *
+ * @author Lars Pastewka <lars.pastewka@imtek.uni-freiburg.de>
+ *
+ * @date   16 Oct 2026
+ *
+ * @brief  Batch of scalar reductions of mixed type and operation
+ *         flushed in a single collective
+ *
+ * Copyright © 2026 Lars Pastewka
+ *
+ * µGrid is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * µGrid is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with µGrid; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * Additional permission under GNU GPL version 3 section 7
+ *
+ * If you modify this Program, or any covered work, by linking or combining it
+ * with proprietary FFT implementations or numerical libraries, containing parts
+ * covered by the terms of those libraries' licenses, the licensors of this
+ * Program grant you additional permission to convey the resulting work.
+ *
+ */
+
+#include "reduction_batch.hh"
+
+#include <algorithm>
+
+namespace muGrid {
+
+  /* ---------------------------------------------------------------------- */
+  ReductionBatch::ReductionBatch(const Communicator & comm) : comm{comm} {}
+
+  /* ---------------------------------------------------------------------- */
+  void ReductionBatch::flush() {
+    const Index_t nb_pending{this->get_nb_pending()};
+#ifdef WITH_MPI
+    if (nb_pending > 0 and this->comm.get_mpi_comm() != MPI_COMM_NULL) {
+      // every entry is a single element of an opaque type, the custom
+      // operation dispatches on the type and operation stored in the entry
+      MPI_Datatype entry_type{};
+      MPI_Type_contiguous(sizeof(Entry), MPI_BYTE, &entry_type);
+      MPI_Type_commit(&entry_type);
+      MPI_Op operation{};
+      MPI_Op_create(&ReductionBatch::combine, 1, &operation);
+      auto message{MPI_Allreduce(MPI_IN_PLACE,
+                                 this->entries.data() + this->nb_reduced,
+                                 static_cast<int>(nb_pending), entry_type,
+                                 operation, this->comm.get_mpi_comm())};
+      MPI_Op_free(&operation);
+      MPI_Type_free(&entry_type);
+      if (message != 0) {
+        std::stringstream error{};
+        error << "MPI_Allreduce of " << nb_pending
+              << " batched values failed with " << message << " on rank "
+              << this->comm.rank();
+        throw RuntimeError(error.str());
+      }
+    }
+#else
+    auto && group{this->comm.get_thread_group()};
+    if (nb_pending > 0 and group != nullptr) {
+      group->allreduce(this->comm.rank(),
+                       this->entries.data() + this->nb_reduced, nb_pending,
+                       &ReductionBatch::combine_entry);
+    }
+#endif
+    this->nb_reduced += nb_pending;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void ReductionBatch::clear() {
+    this->entries.clear();
+    this->nb_reduced = 0;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  //! combine two values with a reduction operation
+  template <typename T>
+  static void combine_values(const T & in, T & inout,
+                             const ReductionBatch::Operation & operation) {
+    switch (operation) {
+    case ReductionBatch::Operation::Sum: {
+      inout += in;
+      break;
+    }
+    case ReductionBatch::Operation::Max: {
+      inout = std::max(inout, in);
+      break;
+    }
+    case ReductionBatch::Operation::Min: {
+      inout = std::min(inout, in);
+      break;
+    }
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void ReductionBatch::combine_entry(const Entry & in, Entry & inout) {
+    switch (inout.type) {
+    case Type::Int: {
+      combine_values(in.value.integer, inout.value.integer, inout.operation);
+      break;
+    }
+    case Type::Index: {
+      combine_values(in.value.index, inout.value.index, inout.operation);
+      break;
+    }
+    case Type::Real: {
+      combine_values(in.value.real, inout.value.real, inout.operation);
+      break;
+    }
+    }
+  }
+
+#ifdef WITH_MPI
+  /* ---------------------------------------------------------------------- */
+  void ReductionBatch::combine(void * in, void * inout, int * len,
+                               MPI_Datatype * /*datatype*/) {
+    const Entry * in_entries{static_cast<const Entry *>(in)};
+    Entry * inout_entries{static_cast<Entry *>(inout)};
+    for (int i{0}; i < *len; ++i) {
+      combine_entry(in_entries[i], inout_entries[i]);
+    }
+  }
+#endif
+
+}  // namespace muGrid
@@ -0,0 +1,225 @@
+/**
+ * @file   reduction_batch.hh
+ *
+ * @author Lars Pastewka <lars.pastewka@imtek.uni-freiburg.de>
+ *
+ * @date   16 Oct 2026
+ *
+ * @brief  Batch of scalar reductions of mixed type and operation
+ *         flushed in a single collective
+ *
+ * Copyright © 2026 Lars Pastewka
+ *
+ * µGrid is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * µGrid is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with µGrid; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * Additional permission under GNU GPL version 3 section 7
+ *
+ * If you modify this Program, or any covered work, by linking or combining it
+ * with proprietary FFT implementations or numerical libraries, containing parts
+ * covered by the terms of those libraries' licenses, the licensors of this
+ * Program grant you additional permission to convey the resulting work.
+ *
+ */
+
+#ifndef SRC_LIBMUGRID_REDUCTION_BATCH_HH_
+#define SRC_LIBMUGRID_REDUCTION_BATCH_HH_
+
+#include "communicator.hh"
+#include "exception.hh"
+#include "grid_common.hh"
+
+#include <sstream>
+#include <type_traits>
+#include <vector>
+
+namespace muGrid {
+
+  /**
+   * Queue of scalar reductions that are evaluated together. Convergence
+   * checks typically reduce several scalars per iteration (e.g., a residual
+   * norm, an energy and a maximum stress); with `Communicator::sum` and
+   * `Communicator::max`, each of them is a separate collective. Instead, the
+   * values (of type `Int`, `Index_t` or `Real`, with any of the operations)
+   * are queued with `sum`, `max` and `min` and reduced with a single
+   * `MPI_Allreduce` on `flush()`, so the latency of a collective is paid only
+   * once. The reduced values are retrieved with the handles returned on
+   * queueing:
+   *
+   *     ReductionBatch batch{comm};
+   *     auto residual{batch.sum(local_residual)};
+   *     auto max_stress{batch.max(local_max_stress)};
+   *     batch.flush();
+   *     if (batch.get(residual) < tol) ...
+   */
+  class ReductionBatch {
+   public:
+    //! reduction operations
+    enum class Operation : int { Sum, Max, Min };
+
+    //! handle of a queued value, used to retrieve its reduced value
+    template <typename T>
+    class Result {
+      friend ReductionBatch;
+
+     public:
+      //! Default constructor
+      Result() = delete;
+
+      //! position of the value in the batch
+      const Index_t & get_index() const { return this->index; }
+
+     protected:
+      //! Constructor from the position of the value in the batch
+      explicit Result(const Index_t & index) : index{index} {}
+      Index_t index;  //!< position of the value in the batch
+    };
+
+    //! Default constructor
+    ReductionBatch() = delete;
+
+    //! Constructor from the communicator on which the values are reduced
+    explicit ReductionBatch(const Communicator & comm);
+
+    //! Copy constructor
+    ReductionBatch(const ReductionBatch & other) = delete;
+
+    //! Move constructor
+    ReductionBatch(ReductionBatch && other) = default;
+
+    //! Destructor
+    ~ReductionBatch() = default;
+
+    //! Copy assignment operator
+    ReductionBatch & operator=(const ReductionBatch & other) = delete;
+
+    //! Move assignment operator
+    ReductionBatch & operator=(ReductionBatch && other) = delete;
+
+    //! queue the sum of `value` over all processes
+    template <typename T>
+    Result<T> sum(const T & value) {
+      return this->push(value, Operation::Sum);
+    }
+
+    //! queue the maximum of `value` over all processes
+    template <typename T>
+    Result<T> max(const T & value) {
+      return this->push(value, Operation::Max);
+    }
+
+    //! queue the minimum of `value` over all processes
+    template <typename T>
+    Result<T> min(const T & value) {
+      return this->push(value, Operation::Min);
+    }
+
+    /**
+     * reduce all values queued since the last flush in a single collective,
+     * needs to be called by all processes of the communicator with the same
+     * sequence of queued types and operations
+     */
+    void flush();
+
+    //! return the reduced value of a queued value (after `flush()`)
+    template <typename T>
+    T get(const Result<T> & result) const {
+      if (result.index >= this->nb_reduced) {
+        std::stringstream error{};
+        error << "The value at position " << result.index
+              << " of this reduction batch has not been reduced yet, call "
+                 "flush() first";
+        throw RuntimeError(error.str());
+      }
+      return value_of<T>(this->entries[result.index]);
+    }
+
+    //! number of queued values (reduced or not)
+    Index_t size() const { return this->entries.size(); }
+
+    //! number of values queued since the last flush
+    Index_t get_nb_pending() const { return this->size() - this->nb_reduced; }
+
+    //! discard all values, this invalidates all handles
+    void clear();
+
+   protected:
+    //! type of a queued value
+    enum class Type : int { Int, Index, Real };
+
+    //! storage of a queued value
+    union Value {
+      Int integer;    //!< value of type `Int`
+      Index_t index;  //!< value of type `Index_t`
+      Real real;      //!< value of type `Real`
+    };
+
+    //! queued value with its type and operation, reduced as a single element
+    struct Entry {
+      Value value;          //!< value (local before and reduced after flush)
+      Type type;            //!< type of the value
+      Operation operation;  //!< reduction operation
+    };
+
+    //! queue `value` for reduction with `operation`
+    template <typename T>
+    Result<T> push(const T & value, const Operation & operation) {
+      Entry entry{};
+      entry.operation = operation;
+      if constexpr (std::is_same<T, Int>::value) {
+        entry.type = Type::Int;
+        entry.value.integer = value;
+      } else if constexpr (std::is_same<T, Index_t>::value) {
+        entry.type = Type::Index;
+        entry.value.index = value;
+      } else {
+        static_assert(std::is_same<T, Real>::value,
+                      "Only Int, Index_t and Real values can be reduced");
+        entry.type = Type::Real;
+        entry.value.real = value;
+      }
+      this->entries.push_back(entry);
+      return Result<T>{this->size() - 1};
+    }
+
+    //! value of an entry
+    template <typename T>
+    static T value_of(const Entry & entry) {
+      if constexpr (std::is_same<T, Int>::value) {
+        return entry.value.integer;
+      } else if constexpr (std::is_same<T, Index_t>::value) {
+        return entry.value.index;
+      } else {
+        return entry.value.real;
+      }
+    }
+
+    //! combine the value of `in` into `inout` with the operation of `inout`
+    static void combine_entry(const Entry & in, Entry & inout);
+
+#ifdef WITH_MPI
+    //! combine `len` entries of `in` into `inout` (the custom MPI operation)
+    static void combine(void * in, void * inout, int * len,
+                        MPI_Datatype * datatype);
+#endif
+
+    Communicator comm;           //!< communicator to reduce on
+    std::vector<Entry> entries;  //!< queued values
+    Index_t nb_reduced{0};       //!< number of entries that are reduced
+  };
+
+}  // namespace muGrid
+
+#endif  // SRC_LIBMUGRID_REDUCTION_BATCH_HH_
@@ -0,0 +1,287 @@
+/**
+ * @file   stencil_operator_base.cc
+ *
+ * @author Lars Pastewka <lars.pastewka@imtek.uni-freiburg.de>
+ *
+ * @date   16 Oct 2026
+ *
+ * @brief  implementation of the common stencil operator machinery
+ *
+ * Copyright © 2026 Lars Pastewka
+ *
+ * µGrid is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * µGrid is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with µGrid; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * Additional permission under GNU GPL version 3 section 7
+ *
+ * If you modify this Program, or any covered work, by linking or combining it
+ * with proprietary FFT implementations or numerical libraries, containing parts
+ * covered by the terms of those libraries' licenses, the licensors of this
+ * Program grant you additional permission to convey the resulting work.
+ *
+ */
+
+#include "stencil_operator_base.hh"
+#include "field_collection_global.hh"
+#include "exception.hh"
+
+#include <algorithm>
+#include <array>
+#include <sstream>
+
+namespace muGrid {
+
+  /* ---------------------------------------------------------------------- */
+  PendingApplication::~PendingApplication() {
+    if (this->state != nullptr and this->state->pending) {
+      this->finish();
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  bool PendingApplication::is_pending() const {
+    this->check_state();
+    return this->state->pending;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void PendingApplication::finish() {
+    this->check_state();
+    if (not this->state->pending) {
+      return;
+    }
+    // even if a sweep throws, the exchanges must not be finished twice
+    this->state->pending = false;
+    for (auto * input_field : this->state->exchanged_fields) {
+      input_field->finish_communicate_ghosts();
+    }
+    for (auto * table : this->state->shell_tables) {
+      this->state->sweep(*table);
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void PendingApplication::check_state() const {
+    if (this->state == nullptr) {
+      throw RuntimeError("The pending application has been moved from and no "
+                         "longer refers to an application of an operator");
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void StencilOperatorBase::set_nb_threads(const Index_t & nb_threads) {
+    if (nb_threads < 1) {
+      std::stringstream err_msg{};
+      err_msg << "The number of threads must be positive, but " << nb_threads
+              << " were requested";
+      throw RuntimeError{err_msg.str()};
+    }
+    if (nb_threads == this->get_nb_threads()) {
+      return;
+    }
+    this->thread_pool = nb_threads == 1
+                            ? nullptr
+                            : std::make_unique<ThreadPool>(nb_threads);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  Index_t StencilOperatorBase::get_nb_threads() const {
+    return this->thread_pool == nullptr ? 1
+                                        : this->thread_pool->get_nb_threads();
+  }
+
+  /* ---------------------------------------------------------------------- */
+  const CcoordOps::NeighbourTable & StencilOperatorBase::get_neighbour_table(
+      const CcoordOps::DynamicPixels & pixels,
+      const std::vector<DynCcoord_t> & offsets,
+      const DynCcoord_t & nb_region_grid_pts,
+      const DynCcoord_t & region_locations, const bool & periodic) const {
+    // everything the table depends on
+    std::vector<Index_t> key{pixels.get_dim(), periodic};
+    for (auto * ccoord :
+         {&pixels.get_nb_subdomain_grid_pts(), &pixels.get_subdomain_locations(),
+          &pixels.get_strides(), &nb_region_grid_pts, &region_locations}) {
+      key.insert(key.end(), ccoord->begin(), ccoord->end());
+    }
+    for (auto && offset : offsets) {
+      key.insert(key.end(), offset.begin(), offset.end());
+    }
+    std::lock_guard<std::mutex> lock{*this->neighbour_tables_mutex};
+    auto table{this->neighbour_tables.find(key)};
+    if (table == this->neighbour_tables.end()) {
+      table = this->neighbour_tables
+                  .emplace(key, pixels.get_neighbour_table(
+                                    offsets, nb_region_grid_pts,
+                                    region_locations, periodic))
+                  .first;
+    }
+    // the nodes of the map, and hence the tables, never move
+    return table->second;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  const CcoordOps::NeighbourTable & StencilOperatorBase::get_neighbour_table(
+      const CcoordOps::DynamicPixels & pixels,
+      const std::vector<DynCcoord_t> & offsets) const {
+    constexpr bool periodic{true};
+    return this->get_neighbour_table(pixels, offsets,
+                                     pixels.get_nb_subdomain_grid_pts(),
+                                     pixels.get_subdomain_locations(),
+                                     periodic);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  //! the collection of `input_field`, checked to have enough ghost layers
+  const GlobalFieldCollection &
+  get_ghosted_collection(const Field & input_field, const DynCcoord_t & nb_left,
+                         const DynCcoord_t & nb_right) {
+    auto & collection{dynamic_cast<const GlobalFieldCollection &>(
+        input_field.get_collection())};
+    auto && nb_ghosts_left{collection.get_nb_ghosts_left()};
+    auto && nb_ghosts_right{collection.get_nb_ghosts_right()};
+    for (Index_t d{0}; d < nb_left.get_dim(); ++d) {
+      if (nb_ghosts_left[d] < nb_left[d] or nb_ghosts_right[d] < nb_right[d]) {
+        std::stringstream err_msg{};
+        err_msg << "The stencil requires at least " << nb_left
+                << " left and " << nb_right
+                << " right ghost layers, but the field collection has "
+                << nb_ghosts_left << " left and " << nb_ghosts_right
+                << " right ghosts";
+        throw RuntimeError{err_msg.str()};
+      }
+    }
+    return collection;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void StencilOperatorBase::apply_with_ghosts(
+      const std::vector<const Field *> & input_fields,
+      const std::vector<DynCcoord_t> & offsets, const DynCcoord_t & nb_left,
+      const DynCcoord_t & nb_right, const Sweep_t & sweep) const {
+    auto & collection{
+        get_ghosted_collection(*input_fields.front(), nb_left, nb_right)};
+    constexpr bool periodic{false};
+    sweep(this->get_neighbour_table(
+        collection.get_pixels(), offsets,
+        collection.get_nb_subdomain_grid_pts(),
+        collection.get_subdomain_locations(), periodic));
+  }
+
+  /* ---------------------------------------------------------------------- */
+  PendingApplication StencilOperatorBase::begin_apply_with_ghosts(
+      const std::vector<Field *> & input_fields,
+      const std::vector<DynCcoord_t> & offsets, const DynCcoord_t & nb_left,
+      const DynCcoord_t & nb_right, const Sweep_t & sweep) const {
+    auto state{std::make_unique<PendingApplication::State>()};
+    state->sweep = sweep;
+    // the same field may appear several times in a batch, but its ghosts can
+    // only be exchanged once at a time. All processes start the exchanges in
+    // the same order, so the messages of different fields are matched
+    // correctly.
+    for (auto * input_field : input_fields) {
+      if (std::find(state->exchanged_fields.begin(),
+                    state->exchanged_fields.end(),
+                    input_field) == state->exchanged_fields.end()) {
+        state->exchanged_fields.push_back(input_field);
+      }
+    }
+    auto & collection{
+        get_ghosted_collection(*input_fields.front(), nb_left, nb_right)};
+    auto & pixels{collection.get_pixels()};
+    constexpr bool periodic{false};
+    // the core does not need the ghosts, the shell around it does
+    auto && boxes{split_core_shell(collection.get_nb_subdomain_grid_pts(),
+                                   collection.get_subdomain_locations(),
+                                   nb_left, nb_right)};
+    for (auto && box = std::next(boxes.begin()); box != boxes.end(); ++box) {
+      state->shell_tables.push_back(&this->get_neighbour_table(
+          pixels, offsets, std::get<0>(*box), std::get<1>(*box), periodic));
+    }
+    for (auto * input_field : state->exchanged_fields) {
+      input_field->begin_communicate_ghosts();
+    }
+    state->pending = true;
+    PendingApplication application{std::move(state)};
+    auto && core{boxes.front()};
+    try {
+      application.state->sweep(this->get_neighbour_table(
+          pixels, offsets, std::get<0>(core), std::get<1>(core), periodic));
+    } catch (...) {
+      // complete the exchanges, but do not evaluate the shell
+      application.state->shell_tables.clear();
+      application.finish();
+      throw;
+    }
+    return application;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  PendingApplication StencilOperatorBase::finished_application() {
+    return PendingApplication{std::make_unique<PendingApplication::State>()};
+  }
+
+  /* ---------------------------------------------------------------------- */
+  std::vector<std::tuple<DynCcoord_t, DynCcoord_t>>
+  StencilOperatorBase::split_core_shell(const DynCcoord_t & nb_grid_pts,
+                                        const DynCcoord_t & locations,
+                                        const DynCcoord_t & nb_left,
+                                        const DynCcoord_t & nb_right) {
+    const Index_t dim{nb_grid_pts.get_dim()};
+    // per direction, the ranges [begin, end) of the left shell, the core and
+    // the right shell, relative to `locations`
+    std::vector<std::array<Index_t, 4>> bounds(dim);
+    for (Index_t d{0}; d < dim; ++d) {
+      const Index_t n{nb_grid_pts[d]};
+      const Index_t left_end{std::min(nb_left[d], n)};
+      const Index_t core_end{std::max(left_end, n - nb_right[d])};
+      bounds[d] = {0, left_end, core_end, n};
+    }
+    auto && make_box{[&](const std::vector<Index_t> & begins,
+                         const std::vector<Index_t> & ends) {
+      DynCcoord_t shape(dim), location(dim);
+      for (Index_t d{0}; d < dim; ++d) {
+        shape[d] = std::max(Index_t{0}, ends[d] - begins[d]);
+        location[d] = locations[d] + begins[d];
+      }
+      return std::make_tuple(shape, location);
+    }};
+    std::vector<std::tuple<DynCcoord_t, DynCcoord_t>> boxes{};
+    std::vector<Index_t> begins(dim), ends(dim);
+    for (Index_t d{0}; d < dim; ++d) {
+      begins[d] = bounds[d][1];
+      ends[d] = bounds[d][2];
+    }
+    boxes.push_back(make_box(begins, ends));
+    // a pixel outside the core belongs to the box of the first direction in
+    // which it is outside the core
+    for (Index_t d{0}; d < dim; ++d) {
+      for (Index_t e{0}; e < dim; ++e) {
+        begins[e] = e < d ? bounds[e][1] : bounds[e][0];
+        ends[e] = e < d ? bounds[e][2] : bounds[e][3];
+      }
+      // the left and the right shell in direction d
+      for (Index_t side{0}; side < 2; ++side) {
+        begins[d] = bounds[d][2 * side];
+        ends[d] = bounds[d][2 * side + 1];
+        auto && box{make_box(begins, ends)};
+        if (CcoordOps::get_size(std::get<0>(box)) > 0) {
+          boxes.push_back(box);
+        }
+      }
+    }
+    return boxes;
+  }
+
+}  // namespace muGrid
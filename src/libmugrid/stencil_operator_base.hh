@@ -0,0 +1,284 @@
+/**
+ * @file   stencil_operator_base.hh
+ *
+ * @author Lars Pastewka <lars.pastewka@imtek.uni-freiburg.de>
+ *
+ * @date   16 Oct 2026
+ *
+ * @brief  common machinery of operators evaluating a stencil on every pixel
+ *
+ * Copyright © 2026 Lars Pastewka
+ *
+ * µGrid is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * µGrid is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with µGrid; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * Additional permission under GNU GPL version 3 section 7
+ *
+ * If you modify this Program, or any covered work, by linking or combining it
+ * with proprietary FFT implementations or numerical libraries, containing parts
+ * covered by the terms of those libraries' licenses, the licensors of this
+ * Program grant you additional permission to convey the resulting work.
+ *
+ */
+
+#include "gradient_operator_base.hh"
+#include "ccoord_operations.hh"
+#include "thread_pool.hh"
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+#ifndef SRC_LIBMUGRID_STENCIL_OPERATOR_BASE_HH_
+#define SRC_LIBMUGRID_STENCIL_OPERATOR_BASE_HH_
+
+namespace muGrid {
+
+  class StencilOperatorBase;
+
+  /**
+   * handle of an application of a `StencilOperatorBase` whose ghost exchange
+   * is in flight, see e.g. `GradientOperatorDefault::begin_apply_gradient`.
+   * Beginning the application starts filling the ghost layers of its input
+   * fields and evaluates the pixels that do not depend on ghosts. `finish()`
+   * waits for the ghosts and evaluates the remaining shell of pixels. The
+   * input and output fields, and the operator, must outlive the pending
+   * application, and the input fields must not be modified until it has
+   * finished. Destroying a pending handle finishes the application, as the
+   * exchange has to complete.
+   */
+  class PendingApplication {
+    friend StencilOperatorBase;
+
+   public:
+    //! operation evaluated on all pixels of a neighbour table
+    using Sweep_t =
+        std::function<void(const CcoordOps::NeighbourTable & table)>;
+
+    //! Default constructor
+    PendingApplication() = delete;
+
+    //! Copy constructor
+    PendingApplication(const PendingApplication & other) = delete;
+
+    //! Move constructor
+    PendingApplication(PendingApplication && other) = default;
+
+    //! Destructor
+    ~PendingApplication();
+
+    //! Copy assignment operator
+    PendingApplication & operator=(const PendingApplication & other) = delete;
+
+    //! Move assignment operator
+    PendingApplication & operator=(PendingApplication && other) = delete;
+
+    //! whether the shell of pixels still has to be evaluated
+    bool is_pending() const;
+
+    /**
+     * wait for the ghost exchanges of the input fields and evaluate the
+     * pixels that depend on the ghosts. Does nothing if the application has
+     * already finished.
+     */
+    void finish();
+
+   protected:
+    //! exchanges in flight and the work left to do, at a fixed address
+    struct State {
+      std::vector<Field *> exchanged_fields;  //!< fields with pending ghosts
+      //! tables of the shell of pixels that read from the ghosts
+      std::vector<const CcoordOps::NeighbourTable *> shell_tables;
+      Sweep_t sweep;        //!< evaluates the pixels of a table
+      bool pending{false};  //!< whether `finish` has yet to be called
+    };
+
+    //! Constructor from the state of a begun application
+    explicit PendingApplication(std::unique_ptr<State> state)
+        : state{std::move(state)} {}
+
+    //! throws if the handle has been moved from
+    void check_state() const;
+
+    std::unique_ptr<State> state;  //!< state of the application
+  };
+
+  /**
+   * Common machinery of the operators that evaluate a stencil of
+   * neighbouring pixels on every pixel of a global field collection: the
+   * loops over the pixels (through `CcoordOps::NeighbourTable`), their
+   * distribution among threads and the filling of ghost layers.
+   */
+  class StencilOperatorBase : public GradientOperatorBase {
+   public:
+    using Parent = GradientOperatorBase;
+
+    //! Default constructor
+    StencilOperatorBase() = default;
+
+    //! Copy constructor
+    StencilOperatorBase(const StencilOperatorBase & other) = delete;
+
+    //! Move constructor
+    StencilOperatorBase(StencilOperatorBase && other) = default;
+
+    //! Destructor
+    virtual ~StencilOperatorBase() = default;
+
+    //! Copy assignment operator
+    StencilOperatorBase & operator=(const StencilOperatorBase & other) = delete;
+
+    //! Move assignment operator
+    StencilOperatorBase & operator=(StencilOperatorBase && other) = default;
+
+    /**
+     * set the number of threads used to evaluate the operator and its
+     * transpose. For a fixed number of threads, results are bitwise
+     * reproducible. Defaults to a single thread.
+     */
+    void set_nb_threads(const Index_t & nb_threads);
+
+    //! return the number of threads used to evaluate the operators
+    Index_t get_nb_threads() const;
+
+   protected:
+    /**
+     * operation evaluated on all pixels of a neighbour table, typically
+     * through `for_each_pixel` or `for_each_chunk`. It is called once per
+     * table, hence its dispatch does not matter.
+     */
+    using Sweep_t = PendingApplication::Sweep_t;
+
+    /**
+     * evaluate `kernel(index, neighbours)` on all pixels of `table`, where
+     * `index` is the storage index of the pixel and `neighbours` the storage
+     * indices of the pixels of its stencil. The pixels are split among the
+     * threads, hence the kernel must not write to data that belongs to
+     * another pixel.
+     */
+    template <class Kernel>
+    void for_each_pixel(const CcoordOps::NeighbourTable & table,
+                        const Kernel & kernel) const;
+
+    /**
+     * evaluate `kernel(begin, end)` on contiguous chunks of the pixels of
+     * `table` covering all of them, one chunk per thread. The same
+     * restrictions as for `for_each_pixel` apply.
+     */
+    template <class Kernel>
+    void for_each_chunk(const CcoordOps::NeighbourTable & table,
+                        const Kernel & kernel) const;
+
+    /**
+     * return the table of the stencil `offsets` on the region of
+     * `nb_region_grid_pts` pixels at `region_locations` of `pixels`, see
+     * `CcoordOps::DynamicPixels::get_neighbour_table`. The tables are built
+     * on first use and kept by the operator, keyed by the grid, stencil and
+     * region they describe, so repeated applications do not rebuild them.
+     */
+    const CcoordOps::NeighbourTable &
+    get_neighbour_table(const CcoordOps::DynamicPixels & pixels,
+                        const std::vector<DynCcoord_t> & offsets,
+                        const DynCcoord_t & nb_region_grid_pts,
+                        const DynCcoord_t & region_locations,
+                        const bool & periodic) const;
+
+    //! same as above for the whole (periodic) subdomain of `pixels`
+    const CcoordOps::NeighbourTable &
+    get_neighbour_table(const CcoordOps::DynamicPixels & pixels,
+                        const std::vector<DynCcoord_t> & offsets) const;
+
+    /**
+     * evaluate `sweep` on the tables of the stencil `offsets` covering the
+     * subdomain of a collection with ghosts, whose ghosts the caller has
+     * filled. Only the pixels within `nb_left` (`nb_right`) pixels of the
+     * left (right) boundaries of the subdomain may read from the ghost
+     * layers, and the collection needs at least as many ghost layers. All
+     * input fields live in the same collection.
+     */
+    void apply_with_ghosts(const std::vector<const Field *> & input_fields,
+                           const std::vector<DynCcoord_t> & offsets,
+                           const DynCcoord_t & nb_left,
+                           const DynCcoord_t & nb_right,
+                           const Sweep_t & sweep) const;
+
+    /**
+     * same as above, but first starts filling the ghosts of the input fields
+     * (each field only once, even if it appears several times), evaluates
+     * the core of pixels that do not read from the ghosts and returns the
+     * rest of the work as a pending application. `sweep` has to own
+     * everything it refers to except for the fields and the operator.
+     */
+    PendingApplication
+    begin_apply_with_ghosts(const std::vector<Field *> & input_fields,
+                            const std::vector<DynCcoord_t> & offsets,
+                            const DynCcoord_t & nb_left,
+                            const DynCcoord_t & nb_right,
+                            const Sweep_t & sweep) const;
+
+    //! a pending application that has nothing left to do
+    static PendingApplication finished_application();
+
+    /**
+     * splits the box of `nb_grid_pts` at `locations` into its core, the
+     * pixels that are at least `nb_left` (`nb_right`) pixels away from its
+     * left (right) boundaries, and disjoint boxes covering the remaining
+     * shell. Returns the shape and location of the core followed by those of
+     * the non-empty shell boxes.
+     */
+    static std::vector<std::tuple<DynCcoord_t, DynCcoord_t>>
+    split_core_shell(const DynCcoord_t & nb_grid_pts,
+                     const DynCcoord_t & locations, const DynCcoord_t & nb_left,
+                     const DynCcoord_t & nb_right);
+
+    //! threads evaluating the operators, none if single-threaded
+    std::unique_ptr<ThreadPool> thread_pool{};
+    //! neighbour tables built so far, see `get_neighbour_table`
+    mutable std::map<std::vector<Index_t>, CcoordOps::NeighbourTable>
+        neighbour_tables{};
+    //! protects `neighbour_tables`, the operators may be applied concurrently
+    std::unique_ptr<std::mutex> neighbour_tables_mutex{
+        std::make_unique<std::mutex>()};
+  };
+
+  /* ---------------------------------------------------------------------- */
+  template <class Kernel>
+  void
+  StencilOperatorBase::for_each_pixel(const CcoordOps::NeighbourTable & table,
+                                      const Kernel & kernel) const {
+    this->for_each_chunk(table, [&table, &kernel](const Index_t & begin,
+                                                  const Index_t & end) {
+      table.for_each(begin, end, kernel);
+    });
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <class Kernel>
+  void
+  StencilOperatorBase::for_each_chunk(const CcoordOps::NeighbourTable & table,
+                                      const Kernel & kernel) const {
+    if (this->thread_pool == nullptr) {
+      kernel(Index_t{0}, table.size());
+    } else {
+      this->thread_pool->parallel_for(0, table.size(), kernel);
+    }
+  }
+
+}  // namespace muGrid
+
+#endif  // SRC_LIBMUGRID_STENCIL_OPERATOR_BASE_HH_
@@ -40,6 +40,7 @@
 #include "grid_common.hh"
 #include "T4_map_proxy.hh"
 #include "eigen_tools.hh"
+#include "tensor_batch.hh"
 
 #include "Eigen/Dense"
 #include "unsupported/Eigen/CXX11/Tensor"
@@ -594,6 +595,136 @@ namespace muGrid {
     }  // namespace AxisTransform
 
   }  // namespace Matrices
+
+  /**
+   * Tensor algebra on batches of tensors (see `muGrid::TensorBatch`). The
+   * operations mirror those of `muGrid::Matrices` and evaluate them at all
+   * points of a batch at once, one SIMD instruction per component.
+   */
+  namespace Batches {
+
+    //! batch of second-rank tensors
+    template <typename T, Dim_t Dim, Dim_t Width>
+    using T2Batch = TensorBatch<T, Dim, Dim, Width>;
+
+    //! batch of fourth-rank tensors in matrix representation
+    template <typename T, Dim_t Dim, Dim_t Width>
+    using T4Batch = TensorBatch<T, Dim * Dim, Dim * Dim, Width>;
+
+    //! batch of second-order identities
+    template <typename T, Dim_t Dim, Dim_t Width>
+    inline T2Batch<T, Dim, Width> I2() {
+      auto identity{T2Batch<T, Dim, Width>::Zero()};
+      for (Dim_t i{0}; i < Dim; ++i) {
+        identity(i, i).setOnes();
+      }
+      return identity;
+    }
+
+    //! matrix product Cᵢⱼ = AᵢₐBₐⱼ at every point
+    template <typename T, Dim_t NbRow, Dim_t NbInner, Dim_t NbCol,
+              Dim_t Width>
+    inline TensorBatch<T, NbRow, NbCol, Width>
+    matmul(const TensorBatch<T, NbRow, NbInner, Width> & A,
+           const TensorBatch<T, NbInner, NbCol, Width> & B) {
+      auto C{TensorBatch<T, NbRow, NbCol, Width>::Zero()};
+      for (Dim_t j{0}; j < NbCol; ++j) {
+        for (Dim_t a{0}; a < NbInner; ++a) {
+          for (Dim_t i{0}; i < NbRow; ++i) {
+            C(i, j) += A(i, a) * B(a, j);
+          }
+        }
+      }
+      return C;
+    }
+
+    //! transpose at every point
+    template <typename T, Dim_t NbRow, Dim_t NbCol, Dim_t Width>
+    inline TensorBatch<T, NbCol, NbRow, Width>
+    transpose(const TensorBatch<T, NbRow, NbCol, Width> & A) {
+      TensorBatch<T, NbCol, NbRow, Width> transposed{};
+      for (Dim_t j{0}; j < NbCol; ++j) {
+        for (Dim_t i{0}; i < NbRow; ++i) {
+          transposed(j, i) = A(i, j);
+        }
+      }
+      return transposed;
+    }
+
+    //! trace of a second-rank tensor at every point
+    template <typename T, Dim_t Dim, Dim_t Width>
+    inline Eigen::Array<T, Width, 1> trace(const T2Batch<T, Dim, Width> & A) {
+      Eigen::Array<T, Width, 1> trace{A(0, 0)};
+      for (Dim_t i{1}; i < Dim; ++i) {
+        trace += A(i, i);
+      }
+      return trace;
+    }
+
+    /**
+     * simple contraction between two second-rank tensors Cᵢⱼ = AᵢₐBₐⱼ at every
+     * point
+     */
+    template <Dim_t Dim, typename T, Dim_t Width>
+    inline T2Batch<T, Dim, Width> dot(const T2Batch<T, Dim, Width> & A,
+                                      const T2Batch<T, Dim, Width> & B) {
+      return matmul(A, B);
+    }
+
+    /**
+     * double contraction between two second-rank tensors c = AᵢⱼBᵢⱼ at every
+     * point (for `Dim` = 1, second- and fourth-rank batches are of the same
+     * type and the fourth-rank overload below is selected)
+     */
+    template <Dim_t Dim, typename T, Dim_t Width>
+    inline Eigen::Array<T, Width, 1> ddot(const T2Batch<T, Dim, Width> & A,
+                                          const T2Batch<T, Dim, Width> & B) {
+      return (A.values * B.values).rowwise().sum();
+    }
+
+    /**
+     * double contraction between two fourth-rank tensors
+     * Cᵢⱼₖₗ = AᵢⱼₐₑBₐₑₖₗ at every point
+     */
+    template <Dim_t Dim, typename T, Dim_t Width>
+    inline T4Batch<T, Dim, Width> ddot(const T4Batch<T, Dim, Width> & A,
+                                       const T4Batch<T, Dim, Width> & B) {
+      return matmul(A, B);
+    }
+
+    /**
+     * standard tensor multiplication of a fourth-rank tensor with a
+     * second-rank tensor Bᵢⱼ = AᵢⱼₖₗEₖₗ at every point (e.g., the stress from
+     * the stiffness and the strain)
+     */
+    template <Dim_t Dim, typename T, Dim_t Width>
+    inline T2Batch<T, Dim, Width> tensmult(const T4Batch<T, Dim, Width> & A,
+                                           const T2Batch<T, Dim, Width> & E) {
+      constexpr Dim_t Size{Dim * Dim};
+      auto B{T2Batch<T, Dim, Width>::Zero()};
+      for (Dim_t kl{0}; kl < Size; ++kl) {
+        for (Dim_t ij{0}; ij < Size; ++ij) {
+          B[ij] += A(ij, kl) * E[kl];
+        }
+      }
+      return B;
+    }
+
+    //! outer tensor product Cᵢⱼₖₗ = AᵢⱼBₖₗ at every point
+    template <Dim_t Dim, typename T, Dim_t Width>
+    inline T4Batch<T, Dim, Width> outer(const T2Batch<T, Dim, Width> & A,
+                                        const T2Batch<T, Dim, Width> & B) {
+      constexpr Dim_t Size{Dim * Dim};
+      T4Batch<T, Dim, Width> C{};
+      for (Dim_t kl{0}; kl < Size; ++kl) {
+        for (Dim_t ij{0}; ij < Size; ++ij) {
+          C(ij, kl) = A[ij] * B[kl];
+        }
+      }
+      return C;
+    }
+
+  }  // namespace Batches
 }  // namespace muGrid
 
 #endif  // SRC_LIBMUGRID_TENSOR_ALGEBRA_HH_
@@ -0,0 +1,209 @@
+/**
+ * @file   tensor_batch.hh
+ *
+ * @author Lars Pastewka <lars.pastewka@imtek.uni-freiburg.de>
+ *
+ * @date   16 Oct 2026
+ *
+ * @brief  tensors at several points, stored as a structure of arrays for SIMD evaluation
+ *
+ * Copyright © 2026 Lars Pastewka
+ *
+ * µGrid is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * µGrid is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with µGrid; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * Additional permission under GNU GPL version 3 section 7
+ *
+ * If you modify this Program, or any covered work, by linking or combining it
+ * with proprietary FFT implementations or numerical libraries, containing parts
+ * covered by the terms of those libraries' licenses, the licensors of this
+ * Program grant you additional permission to convey the resulting work.
+ *
+ */
+
+#ifndef SRC_LIBMUGRID_TENSOR_BATCH_HH_
+#define SRC_LIBMUGRID_TENSOR_BATCH_HH_
+
+#include "grid_common.hh"
+
+#include "Eigen/Dense"
+
+namespace muGrid {
+
+  /**
+   * number of values of type `T` processed by one SIMD instruction (the
+   * packet size of Eigen for the target architecture), the default width of
+   * batches
+   */
+  template <typename T>
+  constexpr Dim_t simd_width() {
+    return Eigen::internal::packet_traits<T>::size;
+  }
+
+  /**
+   * Statically sized tensors (in matrix representation, `NbRow` × `NbCol`)
+   * at `Width` points at once, e.g., at `Width` quadrature points. The batch
+   * is stored as a structure of arrays: every component is an
+   * `Eigen::Array<T, Width, 1>` that holds the component at all points, such
+   * that arithmetic on batches processes all points with one (SIMD)
+   * instruction per component. Batches are handed out by
+   * `StaticFieldMap::batches` and the tensor algebra of the namespace
+   * `muGrid::Batches` (see `tensor_algebra.hh`) operates on them.
+   */
+  template <typename T, Dim_t NbRow, Dim_t NbCol, Dim_t Width>
+  struct TensorBatch {
+    static_assert(NbRow > 0 and NbCol > 0 and Width > 0,
+                  "Only statically sized batches are supported");
+
+    //! stored scalar type
+    using Scalar = T;
+
+    //! values of a single component at all points of the batch
+    using Lane_t = Eigen::Array<T, Width, 1>;
+
+    //! values of all components, one column per component in column-major
+    //! component order
+    using Storage_t = Eigen::Array<T, Width, NbRow * NbCol>;
+
+    //! tensor at a single point
+    using Point_t = Eigen::Matrix<T, NbRow, NbCol>;
+
+    //! number of rows of the tensors
+    constexpr static Dim_t Rows() { return NbRow; }
+
+    //! number of columns of the tensors
+    constexpr static Dim_t Cols() { return NbCol; }
+
+    //! number of points in the batch
+    constexpr static Dim_t Points() { return Width; }
+
+    //! batch with all components set to zero
+    static TensorBatch Zero() { return TensorBatch{Storage_t::Zero()}; }
+
+    //! batch holding the same tensor at all points
+    template <class Derived>
+    static TensorBatch Constant(const Eigen::MatrixBase<Derived> & value) {
+      TensorBatch batch{};
+      for (Dim_t col{0}; col < NbCol; ++col) {
+        for (Dim_t row{0}; row < NbRow; ++row) {
+          batch(row, col).setConstant(value(row, col));
+        }
+      }
+      return batch;
+    }
+
+    //! component (`row`, `col`) at all points of the batch
+    decltype(auto) operator()(const Dim_t & row, const Dim_t & col) {
+      return this->values.col(row + col * NbRow);
+    }
+
+    //! component (`row`, `col`) at all points of the batch
+    decltype(auto) operator()(const Dim_t & row, const Dim_t & col) const {
+      return this->values.col(row + col * NbRow);
+    }
+
+    //! component with column-major linear index `index` at all points
+    decltype(auto) operator[](const Dim_t & index) {
+      return this->values.col(index);
+    }
+
+    //! component with column-major linear index `index` at all points
+    decltype(auto) operator[](const Dim_t & index) const {
+      return this->values.col(index);
+    }
+
+    //! return the tensor at the point `point` of the batch
+    Point_t get_point(const Dim_t & point) const {
+      Point_t value{};
+      Eigen::Map<Eigen::Array<T, 1, NbRow * NbCol>>(value.data()) =
+          this->values.row(point);
+      return value;
+    }
+
+    //! set the tensor at the point `point` of the batch
+    template <class Derived>
+    void set_point(const Dim_t & point,
+                   const Eigen::MatrixBase<Derived> & value) {
+      const Point_t plain{value};
+      this->values.row(point) =
+          Eigen::Map<const Eigen::Array<T, 1, NbRow * NbCol>>(plain.data());
+    }
+
+    //! add another batch
+    TensorBatch & operator+=(const TensorBatch & other) {
+      this->values += other.values;
+      return *this;
+    }
+
+    //! subtract another batch
+    TensorBatch & operator-=(const TensorBatch & other) {
+      this->values -= other.values;
+      return *this;
+    }
+
+    //! scale all points by the same factor
+    TensorBatch & operator*=(const T & factor) {
+      this->values *= factor;
+      return *this;
+    }
+
+    //! scale every point by its own factor
+    TensorBatch & operator*=(const Lane_t & factors) {
+      this->values.colwise() *= factors;
+      return *this;
+    }
+
+    //! values, one column per component
+    Storage_t values;
+  };
+
+  /* ---------------------------------------------------------------------- */
+  //! sum of two batches
+  template <typename T, Dim_t NbRow, Dim_t NbCol, Dim_t Width>
+  TensorBatch<T, NbRow, NbCol, Width>
+  operator+(TensorBatch<T, NbRow, NbCol, Width> a,
+            const TensorBatch<T, NbRow, NbCol, Width> & b) {
+    return a += b;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  //! difference of two batches
+  template <typename T, Dim_t NbRow, Dim_t NbCol, Dim_t Width>
+  TensorBatch<T, NbRow, NbCol, Width>
+  operator-(TensorBatch<T, NbRow, NbCol, Width> a,
+            const TensorBatch<T, NbRow, NbCol, Width> & b) {
+    return a -= b;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  //! batch scaled by a factor
+  template <typename T, Dim_t NbRow, Dim_t NbCol, Dim_t Width>
+  TensorBatch<T, NbRow, NbCol, Width>
+  operator*(const T & factor, TensorBatch<T, NbRow, NbCol, Width> a) {
+    return a *= factor;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  //! batch scaled point by point
+  template <typename T, Dim_t NbRow, Dim_t NbCol, Dim_t Width>
+  TensorBatch<T, NbRow, NbCol, Width>
+  operator*(const Eigen::Array<T, Width, 1> & factors,
+            TensorBatch<T, NbRow, NbCol, Width> a) {
+    return a *= factors;
+  }
+
+}  // namespace muGrid
+
+#endif  // SRC_LIBMUGRID_TENSOR_BATCH_HH_
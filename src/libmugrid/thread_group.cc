@@ -0,0 +1,162 @@
+/**
+ * @file   thread_group.cc
+ *
+ * @author Lars Pastewka <lars.pastewka@imtek.uni-freiburg.de>
+ *
+ * @date   16 Oct 2026
+ *
+ * @brief  implementation of the in-process thread group
+ *
+ * Copyright © 2026 Lars Pastewka
+ *
+ * µGrid is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * µGrid is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with µGrid; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * Additional permission under GNU GPL version 3 section 7
+ *
+ * If you modify this Program, or any covered work, by linking or combining it
+ * with proprietary FFT implementations or numerical libraries, containing parts
+ * covered by the terms of those libraries' licenses, the licensors of this
+ * Program grant you additional permission to convey the resulting work.
+ *
+ */
+
+#include "thread_group.hh"
+
+#include <cstring>
+
+namespace muGrid {
+
+  /* ---------------------------------------------------------------------- */
+  ThreadGroup::ThreadGroup(const int & nb_ranks)
+      : nb_ranks{nb_ranks}, addresses(std::max(nb_ranks, 0), nullptr) {
+    if (nb_ranks < 1) {
+      std::stringstream error{};
+      error << "A thread group needs at least one rank, but " << nb_ranks
+            << " were requested.";
+      throw RuntimeError(error.str());
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  const int & ThreadGroup::size() const { return this->nb_ranks; }
+
+  /* ---------------------------------------------------------------------- */
+  void ThreadGroup::barrier() {
+    std::unique_lock<std::mutex> lock{this->mutex};
+    this->check_aborted();
+    const Index_t arrival_generation{this->generation};
+    ++this->nb_arrived;
+    if (this->nb_arrived == this->nb_ranks) {
+      this->nb_arrived = 0;
+      ++this->generation;
+      this->arrival.notify_all();
+      return;
+    }
+    this->arrival.wait(lock, [this, &arrival_generation] {
+      return this->generation != arrival_generation or this->aborted;
+    });
+    if (this->generation == arrival_generation) {
+      this->check_aborted();
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void ThreadGroup::publish(const int & rank, const void * address) {
+    {
+      std::lock_guard<std::mutex> lock{this->mutex};
+      this->addresses[rank] = address;
+    }
+    this->barrier();
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void ThreadGroup::post(const int & source, const int & dest, const int & tag,
+                         const void * data, const size_t & nb_bytes) {
+    if (dest < 0 or dest >= this->nb_ranks) {
+      std::stringstream error{};
+      error << "Rank " << source << " can't send to rank " << dest
+            << " in a thread group of " << this->nb_ranks << " ranks";
+      throw RuntimeError(error.str());
+    }
+    const char * bytes{static_cast<const char *>(data)};
+    std::vector<char> message(bytes, bytes + nb_bytes);
+    {
+      std::lock_guard<std::mutex> lock{this->mutex};
+      this->check_aborted();
+      this->messages[MessageKey_t{source, dest, tag}].push_back(
+          std::move(message));
+    }
+    this->delivery.notify_all();
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void ThreadGroup::fetch(const int & source, const int & dest,
+                          const int & tag, void * data,
+                          const size_t & nb_bytes) {
+    if (source < 0 or source >= this->nb_ranks) {
+      std::stringstream error{};
+      error << "Rank " << dest << " can't receive from rank " << source
+            << " in a thread group of " << this->nb_ranks << " ranks";
+      throw RuntimeError(error.str());
+    }
+    std::unique_lock<std::mutex> lock{this->mutex};
+    auto & queue{this->messages[MessageKey_t{source, dest, tag}]};
+    this->delivery.wait(
+        lock, [this, &queue] { return not queue.empty() or this->aborted; });
+    this->check_aborted();
+    std::vector<char> message{std::move(queue.front())};
+    queue.pop_front();
+    lock.unlock();
+    if (message.size() > nb_bytes) {
+      std::stringstream error{};
+      error << "Rank " << dest << " received a message of " << message.size()
+            << " bytes from rank " << source << " (tag " << tag
+            << "), but the receive buffer only holds " << nb_bytes
+            << " bytes";
+      throw RuntimeError(error.str());
+    }
+    std::memcpy(data, message.data(), message.size());
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void ThreadGroup::abort(std::exception_ptr error) {
+    {
+      std::lock_guard<std::mutex> lock{this->mutex};
+      if (not this->aborted) {
+        this->error = error;
+      }
+      this->aborted = true;
+    }
+    this->arrival.notify_all();
+    this->delivery.notify_all();
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void ThreadGroup::rethrow_error() const {
+    if (this->error) {
+      std::rethrow_exception(this->error);
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void ThreadGroup::check_aborted() const {
+    if (this->aborted) {
+      throw RuntimeError("The thread group has been aborted because another "
+                         "rank failed");
+    }
+  }
+
+}  // namespace muGrid
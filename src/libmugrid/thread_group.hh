@@ -0,0 +1,215 @@
+/**
+ * @file   thread_group.hh
+ *
+ * @author Lars Pastewka <lars.pastewka@imtek.uni-freiburg.de>
+ *
+ * @date   16 Oct 2026
+ *
+ * @brief  group of threads that act as the ranks of a communicator
+ *
+ * Copyright © 2026 Lars Pastewka
+ *
+ * µGrid is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * µGrid is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with µGrid; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * Additional permission under GNU GPL version 3 section 7
+ *
+ * If you modify this Program, or any covered work, by linking or combining it
+ * with proprietary FFT implementations or numerical libraries, containing parts
+ * covered by the terms of those libraries' licenses, the licensors of this
+ * Program grant you additional permission to convey the resulting work.
+ *
+ */
+
+#ifndef SRC_LIBMUGRID_THREAD_GROUP_HH_
+#define SRC_LIBMUGRID_THREAD_GROUP_HH_
+
+#include "grid_common.hh"
+#include "exception.hh"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <tuple>
+#include <vector>
+
+namespace muGrid {
+
+  /**
+   * State shared by a group of threads of the same process that act as the
+   * ranks of a communicator (see `Communicator::run_on_threads`). This makes
+   * it possible to exercise rank-dependent code paths (decompositions, ghost
+   * exchange, gathers, scans, ...) without MPI.
+   *
+   * Collective operations are implemented without copies through the shared
+   * address space: every rank publishes the address of its argument, waits
+   * for all other ranks and then reads the arguments of its peers directly.
+   * A final barrier guarantees that no argument goes out of scope while it is
+   * still read. Point-to-point messages are buffered, i.e. a send completes
+   * immediately and the matching receive copies the message out of the
+   * buffer.
+   *
+   * All ranks must call the collective operations in the same order, as with
+   * MPI. An exception on any rank aborts the group: all ranks that are
+   * waiting on (or later enter) an operation of the group throw a
+   * `RuntimeError`, such that a failing rank can not deadlock the others.
+   */
+  class ThreadGroup {
+   public:
+    //! Default constructor
+    ThreadGroup() = delete;
+
+    //! constructor for a group of `nb_ranks` ranks
+    explicit ThreadGroup(const int & nb_ranks);
+
+    //! Copy constructor
+    ThreadGroup(const ThreadGroup & other) = delete;
+
+    //! Move constructor
+    ThreadGroup(ThreadGroup && other) = delete;
+
+    //! Destructor
+    ~ThreadGroup() = default;
+
+    //! Copy assignment operator
+    ThreadGroup & operator=(const ThreadGroup & other) = delete;
+
+    //! Move assignment operator
+    ThreadGroup & operator=(ThreadGroup && other) = delete;
+
+    //! number of ranks of the group
+    const int & size() const;
+
+    //! block until all ranks of the group have called `barrier`
+    void barrier();
+
+    /**
+     * make `address` available to the other ranks through `get_published`
+     * and block until all ranks have published their address
+     */
+    void publish(const int & rank, const void * address);
+
+    //! address published by `rank` in the present collective operation
+    template <typename T>
+    const T * get_published(const int & rank) const {
+      return static_cast<const T *>(this->addresses[rank]);
+    }
+
+    /**
+     * combine the `count` values pointed to by `values` on all ranks with
+     * `operation`, which is called as `operation(in, inout)` and has to
+     * combine `in` into `inout`. The values of all ranks are combined in the
+     * order of the ranks, hence all ranks obtain bitwise identical results.
+     */
+    template <typename T, typename Operation>
+    void allreduce(const int & rank, T * values, const Index_t & count,
+                   Operation && operation) {
+      this->publish(rank, values);
+      const T * first{this->get_published<T>(0)};
+      std::vector<T> result(first, first + count);
+      for (int peer{1}; peer < this->nb_ranks; ++peer) {
+        const T * peer_values{this->get_published<T>(peer)};
+        for (Index_t i{0}; i < count; ++i) {
+          operation(peer_values[i], result[i]);
+        }
+      }
+      this->barrier();
+      std::copy(result.begin(), result.end(), values);
+    }
+
+    /**
+     * personalised all-to-all exchange (the equivalent of `MPI_Alltoallv`):
+     * `send_counts[p]` values of `send_buf` are sent to rank `p` and
+     * `recv_counts[p]` values are received from rank `p`, the blocks for the
+     * individual ranks are contiguous and ordered by rank. Every rank copies
+     * its blocks directly out of the send buffers of its peers.
+     */
+    template <typename T>
+    void alltoallv(const int & rank, const T * send_buf,
+                   const std::vector<int> & send_counts, T * recv_buf,
+                   const std::vector<int> & recv_counts) {
+      const std::tuple<const T *, const std::vector<int> *> own{send_buf,
+                                                                &send_counts};
+      this->publish(rank, &own);
+      for (int peer{0}; peer < this->nb_ranks; ++peer) {
+        auto && peer_data{*this->get_published<
+            std::tuple<const T *, const std::vector<int> *>>(peer)};
+        const std::vector<int> & peer_counts{*std::get<1>(peer_data)};
+        if (peer_counts[rank] != recv_counts[peer]) {
+          this->barrier();
+          std::stringstream error{};
+          error << "Rank " << rank << " expects " << recv_counts[peer]
+                << " values from rank " << peer << ", which sends "
+                << peer_counts[rank];
+          throw RuntimeError(error.str());
+        }
+        Index_t offset{0};
+        for (int p{0}; p < rank; ++p) {
+          offset += peer_counts[p];
+        }
+        const T * block{std::get<0>(peer_data) + offset};
+        std::copy(block, block + peer_counts[rank], recv_buf);
+        recv_buf += recv_counts[peer];
+      }
+      this->barrier();
+    }
+
+    //! buffer a copy of a message of `nb_bytes` bytes from rank `source` to
+    //! rank `dest`
+    void post(const int & source, const int & dest, const int & tag,
+              const void * data, const size_t & nb_bytes);
+
+    /**
+     * block until a message from rank `source` to rank `dest` with tag `tag`
+     * has been posted and copy it to `data`, which holds at most `nb_bytes`
+     * bytes. Messages with the same source, destination and tag are
+     * received in the order in which they were posted.
+     */
+    void fetch(const int & source, const int & dest, const int & tag,
+               void * data, const size_t & nb_bytes);
+
+    //! abort the group because of `error`, which is kept if it is the first
+    //! error of the group
+    void abort(std::exception_ptr error);
+
+    //! rethrow the first error of the group, if there is one
+    void rethrow_error() const;
+
+   protected:
+    //! throw if the group has been aborted, the mutex must be held
+    void check_aborted() const;
+
+    //! key of the messages from source to destination with a tag
+    using MessageKey_t = std::tuple<int, int, int>;
+
+    int nb_ranks;                              //!< number of ranks
+    std::mutex mutex{};                        //!< protects the state below
+    std::condition_variable arrival{};         //!< signals complete barriers
+    std::condition_variable delivery{};        //!< signals posted messages
+    int nb_arrived{0};                         //!< ranks in the barrier
+    Index_t generation{0};                     //!< counts complete barriers
+    std::vector<const void *> addresses;       //!< published addresses
+    std::map<MessageKey_t, std::deque<std::vector<char>>> messages{};
+    bool aborted{false};                       //!< whether a rank failed
+    std::exception_ptr error{};                //!< first error of the group
+  };
+
+}  // namespace muGrid
+
+#endif  // SRC_LIBMUGRID_THREAD_GROUP_HH_
@@ -0,0 +1,182 @@
+/**
+ * @file   thread_pool.cc
+ *
+ * @author Lars Pastewka <lars.pastewka@imtek.uni-freiburg.de>
+ *
+ * @date   16 Oct 2026
+ *
+ * @brief  Persistent pool of worker threads for shared-memory
+ *         parallel loops
+ *
+ * Copyright © 2026 Lars Pastewka
+ *
+ * µGrid is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * µGrid is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with µGrid; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * Additional permission under GNU GPL version 3 section 7
+ *
+ * If you modify this Program, or any covered work, by linking or combining it
+ * with proprietary FFT implementations or numerical libraries, containing parts
+ * covered by the terms of those libraries' licenses, the licensors of this
+ * Program grant you additional permission to convey the resulting work.
+ *
+ */
+
+#include "thread_pool.hh"
+#include "exception.hh"
+
+#include <algorithm>
+#include <sstream>
+
+namespace muGrid {
+
+  /* ---------------------------------------------------------------------- */
+  ThreadPool::ThreadPool(const Index_t & nb_threads) : nb_threads{nb_threads} {
+    if (nb_threads < 1) {
+      std::stringstream error{};
+      error << "A thread pool needs at least one thread, but " << nb_threads
+            << " were requested.";
+      throw RuntimeError(error.str());
+    }
+    for (Index_t thread_id{1}; thread_id < nb_threads; ++thread_id) {
+      this->workers.emplace_back(&ThreadPool::work, this, thread_id);
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  ThreadPool::~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock{this->mutex};
+      this->shutting_down = true;
+    }
+    this->start.notify_all();
+    for (auto && worker : this->workers) {
+      worker.join();
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  const Index_t & ThreadPool::get_nb_threads() const {
+    return this->nb_threads;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void ThreadPool::run(const Task_t & task) {
+    if (this->workers.empty()) {
+      task(0);
+      return;
+    }
+    bool idle{false};
+    if (not this->busy.compare_exchange_strong(idle, true)) {
+      // the pool is executing another task (possibly the one calling us)
+      for (Index_t thread_id{0}; thread_id < this->nb_threads; ++thread_id) {
+        task(thread_id);
+      }
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock{this->mutex};
+      this->task = &task;
+      this->nb_busy = static_cast<Index_t>(this->workers.size());
+      this->error = nullptr;
+      ++this->generation;
+    }
+    this->start.notify_all();
+
+    std::exception_ptr own_error{};
+    try {
+      task(0);
+    } catch (...) {
+      own_error = std::current_exception();
+    }
+
+    std::unique_lock<std::mutex> lock{this->mutex};
+    this->done.wait(lock, [this] { return this->nb_busy == 0; });
+    this->task = nullptr;
+    this->busy = false;
+    if (own_error) {
+      std::rethrow_exception(own_error);
+    }
+    if (this->error) {
+      std::rethrow_exception(this->error);
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void ThreadPool::parallel_for(const Index_t & begin, const Index_t & end,
+                                const Range_t & body) {
+    const Index_t nb_chunks{this->nb_threads};
+    this->run([&begin, &end, &body, &nb_chunks](const Index_t & thread_id) {
+      auto && chunk{get_chunk(begin, end, nb_chunks, thread_id)};
+      if (std::get<0>(chunk) < std::get<1>(chunk)) {
+        body(std::get<0>(chunk), std::get<1>(chunk));
+      }
+    });
+  }
+
+  /* ---------------------------------------------------------------------- */
+  std::tuple<Index_t, Index_t>
+  ThreadPool::get_chunk(const Index_t & begin, const Index_t & end,
+                        const Index_t & nb_chunks, const Index_t & thread_id) {
+    const Index_t size{std::max(end - begin, Index_t{0})};
+    const Index_t chunk_size{size / nb_chunks};
+    const Index_t remainder{size % nb_chunks};
+    // the first `remainder` chunks get one additional entry
+    const Index_t chunk_begin{begin + thread_id * chunk_size +
+                              std::min(thread_id, remainder)};
+    const Index_t chunk_end{chunk_begin + chunk_size +
+                            (thread_id < remainder ? 1 : 0)};
+    return std::make_tuple(chunk_begin, chunk_end);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void ThreadPool::work(const Index_t & thread_id) {
+    Index_t last_generation{0};
+    while (true) {
+      const Task_t * current_task{nullptr};
+      {
+        std::unique_lock<std::mutex> lock{this->mutex};
+        this->start.wait(lock, [this, &last_generation] {
+          return this->shutting_down or this->generation != last_generation;
+        });
+        if (this->shutting_down) {
+          return;
+        }
+        last_generation = this->generation;
+        current_task = this->task;
+      }
+
+      std::exception_ptr task_error{};
+      try {
+        (*current_task)(thread_id);
+      } catch (...) {
+        task_error = std::current_exception();
+      }
+
+      bool is_last{false};
+      {
+        std::lock_guard<std::mutex> lock{this->mutex};
+        if (task_error and not this->error) {
+          this->error = task_error;
+        }
+        is_last = --this->nb_busy == 0;
+      }
+      if (is_last) {
+        this->done.notify_one();
+      }
+    }
+  }
+
+}  // namespace muGrid
@@ -0,0 +1,142 @@
+/**
+ * @file   thread_pool.hh
+ *
+ * @author Lars Pastewka <lars.pastewka@imtek.uni-freiburg.de>
+ *
+ * @date   16 Oct 2026
+ *
+ * @brief  Persistent pool of worker threads for shared-memory
+ *         parallel loops
+ *
+ * Copyright © 2026 Lars Pastewka
+ *
+ * µGrid is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * µGrid is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with µGrid; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * Additional permission under GNU GPL version 3 section 7
+ *
+ * If you modify this Program, or any covered work, by linking or combining it
+ * with proprietary FFT implementations or numerical libraries, containing parts
+ * covered by the terms of those libraries' licenses, the licensors of this
+ * Program grant you additional permission to convey the resulting work.
+ *
+ */
+
+#ifndef SRC_LIBMUGRID_THREAD_POOL_HH_
+#define SRC_LIBMUGRID_THREAD_POOL_HH_
+
+#include "grid_common.hh"
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace muGrid {
+
+  /**
+   * A fixed set of worker threads that repeatedly execute tasks on behalf of
+   * a calling thread. The work is split statically (every thread always gets
+   * the same chunk for the same loop), such that results that depend on the
+   * order of floating-point operations are reproducible for a fixed number of
+   * threads. The calling thread participates as thread 0, hence a pool of
+   * `nb_threads` threads spawns `nb_threads - 1` workers and a pool with a
+   * single thread runs everything on the calling thread.
+   *
+   * A pool executes one task at a time. A task submitted while the pool is
+   * busy, be it from another thread or from within one of the pool's own
+   * tasks, is executed serially on the submitting thread instead, calling it
+   * once for every thread id in turn. As the split depends on the thread id
+   * only, the result is the same either way. A pool must not be destroyed
+   * while a task is running.
+   */
+  class ThreadPool {
+   public:
+    //! signature of a task, called with the id of the executing thread
+    using Task_t = std::function<void(const Index_t & thread_id)>;
+    //! signature of a loop body, called with a half-open range [begin, end)
+    using Range_t =
+        std::function<void(const Index_t & begin, const Index_t & end)>;
+
+    //! Default constructor
+    ThreadPool() = delete;
+
+    //! constructor, spawns `nb_threads - 1` workers
+    explicit ThreadPool(const Index_t & nb_threads);
+
+    //! Copy constructor
+    ThreadPool(const ThreadPool & other) = delete;
+
+    //! Move constructor
+    ThreadPool(ThreadPool && other) = delete;
+
+    //! Destructor, joins the workers
+    ~ThreadPool();
+
+    //! Copy assignment operator
+    ThreadPool & operator=(const ThreadPool & other) = delete;
+
+    //! Move assignment operator
+    ThreadPool & operator=(ThreadPool && other) = delete;
+
+    //! number of threads (including the calling thread)
+    const Index_t & get_nb_threads() const;
+
+    /**
+     * execute `task` once on every thread of the pool and return once all
+     * threads have finished. An exception thrown by any of the threads is
+     * rethrown on the calling thread. If the pool is busy, `task` is called
+     * for every thread id in turn on the calling thread.
+     */
+    void run(const Task_t & task);
+
+    /**
+     * split the range [begin, end) into `get_nb_threads()` contiguous chunks
+     * of (nearly) equal size and call `body` on each chunk in parallel
+     */
+    void parallel_for(const Index_t & begin, const Index_t & end,
+                      const Range_t & body);
+
+    //! returns the chunk of the range [begin, end) processed by `thread_id`
+    //! when it is split into `nb_chunks` parts
+    static std::tuple<Index_t, Index_t> get_chunk(const Index_t & begin,
+                                                  const Index_t & end,
+                                                  const Index_t & nb_chunks,
+                                                  const Index_t & thread_id);
+
+   protected:
+    //! main loop of the worker threads
+    void work(const Index_t & thread_id);
+
+    Index_t nb_threads;                  //!< including the calling thread
+    std::vector<std::thread> workers{};  //!< worker threads
+    std::mutex mutex{};                  //!< protects the state below
+    std::condition_variable start{};     //!< signals a new task
+    std::condition_variable done{};      //!< signals the end of a task
+    const Task_t * task{nullptr};        //!< task currently executed
+    Index_t generation{0};               //!< counts the tasks started
+    Index_t nb_busy{0};                  //!< workers still executing
+    bool shutting_down{false};           //!< tells the workers to exit
+    std::exception_ptr error{};          //!< first exception of a task
+    std::atomic<bool> busy{false};       //!< whether a task is running
+  };
+
+}  // namespace muGrid
+
+#endif  // SRC_LIBMUGRID_THREAD_POOL_HH_
@@ -443,6 +443,15 @@ namespace muGrid {
     return tmp;
   }
 
+  /* ---------------------------------------------------------------------- */
+  Unit Unit::reciprocal() const {
+    Unit tmp{this->tag};
+    for (int i{0}; i < NbUnits; ++i) {
+      tmp.units[i] = UnitExponent(0) / this->units[i];
+    }
+    return tmp;
+  }
+
   /* ---------------------------------------------------------------------- */
   Unit::Unit(const Int & tag)
       : units{[]() {
@@ -255,6 +255,9 @@ namespace muGrid {
     //! division
     Unit operator/(const Unit & other) const;
 
+    //! reciprocal, the unit of one over a quantity of this unit
+    Unit reciprocal() const;
+
     friend std::ostream & operator<<(std::ostream &, const Unit & unit);
 
    protected:
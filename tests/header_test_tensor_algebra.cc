@@ -336,6 +336,56 @@ namespace muGrid {
     auto && err_4{testGoodies::rel_error(Fix::m4, m4_back)};
     BOOST_CHECK_LT(err_4, Fix::tol);
   }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(batched_algebra, Fix,
+                                   testGoodies::multidimlist, Fix) {
+    constexpr Dim_t dim{Fix::dim};
+    constexpr Dim_t Width{simd_width<Real>() + 1};
+    using T2_t = Batches::T2Batch<Real, dim, Width>;
+    using T4_t = Batches::T4Batch<Real, dim, Width>;
+    T2_t A{}, B{};
+    T4_t C{}, D{};
+    for (Dim_t point{0}; point < Width; ++point) {
+      A.set_point(point, Matrices::Tens2_t<dim>::Random());
+      B.set_point(point, Matrices::Tens2_t<dim>::Random());
+      C.set_point(point, Matrices::Tens4_t<dim>::Random());
+      D.set_point(point, Matrices::Tens4_t<dim>::Random());
+    }
+
+    const auto stress{Batches::tensmult<dim>(C, A)};
+    const auto product{Batches::dot<dim>(A, B)};
+    const auto stiffness{Batches::ddot<dim>(C, D)};
+    const auto outer{Batches::outer<dim>(A, B)};
+    const auto transposed{Batches::transpose(A)};
+    const auto traces{Batches::trace(A)};
+    const auto contractions{Batches::ddot<dim>(A, B)};
+    const auto shifted{A + Batches::I2<Real, dim, Width>()};
+    for (Dim_t point{0}; point < Width; ++point) {
+      const auto a{A.get_point(point)};
+      const auto b{B.get_point(point)};
+      const auto c{C.get_point(point)};
+      const auto d{D.get_point(point)};
+      Real error{
+          (stress.get_point(point) - Matrices::tensmult(c, a)).norm()};
+      BOOST_CHECK_LT(error, tol);
+      error = (product.get_point(point) - a * b).norm();
+      BOOST_CHECK_LT(error, tol);
+      error = (stiffness.get_point(point) - c * d).norm();
+      BOOST_CHECK_LT(error, tol);
+      error = (outer.get_point(point) - Matrices::outer(a, b)).norm();
+      BOOST_CHECK_LT(error, tol);
+      error = (transposed.get_point(point) - a.transpose()).norm();
+      BOOST_CHECK_LT(error, tol);
+      BOOST_CHECK_LT(std::abs(traces(point) - a.trace()), tol);
+      BOOST_CHECK_LT(
+          std::abs(contractions(point) - (a.array() * b.array()).sum()), tol);
+      error = (shifted.get_point(point) - a -
+               Matrices::I2<dim>()).norm();
+      BOOST_CHECK_LT(error, tol);
+    }
+  }
+
   BOOST_AUTO_TEST_SUITE_END();
 
 }  // namespace muGrid
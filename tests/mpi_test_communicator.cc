@@ -37,6 +37,7 @@
 #include "tests.hh"
 
 #include "libmugrid/communicator.hh"
+#include "libmugrid/reduction_batch.hh"
 
 namespace muGrid {
   BOOST_AUTO_TEST_SUITE(mpi_communicator_test);
@@ -254,6 +255,94 @@ namespace muGrid {
     }
   }
 
+  // ----------------------------------------------------------------------
+  BOOST_AUTO_TEST_CASE(non_blocking_collectives_test) {
+    auto & comm{MPIContext::get_context().comm};
+    const auto rank{comm.rank()};
+    const auto nb_cores{comm.size()};
+
+    // start all reductions before waiting for any of them, the arguments may
+    // go out of scope while the reductions are pending
+    auto sum_request{comm.isum(Real(rank + 1))};
+    auto max_request{comm.imax(Index_t{rank})};
+    auto matrix_sum_request{[&comm]() {
+      Eigen::Matrix<Real, 2, 3> send_mat{};
+      send_mat << 1., 2., 3., 4., 5., 6.;
+      return comm.isum(send_mat);
+    }()};
+    const Index_t nb_cols{rank + 2};
+    DynMatrix_t<Real> send_gather(2, nb_cols);
+    for (Index_t col{0}; col < nb_cols; ++col) {
+      send_gather.col(col).setConstant(rank + col);
+    }
+    auto gather_request{comm.template igather<Real>(send_gather)};
+
+    // 1 + 2 + 3 + ... + n = n*(n+1)/2
+    BOOST_CHECK_EQUAL(sum_request.wait(), nb_cores * (nb_cores + 1) / 2);
+    BOOST_CHECK(sum_request.test());
+    BOOST_CHECK_EQUAL(max_request.wait(), nb_cores - 1);
+    auto && matrix_sum{matrix_sum_request.wait()};
+    for (Index_t row{0}; row < matrix_sum.rows(); ++row) {
+      for (Index_t col{0}; col < matrix_sum.cols(); ++col) {
+        BOOST_CHECK_EQUAL(matrix_sum(row, col),
+                          (row * matrix_sum.cols() + col + 1) * nb_cores);
+      }
+    }
+    while (not gather_request.test()) {
+    }
+    auto && gathered{gather_request.wait()};
+    BOOST_CHECK_EQUAL(gathered, comm.template gather<Real>(send_gather));
+
+    // nothing to gather anywhere
+    DynMatrix_t<Real> send_empty(0, 0);
+    auto empty_request{comm.template igather<Real>(send_empty)};
+    BOOST_CHECK(empty_request.test());
+    BOOST_CHECK_EQUAL(empty_request.wait().size(), 0);
+
+    // a moved-from request no longer refers to the operation
+    auto moved_request{std::move(empty_request)};
+    BOOST_CHECK_EQUAL(moved_request.wait().size(), 0);
+    BOOST_CHECK_THROW(empty_request.test(), RuntimeError);
+    BOOST_CHECK_THROW(empty_request.wait(), RuntimeError);
+  }
+
+  // ----------------------------------------------------------------------
+  BOOST_AUTO_TEST_CASE(reduction_batch_test) {
+    auto & comm{MPIContext::get_context().comm};
+    const auto rank{comm.rank()};
+    const auto nb_cores{comm.size()};
+
+    ReductionBatch batch{comm};
+    auto real_sum{batch.sum(Real(rank + 1))};
+    auto int_max{batch.max(Int(rank))};
+    auto index_min{batch.min(Index_t{rank + 5})};
+    auto real_min{batch.min(Real(-rank))};
+    auto index_sum{batch.sum(Index_t{1})};
+    BOOST_CHECK_EQUAL(batch.size(), 5);
+    BOOST_CHECK_EQUAL(batch.get_nb_pending(), 5);
+    BOOST_CHECK_THROW(batch.get(real_sum), RuntimeError);
+
+    batch.flush();
+    BOOST_CHECK_EQUAL(batch.get_nb_pending(), 0);
+    // 1 + 2 + 3 + ... + n = n*(n+1)/2
+    BOOST_CHECK_EQUAL(batch.get(real_sum), nb_cores * (nb_cores + 1) / 2);
+    BOOST_CHECK_EQUAL(batch.get(int_max), nb_cores - 1);
+    BOOST_CHECK_EQUAL(batch.get(index_min), 5);
+    BOOST_CHECK_EQUAL(batch.get(real_min), -(nb_cores - 1));
+    BOOST_CHECK_EQUAL(batch.get(index_sum), nb_cores);
+
+    // values queued after a flush are reduced by the next one
+    auto second_sum{batch.sum(Real(2 * rank))};
+    BOOST_CHECK_THROW(batch.get(second_sum), RuntimeError);
+    batch.flush();
+    BOOST_CHECK_EQUAL(batch.get(second_sum), nb_cores * (nb_cores - 1));
+    BOOST_CHECK_EQUAL(batch.get(real_sum), nb_cores * (nb_cores + 1) / 2);
+
+    batch.clear();
+    BOOST_CHECK_EQUAL(batch.size(), 0);
+    batch.flush();
+  }
+
   BOOST_AUTO_TEST_SUITE_END();
 
 }  // namespace muGrid
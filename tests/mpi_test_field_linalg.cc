@@ -0,0 +1,121 @@
+/**
+ * @file   mpi_test_field_linalg.cc
+ *
+ * @author Lars Pastewka <lars.pastewka@imtek.uni-freiburg.de>
+ *
+ * @date   16 Oct 2026
+ *
+ * @brief  tests for the distributed reductions on fields
+ *
+ * Copyright © 2026 Lars Pastewka
+ *
+ * µGrid is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * µGrid is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with µGrid; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * Additional permission under GNU GPL version 3 section 7
+ *
+ * If you modify this Program, or any covered work, by linking or combining it
+ * with proprietary FFT implementations or numerical libraries, containing parts
+ * covered by the terms of those libraries' licenses, the licensors of this
+ * Program grant you additional permission to convey the resulting work.
+ *
+ */
+
+#include "tests.hh"
+#include "mpi_context.hh"
+
+#include "libmugrid/ccoord_operations.hh"
+#include "libmugrid/field_collection_global.hh"
+#include "libmugrid/field_linalg.hh"
+#include "libmugrid/field_map.hh"
+
+namespace muGrid {
+  BOOST_AUTO_TEST_SUITE(mpi_field_linalg);
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(reductions_slab_decomposition) {
+    auto & comm{MPIContext::get_context().comm};
+    // decomposition into slabs along the first direction
+    const Index_t nb_slab_pts{3};
+    const DynCcoord_t nb_domain_grid_pts{comm.size() * nb_slab_pts, 4};
+    const DynCcoord_t nb_subdomain_grid_pts{nb_slab_pts, 4};
+    const DynCcoord_t subdomain_locations{comm.rank() * nb_slab_pts, 0};
+    GlobalFieldCollection fc{nb_domain_grid_pts, nb_subdomain_grid_pts,
+                             subdomain_locations, DynCcoord_t{2, 1},
+                             DynCcoord_t{1, 2}, comm};
+    auto & x{fc.register_real_field("x", 2)};
+    auto & y{fc.register_real_field("y", 2)};
+
+    // the ghosts hold garbage that must not contribute
+    auto && value{[](const DynCcoord_t & ccoord, const Index_t & dof) {
+      return Real(1 + dof + 10 * ccoord[0] + 100 * ccoord[1]);
+    }};
+    linalg::fill(Real{1e10}, x);
+    linalg::fill(Real{1e10}, y);
+    auto && x_map{x.get_pixel_map()};
+    auto && y_map{y.get_pixel_map()};
+    for (auto && ccoord : CcoordOps::DynamicPixels(nb_subdomain_grid_pts,
+                                                   subdomain_locations)) {
+      const Index_t index{fc.get_pixels().get_index(ccoord)};
+      for (Index_t dof{0}; dof < 2; ++dof) {
+        x_map[index](dof) = value(ccoord, dof);
+        y_map[index](dof) = 1;
+      }
+    }
+
+    // reference over the whole domain
+    Real x_sum{0}, x_squared_sum{0}, x_max{0};
+    for (auto && ccoord : CcoordOps::DynamicPixels(nb_domain_grid_pts)) {
+      for (Index_t dof{0}; dof < 2; ++dof) {
+        x_sum += value(ccoord, dof);
+        x_squared_sum += value(ccoord, dof) * value(ccoord, dof);
+        x_max = std::max(x_max, value(ccoord, dof));
+      }
+    }
+
+    BOOST_CHECK_EQUAL(linalg::dot(x, y), x_sum);
+    BOOST_CHECK_LE(std::abs(linalg::norm2(x) - std::sqrt(x_squared_sum)),
+                   tol * x_squared_sum);
+    BOOST_CHECK_EQUAL(linalg::max_abs(x), x_max);
+    auto && dots{linalg::dot_many<Real>({{x, y}, {x, x}, {y, y}})};
+    BOOST_REQUIRE_EQUAL(dots.size(), 3);
+    BOOST_CHECK_EQUAL(dots[0], x_sum);
+    BOOST_CHECK_EQUAL(dots[1], x_squared_sum);
+    BOOST_CHECK_EQUAL(dots[2], 2 * nb_domain_grid_pts[0] *
+                                   nb_domain_grid_pts[1]);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(reductions_explicit_communicator) {
+    auto & comm{MPIContext::get_context().comm};
+    // collections without ghost layers do not know the communicator
+    const DynCcoord_t nb_domain_grid_pts{comm.size() * 5, 3};
+    const DynCcoord_t nb_subdomain_grid_pts{5, 3};
+    const DynCcoord_t subdomain_locations{comm.rank() * 5, 0};
+    GlobalFieldCollection fc{nb_domain_grid_pts, nb_subdomain_grid_pts,
+                             subdomain_locations};
+    auto & x{fc.register_complex_field("x", 1)};
+    linalg::fill(Complex{0, 1}, x);
+    const Index_t nb_pixels{nb_domain_grid_pts[0] * nb_domain_grid_pts[1]};
+    BOOST_CHECK_EQUAL(linalg::dot(x, x, comm), Complex(nb_pixels));
+    BOOST_CHECK_EQUAL(linalg::dot_many<Complex>({{x, x}}, comm)[0],
+                      Complex(nb_pixels));
+    BOOST_CHECK_EQUAL(linalg::max_abs(x, comm), 1);
+    BOOST_CHECK_LE(std::abs(linalg::norm2(x, comm) - std::sqrt(nb_pixels)),
+                   tol);
+  }
+
+  BOOST_AUTO_TEST_SUITE_END();
+}  // namespace muGrid
@@ -0,0 +1,149 @@
+/**
+ * @file   mpi_test_field_redistribution.cc
+ *
+ * @author Lars Pastewka <lars.pastewka@imtek.uni-freiburg.de>
+ *
+ * @date   16 Oct 2026
+ *
+ * @brief  Parallel tests for the redistribution of fields between
+ *         decompositions
+ *
+ * Copyright © 2026 Lars Pastewka
+ *
+ * µGrid is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * µGrid is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with µGrid; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * Additional permission under GNU GPL version 3 section 7
+ *
+ * If you modify this Program, or any covered work, by linking or combining it
+ * with proprietary FFT implementations or numerical libraries, containing parts
+ * covered by the terms of those libraries' licenses, the licensors of this
+ * Program grant you additional permission to convey the resulting work.
+ *
+ */
+
+#include "tests.hh"
+#include "mpi_context.hh"
+
+#include "libmugrid/cartesian_decomposition.hh"
+#include "libmugrid/ccoord_operations.hh"
+#include "libmugrid/field_collection_global.hh"
+#include "libmugrid/field_map.hh"
+#include "libmugrid/field_redistribution.hh"
+#include "libmugrid/field_typed.hh"
+
+namespace muGrid {
+  BOOST_AUTO_TEST_SUITE(mpi_field_redistribution);
+
+  //! value of degree of freedom `dof` at the global pixel `ccoord`
+  static Real redistribution_value(const DynCcoord_t & ccoord,
+                                   const Index_t & dof) {
+    Real value{Real(dof)};
+    for (auto && c : ccoord) {
+      value = 100 * value + c;
+    }
+    return value;
+  }
+
+  //! fill the subdomain of `field` with `redistribution_value`
+  static void fill(RealField & field, const GlobalFieldCollection & fc) {
+    auto && map{field.get_pixel_map()};
+    for (auto && ccoord :
+         CcoordOps::DynamicPixels(fc.get_nb_subdomain_grid_pts(),
+                                  fc.get_subdomain_locations())) {
+      auto && values{map[fc.get_index(ccoord)]};
+      for (Index_t dof{0}; dof < values.size(); ++dof) {
+        values(dof) = redistribution_value(ccoord, dof);
+      }
+    }
+  }
+
+  //! check the subdomain of `field` against `redistribution_value`
+  static void check(RealField & field, const GlobalFieldCollection & fc) {
+    auto && map{field.get_pixel_map()};
+    for (auto && ccoord :
+         CcoordOps::DynamicPixels(fc.get_nb_subdomain_grid_pts(),
+                                  fc.get_subdomain_locations())) {
+      auto && values{map[fc.get_index(ccoord)]};
+      for (Index_t dof{0}; dof < values.size(); ++dof) {
+        BOOST_CHECK_EQUAL(values(dof), redistribution_value(ccoord, dof));
+      }
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(slabs_to_pencils) {
+    auto & comm{MPIContext::get_context().comm};
+    // every slab holds two layers, and the grid is large enough along the
+    // first two directions for any pencil decomposition (prime numbers of
+    // processes subdivide a single direction)
+    const Index_t nb_procs{comm.size()};
+    const DynCcoord_t nb_domain_grid_pts{nb_procs + 5, nb_procs + 4,
+                                         2 * nb_procs};
+    // slabs along the last direction onto a free decomposition of the first
+    // two directions
+    CartesianDecomposition slabs{nb_domain_grid_pts, comm,
+                                 DynCcoord_t{1, 1, comm.size()}};
+    CartesianDecomposition pencils{nb_domain_grid_pts, comm,
+                                   DynCcoord_t{0, 0, 1}};
+    GlobalFieldCollection source_fc{nb_domain_grid_pts.get_dim(),
+                                    {{"quad", 2}}};
+    GlobalFieldCollection target_fc{nb_domain_grid_pts.get_dim(),
+                                    {{"quad", 2}}};
+    slabs.initialise(source_fc);
+    pencils.initialise(target_fc);
+    auto & source{source_fc.register_real_field("field", 3, "quad")};
+    auto & target{target_fc.register_real_field("field", 3, "quad")};
+    fill(source, source_fc);
+
+    FieldRedistribution redistribution{source_fc, target_fc, comm};
+    redistribution.redistribute(source, target);
+    check(target, target_fc);
+
+    // and back again into a structure of arrays
+    source_fc.convert_storage_order(StorageOrder::RowMajor);
+    source.eigen_vec().setZero();
+    FieldRedistribution backwards{target_fc, source_fc, comm};
+    backwards.redistribute(target, source);
+    source_fc.convert_storage_order(StorageOrder::ColMajor);
+    check(source, source_fc);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(change_of_process_count) {
+    auto & comm{MPIContext::get_context().comm};
+    const DynCcoord_t nb_domain_grid_pts{7, 3};
+    // the whole domain on the first process, as if read from a restart file
+    // written by a serial run
+    const bool is_root{comm.rank() == 0};
+    GlobalFieldCollection source_fc{
+        nb_domain_grid_pts,
+        is_root ? nb_domain_grid_pts : DynCcoord_t{0, 0},
+        DynCcoord_t{0, 0}};
+    GlobalFieldCollection target_fc{nb_domain_grid_pts.get_dim()};
+    CartesianDecomposition{nb_domain_grid_pts, comm}.initialise(target_fc);
+    auto & source{source_fc.register_real_field("field", 2)};
+    auto & target{target_fc.register_real_field("field", 2)};
+    fill(source, source_fc);
+
+    FieldRedistribution redistribution{source_fc, target_fc, comm};
+    BOOST_CHECK_EQUAL(redistribution.get_nb_send_pixels(),
+                      is_root ? 7 * 3 : 0);
+    redistribution.redistribute(source, target);
+    check(target, target_fc);
+  }
+
+  BOOST_AUTO_TEST_SUITE_END();
+}  // namespace muGrid
@@ -0,0 +1,240 @@
+/**
+ * @file   mpi_test_ghosts.cc
+ *
+ * @author Lars Pastewka <lars.pastewka@imtek.uni-freiburg.de>
+ *
+ * @date   16 Oct 2026
+ *
+ * @brief  parallel tests for the ghost layers of global field collections
+ *
+ * Copyright © 2026 Till Junge
+ *
+ * µGrid is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * µGrid is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with µGrid; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * Additional permission under GNU GPL version 3 section 7
+ *
+ * If you modify this Program, or any covered work, by linking or combining it
+ * with proprietary FFT implementations or numerical libraries, containing parts
+ * covered by the terms of those libraries' licenses, the licensors of this
+ * Program grant you additional permission to convey the resulting work.
+ *
+ */
+
+#include "tests.hh"
+#include "mpi_context.hh"
+#include "test_discrete_gradient_operator.hh"
+#include "test_goodies.hh"
+
+#include "libmugrid/cartesian_decomposition.hh"
+#include "libmugrid/field_collection_global.hh"
+#include "libmugrid/field_map.hh"
+#include "libmugrid/field_typed.hh"
+#include "libmugrid/ccoord_operations.hh"
+#include "libmugrid/gradient_operator_default.hh"
+
+#include <boost/mpl/list.hpp>
+
+namespace muGrid {
+  BOOST_AUTO_TEST_SUITE(mpi_ghosts);
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(ghost_exchange_slab_decomposition) {
+    auto & comm{MPIContext::get_context().comm};
+    // decomposition into slabs along the first direction
+    const Index_t nb_slab_pts{3};
+    const DynCcoord_t nb_domain_grid_pts{comm.size() * nb_slab_pts, 4};
+    const DynCcoord_t nb_subdomain_grid_pts{nb_slab_pts, 4};
+    const DynCcoord_t subdomain_locations{comm.rank() * nb_slab_pts, 0};
+    const DynCcoord_t nb_ghosts_left{2, 1};
+    const DynCcoord_t nb_ghosts_right{1, 2};
+    GlobalFieldCollection fc{nb_domain_grid_pts, nb_subdomain_grid_pts,
+                             subdomain_locations, nb_ghosts_left,
+                             nb_ghosts_right, comm};
+    fc.set_nb_sub_pts("quad", 2);
+
+    const int left{(comm.rank() + comm.size() - 1) % comm.size()};
+    const int right{(comm.rank() + 1) % comm.size()};
+    BOOST_CHECK_EQUAL(fc.get_left_neighbour_ranks()[0], left);
+    BOOST_CHECK_EQUAL(fc.get_right_neighbour_ranks()[0], right);
+    BOOST_CHECK_EQUAL(fc.get_left_neighbour_ranks()[1], comm.rank());
+    BOOST_CHECK_EQUAL(fc.get_right_neighbour_ranks()[1], comm.rank());
+
+    auto & field{fc.register_real_field("field", 3, "quad")};
+    auto && value{[](const DynCcoord_t & ccoord, const Index_t & dof) {
+      return 1000 * dof + 10 * ccoord[0] + ccoord[1];
+    }};
+    field.eigen_vec().setConstant(-1);
+    auto && map{field.get_pixel_map()};
+    for (auto && ccoord : CcoordOps::DynamicPixels(nb_subdomain_grid_pts,
+                                                   subdomain_locations)) {
+      auto && pixel_vals{map[fc.get_pixels().get_index(ccoord)]};
+      for (Index_t dof{0}; dof < pixel_vals.size(); ++dof) {
+        pixel_vals(dof) = value(ccoord, dof);
+      }
+    }
+    field.communicate_ghosts();
+
+    // the ghosts (including the corners) hold the values of the neighbours
+    for (auto && id_ccoord : fc.get_pixels().enumerate()) {
+      auto && pixel_vals{map[std::get<0>(id_ccoord)]};
+      DynCcoord_t ccoord{(std::get<1>(id_ccoord) + nb_domain_grid_pts) %
+                         nb_domain_grid_pts};
+      for (Index_t dof{0}; dof < pixel_vals.size(); ++dof) {
+        BOOST_CHECK_EQUAL(pixel_vals(dof), value(ccoord, dof));
+      }
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(ghost_exchange_cartesian_decomposition) {
+    auto & comm{MPIContext::get_context().comm};
+    const DynCcoord_t nb_domain_grid_pts{7, 6, 5};
+    CartesianDecomposition decomposition{nb_domain_grid_pts, comm};
+    auto && nb_subdivisions{decomposition.get_nb_subdivisions()};
+    Index_t nb_procs{1};
+    for (auto && n : nb_subdivisions) {
+      nb_procs *= n;
+    }
+    BOOST_CHECK_EQUAL(nb_procs, comm.size());
+
+    // the subdomains tile the domain
+    auto && nb_subdomain_grid_pts{decomposition.get_nb_subdomain_grid_pts()};
+    Index_t nb_pixels{1};
+    for (auto && n : nb_subdomain_grid_pts) {
+      nb_pixels *= n;
+    }
+    BOOST_CHECK_EQUAL(comm.sum(nb_pixels), 7 * 6 * 5);
+
+    GlobalFieldCollection fc{nb_domain_grid_pts.get_dim()};
+    const DynCcoord_t nb_ghosts{1, 1, 1};
+    decomposition.initialise(fc, nb_ghosts, nb_ghosts);
+    for (Index_t d{0}; d < nb_domain_grid_pts.get_dim(); ++d) {
+      BOOST_CHECK_EQUAL(fc.get_left_neighbour_ranks()[d],
+                        decomposition.get_left_neighbour_ranks()[d]);
+      BOOST_CHECK_EQUAL(fc.get_right_neighbour_ranks()[d],
+                        decomposition.get_right_neighbour_ranks()[d]);
+    }
+
+    auto & field{fc.register_real_field("field", 1)};
+    auto && value{[](const DynCcoord_t & ccoord) {
+      return 100 * ccoord[0] + 10 * ccoord[1] + ccoord[2];
+    }};
+    field.eigen_vec().setConstant(-1);
+    auto && map{field.get_pixel_map()};
+    for (auto && ccoord :
+         CcoordOps::DynamicPixels(nb_subdomain_grid_pts,
+                                  decomposition.get_subdomain_locations())) {
+      map[fc.get_pixels().get_index(ccoord)](0) = value(ccoord);
+    }
+    field.communicate_ghosts();
+    for (auto && id_ccoord : fc.get_pixels().enumerate()) {
+      DynCcoord_t ccoord{(std::get<1>(id_ccoord) + nb_domain_grid_pts) %
+                         nb_domain_grid_pts};
+      BOOST_CHECK_EQUAL(map[std::get<0>(id_ccoord)](0), value(ccoord));
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(ghost_exchange_empty_subdomain) {
+    auto & comm{MPIContext::get_context().comm};
+    if (comm.size() < 2) {
+      return;
+    }
+    // the last process is empty, which is not a valid decomposition for
+    // ghost layers; all processes need to fail
+    const bool is_empty{comm.rank() + 1 == comm.size()};
+    const Index_t nb_slab_pts{3};
+    const DynCcoord_t nb_domain_grid_pts{(comm.size() - 1) * nb_slab_pts, 4};
+    const DynCcoord_t nb_subdomain_grid_pts{is_empty ? 0 : nb_slab_pts, 4};
+    const DynCcoord_t subdomain_locations{
+        is_empty ? 0 : comm.rank() * nb_slab_pts, 0};
+    GlobalFieldCollection fc{2};
+    BOOST_CHECK_THROW(fc.initialise(nb_domain_grid_pts, nb_subdomain_grid_pts,
+                                    subdomain_locations, DynCcoord_t{1, 1},
+                                    DynCcoord_t{1, 1}, comm),
+                      FieldCollectionError);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  using DOperatorFixtures =
+      boost::mpl::list<FixtureTriangularStraight, FixtureBilinearQuadrilat>;
+
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(gradient_overlapping_communication, Fix,
+                                   DOperatorFixtures, Fix) {
+    auto & comm{MPIContext::get_context().comm};
+    const Index_t nb_slab_pts{3};
+    const DynCcoord_t nb_domain_grid_pts{comm.size() * nb_slab_pts, 4};
+    const DynCcoord_t nb_subdomain_grid_pts{nb_slab_pts, 4};
+    const DynCcoord_t subdomain_locations{comm.rank() * nb_slab_pts, 0};
+    const DynCcoord_t nb_ghosts{1, 1};
+    const std::string nodal_pt_tag{"nodal_pt"};
+    const std::string quad_pt_tag{"quad_pt"};
+    const Index_t nb_quad_pts{Fix::NbQuadPerELement * Fix::NbElements};
+
+    // every process evaluates the full periodic domain as reference
+    GlobalFieldCollection reference{nb_domain_grid_pts, nb_domain_grid_pts};
+    GlobalFieldCollection distributed{
+        nb_domain_grid_pts, nb_subdomain_grid_pts, subdomain_locations,
+        nb_ghosts, nb_ghosts, comm};
+    for (auto * collection : {&reference, &distributed}) {
+      collection->set_nb_sub_pts(nodal_pt_tag, Fix::NbNode);
+      collection->set_nb_sub_pts(quad_pt_tag, nb_quad_pts);
+    }
+    auto & u_ref{reference.register_real_field("u", 1, nodal_pt_tag)};
+    auto & Bu_ref{reference.register_real_field("B·u", Fix::Dim, quad_pt_tag)};
+    auto & BTBu_ref{reference.register_real_field("BᵀB·u", 1, nodal_pt_tag)};
+    auto & u{distributed.register_real_field("u", 1, nodal_pt_tag)};
+    auto & Bu{distributed.register_real_field("B·u", Fix::Dim, quad_pt_tag)};
+    auto & BTBu{distributed.register_real_field("BᵀB·u", 1, nodal_pt_tag)};
+
+    auto && value{[](const DynCcoord_t & ccoord) {
+      return std::sin(1.3 * ccoord[0] + 0.7 * ccoord[1]) + 0.1 * ccoord[0];
+    }};
+    auto && u_ref_map{u_ref.get_pixel_map()};
+    for (auto && id_ccoord : reference.get_pixels().enumerate()) {
+      u_ref_map[std::get<0>(id_ccoord)] << value(std::get<1>(id_ccoord));
+    }
+    auto && u_map{u.get_pixel_map()};
+    CcoordOps::DynamicPixels subdomain{nb_subdomain_grid_pts,
+                                       subdomain_locations};
+    for (auto && ccoord : subdomain) {
+      u_map[distributed.get_pixels().get_index(ccoord)] << value(ccoord);
+    }
+
+    this->d_operator.apply_gradient(u_ref, Bu_ref);
+    this->d_operator.apply_transpose(Bu_ref, BTBu_ref);
+    // exchange the ghosts while evaluating the interior
+    this->d_operator.template begin_apply_gradient<Real>({&u}, {&Bu})
+        .finish();
+    this->d_operator.template begin_apply_transpose<Real>({&Bu}, {&BTBu})
+        .finish();
+
+    auto && Bu_ref_map{Bu_ref.get_pixel_map()};
+    auto && Bu_map{Bu.get_pixel_map()};
+    auto && BTBu_ref_map{BTBu_ref.get_pixel_map()};
+    auto && BTBu_map{BTBu.get_pixel_map()};
+    for (auto && ccoord : subdomain) {
+      auto && id{distributed.get_pixels().get_index(ccoord)};
+      auto && ref_id{reference.get_pixels().get_index(ccoord)};
+      BOOST_CHECK_LE(testGoodies::rel_error(Bu_map[id], Bu_ref_map[ref_id]),
+                     tol);
+      BOOST_CHECK_LE(
+          testGoodies::rel_error(BTBu_map[id], BTBu_ref_map[ref_id]), tol);
+    }
+  }
+
+  BOOST_AUTO_TEST_SUITE_END();
+}  // namespace muGrid
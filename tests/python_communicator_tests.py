@@ -126,6 +126,25 @@ class Communicator_Check(unittest.TestCase):
 
         self.assertTrue((a_gathered == a_ref.T).all())
 
+    def test_nonblocking_collectives(self):
+        try:
+            from mpi4py import MPI
+            comm = muGrid.Communicator(MPI.COMM_WORLD)
+        except ImportError:
+            comm = muGrid.Communicator()
+
+        sum_request = comm.isum(comm.rank + 3)
+        max_request = comm.imax(float(comm.rank))
+        a = np.arange(comm.rank*2+4, dtype=float).reshape((-1, 2)).T
+        gather_request = comm.igather(a)
+
+        # 1 + 2 + 3 + ... + n = n*(n+1)/2
+        self.assertEqual(sum_request.wait(),
+                         comm.size*(comm.size+1)/2 + 2*comm.size)
+        self.assertTrue(sum_request.test())
+        self.assertEqual(max_request.wait(), comm.size - 1)
+        self.assertTrue((gather_request.wait() == comm.gather(a)).all())
+
 
 if __name__ == '__main__':
     unittest.main()
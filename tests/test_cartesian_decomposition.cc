@@ -0,0 +1,97 @@
+/**
+ * @file   test_cartesian_decomposition.cc
+ *
+ * @author Lars Pastewka <lars.pastewka@imtek.uni-freiburg.de>
+ *
+ * @date   16 Oct 2026
+ *
+ * @brief  Tests for the automatic Cartesian decomposition
+ *
+ * Copyright © 2026 Lars Pastewka
+ *
+ * µGrid is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * µGrid is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with µGrid; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * Additional permission under GNU GPL version 3 section 7
+ *
+ * If you modify this Program, or any covered work, by linking or combining it
+ * with proprietary FFT implementations or numerical libraries, containing parts
+ * covered by the terms of those libraries' licenses, the licensors of this
+ * Program grant you additional permission to convey the resulting work.
+ *
+ */
+
+#include "tests.hh"
+
+#include "libmugrid/cartesian_decomposition.hh"
+#include "libmugrid/exception.hh"
+
+namespace muGrid {
+
+  BOOST_AUTO_TEST_SUITE(cartesian_decomposition);
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(process_grid) {
+    auto && grid{[](const DynCcoord_t & nb_grid_pts, const Index_t & nb_procs,
+                    const DynCcoord_t & nb_subdivisions = {}) {
+      return CartesianDecomposition::compute_process_grid(
+          nb_grid_pts, nb_procs, nb_subdivisions);
+    }};
+    // slabs across the short direction of elongated grids
+    BOOST_CHECK_EQUAL(grid({1024, 16}, 4), (DynCcoord_t{4, 1}));
+    BOOST_CHECK_EQUAL(grid({16, 1024}, 4), (DynCcoord_t{1, 4}));
+    // slabs, pencils and blocks for cubes with growing numbers of processes
+    BOOST_CHECK_EQUAL(grid({64, 64, 64}, 4), (DynCcoord_t{1, 1, 4}));
+    BOOST_CHECK_EQUAL(grid({64, 64, 64}, 16), (DynCcoord_t{1, 4, 4}));
+    BOOST_CHECK_EQUAL(grid({64, 64, 64}, 64), (DynCcoord_t{4, 4, 4}));
+    BOOST_CHECK_EQUAL(grid({64, 64, 64}, 1), (DynCcoord_t{1, 1, 1}));
+    // prescribed directions are kept
+    BOOST_CHECK_EQUAL(grid({32, 32}, 4, {2, 0}), (DynCcoord_t{2, 2}));
+    BOOST_CHECK_EQUAL(grid({64, 64, 64}, 8, {8, 0, 0}),
+                      (DynCcoord_t{8, 1, 1}));
+    // subdomains need at least one grid point
+    BOOST_CHECK_EQUAL(grid({2, 64}, 8), (DynCcoord_t{1, 8}));
+    BOOST_CHECK_THROW(grid({5, 3}, 7), RuntimeError);
+    BOOST_CHECK_THROW(grid({32, 32}, 4, {3, 0}), RuntimeError);
+    BOOST_CHECK_THROW(grid({32, 32}, 4, {2, 2, 1}), RuntimeError);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(serial_decomposition) {
+    const DynCcoord_t nb_domain_grid_pts{8, 6};
+    CartesianDecomposition decomposition{nb_domain_grid_pts};
+    BOOST_CHECK_EQUAL(decomposition.get_nb_subdivisions(),
+                      (DynCcoord_t{1, 1}));
+    BOOST_CHECK_EQUAL(decomposition.get_nb_subdomain_grid_pts(),
+                      nb_domain_grid_pts);
+    BOOST_CHECK_EQUAL(decomposition.get_subdomain_locations(),
+                      (DynCcoord_t{0, 0}));
+    for (auto && rank : decomposition.get_left_neighbour_ranks()) {
+      BOOST_CHECK_EQUAL(rank, 0);
+    }
+    for (auto && rank : decomposition.get_right_neighbour_ranks()) {
+      BOOST_CHECK_EQUAL(rank, 0);
+    }
+
+    GlobalFieldCollection fc{nb_domain_grid_pts.get_dim()};
+    decomposition.initialise(fc, {1, 1}, {1, 1});
+    BOOST_CHECK_EQUAL(fc.get_nb_subdomain_grid_pts(), nb_domain_grid_pts);
+    BOOST_CHECK_EQUAL(fc.get_nb_subdomain_grid_pts_with_ghosts(),
+                      (DynCcoord_t{10, 8}));
+  }
+
+  BOOST_AUTO_TEST_SUITE_END();
+
+}  // namespace muGrid
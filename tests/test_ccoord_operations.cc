@@ -147,6 +147,58 @@ namespace muGrid {
     BOOST_CHECK_EQUAL(c1 - c2, c1mc2);
   }
 
+  BOOST_AUTO_TEST_CASE(neighbour_table) {
+    // a padded grid with a region inside, and a stencil with offsets that
+    // reach beyond the direct neighbours
+    const DynCcoord_t nb_grid_pts{7, 6, 5};
+    const DynCcoord_t locations{-2, -1, 3};
+    const DynCcoord_t nb_region_grid_pts{4, 3, 2};
+    const DynCcoord_t region_locations{0, 0, 4};
+    CcoordOps::DynamicPixels pixels{nb_grid_pts, locations};
+    const std::vector<DynCcoord_t> offsets{
+        {0, 0, 0}, {1, 0, 0}, {-2, 1, 0}, {1, 1, 1}, {0, -1, -1}, {5, 0, 0}};
+
+    CcoordOps::DynamicPixels region{nb_region_grid_pts, region_locations};
+    // the last offset only fits into the grid when wrapping around
+    const std::vector<DynCcoord_t> within{offsets.begin(), offsets.end() - 1};
+    for (bool periodic : {true, false}) {
+      const std::vector<DynCcoord_t> & stencil{periodic ? offsets : within};
+      auto && table{pixels.get_neighbour_table(stencil, nb_region_grid_pts,
+                                               region_locations, periodic)};
+      BOOST_CHECK_EQUAL(table.size(), region.size());
+      BOOST_CHECK_EQUAL(table.get_nb_offsets(), stencil.size());
+      // any subrange must start counting at the right pixel
+      for (Index_t begin : {Index_t{0}, Index_t{5}}) {
+        Index_t i{begin};
+        table.for_each(
+            begin, table.size(),
+            [&](const Index_t & index, const Index_t * neighbour_ids) {
+              auto && ccoord{region.get_ccoord(i++)};
+              BOOST_CHECK_EQUAL(index, pixels.get_index(ccoord));
+              for (Index_t k{0}; k < table.get_nb_offsets(); ++k) {
+                DynCcoord_t neighbour{ccoord + stencil[k]};
+                if (periodic) {
+                  for (Index_t d{0}; d < 3; ++d) {
+                    const Index_t n{nb_region_grid_pts[d]};
+                    neighbour[d] =
+                        region_locations[d] +
+                        ((neighbour[d] - region_locations[d]) % n + n) % n;
+                  }
+                }
+                BOOST_CHECK_EQUAL(neighbour_ids[k],
+                                  pixels.get_index(neighbour));
+              }
+            });
+        BOOST_CHECK_EQUAL(i, table.size());
+      }
+    }
+
+    // without wrapping, all neighbours must be in the grid
+    BOOST_CHECK_THROW(pixels.get_neighbour_table(offsets, nb_region_grid_pts,
+                                                 region_locations, false),
+                      RuntimeError);
+  }
+
   BOOST_AUTO_TEST_SUITE_END();
 
 }  // namespace muGrid
@@ -0,0 +1,67 @@
+/**
+ * @file   test_communicator.cc
+ *
+ * @author Lars Pastewka <lars.pastewka@imtek.uni-freiburg.de>
+ *
+ * @date   16 Oct 2026
+ *
+ * @brief  Tests for the serial communicator
+ *
+ * Copyright © 2026 Lars Pastewka
+ *
+ * µGrid is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * µGrid is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with µGrid; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * Additional permission under GNU GPL version 3 section 7
+ *
+ * If you modify this Program, or any covered work, by linking or combining it
+ * with proprietary FFT implementations or numerical libraries, containing parts
+ * covered by the terms of those libraries' licenses, the licensors of this
+ * Program grant you additional permission to convey the resulting work.
+ *
+ */
+
+#include "tests.hh"
+
+#include "libmugrid/communicator.hh"
+
+namespace muGrid {
+  BOOST_AUTO_TEST_SUITE(communicator_test);
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(non_blocking_collectives_serial) {
+    // the same calls as in the parallel test need to compile and complete
+    // immediately with the serial communicator
+    Communicator comm{};
+    auto sum_request{comm.isum(Real(3))};
+    BOOST_CHECK(sum_request.test());
+    BOOST_CHECK_EQUAL(sum_request.wait(), 3);
+    auto max_request{comm.imax(Index_t{4})};
+    BOOST_CHECK_EQUAL(max_request.wait(), 4);
+
+    DynMatrix_t<Real> send_gather(2, 3);
+    send_gather << 1., 2., 3., 4., 5., 6.;
+    auto gather_request{comm.template igather<Real>(send_gather)};
+    BOOST_CHECK(gather_request.test());
+    BOOST_CHECK_EQUAL(gather_request.wait(), send_gather);
+
+    DynMatrix_t<Real> send_empty(0, 0);
+    auto empty_request{comm.template igather<Real>(send_empty)};
+    BOOST_CHECK_EQUAL(empty_request.wait().size(), 0);
+  }
+
+  BOOST_AUTO_TEST_SUITE_END();
+
+}  // namespace muGrid
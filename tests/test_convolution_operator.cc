@@ -0,0 +1,375 @@
+/**
+ * @file   test_convolution_operator.cc
+ *
+ * @author Lars Pastewka <lars.pastewka@imtek.uni-freiburg.de>
+ *
+ * @date   16 Oct 2026
+ *
+ * @brief  Tests for the convolution operator
+ *
+ * Copyright © 2026 Lars Pastewka
+ *
+ * µGrid is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * µGrid is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with µGrid; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * Additional permission under GNU GPL version 3 section 7
+ *
+ * If you modify this Program, or any covered work, by linking or combining it
+ * with proprietary FFT implementations or numerical libraries, containing parts
+ * covered by the terms of those libraries' licenses, the licensors of this
+ * Program grant you additional permission to convey the resulting work.
+ *
+ */
+
+#include "tests.hh"
+#include "mpi_context.hh"
+#include "test_goodies.hh"
+
+#include "libmugrid/convolution_operator.hh"
+#include "libmugrid/field_collection_global.hh"
+#include "libmugrid/field_map.hh"
+
+#include <cmath>
+
+namespace muGrid {
+
+  BOOST_AUTO_TEST_SUITE(convolution_operator);
+
+  //! the second-order finite-difference Laplacian on a unit grid
+  ConvolutionOperator make_laplacian(const Index_t & dim) {
+    std::vector<DynCcoord_t> offsets{DynCcoord_t(dim)};
+    std::vector<Eigen::MatrixXd> coefficients{
+        Eigen::MatrixXd::Constant(1, 1, -2. * dim)};
+    for (Index_t d{0}; d < dim; ++d) {
+      for (Index_t sign : {-1, 1}) {
+        DynCcoord_t offset(dim);
+        offset[d] = sign;
+        offsets.push_back(offset);
+        coefficients.push_back(Eigen::MatrixXd::Ones(1, 1));
+      }
+    }
+    return ConvolutionOperator{dim, offsets, coefficients};
+  }
+
+  /**
+   * an operator with random coefficients between two components on three
+   * input sub-points and three components on two output sub-points, and a
+   * stencil reaching two pixels in some directions
+   */
+  ConvolutionOperator make_random_operator() {
+    const std::vector<DynCcoord_t> offsets{{0, 0}, {1, 0},  {-2, 0},
+                                           {0, 2}, {0, -1}, {1, 1}};
+    std::vector<Eigen::MatrixXd> coefficients{};
+    for (size_t k{0}; k < offsets.size(); ++k) {
+      coefficients.push_back(Eigen::MatrixXd::Random(3 * 2, 2 * 3));
+    }
+    return ConvolutionOperator{twoD, offsets, coefficients, 3, 2};
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(laplacian) {
+    for (Index_t dim : {oneD, twoD, threeD}) {
+      auto && laplacian{make_laplacian(dim)};
+      BOOST_CHECK_EQUAL(laplacian.get_spatial_dim(), dim);
+      BOOST_CHECK_EQUAL(laplacian.get_nb_input_components(), 1);
+      BOOST_CHECK_EQUAL(laplacian.get_nb_output_components(), 1);
+      BOOST_CHECK_EQUAL(laplacian.get_offsets().size(), 2 * dim + 1);
+
+      // the Laplacian of a product of periodic sines is known exactly
+      auto && nb_grid_pts{CcoordOps::get_cube(dim, Index_t{6})};
+      GlobalFieldCollection collection{nb_grid_pts, nb_grid_pts};
+      auto & u{collection.register_real_field("u", 1)};
+      auto & lap_u{collection.register_real_field("Δu", 1)};
+      auto & ref{collection.register_real_field("reference", 1)};
+      auto && u_map{u.get_pixel_map()};
+      auto && ref_map{ref.get_pixel_map()};
+      const Real k{2 * pi / nb_grid_pts[0]};
+      for (auto && id_ccoord : collection.get_pixels().enumerate()) {
+        auto && id{std::get<0>(id_ccoord)};
+        auto && ccoord{std::get<1>(id_ccoord)};
+        Real value{1.};
+        for (Index_t d{0}; d < dim; ++d) {
+          value *= std::sin(k * ccoord[d]);
+        }
+        u_map[id] << value;
+        ref_map[id] << dim * 2 * (std::cos(k) - 1) * value;
+      }
+      laplacian.apply(u, lap_u);
+      BOOST_CHECK_LE(
+          testGoodies::rel_error(lap_u.eigen_vec(), ref.eigen_vec()), tol);
+
+      // the increment adds to the output
+      laplacian.apply_increment(u, -.5, lap_u);
+      BOOST_CHECK_LE(testGoodies::rel_error(lap_u.eigen_vec(),
+                                            .5 * ref.eigen_vec()),
+                     tol);
+
+      // the Laplacian is symmetric
+      laplacian.apply_transpose(u, lap_u);
+      BOOST_CHECK_LE(
+          testGoodies::rel_error(lap_u.eigen_vec(), ref.eigen_vec()), tol);
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(several_grids) {
+    // the operator keeps the neighbour tables of every grid it is applied to
+    auto && laplacian{make_laplacian(twoD)};
+    for (Index_t nb : {6, 8, 6}) {
+      const DynCcoord_t nb_grid_pts{nb, nb + 1};
+      GlobalFieldCollection collection{nb_grid_pts, nb_grid_pts};
+      auto & u{collection.register_real_field("u", 1)};
+      auto & lap_u{collection.register_real_field("Δu", 1)};
+      auto & ref{collection.register_real_field("reference", 1)};
+      auto && u_map{u.get_pixel_map()};
+      auto && ref_map{ref.get_pixel_map()};
+      for (auto && id_ccoord : collection.get_pixels().enumerate()) {
+        auto && id{std::get<0>(id_ccoord)};
+        auto && ccoord{std::get<1>(id_ccoord)};
+        Real value{1.}, factor{0.};
+        for (Index_t d{0}; d < twoD; ++d) {
+          const Real k{2 * pi / nb_grid_pts[d]};
+          value *= std::sin(k * ccoord[d]);
+          factor += 2 * (std::cos(k) - 1);
+        }
+        u_map[id] << value;
+        ref_map[id] << factor * value;
+      }
+      laplacian.apply(u, lap_u);
+      BOOST_CHECK_LE(
+          testGoodies::rel_error(lap_u.eigen_vec(), ref.eigen_vec()), tol);
+      laplacian.apply_transpose(u, lap_u);
+      BOOST_CHECK_LE(
+          testGoodies::rel_error(lap_u.eigen_vec(), ref.eigen_vec()), tol);
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(components_and_sub_pts) {
+    auto && op{make_random_operator()};
+    BOOST_CHECK_EQUAL(op.get_nb_input_components(), 2);
+    BOOST_CHECK_EQUAL(op.get_nb_output_components(), 3);
+    BOOST_CHECK_EQUAL(op.get_nb_pixel_nodal_pts(), 3);
+    BOOST_CHECK_EQUAL(op.get_nb_pixel_quad_pts(), 2);
+
+    const DynCcoord_t nb_grid_pts{5, 4};
+    GlobalFieldCollection collection{nb_grid_pts, nb_grid_pts};
+    collection.set_nb_sub_pts("in", 3);
+    collection.set_nb_sub_pts("out", 2);
+    auto & u{collection.register_real_field("u", 2, "in")};
+    auto & v{collection.register_real_field("v", 3, "out")};
+    auto & Au{collection.register_real_field("A·u", 3, "out")};
+    auto & ATv{collection.register_real_field("Aᵀ·v", 2, "in")};
+    u.eigen_vec().setRandom();
+    v.eigen_vec().setRandom();
+
+    // compare to the stencil evaluated by hand on the periodic grid
+    op.apply(u, Au);
+    auto && pixels{collection.get_pixels()};
+    auto && u_map{u.get_pixel_map()};
+    auto && Au_map{Au.get_pixel_map()};
+    for (auto && id_ccoord : pixels.enumerate()) {
+      auto && ccoord{std::get<1>(id_ccoord)};
+      Eigen::VectorXd expected{Eigen::VectorXd::Zero(6)};
+      for (size_t k{0}; k < op.get_offsets().size(); ++k) {
+        DynCcoord_t neighbour(twoD);
+        for (Index_t d{0}; d < twoD; ++d) {
+          neighbour[d] = (ccoord[d] + op.get_offsets()[k][d] + nb_grid_pts[d]) %
+                         nb_grid_pts[d];
+        }
+        // per pixel, the maps hold components × sub-points matrices
+        auto && u_pixel{u_map[pixels.get_index(neighbour)]};
+        expected += op.get_coefficients()[k] *
+                    Eigen::Map<const Eigen::VectorXd>(u_pixel.data(), 6);
+      }
+      auto && Au_pixel{Au_map[std::get<0>(id_ccoord)]};
+      BOOST_CHECK_LE(testGoodies::rel_error(
+                         Eigen::Map<const Eigen::VectorXd>(Au_pixel.data(), 6),
+                         expected),
+                     tol);
+    }
+
+    // the transpose is the adjoint with respect to the weighted inner
+    // product of the output field
+    const std::vector<Real> weights{.25, 2.};
+    op.apply_transpose(v, ATv, weights);
+    Real vAu{0.};
+    auto && v_map{v.get_pixel_map()};
+    for (auto && id_ccoord : pixels.enumerate()) {
+      auto && id{std::get<0>(id_ccoord)};
+      for (Index_t q{0}; q < 2; ++q) {
+        vAu += weights[q] * v_map[id].col(q).dot(Au_map[id].col(q));
+      }
+    }
+    const Real ATvu{ATv.eigen_vec().dot(u.eigen_vec())};
+    BOOST_CHECK_LE(std::abs(vAu - ATvu), tol * std::abs(vAu));
+
+    // fields that do not match the coefficients are rejected
+    BOOST_CHECK_THROW(op.apply(Au, u), RuntimeError);
+    BOOST_CHECK_THROW(op.apply_transpose(v, ATv, {1.}), RuntimeError);
+    // as are fields of matching shape that live in different collections
+    GlobalFieldCollection other{nb_grid_pts, nb_grid_pts};
+    other.set_nb_sub_pts("in", 3);
+    other.set_nb_sub_pts("out", 2);
+    auto & other_u{other.register_real_field("u", 2, "in")};
+    auto & other_v{other.register_real_field("v", 3, "out")};
+    BOOST_CHECK_THROW(op.apply(other_u, Au), RuntimeError);
+    BOOST_CHECK_THROW(op.apply_transpose(other_v, ATv), RuntimeError);
+    BOOST_CHECK_THROW(
+        ConvolutionOperator(twoD, {{0, 0}}, {Eigen::MatrixXd::Ones(3, 3)}, 2),
+        RuntimeError);
+    BOOST_CHECK_THROW(ConvolutionOperator(twoD, {{0, 0}, {1, 0}},
+                                          {Eigen::MatrixXd::Ones(1, 1)}),
+                      RuntimeError);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(ghosts_and_threads) {
+    auto & comm{MPIContext::get_context().comm};
+    auto && op{make_random_operator()};
+    const DynCcoord_t nb_grid_pts{6, 5};
+    const DynCcoord_t nb_ghosts{2, 2};
+
+    // periodic reference without ghosts and the same grid padded with ghosts
+    GlobalFieldCollection periodic{nb_grid_pts, nb_grid_pts};
+    GlobalFieldCollection ghosted{nb_grid_pts,      nb_grid_pts,
+                                  DynCcoord_t{0, 0}, nb_ghosts,
+                                  nb_ghosts,        comm};
+    for (auto * collection : {&periodic, &ghosted}) {
+      collection->set_nb_sub_pts("in", 3);
+      collection->set_nb_sub_pts("out", 2);
+    }
+    auto & u_ref{periodic.register_real_field("u", 2, "in")};
+    auto & Au_ref{periodic.register_real_field("A·u", 3, "out")};
+    auto & ATAu_ref{periodic.register_real_field("AᵀA·u", 2, "in")};
+    auto & u{ghosted.register_real_field("u", 2, "in")};
+    auto & Au{ghosted.register_real_field("A·u", 3, "out")};
+    auto & ATAu{ghosted.register_real_field("AᵀA·u", 2, "in")};
+
+    u_ref.eigen_vec().setRandom();
+    op.apply(u_ref, Au_ref);
+    op.apply_transpose(Au_ref, ATAu_ref);
+
+    auto && interior{CcoordOps::DynamicPixels(nb_grid_pts)};
+    auto && u_ref_map{u_ref.get_pixel_map()};
+    auto && u_map{u.get_pixel_map()};
+    auto && Au_ref_map{Au_ref.get_pixel_map()};
+    auto && Au_map{Au.get_pixel_map()};
+    auto && ATAu_ref_map{ATAu_ref.get_pixel_map()};
+    auto && ATAu_map{ATAu.get_pixel_map()};
+    for (auto && nb_threads : {1, 3}) {
+      op.set_nb_threads(nb_threads);
+      // either the caller fills the ghosts, or the operator fills them
+      // while evaluating the interior
+      for (bool overlapping : {false, true}) {
+        // poison the ghosts to make sure they are actually communicated
+        u.eigen_vec().setConstant(1e10);
+        for (auto && ccoord : interior) {
+          u_map[ghosted.get_pixels().get_index(ccoord)] =
+              u_ref_map[periodic.get_pixels().get_index(ccoord)];
+        }
+        if (overlapping) {
+          op.begin_apply(u, Au).finish();
+          op.begin_apply_transpose(Au, ATAu).finish();
+        } else {
+          u.communicate_ghosts();
+          op.apply(u, Au);
+          Au.communicate_ghosts();
+          op.apply_transpose(Au, ATAu);
+        }
+        for (auto && ccoord : interior) {
+          auto && id{ghosted.get_pixels().get_index(ccoord)};
+          auto && id_ref{periodic.get_pixels().get_index(ccoord)};
+          BOOST_CHECK_LE(testGoodies::rel_error(Au_map[id], Au_ref_map[id_ref]),
+                         tol);
+          BOOST_CHECK_LE(
+              testGoodies::rel_error(ATAu_map[id], ATAu_ref_map[id_ref]), tol);
+        }
+      }
+    }
+
+    // increments on a begun application add to the output
+    op.begin_apply_increment(u, -1., Au).finish();
+    for (auto && ccoord : interior) {
+      BOOST_CHECK_LE(Au_map[ghosted.get_pixels().get_index(ccoord)].norm(),
+                     tol);
+    }
+
+    // the stencil reaches two pixels to the left in the first direction
+    GlobalFieldCollection thin{nb_grid_pts,       nb_grid_pts,
+                               DynCcoord_t{0, 0}, DynCcoord_t{1, 2},
+                               nb_ghosts,         comm};
+    thin.set_nb_sub_pts("in", 3);
+    thin.set_nb_sub_pts("out", 2);
+    auto & w{thin.register_real_field("w", 2, "in")};
+    auto & Aw{thin.register_real_field("A·w", 3, "out")};
+    BOOST_CHECK_THROW(op.apply(w, Aw), RuntimeError);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(complex_and_float_fields) {
+    auto && op{make_random_operator()};
+    const DynCcoord_t nb_grid_pts{5, 4};
+    GlobalFieldCollection collection{nb_grid_pts, nb_grid_pts};
+    collection.set_nb_sub_pts("in", 3);
+    collection.set_nb_sub_pts("out", 2);
+    auto & re{collection.register_real_field("re", 2, "in")};
+    auto & im{collection.register_real_field("im", 2, "in")};
+    auto & A_re{collection.register_real_field("A·re", 3, "out")};
+    auto & A_im{collection.register_real_field("A·im", 3, "out")};
+    auto & AT_A_re{collection.register_real_field("AᵀA·re", 2, "in")};
+    auto & u{collection.register_complex_field("u", 2, "in")};
+    auto & Au{collection.register_complex_field("A·u", 3, "out")};
+    auto & u_float{collection.register_float_field("u float", 2, "in")};
+    auto & Au_float{collection.register_float_field("A·u float", 3, "out")};
+    auto & ATAu_float{
+        collection.register_float_field("AᵀA·u float", 2, "in")};
+    re.eigen_vec().setRandom();
+    im.eigen_vec().setRandom();
+    u.eigen_vec() = re.eigen_vec() + Complex{0., 1.} * im.eigen_vec();
+    u_float.eigen_vec() = re.eigen_vec().cast<Float>();
+    const std::vector<Real> weights{.25, 2.};
+    op.apply(re, A_re);
+    op.apply(im, A_im);
+    op.apply_transpose(A_re, AT_A_re, weights);
+
+    // the operator acts on the real and imaginary parts separately
+    op.apply(u, Au);
+    BOOST_CHECK_LE(
+        testGoodies::rel_error(Au.eigen_vec().real(), A_re.eigen_vec()), tol);
+    BOOST_CHECK_LE(
+        testGoodies::rel_error(Au.eigen_vec().imag(), A_im.eigen_vec()), tol);
+    op.apply_increment(u, Complex{0., -1.}, Au);
+    BOOST_CHECK_LE(testGoodies::rel_error(
+                       Au.eigen_vec().real(),
+                       A_re.eigen_vec() + A_im.eigen_vec()),
+                   tol);
+
+    // single-precision fields are accurate to single precision
+    const Real float_tol{1e-5};
+    op.apply(u_float, Au_float);
+    op.apply_transpose(Au_float, ATAu_float, weights);
+    BOOST_CHECK_LE(testGoodies::rel_error(Au_float.eigen_vec().cast<Real>(),
+                                          A_re.eigen_vec()),
+                   float_tol);
+    BOOST_CHECK_LE(testGoodies::rel_error(
+                       ATAu_float.eigen_vec().cast<Real>(),
+                       AT_A_re.eigen_vec()),
+                   float_tol);
+  }
+
+  BOOST_AUTO_TEST_SUITE_END();
+
+}  // namespace muGrid
@@ -35,6 +35,7 @@
  */
 
 #include "tests.hh"
+#include "mpi_context.hh"
 #include "test_goodies.hh"
 #include "test_discrete_gradient_operator.hh"
 
@@ -209,6 +210,489 @@ namespace muGrid {
     }
   }
 
+  /* ---------------------------------------------------------------------- */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(gradient_with_ghosts, Fix,
+                                   DOperatorFixtures, Fix) {
+    auto & comm{MPIContext::get_context().comm};
+    const DynCcoord_t nb_grid_pts{4, 3};
+    const DynCcoord_t nb_ghosts{1, 1};
+    const std::string nodal_pt_tag{"nodal_pt"};
+    const std::string quad_pt_tag{"quad_pt"};
+    const Index_t nb_quad_pts{Fix::NbQuadPerELement * Fix::NbElements};
+    // non-uniform weights, such that the transpose depends on which
+    // quadrature point each weight is applied to
+    std::vector<Real> weights(nb_quad_pts);
+    for (Index_t q{0}; q < nb_quad_pts; ++q) {
+      weights[q] = 1. + q;
+    }
+
+    // periodic reference without ghosts and the same grid padded with ghosts
+    GlobalFieldCollection periodic{nb_grid_pts, nb_grid_pts};
+    GlobalFieldCollection ghosted{nb_grid_pts, nb_grid_pts,
+                                  DynCcoord_t{0, 0}, nb_ghosts,
+                                  nb_ghosts, comm};
+    BOOST_CHECK(ghosted.has_ghosts());
+    BOOST_CHECK_EQUAL(ghosted.get_nb_pixels(), 6 * 5);
+    BOOST_CHECK_EQUAL(ghosted.get_nb_subdomain_grid_pts(), nb_grid_pts);
+    for (auto * collection : {&periodic, &ghosted}) {
+      collection->set_nb_sub_pts(nodal_pt_tag, Fix::NbNode);
+      collection->set_nb_sub_pts(quad_pt_tag, nb_quad_pts);
+    }
+
+    auto & u_ref{periodic.register_real_field("u", 1, nodal_pt_tag)};
+    auto & Bu_ref{periodic.register_real_field("B·u", Fix::Dim, quad_pt_tag)};
+    auto & BTBu_ref{periodic.register_real_field("BᵀB·u", 1, nodal_pt_tag)};
+    auto & u{ghosted.register_real_field("u", 1, nodal_pt_tag)};
+    auto & Bu{ghosted.register_real_field("B·u", Fix::Dim, quad_pt_tag)};
+    auto & BTBu{ghosted.register_real_field("BᵀB·u", 1, nodal_pt_tag)};
+
+    u_ref.eigen_vec().setRandom();
+    auto && u_ref_map{u_ref.get_pixel_map()};
+    auto && u_map{u.get_pixel_map()};
+    auto && interior{CcoordOps::DynamicPixels(nb_grid_pts)};
+    this->d_operator.apply_gradient(u_ref, Bu_ref);
+    this->d_operator.apply_transpose(Bu_ref, BTBu_ref, weights);
+    auto && Bu_ref_map{Bu_ref.get_pixel_map()};
+    auto && Bu_map{Bu.get_pixel_map()};
+    auto && BTBu_ref_map{BTBu_ref.get_pixel_map()};
+    auto && BTBu_map{BTBu.get_pixel_map()};
+
+    // either the caller fills the ghosts, or the operator fills them while
+    // evaluating the interior
+    for (bool overlapping : {false, true}) {
+      // poison the ghosts to make sure they are actually communicated
+      u.eigen_vec().setConstant(1e10);
+      for (auto && ccoord : interior) {
+        u_map[ghosted.get_pixels().get_index(ccoord)] =
+            u_ref_map[periodic.get_pixels().get_index(ccoord)];
+      }
+      if (overlapping) {
+        auto pending{this->d_operator.template begin_apply_gradient<Real>(
+            {&u}, {&Bu})};
+        BOOST_CHECK(pending.is_pending());
+        pending.finish();
+        BOOST_CHECK(not pending.is_pending());
+        // finishing twice does nothing
+        pending.finish();
+      } else {
+        u.communicate_ghosts();
+        this->d_operator.apply_gradient(u, Bu);
+      }
+      for (auto && ccoord : interior) {
+        auto && error{testGoodies::rel_error(
+            Bu_map[ghosted.get_pixels().get_index(ccoord)],
+            Bu_ref_map[periodic.get_pixels().get_index(ccoord)])};
+        BOOST_CHECK_LE(error, tol);
+      }
+
+      // the transpose needs the left quadrature point ghosts
+      if (overlapping) {
+        // destroying the pending application finishes it
+        auto pending{this->d_operator.template begin_apply_transpose<Real>(
+            {&Bu}, {&BTBu}, weights)};
+        BOOST_CHECK(pending.is_pending());
+      } else {
+        Bu.communicate_ghosts();
+        this->d_operator.apply_transpose(Bu, BTBu, weights);
+      }
+      for (auto && ccoord : interior) {
+        auto && error{testGoodies::rel_error(
+            BTBu_map[ghosted.get_pixels().get_index(ccoord)],
+            BTBu_ref_map[periodic.get_pixels().get_index(ccoord)])};
+        BOOST_CHECK_LE(error, tol);
+      }
+    }
+
+    // a moved-from pending application refers to no application
+    auto pending{
+        this->d_operator.template begin_apply_gradient<Real>({&u}, {&Bu})};
+    PendingApplication moved{std::move(pending)};
+    BOOST_CHECK(moved.is_pending());
+    BOOST_CHECK_THROW(pending.finish(), RuntimeError);
+    moved.finish();
+
+    // one ghost layer on each side is required
+    GlobalFieldCollection no_right_ghosts{nb_grid_pts, nb_grid_pts,
+                                          DynCcoord_t{0, 0}, nb_ghosts,
+                                          DynCcoord_t{0, 0}, comm};
+    no_right_ghosts.set_nb_sub_pts(nodal_pt_tag, Fix::NbNode);
+    no_right_ghosts.set_nb_sub_pts(quad_pt_tag, nb_quad_pts);
+    auto & v{no_right_ghosts.register_real_field("v", 1, nodal_pt_tag)};
+    auto & Bv{no_right_ghosts.register_real_field("B·v", Fix::Dim,
+                                                  quad_pt_tag)};
+    BOOST_CHECK_THROW(this->d_operator.apply_gradient(v, Bv), RuntimeError);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(multithreaded_operators, Fix,
+                                   DOperatorFixtures, Fix) {
+    const DynCcoord_t nb_grid_pts{5, 7};
+    const std::string nodal_pt_tag{"nodal_pt"};
+    const std::string quad_pt_tag{"quad_pt"};
+    GlobalFieldCollection collection{nb_grid_pts, nb_grid_pts};
+    collection.set_nb_sub_pts(nodal_pt_tag, Fix::NbNode);
+    collection.set_nb_sub_pts(quad_pt_tag,
+                              Fix::NbQuadPerELement * Fix::NbElements);
+
+    auto & u{collection.register_real_field("u", 2, nodal_pt_tag)};
+    auto & Bu_ref{
+        collection.register_real_field("B·u ref", 2 * Fix::Dim, quad_pt_tag)};
+    auto & BTBu_ref{
+        collection.register_real_field("BᵀB·u ref", 2, nodal_pt_tag)};
+    auto & Bu{
+        collection.register_real_field("B·u", 2 * Fix::Dim, quad_pt_tag)};
+    auto & BTBu{collection.register_real_field("BᵀB·u", 2, nodal_pt_tag)};
+    u.eigen_vec().setRandom();
+
+    BOOST_CHECK_EQUAL(this->d_operator.get_nb_threads(), 1);
+    this->d_operator.apply_gradient(u, Bu_ref);
+    this->d_operator.apply_transpose(Bu_ref, BTBu_ref);
+
+    // more threads than planes exercises idle threads in the transpose
+    for (auto && nb_threads : {2, 3, 8}) {
+      this->d_operator.set_nb_threads(nb_threads);
+      BOOST_CHECK_EQUAL(this->d_operator.get_nb_threads(), nb_threads);
+      this->d_operator.apply_gradient(u, Bu);
+      this->d_operator.apply_transpose(Bu, BTBu);
+      BOOST_CHECK_LE(
+          testGoodies::rel_error(Bu.eigen_vec(), Bu_ref.eigen_vec()), tol);
+      BOOST_CHECK_LE(
+          testGoodies::rel_error(BTBu.eigen_vec(), BTBu_ref.eigen_vec()), tol);
+    }
+    this->d_operator.set_nb_threads(1);
+    BOOST_CHECK_THROW(this->d_operator.set_nb_threads(0), RuntimeError);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(gather_transpose, Fix, DOperatorFixtures,
+                                   Fix) {
+    const DynCcoord_t nb_grid_pts{4, 5};
+    const std::string nodal_pt_tag{"nodal_pt"};
+    const std::string quad_pt_tag{"quad_pt"};
+    const Index_t nb_quad_pts{Fix::NbQuadPerELement * Fix::NbElements};
+    GlobalFieldCollection collection{nb_grid_pts, nb_grid_pts};
+    collection.set_nb_sub_pts(nodal_pt_tag, Fix::NbNode);
+    collection.set_nb_sub_pts(quad_pt_tag, nb_quad_pts);
+
+    auto & Bu{
+        collection.register_real_field("B·u", 2 * Fix::Dim, quad_pt_tag)};
+    auto & scattered{
+        collection.register_real_field("scatter", 2, nodal_pt_tag)};
+    auto & gathered{collection.register_real_field("gather", 2, nodal_pt_tag)};
+    Bu.eigen_vec().setRandom();
+    std::vector<Real> weights(nb_quad_pts);
+    for (Index_t q{0}; q < nb_quad_pts; ++q) {
+      weights[q] = 1. + q;
+    }
+
+    BOOST_CHECK(this->d_operator.get_transpose_algorithm() ==
+                TransposeAlgorithm::Scatter);
+    this->d_operator.apply_transpose(Bu, scattered, weights);
+    this->d_operator.set_transpose_algorithm(TransposeAlgorithm::Gather);
+    for (auto && nb_threads : {1, 3}) {
+      this->d_operator.set_nb_threads(nb_threads);
+      this->d_operator.apply_transpose(Bu, gathered, weights);
+      BOOST_CHECK_LE(testGoodies::rel_error(gathered.eigen_vec(),
+                                            scattered.eigen_vec()),
+                     tol);
+    }
+    this->d_operator.set_nb_threads(1);
+    this->d_operator.set_transpose_algorithm(TransposeAlgorithm::Scatter);
+
+    // one weight per quadrature point is required
+    weights.push_back(1.);
+    BOOST_CHECK_THROW(this->d_operator.apply_transpose(Bu, scattered, weights),
+                      RuntimeError);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(fixed_size_kernels, Fix, DOperatorFixtures,
+                                   Fix) {
+    const DynCcoord_t nb_grid_pts{3, 4};
+    const std::string nodal_pt_tag{"nodal_pt"};
+    const std::string quad_pt_tag{"quad_pt"};
+    GlobalFieldCollection collection{nb_grid_pts, nb_grid_pts};
+    collection.set_nb_sub_pts(nodal_pt_tag, Fix::NbNode);
+    collection.set_nb_sub_pts(quad_pt_tag,
+                              Fix::NbQuadPerELement * Fix::NbElements);
+
+    // scalar and vector fields have specialised kernels, the last one not
+    BOOST_CHECK(this->d_operator.get_fixed_size_kernels());
+    for (Index_t nb_components : {Index_t{1}, Fix::Dim, Fix::Dim + 1}) {
+      const std::string suffix{std::to_string(nb_components)};
+      auto & u{collection.register_real_field("u" + suffix, nb_components,
+                                              nodal_pt_tag)};
+      auto & Bu_fixed{collection.register_real_field(
+          "B·u fixed" + suffix, Fix::Dim * nb_components, quad_pt_tag)};
+      auto & Bu_dynamic{collection.register_real_field(
+          "B·u dynamic" + suffix, Fix::Dim * nb_components, quad_pt_tag)};
+      auto & BTBu_fixed{collection.register_real_field(
+          "BᵀB·u fixed" + suffix, nb_components, nodal_pt_tag)};
+      auto & BTBu_dynamic{collection.register_real_field(
+          "BᵀB·u dynamic" + suffix, nb_components, nodal_pt_tag)};
+      u.eigen_vec().setRandom();
+
+      for (auto && algorithm :
+           {TransposeAlgorithm::Scatter, TransposeAlgorithm::Gather}) {
+        this->d_operator.set_transpose_algorithm(algorithm);
+        this->d_operator.set_fixed_size_kernels(true);
+        this->d_operator.apply_gradient(u, Bu_fixed);
+        this->d_operator.apply_transpose(Bu_fixed, BTBu_fixed);
+        this->d_operator.set_fixed_size_kernels(false);
+        this->d_operator.apply_gradient(u, Bu_dynamic);
+        this->d_operator.apply_transpose(Bu_dynamic, BTBu_dynamic);
+
+        BOOST_CHECK_LE(testGoodies::rel_error(Bu_fixed.eigen_vec(),
+                                              Bu_dynamic.eigen_vec()),
+                       tol);
+        BOOST_CHECK_LE(testGoodies::rel_error(BTBu_fixed.eigen_vec(),
+                                              BTBu_dynamic.eigen_vec()),
+                       tol);
+      }
+    }
+    this->d_operator.set_fixed_size_kernels(true);
+    this->d_operator.set_transpose_algorithm(TransposeAlgorithm::Scatter);
+
+    // the number of sub-points must match the operator
+    auto & wrong{collection.register_real_field("wrong", 1, quad_pt_tag)};
+    auto & Bwrong{
+        collection.register_real_field("B·wrong", Fix::Dim, quad_pt_tag)};
+    BOOST_CHECK_THROW(this->d_operator.apply_gradient(wrong, Bwrong),
+                      RuntimeError);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(batched_operators, Fix, DOperatorFixtures,
+                                   Fix) {
+    auto & comm{MPIContext::get_context().comm};
+    const DynCcoord_t nb_grid_pts{4, 5};
+    const DynCcoord_t nb_ghosts{1, 1};
+    const std::string nodal_pt_tag{"nodal_pt"};
+    const std::string quad_pt_tag{"quad_pt"};
+    const Index_t nb_quad_pts{Fix::NbQuadPerELement * Fix::NbElements};
+    std::vector<Real> weights(nb_quad_pts);
+    for (Index_t q{0}; q < nb_quad_pts; ++q) {
+      weights[q] = 1. + q;
+    }
+
+    // a batch of scalar and vector fields, with and without ghosts
+    GlobalFieldCollection periodic{nb_grid_pts, nb_grid_pts};
+    GlobalFieldCollection ghosted{nb_grid_pts, nb_grid_pts,
+                                  DynCcoord_t{0, 0}, nb_ghosts,
+                                  nb_ghosts, comm};
+    for (auto * collection : {&periodic, &ghosted}) {
+      collection->set_nb_sub_pts(nodal_pt_tag, Fix::NbNode);
+      collection->set_nb_sub_pts(quad_pt_tag, nb_quad_pts);
+      std::vector<const TypedFieldBase<Real> *> u{};
+      std::vector<TypedFieldBase<Real> *> u_mut{}, Bu{}, BTBu{};
+      for (Index_t nb_components : {Index_t{1}, Index_t{2}, Fix::Dim}) {
+        const std::string suffix{std::to_string(u.size())};
+        auto & u_i{collection->register_real_field("u" + suffix,
+                                                   nb_components,
+                                                   nodal_pt_tag)};
+        u_i.eigen_vec().setRandom();
+        // the batches take const input fields, whose ghosts the caller fills
+        u_i.communicate_ghosts();
+        u.push_back(&u_i);
+        u_mut.push_back(&u_i);
+        Bu.push_back(&collection->register_real_field(
+            "B·u" + suffix, Fix::Dim * nb_components, quad_pt_tag));
+        BTBu.push_back(&collection->register_real_field(
+            "BᵀB·u" + suffix, nb_components, nodal_pt_tag));
+      }
+      auto & Bu_ref{collection->register_real_field("B·u ref", 2 * Fix::Dim,
+                                                    quad_pt_tag)};
+      auto & BTBu_ref{
+          collection->register_real_field("BᵀB·u ref", 2, nodal_pt_tag)};
+
+      for (auto && algorithm :
+           {TransposeAlgorithm::Scatter, TransposeAlgorithm::Gather}) {
+        this->d_operator.set_transpose_algorithm(algorithm);
+        for (auto && nb_threads : {1, 3}) {
+          this->d_operator.set_nb_threads(nb_threads);
+          // increments add to the output
+          this->d_operator.apply_gradient_batch(u, Bu);
+          this->d_operator.apply_gradient_increment_batch(u, -1., Bu);
+          for (auto * field : Bu) {
+            BOOST_CHECK_LE(field->eigen_vec().norm(), tol);
+          }
+
+          this->d_operator.apply_gradient_batch(u, Bu);
+          for (auto * field : Bu) {
+            field->communicate_ghosts();
+          }
+          this->d_operator.apply_transpose_batch(
+              std::vector<const TypedFieldBase<Real> *>(Bu.begin(), Bu.end()),
+              BTBu, weights);
+          // compare to the unbatched operators
+          for (size_t i{0}; i < u.size(); ++i) {
+            if (BTBu[i]->get_nb_components() != 2) {
+              continue;
+            }
+            this->d_operator.apply_gradient(*u[i], Bu_ref);
+            Bu_ref.communicate_ghosts();
+            this->d_operator.apply_transpose(Bu_ref, BTBu_ref, weights);
+            BOOST_CHECK_LE(testGoodies::rel_error(Bu[i]->eigen_vec(),
+                                                  Bu_ref.eigen_vec()),
+                           tol);
+            BOOST_CHECK_LE(testGoodies::rel_error(BTBu[i]->eigen_vec(),
+                                                  BTBu_ref.eigen_vec()),
+                           tol);
+          }
+        }
+      }
+      this->d_operator.set_nb_threads(1);
+      this->d_operator.set_transpose_algorithm(TransposeAlgorithm::Scatter);
+
+      // the batches must have the same size
+      BOOST_CHECK_THROW(this->d_operator.apply_gradient_batch(
+                            u, std::vector<TypedFieldBase<Real> *>{Bu[0]}),
+                        RuntimeError);
+
+      // begun batches fill the ghosts of their input fields. The first
+      // field appears twice, its ghosts are only exchanged once at a time.
+      u_mut.push_back(u_mut.front());
+      Bu.push_back(&collection->register_real_field(
+          "B·u repeated", Fix::Dim * u_mut.front()->get_nb_components(),
+          quad_pt_tag));
+      BTBu.push_back(&collection->register_real_field(
+          "BᵀB·u repeated", u_mut.front()->get_nb_components(),
+          nodal_pt_tag));
+      // leave stale ghosts behind
+      for (auto * field : u_mut) {
+        field->eigen_vec().setRandom();
+      }
+      this->d_operator.begin_apply_gradient(u_mut, Bu).finish();
+      this->d_operator.begin_apply_transpose(Bu, BTBu, weights).finish();
+      BOOST_CHECK_LE(testGoodies::rel_error(Bu.back()->eigen_vec(),
+                                            Bu.front()->eigen_vec()),
+                     tol);
+      BOOST_CHECK_LE(testGoodies::rel_error(BTBu.back()->eigen_vec(),
+                                            BTBu.front()->eigen_vec()),
+                     tol);
+      // compare to the unbatched operators
+      for (size_t i{0}; i < u_mut.size(); ++i) {
+        if (BTBu[i]->get_nb_components() != 2) {
+          continue;
+        }
+        u_mut[i]->communicate_ghosts();
+        this->d_operator.apply_gradient(*u_mut[i], Bu_ref);
+        Bu_ref.communicate_ghosts();
+        this->d_operator.apply_transpose(Bu_ref, BTBu_ref, weights);
+        BOOST_CHECK_LE(testGoodies::rel_error(Bu[i]->eigen_vec(),
+                                              Bu_ref.eigen_vec()),
+                       tol);
+        BOOST_CHECK_LE(testGoodies::rel_error(BTBu[i]->eigen_vec(),
+                                              BTBu_ref.eigen_vec()),
+                       tol);
+      }
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(complex_and_float_fields, Fix,
+                                   DOperatorFixtures, Fix) {
+    const DynCcoord_t nb_grid_pts{4, 5};
+    const std::string nodal_pt_tag{"nodal_pt"};
+    const std::string quad_pt_tag{"quad_pt"};
+    const Index_t nb_quad_pts{Fix::NbQuadPerELement * Fix::NbElements};
+    const Index_t nb_components{2};
+    std::vector<Real> weights(nb_quad_pts);
+    for (Index_t q{0}; q < nb_quad_pts; ++q) {
+      weights[q] = 1. + q;
+    }
+    GlobalFieldCollection collection{nb_grid_pts, nb_grid_pts};
+    collection.set_nb_sub_pts(nodal_pt_tag, Fix::NbNode);
+    collection.set_nb_sub_pts(quad_pt_tag, nb_quad_pts);
+    const Index_t nb_grad_components{Fix::Dim * nb_components};
+
+    auto & re{collection.register_real_field("re", nb_components,
+                                             nodal_pt_tag)};
+    auto & im{collection.register_real_field("im", nb_components,
+                                             nodal_pt_tag)};
+    auto & B_re{collection.register_real_field("B·re", nb_grad_components,
+                                               quad_pt_tag)};
+    auto & B_im{collection.register_real_field("B·im", nb_grad_components,
+                                               quad_pt_tag)};
+    auto & BT_re{collection.register_real_field("Bᵀ·re", nb_components,
+                                                nodal_pt_tag)};
+    auto & BT_im{collection.register_real_field("Bᵀ·im", nb_components,
+                                                nodal_pt_tag)};
+    auto & u{collection.register_complex_field("u", nb_components,
+                                               nodal_pt_tag)};
+    auto & Bu{collection.register_complex_field("B·u", nb_grad_components,
+                                                quad_pt_tag)};
+    auto & BTBu{collection.register_complex_field("BᵀB·u", nb_components,
+                                                  nodal_pt_tag)};
+    auto & u_float{collection.register_float_field("u float", nb_components,
+                                                   nodal_pt_tag)};
+    auto & Bu_float{collection.register_float_field(
+        "B·u float", nb_grad_components, quad_pt_tag)};
+    auto & BTBu_float{collection.register_float_field(
+        "BᵀB·u float", nb_components, nodal_pt_tag)};
+    re.eigen_vec().setRandom();
+    im.eigen_vec().setRandom();
+    u.eigen_vec() = re.eigen_vec() + Complex{0., 1.} * im.eigen_vec();
+    u_float.eigen_vec() = re.eigen_vec().template cast<Float>();
+
+    // single precision is only accurate to about seven digits
+    const Real float_tol{1e-5};
+    for (auto && fixed_size : {true, false}) {
+      this->d_operator.set_fixed_size_kernels(fixed_size);
+      for (auto && algorithm :
+           {TransposeAlgorithm::Scatter, TransposeAlgorithm::Gather}) {
+        this->d_operator.set_transpose_algorithm(algorithm);
+        this->d_operator.apply_gradient(re, B_re);
+        this->d_operator.apply_gradient(im, B_im);
+        this->d_operator.apply_transpose(B_re, BT_re, weights);
+        this->d_operator.apply_transpose(B_im, BT_im, weights);
+
+        // the operators act on the real and imaginary parts separately
+        this->d_operator.apply_gradient(u, Bu);
+        this->d_operator.apply_transpose(Bu, BTBu, weights);
+        BOOST_CHECK_LE(testGoodies::rel_error(Bu.eigen_vec().real(),
+                                              B_re.eigen_vec()),
+                       tol);
+        BOOST_CHECK_LE(testGoodies::rel_error(Bu.eigen_vec().imag(),
+                                              B_im.eigen_vec()),
+                       tol);
+        BOOST_CHECK_LE(testGoodies::rel_error(BTBu.eigen_vec().real(),
+                                              BT_re.eigen_vec()),
+                       tol);
+        BOOST_CHECK_LE(testGoodies::rel_error(BTBu.eigen_vec().imag(),
+                                              BT_im.eigen_vec()),
+                       tol);
+        // complex factors rotate the result
+        this->d_operator.apply_gradient_increment(u, Complex{0., 1.}, Bu);
+        BOOST_CHECK_LE(
+            testGoodies::rel_error(
+                Bu.eigen_vec(),
+                Complex{1., 1.} * (B_re.eigen_vec().template cast<Complex>() +
+                                   Complex{0., 1.} * B_im.eigen_vec())),
+            tol);
+
+        // single-precision fields agree with the double-precision operators
+        // to single precision
+        this->d_operator.apply_gradient(u_float, Bu_float);
+        this->d_operator.apply_transpose(Bu_float, BTBu_float, weights);
+        BOOST_CHECK_LE(
+            testGoodies::rel_error(Bu_float.eigen_vec().template cast<Real>(),
+                                   B_re.eigen_vec()),
+            float_tol);
+        BOOST_CHECK_LE(testGoodies::rel_error(
+                           BTBu_float.eigen_vec().template cast<Real>(),
+                           BT_re.eigen_vec()),
+                       float_tol);
+        this->d_operator.apply_transpose_increment(Bu_float, -1., BTBu_float,
+                                                   weights);
+        BOOST_CHECK_LE(BTBu_float.eigen_vec().template cast<Real>().norm(),
+                       float_tol * BT_re.eigen_vec().norm());
+      }
+    }
+    this->d_operator.set_fixed_size_kernels(true);
+    this->d_operator.set_transpose_algorithm(TransposeAlgorithm::Scatter);
+  }
+
   BOOST_AUTO_TEST_SUITE_END();
 
 }  // namespace muGrid
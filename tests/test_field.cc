@@ -399,6 +399,159 @@ namespace muGrid {
     }
   }
 
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(aligned_storage) {
+    constexpr Index_t len{3};
+    const DynCcoord_t nb_grid_pts{len, len};
+    GlobalFieldCollection fc{nb_grid_pts, nb_grid_pts};
+    // odd numbers of entries, such that consecutive allocations would not
+    // be aligned by chance
+    std::vector<Field *> fields{&fc.register_real_field("real", 3),
+                                &fc.register_float_field("float", 1),
+                                &fc.register_int_field("int", 5),
+                                &fc.register_complex_field("complex", 1)};
+    for (auto * field : fields) {
+      BOOST_CHECK_EQUAL(
+          reinterpret_cast<std::uintptr_t>(field->get_void_data_ptr()) %
+              FieldAlignment,
+          0);
+    }
+    auto & real_field{dynamic_cast<RealField &>(*fields.front())};
+    BOOST_CHECK_EQUAL(real_field.get_alignment(), FieldAlignment);
+    // resizing keeps the alignment
+    real_field.set_pad_size(5);
+    BOOST_CHECK_EQUAL(real_field.get_alignment(), FieldAlignment);
+
+    // wrapped fields are as aligned as the memory they view
+    AlignedVector_t<Real> memory(ipow(len, twoD) + 1);
+    WrappedField<Real> aligned{"aligned", fc, 1, memory.size() - 1,
+                               memory.data(), PixelTag};
+    WrappedField<Real> shifted{"shifted", fc, 1, memory.size() - 1,
+                               memory.data() + 1, PixelTag};
+    BOOST_CHECK_EQUAL(aligned.get_alignment(), FieldAlignment);
+    BOOST_CHECK_EQUAL(shifted.get_alignment(), sizeof(Real));
+  }
+
+  /* ---------------------------------------------------------------------- */
+  //! offsets of all entries of a field, in column-major logical order
+  std::vector<Index_t> logical_offsets(const Field & field) {
+    const Shape_t shape{field.get_shape(IterUnit::SubPt)};
+    const Shape_t strides{field.get_strides(IterUnit::SubPt)};
+    Index_t nb_entries{1};
+    for (auto && n : shape) {
+      nb_entries *= n;
+    }
+    std::vector<Index_t> offsets{};
+    for (Index_t index{0}; index < nb_entries; ++index) {
+      Index_t remainder{index}, offset{0};
+      for (size_t dim{0}; dim < shape.size(); ++dim) {
+        offset += (remainder % shape[dim]) * strides[dim];
+        remainder /= shape[dim];
+      }
+      offsets.push_back(offset);
+    }
+    return offsets;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(storage_order_conversion) {
+    const DynCcoord_t nb_grid_pts{3, 4};
+    const std::string quad{"quad"};
+    const FieldCollection::SubPtMap_t nb_sub_pts{{quad, 2}};
+    const Shape_t components_shape{2, 3};
+    GlobalFieldCollection aos_fc{nb_grid_pts, nb_grid_pts, {},
+                                 nb_sub_pts, StorageOrder::ColMajor};
+    // the pixels storage order would otherwise follow the storage order
+    GlobalFieldCollection soa_fc{nb_grid_pts,           nb_grid_pts,
+                                 DynCcoord_t{0, 0},     StorageOrder::ColMajor,
+                                 nb_sub_pts,            StorageOrder::RowMajor};
+    auto & aos{aos_fc.register_real_field("field", components_shape, quad)};
+    auto & other{aos_fc.register_int_field("other", 2, quad)};
+    auto & soa{soa_fc.register_real_field("field", components_shape, quad)};
+
+    // the same logical values in both layouts
+    const auto aos_offsets{logical_offsets(aos)};
+    const auto soa_offsets{logical_offsets(soa)};
+    for (size_t i{0}; i < aos_offsets.size(); ++i) {
+      aos.data()[aos_offsets[i]] = i;
+      soa.data()[soa_offsets[i]] = i;
+    }
+    const Eigen::VectorXd original{aos.eigen_vec()};
+    BOOST_CHECK(not aos.has_same_memory_layout(soa));
+
+    // in-place conversion to a structure of arrays
+    const Real * data{aos.data()};
+    aos.convert_storage_order(StorageOrder::RowMajor);
+    BOOST_CHECK_EQUAL(aos.get_storage_order(), StorageOrder::RowMajor);
+    BOOST_CHECK_EQUAL(aos_fc.get_storage_order(), StorageOrder::ColMajor);
+    BOOST_CHECK_EQUAL(aos.data(), data);
+    BOOST_CHECK(aos.has_same_memory_layout(soa));
+    BOOST_CHECK_EQUAL((aos.eigen_vec() - soa.eigen_vec()).norm(), 0);
+
+    // and back to the storage order of the collection
+    aos.convert_storage_order(StorageOrder::Automatic);
+    BOOST_CHECK_EQUAL(aos.get_storage_order(), StorageOrder::ColMajor);
+    BOOST_CHECK_EQUAL((aos.eigen_vec() - original).norm(), 0);
+
+    // out-of-place conversion
+    soa.set_zero();
+    aos.copy_to(soa);
+    for (size_t i{0}; i < soa_offsets.size(); ++i) {
+      BOOST_CHECK_EQUAL(soa.data()[soa_offsets[i]], Real(i));
+    }
+    auto & mismatched{aos_fc.register_real_field("mismatched", 6, quad)};
+    BOOST_CHECK_THROW(aos.copy_to(mismatched), FieldError);
+
+    // collection-level conversion
+    const auto other_offsets{logical_offsets(other)};
+    for (size_t i{0}; i < other_offsets.size(); ++i) {
+      other.data()[other_offsets[i]] = i;
+    }
+    BOOST_CHECK_THROW(aos_fc.convert_storage_order(StorageOrder::Automatic),
+                      FieldCollectionError);
+    aos_fc.convert_storage_order(StorageOrder::RowMajor);
+    BOOST_CHECK_EQUAL(aos_fc.get_storage_order(), StorageOrder::RowMajor);
+    BOOST_CHECK_EQUAL(other.get_storage_order(), StorageOrder::RowMajor);
+    BOOST_CHECK_EQUAL((aos.eigen_vec() - soa.eigen_vec()).norm(), 0);
+    const auto converted_offsets{logical_offsets(other)};
+    for (size_t i{0}; i < converted_offsets.size(); ++i) {
+      BOOST_CHECK_EQUAL(other.data()[converted_offsets[i]], Int(i));
+    }
+    // fields registered later on follow the collection
+    auto & later{aos_fc.register_real_field("later", components_shape, quad)};
+    BOOST_CHECK(later.has_same_memory_layout(soa));
+
+    // wrapped fields with arbitrary strides cannot be converted
+    std::vector<Real> memory(soa.get_buffer_size());
+    WrappedField<Real> wrapped{"wrapped",         soa_fc, components_shape,
+                               memory.size(),     memory.data(),
+                               quad,              Unit::unitless(),
+                               soa.get_strides(IterUnit::SubPt)};
+    BOOST_CHECK_THROW(wrapped.convert_storage_order(StorageOrder::ColMajor),
+                      FieldError);
+
+    // a collection is only converted if all of its fields can be converted
+    const DynCcoord_t nb_ghosts{1, 1};
+    GlobalFieldCollection mixed_fc{nb_grid_pts, nb_grid_pts, DynCcoord_t{0, 0},
+                                   nb_ghosts,   nb_ghosts,   Communicator{}};
+    mixed_fc.set_nb_sub_pts(quad, 2);
+    auto & convertible{
+        mixed_fc.register_real_field("a", components_shape, quad)};
+    auto & exchanging{
+        mixed_fc.register_real_field("b", components_shape, quad)};
+    convertible.eigen_vec().setRandom();
+    const Eigen::VectorXd before{convertible.eigen_vec()};
+    exchanging.begin_communicate_ghosts();
+    BOOST_CHECK_THROW(mixed_fc.convert_storage_order(StorageOrder::RowMajor),
+                      FieldError);
+    BOOST_CHECK_EQUAL(mixed_fc.get_storage_order(), StorageOrder::ColMajor);
+    BOOST_CHECK_EQUAL(convertible.get_storage_order(), StorageOrder::ColMajor);
+    BOOST_CHECK_EQUAL((convertible.eigen_vec() - before).norm(), 0);
+    exchanging.finish_communicate_ghosts();
+    mixed_fc.convert_storage_order(StorageOrder::RowMajor);
+    BOOST_CHECK_EQUAL(convertible.get_storage_order(), StorageOrder::RowMajor);
+  }
+
   BOOST_AUTO_TEST_SUITE_END();
 
 }  // namespace muGrid
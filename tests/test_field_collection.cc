@@ -34,6 +34,7 @@
  */
 
 #include "tests.hh"
+#include "mpi_context.hh"
 
 #include "libmugrid/field_collection_global.hh"
 #include "libmugrid/field_collection_local.hh"
@@ -44,6 +45,8 @@
 
 #include "test_goodies.hh"
 
+#include <set>
+
 namespace muGrid {
 
   BOOST_AUTO_TEST_SUITE(field_collection_test);
@@ -358,6 +361,254 @@ namespace muGrid {
     BOOST_CHECK_NO_THROW(F::fc.initialise());
   }
 
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(ghost_layers_periodic_image) {
+    auto & comm{MPIContext::get_context().comm};
+    if (comm.size() != 1) {
+      // the full domain must be on this process for this test
+      return;
+    }
+    const DynCcoord_t nb_grid_pts{5, 4};
+    const DynCcoord_t nb_ghosts_left{1, 2};
+    const DynCcoord_t nb_ghosts_right{2, 1};
+    GlobalFieldCollection fc{nb_grid_pts, nb_grid_pts, DynCcoord_t{0, 0},
+                             nb_ghosts_left, nb_ghosts_right, comm};
+    BOOST_CHECK(fc.has_ghosts());
+    BOOST_CHECK_EQUAL(fc.get_nb_subdomain_grid_pts(), nb_grid_pts);
+    BOOST_CHECK_EQUAL(fc.get_subdomain_locations(), (DynCcoord_t{0, 0}));
+    BOOST_CHECK_EQUAL(fc.get_nb_subdomain_grid_pts_with_ghosts(),
+                      (DynCcoord_t{8, 7}));
+    BOOST_CHECK_EQUAL(fc.get_subdomain_locations_with_ghosts(),
+                      (DynCcoord_t{-1, -2}));
+    BOOST_CHECK_EQUAL(fc.get_nb_pixels(), 8 * 7);
+    BOOST_CHECK_EQUAL(fc.get_left_neighbour_ranks()[0], 0);
+    BOOST_CHECK_EQUAL(fc.get_right_neighbour_ranks()[1], 0);
+
+    auto & field{fc.register_real_field("field", 2)};
+    auto & int_field{fc.register_int_field("int field", 1)};
+    auto && value{[](const DynCcoord_t & ccoord, const Index_t & component) {
+      return 100 * component + 10 * ccoord[0] + ccoord[1];
+    }};
+    field.eigen_vec().setConstant(-1);
+    int_field.eigen_vec().setConstant(-1);
+    auto && map{field.get_pixel_map()};
+    auto && int_map{int_field.get_pixel_map()};
+    for (auto && ccoord : CcoordOps::DynamicPixels(nb_grid_pts)) {
+      auto && index{fc.get_pixels().get_index(ccoord)};
+      map[index] << value(ccoord, 0), value(ccoord, 1);
+      int_map[index] << value(ccoord, 0);
+    }
+    field.communicate_ghosts();
+    int_field.communicate_ghosts();
+
+    // the ghosts (including the corners) hold the periodic image
+    for (auto && id_ccoord : fc.get_pixels().enumerate()) {
+      auto && index{std::get<0>(id_ccoord)};
+      auto && ccoord{std::get<1>(id_ccoord)};
+      DynCcoord_t periodic_ccoord{(ccoord + nb_grid_pts) % nb_grid_pts};
+      BOOST_CHECK_EQUAL(map[index](0), value(periodic_ccoord, 0));
+      BOOST_CHECK_EQUAL(map[index](1), value(periodic_ccoord, 1));
+      BOOST_CHECK_EQUAL(int_map[index](0), value(periodic_ccoord, 0));
+    }
+
+    // an empty clone has the same ghost layers
+    auto && clone{fc.get_empty_clone()};
+    BOOST_CHECK_EQUAL(clone.get_nb_ghosts_left(), nb_ghosts_left);
+    BOOST_CHECK_EQUAL(clone.get_nb_ghosts_right(), nb_ghosts_right);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(ghost_layers_errors) {
+    auto & comm{MPIContext::get_context().comm};
+    const DynCcoord_t nb_grid_pts{5, 4};
+    GlobalFieldCollection no_ghosts{nb_grid_pts, nb_grid_pts};
+    BOOST_CHECK(not no_ghosts.has_ghosts());
+    auto & field{no_ghosts.register_real_field("field", 1)};
+    // without ghosts there is nothing to do
+    BOOST_CHECK_NO_THROW(field.communicate_ghosts());
+
+    GlobalFieldCollection negative{2};
+    BOOST_CHECK_THROW(negative.initialise(nb_grid_pts, nb_grid_pts,
+                                          DynCcoord_t{0, 0}, DynCcoord_t{-1, 0},
+                                          DynCcoord_t{0, 0}, comm),
+                      FieldCollectionError);
+    GlobalFieldCollection wrong_dim{2};
+    BOOST_CHECK_THROW(wrong_dim.initialise(nb_grid_pts, nb_grid_pts,
+                                           DynCcoord_t{0, 0},
+                                           DynCcoord_t{1, 1, 1},
+                                           DynCcoord_t{0, 0}, comm),
+                      FieldCollectionError);
+    if (comm.size() == 1) {
+      GlobalFieldCollection too_wide{2};
+      BOOST_CHECK_THROW(too_wide.initialise(nb_grid_pts, nb_grid_pts,
+                                            DynCcoord_t{0, 0},
+                                            DynCcoord_t{0, 5},
+                                            DynCcoord_t{0, 0}, comm),
+                        FieldCollectionError);
+    }
+
+    LocalFieldCollection local{2};
+    local.add_pixel(0);
+    local.initialise();
+    auto & local_field{local.register_real_field("local", 1)};
+    BOOST_CHECK_THROW(local_field.communicate_ghosts(), FieldError);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(arena_allocation) {
+    const DynCcoord_t nb_grid_pts{3, 5};
+    for (auto && huge_pages : {false, true}) {
+      GlobalFieldCollection fc{twoD};
+      fc.set_nb_sub_pts("quad", 3);
+      fc.set_arena_allocation(true, huge_pages);
+      BOOST_CHECK(fc.get_arena_allocation());
+      std::vector<Field *> fields{
+          &fc.register_real_field("real", 3, "quad"),
+          &fc.register_int_field("int", 1),
+          &fc.register_complex_field("complex", 2, "quad"),
+          &fc.register_float_field("float", 1)};
+      BOOST_CHECK(fc.get_arena_data() == nullptr);
+      fc.initialise(nb_grid_pts, nb_grid_pts);
+
+      // all fields lie in the arena, aligned and without overlap
+      const char * arena{static_cast<const char *>(fc.get_arena_data())};
+      BOOST_REQUIRE(arena != nullptr);
+      std::set<const char *> starts{};
+      for (auto * field : fields) {
+        const char * data{
+            static_cast<const char *>(field->get_void_data_ptr())};
+        starts.insert(data);
+        BOOST_CHECK(data >= arena and data < arena + fc.get_arena_size());
+        BOOST_CHECK_EQUAL(
+            reinterpret_cast<std::uintptr_t>(data) % FieldAlignment, 0);
+      }
+      BOOST_CHECK_EQUAL(starts.size(), fields.size());
+      auto & real_field{dynamic_cast<RealField &>(*fields[0])};
+      auto & int_field{dynamic_cast<IntField &>(*fields[1])};
+      BOOST_CHECK(real_field.is_in_arena());
+      // the storage of arena fields is not handed out
+      BOOST_CHECK_THROW(real_field.get_values(), FieldError);
+      BOOST_CHECK_EQUAL(real_field.eigen_vec().norm(), 0.);
+      BOOST_CHECK_EQUAL(real_field.get_buffer_size(), 3 * 3 * 15);
+      real_field.eigen_vec().setRandom();
+      int_field.eigen_vec().setConstant(7);
+      BOOST_CHECK_EQUAL(int_field.eigen_vec().sum(), 7 * 15);
+      const Eigen::VectorXd values{real_field.eigen_vec()};
+
+      // fields that outgrow the arena move into memory of their own
+      real_field.set_pad_size(4);
+      const char * real_data{
+          static_cast<const char *>(real_field.get_void_data_ptr())};
+      BOOST_CHECK(real_data < arena or
+                  real_data >= arena + fc.get_arena_size());
+      BOOST_CHECK(not real_field.is_in_arena());
+      BOOST_CHECK_EQUAL(real_field.get_values().size(), 3 * 3 * 15 + 4);
+      BOOST_CHECK_EQUAL(real_field.get_buffer_size(), 3 * 3 * 15 + 4);
+      BOOST_CHECK_EQUAL(
+          (real_field.eigen_vec().head(values.size()) - values).norm(), 0.);
+
+      // fields need to leave the arena explicitly before they are popped,
+      // as they outlive it
+      BOOST_CHECK_THROW(fc.pop_field("int"), FieldCollectionError);
+      int_field.leave_arena();
+      BOOST_CHECK(not int_field.is_in_arena());
+      auto popped{fc.pop_field("int")};
+      BOOST_CHECK_EQUAL(
+          dynamic_cast<IntField &>(*popped).eigen_vec().sum(), 7 * 15);
+
+      // fields registered after initialisation are not in the arena
+      auto & late{fc.register_real_field("late", 1)};
+      const char * late_data{reinterpret_cast<const char *>(late.data())};
+      BOOST_CHECK(late_data < arena or
+                  late_data >= arena + fc.get_arena_size());
+      BOOST_CHECK_THROW(fc.set_arena_allocation(false), FieldCollectionError);
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(arena_allocation_local) {
+    LocalFieldCollection fc{twoD};
+    fc.set_arena_allocation(true);
+    auto & field{fc.register_real_field("field", 2)};
+    Eigen::Array2d value{1., 2.};
+    for (Index_t pixel{0}; pixel < 3; ++pixel) {
+      fc.add_pixel(pixel);
+      field.push_back(value * pixel);
+    }
+    fc.initialise();
+    BOOST_CHECK(static_cast<const char *>(fc.get_arena_data()) ==
+                reinterpret_cast<const char *>(field.data()));
+    // values pushed before initialisation are kept
+    BOOST_CHECK_EQUAL(field.eigen_vec().sum(), 3. * (0. + 1. + 2.));
+    // growing the field requires leaving the arena first
+    BOOST_CHECK_THROW(field.push_back(value), FieldError);
+    BOOST_CHECK_THROW(field.push_back_single(value), FieldError);
+    field.leave_arena();
+    field.push_back(value);
+    BOOST_CHECK_EQUAL(field.get_values().size(), 4 * 2);
+    BOOST_CHECK_EQUAL(field.get_values()[6], value(0));
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(scratch_fields) {
+    const DynCcoord_t nb_grid_pts{4, 3};
+    GlobalFieldCollection fc{twoD};
+    fc.set_nb_sub_pts("quad", 2);
+    BOOST_CHECK_THROW(fc.borrow_real_field(1), FieldCollectionError);
+    fc.initialise(nb_grid_pts, nb_grid_pts);
+
+    const Real * data{nullptr};
+    {
+      auto scratch{fc.borrow_real_field(3, "quad")};
+      BOOST_CHECK_EQUAL(scratch->get_nb_components(), 3);
+      BOOST_CHECK_EQUAL(scratch->get_nb_entries(), 2 * 12);
+      BOOST_CHECK_EQUAL(scratch->eigen_vec().norm(), 0.);
+      scratch->eigen_vec().setConstant(2.);
+      data = scratch->data();
+    }
+    // returned fields are lent again, without allocation or clearing
+    {
+      auto scratch{fc.borrow_real_field(3, "quad")};
+      BOOST_CHECK_EQUAL(scratch->data(), data);
+      BOOST_CHECK_EQUAL((*scratch).eigen_vec().sum(), 2. * 3 * 2 * 12);
+      // fields in use are not lent twice
+      auto other{fc.borrow_real_field(3, "quad")};
+      BOOST_CHECK(other->data() != data);
+      // moving the handle does not return the field
+      auto moved{std::move(other)};
+      auto third{fc.borrow_real_field(3, "quad")};
+      BOOST_CHECK(third->data() != moved->data());
+    }
+    BOOST_CHECK_EQUAL(fc.get_nb_scratch_fields(), 3);
+
+    // fields are only shared between the same type, shape and sub-division
+    {
+      auto complex_scratch{fc.borrow_complex_field(3, "quad")};
+      auto pixel_scratch{fc.borrow_real_field(3)};
+      auto vector_scratch{fc.borrow_real_field(2, "quad")};
+      BOOST_CHECK_EQUAL(pixel_scratch->get_nb_entries(), 12);
+    }
+    BOOST_CHECK_EQUAL(fc.get_nb_scratch_fields(), 6);
+
+    // scratch fields are not registered
+    BOOST_CHECK_EQUAL(fc.list_fields().size(), 0);
+
+    // fields converted by a borrower are lent again in the storage order of
+    // the collection, with their values
+    auto & reference{fc.register_real_field("reference", 3, "quad")};
+    reference.eigen_vec().setRandom();
+    {
+      auto scratch{fc.borrow_real_field(3, "quad")};
+      scratch->convert_storage_order(StorageOrder::RowMajor);
+      reference.copy_to(*scratch);
+    }
+    {
+      auto scratch{fc.borrow_real_field(3, "quad")};
+      BOOST_CHECK_EQUAL(scratch->get_storage_order(), fc.get_storage_order());
+      BOOST_CHECK(scratch->eigen_vec() == reference.eigen_vec());
+    }
+  }
+
   BOOST_AUTO_TEST_SUITE_END();
 
 }  // namespace muGrid
@@ -0,0 +1,169 @@
+/**
+ * @file   test_field_expression.cc
+ *
+ * @author Lars Pastewka <lars.pastewka@imtek.uni-freiburg.de>
+ *
+ * @date   16 Oct 2026
+ *
+ * @brief  tests for the lazy element-wise expressions of fields
+ *
+ * Copyright © 2026 Lars Pastewka
+ *
+ * µGrid is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * µGrid is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with µGrid; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * Additional permission under GNU GPL version 3 section 7
+ *
+ * If you modify this Program, or any covered work, by linking or combining it
+ * with proprietary FFT implementations or numerical libraries, containing parts
+ * covered by the terms of those libraries' licenses, the licensors of this
+ * Program grant you additional permission to convey the resulting work.
+ *
+ */
+
+#include "tests.hh"
+
+#include "libmugrid/field_collection_global.hh"
+#include "libmugrid/field_expression.hh"
+
+namespace muGrid {
+
+  BOOST_AUTO_TEST_SUITE(field_expression);
+
+  /* ---------------------------------------------------------------------- */
+  //! grid large enough to be split among threads
+  struct ExpressionFixture {
+    static constexpr Index_t NbComponents{3};
+    ExpressionFixture() {
+      this->a.eigen_vec().setRandom();
+      this->b.eigen_vec().setRandom();
+      this->d.eigen_vec().setRandom();
+      this->d.eigen_vec().array() += Real{3};
+    }
+    DynCcoord_t nb_grid_pts{161, 157};
+    GlobalFieldCollection fc{nb_grid_pts, nb_grid_pts};
+    TypedField<Real> & a{fc.register_real_field("a", NbComponents)};
+    TypedField<Real> & b{fc.register_real_field("b", NbComponents)};
+    TypedField<Real> & c{fc.register_real_field("c", NbComponents)};
+    TypedField<Real> & d{fc.register_real_field("d", NbComponents)};
+  };
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_FIXTURE_TEST_CASE(arithmetic, ExpressionFixture) {
+    const Real alpha{1.3};
+    const Eigen::ArrayXd a_ref{this->a.eigen_vec()};
+    const Eigen::ArrayXd b_ref{this->b.eigen_vec()};
+    const Eigen::ArrayXd d_ref{this->d.eigen_vec()};
+    for (Index_t nb_threads{1}; nb_threads < 4; ++nb_threads) {
+      linalg::set_nb_threads(nb_threads);
+      auto && c_vec{this->c.eigen_vec().array()};
+
+      this->c = this->a + alpha * this->b - this->d;
+      BOOST_CHECK_LE((c_vec - (a_ref + alpha * b_ref - d_ref)).abs().maxCoeff(),
+                     tol);
+
+      this->c = (this->a - 2) * this->b / this->d + 1.5;
+      BOOST_CHECK_LE(
+          (c_vec - ((a_ref - 2) * b_ref / d_ref + 1.5)).abs().maxCoeff(), tol);
+
+      this->c = 1. / this->d - this->a * alpha;
+      BOOST_CHECK_LE((c_vec - (1. / d_ref - a_ref * alpha)).abs().maxCoeff(),
+                     tol);
+
+      // negatives of expressions and of fields
+      this->c = -(this->a + this->b) + -this->d;
+      BOOST_CHECK_LE((c_vec - (-(a_ref + b_ref) - d_ref)).abs().maxCoeff(),
+                     tol);
+
+      // the target can appear in the expression
+      this->c = this->a;
+      this->c = this->c * this->b;
+      BOOST_CHECK_LE((c_vec - a_ref * b_ref).abs().maxCoeff(), tol);
+
+      this->c += alpha * this->a;
+      BOOST_CHECK_LE((c_vec - (a_ref * b_ref + alpha * a_ref)).abs().maxCoeff(),
+                     tol);
+      this->c -= this->a * this->b;
+      BOOST_CHECK_LE((c_vec - alpha * a_ref).abs().maxCoeff(), tol);
+    }
+    linalg::set_nb_threads(1);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(complex_and_float_fields) {
+    DynCcoord_t nb_grid_pts{16, 12};
+    GlobalFieldCollection fc{nb_grid_pts, nb_grid_pts};
+    auto & xc{fc.register_complex_field("xc", 2)};
+    auto & yc{fc.register_complex_field("yc", 2)};
+    auto & xf{fc.register_float_field("xf", 2)};
+    auto & yf{fc.register_float_field("yf", 2)};
+    xc.eigen_vec().setRandom();
+    xf.eigen_vec().setRandom();
+
+    const Complex alpha{.5, 2.};
+    yc = alpha * xc - xc * xc;
+    const Eigen::ArrayXcd xc_ref{xc.eigen_vec()};
+    BOOST_CHECK_LE((yc.eigen_vec().array() - (alpha * xc_ref - xc_ref * xc_ref))
+                       .abs()
+                       .maxCoeff(),
+                   tol);
+
+    // scalars are converted to the scalar type of the fields
+    yf = 2.5 * xf + 1;
+    const Eigen::ArrayXf xf_ref{xf.eigen_vec()};
+    BOOST_CHECK_LE(
+        (yf.eigen_vec().array() - (2.5f * xf_ref + 1)).abs().maxCoeff(),
+        1e-6);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_FIXTURE_TEST_CASE(layout_mismatch, ExpressionFixture) {
+    auto & w{this->fc.register_real_field("w", NbComponents + 1)};
+    BOOST_CHECK_THROW(this->c = this->a + w, FieldError);
+    BOOST_CHECK_THROW(w = 2. * this->a, FieldError);
+    BOOST_CHECK_THROW(this->c += this->a * (this->b - w), FieldError);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_FIXTURE_TEST_CASE(units, ExpressionFixture) {
+    auto & length{this->fc.register_real_field("length", NbComponents,
+                                               PixelTag, Unit::length())};
+    auto & area{this->fc.register_real_field(
+        "area", NbComponents, PixelTag, Unit::length() * Unit::length())};
+    length.eigen_vec().setConstant(2);
+
+    // products and quotients combine the units, scalars are dimensionless
+    BOOST_CHECK_NO_THROW(area = length * length);
+    BOOST_CHECK_THROW(area = 2. * length, UnitError);
+    BOOST_CHECK_NO_THROW(length = 3. * length / this->d);
+    BOOST_CHECK_NO_THROW(this->c = length / length);
+    BOOST_CHECK_THROW(this->c = length * this->a, UnitError);
+
+    // a scalar over a field has the reciprocal unit of the field
+    BOOST_CHECK_EQUAL((2. / length).get_unit(), Unit::length().reciprocal());
+    BOOST_CHECK_EQUAL((2. / length).get_unit(),
+                      Unit::unitless() / Unit::length());
+    BOOST_CHECK_EQUAL((2. / this->a).get_unit(), Unit::unitless());
+    BOOST_CHECK_THROW(length = 2. / length, UnitError);
+    BOOST_CHECK_NO_THROW(length = 2. / (this->d / length));
+
+    // only quantities of the same unit can be added
+    BOOST_CHECK_THROW(length = length + this->a, UnitError);
+    BOOST_CHECK_NO_THROW(length = length + 1.);
+  }
+
+  BOOST_AUTO_TEST_SUITE_END();
+
+}  // namespace muGrid
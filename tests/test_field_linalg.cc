@@ -0,0 +1,374 @@
+/**
+ * @file   test_field_linalg.cc
+ *
+ * @author Lars Pastewka <lars.pastewka@imtek.uni-freiburg.de>
+ *
+ * @date   16 Oct 2026
+ *
+ * @brief  tests for the BLAS-1 operations on fields
+ *
+ * Copyright © 2026 Lars Pastewka
+ *
+ * µGrid is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * µGrid is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with µGrid; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * Additional permission under GNU GPL version 3 section 7
+ *
+ * If you modify this Program, or any covered work, by linking or combining it
+ * with proprietary FFT implementations or numerical libraries, containing parts
+ * covered by the terms of those libraries' licenses, the licensors of this
+ * Program grant you additional permission to convey the resulting work.
+ *
+ */
+
+#include "tests.hh"
+
+#include "libmugrid/ccoord_operations.hh"
+#include "libmugrid/field_collection_global.hh"
+#include "libmugrid/field_linalg.hh"
+#include "libmugrid/field_typed.hh"
+
+#include <algorithm>
+#include <thread>
+
+namespace muGrid {
+
+  BOOST_AUTO_TEST_SUITE(field_linalg);
+
+  /* ---------------------------------------------------------------------- */
+  //! odd grid large enough for every thread to get a (ragged) chunk
+  struct LinalgFixture {
+    static constexpr Index_t NbComponents{3};
+    LinalgFixture() {
+      this->x.eigen_vec().setRandom();
+      this->y.eigen_vec().setRandom();
+      // keep the divisor away from zero
+      this->y.eigen_vec().array() += Real{3};
+    }
+    DynCcoord_t nb_grid_pts{161, 157};
+    GlobalFieldCollection fc{nb_grid_pts, nb_grid_pts};
+    TypedField<Real> & x{fc.register_real_field("x", NbComponents)};
+    TypedField<Real> & y{fc.register_real_field("y", NbComponents)};
+    TypedField<Real> & z{fc.register_real_field("z", NbComponents)};
+  };
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_FIXTURE_TEST_CASE(operations, LinalgFixture) {
+    const Real alpha{1.7}, beta{-.3}, value{4.2};
+    const Eigen::ArrayXd x_ref{this->x.eigen_vec()};
+    const Eigen::ArrayXd y_ref{this->y.eigen_vec()};
+    for (Index_t nb_threads{1}; nb_threads < 5; ++nb_threads) {
+      linalg::set_nb_threads(nb_threads);
+      BOOST_CHECK_EQUAL(linalg::get_nb_threads(), nb_threads);
+      auto && z_vec{this->z.eigen_vec().array()};
+
+      linalg::fill(value, this->z);
+      BOOST_CHECK_EQUAL((z_vec - value).abs().maxCoeff(), 0);
+
+      linalg::copy(this->x, this->z);
+      BOOST_CHECK_EQUAL((z_vec - x_ref).abs().maxCoeff(), 0);
+
+      linalg::scale(alpha, this->z);
+      BOOST_CHECK_LE((z_vec - alpha * x_ref).abs().maxCoeff(), tol);
+
+      linalg::copy(this->y, this->z);
+      linalg::axpy(alpha, this->x, this->z);
+      BOOST_CHECK_LE((z_vec - (alpha * x_ref + y_ref)).abs().maxCoeff(), tol);
+
+      linalg::copy(this->y, this->z);
+      linalg::axpby(alpha, this->x, beta, this->z);
+      BOOST_CHECK_LE(
+          (z_vec - (alpha * x_ref + beta * y_ref)).abs().maxCoeff(), tol);
+
+      linalg::multiply(this->x, this->y, this->z);
+      BOOST_CHECK_LE((z_vec - x_ref * y_ref).abs().maxCoeff(), tol);
+
+      linalg::divide(this->x, this->y, this->z);
+      BOOST_CHECK_LE((z_vec - x_ref / y_ref).abs().maxCoeff(), tol);
+    }
+    linalg::set_nb_threads(1);
+    BOOST_CHECK_THROW(linalg::set_nb_threads(0), RuntimeError);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(complex_and_float_fields) {
+    DynCcoord_t nb_grid_pts{256, 256};
+    GlobalFieldCollection fc{nb_grid_pts, nb_grid_pts};
+    auto & xc{fc.register_complex_field("xc", 2)};
+    auto & yc{fc.register_complex_field("yc", 2)};
+    auto & xf{fc.register_float_field("xf", 2)};
+    auto & yf{fc.register_float_field("yf", 2)};
+    xc.eigen_vec().setRandom();
+    yc.eigen_vec().setRandom();
+    xf.eigen_vec().setRandom();
+    yf.eigen_vec().setRandom();
+    const Eigen::ArrayXcd yc_ref{yc.eigen_vec()};
+    const Eigen::ArrayXf yf_ref{yf.eigen_vec()};
+
+    linalg::set_nb_threads(3);
+    const Complex alpha{.5, -2.};
+    linalg::axpy(alpha, xc, yc);
+    BOOST_CHECK_LE(
+        (yc.eigen_vec().array() - (alpha * xc.eigen_vec().array() + yc_ref))
+            .abs()
+            .maxCoeff(),
+        tol);
+    linalg::axpy(Float{2}, xf, yf);
+    BOOST_CHECK_LE(
+        (yf.eigen_vec().array() - (2 * xf.eigen_vec().array() + yf_ref))
+            .abs()
+            .maxCoeff(),
+        1e-6);
+    linalg::set_nb_threads(1);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_FIXTURE_TEST_CASE(layout_mismatch, LinalgFixture) {
+    auto & w{this->fc.register_real_field("w", NbComponents + 1)};
+    BOOST_CHECK_THROW(linalg::copy(this->x, w), FieldError);
+    BOOST_CHECK_THROW(linalg::axpy(1., w, this->y), FieldError);
+    BOOST_CHECK_THROW(linalg::multiply(this->x, this->y, w), FieldError);
+
+    this->fc.set_nb_sub_pts("quad", 2);
+    auto & v{this->fc.register_real_field("v", NbComponents, "quad")};
+    BOOST_CHECK_THROW(linalg::axpby(1., this->x, 1., v), FieldError);
+
+    GlobalFieldCollection uninitialised{twoD};
+    auto & u{uninitialised.register_real_field("u", NbComponents)};
+    BOOST_CHECK_THROW(linalg::fill(1., u), FieldError);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_FIXTURE_TEST_CASE(reductions, LinalgFixture) {
+    // garbage in the pad region must not contribute
+    const Index_t nb_values{this->x.get_nb_entries() * NbComponents};
+    const Index_t pad_size{13};
+    this->x.set_pad_size(pad_size);
+    for (Index_t i{0}; i < pad_size; ++i) {
+      this->x.data()[nb_values + i] = 1e10;
+    }
+    const auto & x_vec{this->x.eigen_vec()};
+    const auto & y_vec{this->y.eigen_vec()};
+    for (Index_t nb_threads{1}; nb_threads < 5; ++nb_threads) {
+      linalg::set_nb_threads(nb_threads);
+      BOOST_CHECK_LE(std::abs(linalg::dot(this->x, this->y) - x_vec.dot(y_vec)),
+                     tol * nb_values);
+      BOOST_CHECK_LE(std::abs(linalg::norm2(this->x) - x_vec.norm()),
+                     tol * nb_values);
+      BOOST_CHECK_EQUAL(linalg::max_abs(this->y), y_vec.cwiseAbs().maxCoeff());
+
+      auto && dots{linalg::dot_many<Real>(
+          {{this->x, this->y}, {this->x, this->x}, {this->y, this->y}})};
+      BOOST_REQUIRE_EQUAL(dots.size(), 3);
+      BOOST_CHECK_LE(std::abs(dots[0] - x_vec.dot(y_vec)), tol * nb_values);
+      BOOST_CHECK_LE(std::abs(dots[1] - x_vec.squaredNorm()),
+                     tol * nb_values);
+      BOOST_CHECK_LE(std::abs(dots[2] - y_vec.squaredNorm()),
+                     tol * nb_values);
+    }
+
+    // the split of the work is static, hence the results are reproducible
+    const Real reference{linalg::dot(this->x, this->y)};
+    for (Index_t i{0}; i < 5; ++i) {
+      BOOST_CHECK_EQUAL(linalg::dot(this->x, this->y), reference);
+    }
+    linalg::set_nb_threads(1);
+    BOOST_CHECK(linalg::dot_many<Real>({}).empty());
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(complex_and_float_reductions) {
+    DynCcoord_t nb_grid_pts{64, 48};
+    GlobalFieldCollection fc{nb_grid_pts, nb_grid_pts};
+    auto & xc{fc.register_complex_field("xc", 2)};
+    auto & yc{fc.register_complex_field("yc", 2)};
+    auto & xf{fc.register_float_field("xf", 2)};
+    xc.eigen_vec().setRandom();
+    yc.eigen_vec().setRandom();
+    xf.eigen_vec().setRandom();
+
+    // the first argument is conjugated
+    BOOST_CHECK_LE(std::abs(linalg::dot(xc, yc) -
+                            xc.eigen_vec().dot(yc.eigen_vec())),
+                   tol);
+    BOOST_CHECK_LE(std::abs(linalg::norm2(xc) - xc.eigen_vec().norm()), tol);
+    BOOST_CHECK_EQUAL(linalg::max_abs(xc),
+                      xc.eigen_vec().cwiseAbs().maxCoeff());
+
+    // single precision is accumulated in double precision
+    const Eigen::VectorXd xd{xf.eigen_vec().cast<Real>()};
+    BOOST_CHECK_LE(std::abs(linalg::dot(xf, xf) - xd.squaredNorm()),
+                   tol * xd.squaredNorm());
+    BOOST_CHECK_LE(std::abs(linalg::norm2(xf) - xd.norm()), tol * xd.norm());
+    BOOST_CHECK_EQUAL(linalg::max_abs(xf),
+                      xf.eigen_vec().cwiseAbs().maxCoeff());
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(reductions_skip_ghosts) {
+    const DynCcoord_t nb_grid_pts{7, 5};
+    for (auto && storage_order : {StorageOrder::ArrayOfStructures,
+                                  StorageOrder::StructurOfArrays}) {
+      GlobalFieldCollection fc{nb_grid_pts, nb_grid_pts, DynCcoord_t{0, 0},
+                               DynCcoord_t{2, 1},     DynCcoord_t{1, 3},
+                               Communicator{},        {},
+                               storage_order};
+      fc.set_nb_sub_pts("quad", 2);
+      auto & x{fc.register_real_field("x", 3, "quad")};
+      auto & y{fc.register_real_field("y", 3, "quad")};
+
+      // ghosts hold garbage, the subdomain holds the value 2 in x and the
+      // linear index of the pixel in y
+      linalg::fill(Real{1e10}, x);
+      linalg::fill(Real{-1e10}, y);
+      const Index_t nb_dof{x.get_nb_dof_per_pixel()};
+      const Index_t nb_buffer_pixels{fc.get_nb_buffer_pixels()};
+      Real y_sum{0};
+      Index_t nb_pixels{0};
+      for (auto && ccoord : CcoordOps::DynamicPixels(nb_grid_pts)) {
+        const Index_t index{fc.get_pixels().get_index(ccoord)};
+        for (Index_t dof{0}; dof < nb_dof; ++dof) {
+          const Index_t i{storage_order == StorageOrder::ArrayOfStructures
+                              ? index * nb_dof + dof
+                              : dof * nb_buffer_pixels + index};
+          x.data()[i] = 2;
+          y.data()[i] = nb_pixels;
+        }
+        y_sum += nb_pixels;
+        ++nb_pixels;
+      }
+      BOOST_CHECK_EQUAL(linalg::dot(x, y), 2 * nb_dof * y_sum);
+      BOOST_CHECK_EQUAL(linalg::norm2(x), std::sqrt(4. * nb_dof * nb_pixels));
+      BOOST_CHECK_EQUAL(linalg::max_abs(y), nb_pixels - 1);
+      auto && dots{linalg::dot_many<Real>({{x, y}, {x, x}})};
+      BOOST_CHECK_EQUAL(dots[0], 2 * nb_dof * y_sum);
+      BOOST_CHECK_EQUAL(dots[1], 4 * nb_dof * nb_pixels);
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_FIXTURE_TEST_CASE(reduction_layout_mismatch, LinalgFixture) {
+    auto & w{this->fc.register_real_field("w", NbComponents + 1)};
+    BOOST_CHECK_THROW(linalg::dot(this->x, w), FieldError);
+    BOOST_CHECK_THROW(linalg::dot_many<Real>({{this->x, this->y}, {w, w}}),
+                      FieldError);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(first_touch_initialisation) {
+    // fields are zero-initialised on the threads of the operations, in their
+    // own memory, in the arena and when they leave it
+    const DynCcoord_t nb_grid_pts{161, 157};
+    linalg::set_nb_threads(3);
+    for (auto && arena : {false, true}) {
+      GlobalFieldCollection fc{twoD};
+      fc.set_arena_allocation(arena);
+      auto & real{fc.register_real_field("real", 3)};
+      auto & complex{fc.register_complex_field("complex", 2)};
+      auto & integer{fc.register_int_field("int", 1)};
+      fc.initialise(nb_grid_pts, nb_grid_pts);
+      BOOST_CHECK_EQUAL(real.is_in_arena(), arena);
+      BOOST_CHECK_EQUAL(real.eigen_vec().cwiseAbs().maxCoeff(), 0);
+      BOOST_CHECK_EQUAL(complex.eigen_vec().cwiseAbs().maxCoeff(), 0);
+      BOOST_CHECK_EQUAL(integer.eigen_vec().cwiseAbs().maxCoeff(), 0);
+
+      // a larger pad region moves the field into memory of its own
+      linalg::fill(Real{2}, real);
+      real.set_pad_size(5);
+      BOOST_CHECK(not real.is_in_arena());
+      auto && values{real.get_values()};
+      BOOST_CHECK_EQUAL(values.size(), real.get_nb_buffer_entries() * 3 + 5);
+      for (size_t i{0}; i < values.size(); ++i) {
+        BOOST_CHECK_EQUAL(values[i], i < values.size() - 5 ? 2 : 0);
+      }
+
+      linalg::fill(Int{7}, integer);
+      integer.leave_arena();
+      BOOST_CHECK_EQUAL(integer.eigen_vec().sum(),
+                        7 * integer.get_nb_buffer_entries());
+    }
+    linalg::set_nb_threads(1);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(threaded_set_zero) {
+    // set_zero clears the whole buffer on the threads of the operations, the
+    // pad region on the calling thread
+    const DynCcoord_t nb_grid_pts{161, 157};
+    linalg::set_nb_threads(3);
+    GlobalFieldCollection fc{nb_grid_pts, nb_grid_pts};
+    auto & field{fc.register_real_field("field", 3)};
+    field.set_pad_size(5);
+    auto && values{field.get_values()};
+    std::fill(values.begin(), values.end(), Real{1});
+    field.set_zero();
+    BOOST_CHECK_EQUAL(*std::max_element(values.begin(), values.end()), 0);
+
+    std::vector<Real> memory(values.size() - 5, 1);
+    WrappedField<Real> wrapped{"wrapped", fc, 3, memory.size(), memory.data(),
+                               PixelTag};
+    wrapped.set_zero();
+    BOOST_CHECK_EQUAL(*std::max_element(memory.begin(), memory.end()), 0);
+    linalg::set_nb_threads(1);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(concurrent_allocation) {
+    // fields allocated and filled from two threads at a time share the pool
+    const DynCcoord_t nb_grid_pts{257, 263};
+    linalg::set_nb_threads(2);
+    std::vector<Real> sums(2, 0);
+    auto && allocate{[&nb_grid_pts, &sums](const Index_t & id) {
+      for (Index_t i{0}; i < 5; ++i) {
+        GlobalFieldCollection fc{nb_grid_pts, nb_grid_pts};
+        auto & field{fc.register_real_field("field", 3)};
+        linalg::fill(Real(id + 1), field);
+        sums[id] += linalg::dot(field, field);
+      }
+    }};
+    std::thread other{allocate, 1};
+    allocate(0);
+    other.join();
+    linalg::set_nb_threads(1);
+    const Real nb_values(nb_grid_pts[0] * nb_grid_pts[1] * 3);
+    BOOST_CHECK_CLOSE(sums[0], 5 * nb_values, tol);
+    BOOST_CHECK_CLOSE(sums[1], 5 * 4 * nb_values, tol);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(subdomain_without_communicator) {
+    // the left half of a domain, as one of two processes would hold it
+    const DynCcoord_t nb_domain_grid_pts{8, 6};
+    const DynCcoord_t nb_subdomain_grid_pts{4, 6};
+    GlobalFieldCollection fc{nb_domain_grid_pts, nb_subdomain_grid_pts,
+                             DynCcoord_t{0, 0}};
+    auto & x{fc.register_real_field("x", 2)};
+    linalg::fill(Real{1}, x);
+
+    // reducing over the serial default would only return the local part
+    BOOST_CHECK_THROW(linalg::dot(x, x), FieldError);
+    BOOST_CHECK_THROW(linalg::norm2(x), FieldError);
+    BOOST_CHECK_THROW(linalg::max_abs(x), FieldError);
+    BOOST_CHECK_THROW(linalg::dot_many<Real>({{x, x}}), FieldError);
+
+    // an explicit communicator is accepted
+    const Communicator comm{};
+    BOOST_CHECK_EQUAL(linalg::dot(x, x, comm), 2 * 4 * 6);
+    BOOST_CHECK_EQUAL(linalg::max_abs(x, comm), 1);
+  }
+
+  BOOST_AUTO_TEST_SUITE_END();
+
+}  // namespace muGrid
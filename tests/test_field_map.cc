@@ -38,6 +38,7 @@
 #include "field_test_fixtures.hh"
 
 #include "libmugrid/iterators.hh"
+#include "libmugrid/tensor_algebra.hh"
 
 namespace muGrid {
   BOOST_AUTO_TEST_SUITE(field_maps);
@@ -329,5 +330,200 @@ namespace muGrid {
     BOOST_CHECK_EQUAL(this->pixel_quad_pt_map.mean(), pix_quad_mean);
   }
 
+  /* ---------------------------------------------------------------------- */
+  BOOST_FIXTURE_TEST_CASE(aligned_maps, SubDivisionFixture) {
+    auto & field{this->fc.register_real_field("aligned", 2, PixelTag)};
+    field.eigen_vec().setRandom();
+    using Aligned_t = AlignedMatrixFieldMap<Real, Mapping::Const, 2, 1,
+                                            IterUnit::Pixel, Eigen::Aligned16>;
+    Aligned_t aligned_map{field};
+    FieldMap<Real, Mapping::Const> map{field};
+    for (auto && tup : akantu::zip(aligned_map, map)) {
+      BOOST_CHECK_EQUAL(std::get<0>(tup), std::get<1>(tup));
+    }
+
+    // iterates of 24 bytes cannot all be aligned to 16 bytes
+    auto & odd_field{this->fc.register_real_field("odd", 3, PixelTag)};
+    using Misaligned_t =
+        AlignedMatrixFieldMap<Real, Mapping::Const, 3, 1, IterUnit::Pixel,
+                              Eigen::Aligned16>;
+    BOOST_CHECK_THROW(Misaligned_t{odd_field}, FieldMapError);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(structure_of_arrays_maps) {
+    const DynCcoord_t nb_grid_pts{3, 5};
+    const std::string quad{"quad"};
+    const FieldCollection::SubPtMap_t nb_sub_pts{{quad, 2}};
+    GlobalFieldCollection aos_fc{nb_grid_pts, nb_grid_pts, {},
+                                 nb_sub_pts, StorageOrder::ColMajor};
+    GlobalFieldCollection soa_fc{nb_grid_pts,       nb_grid_pts,
+                                 DynCcoord_t{0, 0}, StorageOrder::ColMajor,
+                                 nb_sub_pts,        StorageOrder::RowMajor};
+    const Shape_t components_shape{2, 3};
+    auto & aos{aos_fc.register_real_field("tensor", components_shape, quad)};
+    auto & soa{soa_fc.register_real_field("tensor", components_shape, quad)};
+    auto & aos_scalar{aos_fc.register_real_field("scalar", 1, quad)};
+    auto & soa_scalar{soa_fc.register_real_field("scalar", 1, quad)};
+    aos.eigen_vec().setRandom();
+    aos_scalar.eigen_vec().setRandom();
+    aos.copy_to(soa);
+    aos_scalar.copy_to(soa_scalar);
+
+    // dynamic maps have contiguous iterates
+    BOOST_CHECK_THROW((FieldMap<Real, Mapping::Const>{soa}), RuntimeError);
+
+    // static maps with strided iterates
+    using Strided_t =
+        StridedMatrixFieldMap<Real, Mapping::Mut, 2, 3, IterUnit::SubPt>;
+    Strided_t aos_strided{aos};
+    Strided_t soa_strided{soa};
+    BOOST_CHECK(aos_strided.is_contiguous());
+    BOOST_CHECK(not soa_strided.is_contiguous());
+    BOOST_CHECK_EQUAL(aos_strided.size(), soa_strided.size());
+    for (auto && tup : akantu::zip(aos_strided, soa_strided)) {
+      BOOST_CHECK_EQUAL(std::get<0>(tup), std::get<1>(tup));
+    }
+    BOOST_CHECK_EQUAL(aos_strided.mean(), soa_strided.mean());
+    using StridedPixel_t =
+        StridedMatrixFieldMap<Real, Mapping::Const, 6, 2, IterUnit::Pixel>;
+    // a row-major 2 × 3 tensor is not a strided 6-vector
+    BOOST_CHECK_THROW(StridedPixel_t{soa}, FieldMapError);
+    using StridedVector_t =
+        StridedMatrixFieldMap<Real, Mapping::Const, 1, 2, IterUnit::Pixel>;
+    StridedVector_t aos_pixels{aos_scalar};
+    StridedVector_t soa_pixels{soa_scalar};
+    for (auto && tup : akantu::zip(aos_pixels, soa_pixels)) {
+      BOOST_CHECK_EQUAL(std::get<0>(tup), std::get<1>(tup));
+    }
+    for (auto && iterate : soa_strided) {
+      iterate *= 2;
+    }
+    Eigen::VectorXd expected{2 * aos.eigen_vec()};
+    soa.copy_to(aos);
+    BOOST_CHECK_EQUAL((aos.eigen_vec() - expected).norm(), 0);
+    for (size_t i{0}; i < soa_strided.size(); ++i) {
+      BOOST_CHECK_EQUAL(aos_strided[i], soa_strided[i]);
+    }
+
+    // scalar maps need no strides
+    using Scalar_t = ScalarFieldMap<Real, Mapping::Const, IterUnit::SubPt>;
+    Scalar_t aos_scalar_map{aos_scalar};
+    Scalar_t soa_scalar_map{soa_scalar};
+    for (auto && tup : akantu::zip(aos_scalar_map, soa_scalar_map)) {
+      BOOST_CHECK_EQUAL(std::get<0>(tup), std::get<1>(tup));
+    }
+
+    // contiguous static maps refuse structures of arrays
+    using Contiguous_t =
+        MatrixFieldMap<Real, Mapping::Const, 2, 3, IterUnit::SubPt>;
+    BOOST_CHECK_THROW(Contiguous_t{soa}, RuntimeError);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(batched_iteration) {
+    // 15 pixels, such that the last batch of each sub-point is incomplete
+    const DynCcoord_t nb_grid_pts{3, 5};
+    const std::string quad{"quad"};
+    constexpr Dim_t Dim{twoD};
+    constexpr Dim_t Width{4};
+    const FieldCollection::SubPtMap_t nb_sub_pts{{quad, 2}};
+    GlobalFieldCollection aos_fc{nb_grid_pts, nb_grid_pts, {},
+                                 nb_sub_pts, StorageOrder::ColMajor};
+    GlobalFieldCollection soa_fc{nb_grid_pts,       nb_grid_pts,
+                                 DynCcoord_t{0, 0}, StorageOrder::ColMajor,
+                                 nb_sub_pts,        StorageOrder::RowMajor};
+    const Shape_t t2_shape{Dim, Dim};
+    const Shape_t t4_shape{Dim * Dim, Dim * Dim};
+    auto & aos_strain{aos_fc.register_real_field("strain", t2_shape, quad)};
+    auto & aos_stiffness{
+        aos_fc.register_real_field("stiffness", t4_shape, quad)};
+    auto & aos_stress{aos_fc.register_real_field("stress", t2_shape, quad)};
+    auto & soa_strain{soa_fc.register_real_field("strain", t2_shape, quad)};
+    auto & soa_stiffness{
+        soa_fc.register_real_field("stiffness", t4_shape, quad)};
+    auto & soa_stress{soa_fc.register_real_field("stress", t2_shape, quad)};
+    aos_strain.eigen_vec().setRandom();
+    aos_stiffness.eigen_vec().setRandom();
+    aos_strain.copy_to(soa_strain);
+    aos_stiffness.copy_to(soa_stiffness);
+
+    using T2Map_t = StridedT2FieldMap<Real, Mapping::Const, Dim,
+                                      IterUnit::SubPt>;
+    using T4Map_t = StridedT4FieldMap<Real, Mapping::Const, Dim,
+                                      IterUnit::SubPt>;
+    using T2MutMap_t = StridedT2FieldMap<Real, Mapping::Mut, Dim,
+                                         IterUnit::SubPt>;
+    T2Map_t aos_strain_map{aos_strain}, soa_strain_map{soa_strain};
+    T4Map_t aos_stiffness_map{aos_stiffness},
+        soa_stiffness_map{soa_stiffness};
+    T2MutMap_t aos_stress_map{aos_stress}, soa_stress_map{soa_stress};
+
+    // every iterate is handed out exactly once and in the same order for
+    // both storage orders
+    auto && aos_batches{aos_strain_map.batches<Width>()};
+    auto && soa_batches{soa_strain_map.batches<Width>()};
+    BOOST_CHECK_EQUAL(aos_batches.size(), 2 * 4);
+    Index_t nb_points{0};
+    for (auto && tup : akantu::zip(aos_batches, soa_batches)) {
+      auto && aos_batch{std::get<0>(tup)};
+      auto && soa_batch{std::get<1>(tup)};
+      BOOST_CHECK_EQUAL(aos_batch.size(), soa_batch.size());
+      const auto aos_values{aos_batch.load()};
+      const auto soa_values{soa_batch.load()};
+      BOOST_CHECK_EQUAL(aos_values.values.matrix(),
+                        soa_values.values.matrix());
+      for (Dim_t point{0}; point < Width; ++point) {
+        if (point < aos_batch.size()) {
+          BOOST_CHECK_EQUAL(aos_values.get_point(point),
+                            aos_strain_map[aos_batch.get_index(point)]);
+        } else {
+          BOOST_CHECK_EQUAL(aos_values.get_point(point).norm(), 0);
+        }
+      }
+      nb_points += aos_batch.size();
+    }
+    BOOST_CHECK_EQUAL(nb_points, aos_strain_map.size());
+
+    // batched evaluation of σ = C:ε
+    auto evaluate = [](auto & strain_map, auto & stiffness_map,
+                       auto & stress_map) {
+      for (auto && tup :
+           akantu::zip(strain_map.template batches<Width>(),
+                       stiffness_map.template batches<Width>(),
+                       stress_map.template batches<Width>())) {
+        auto && strain{std::get<0>(tup).load()};
+        auto && stiffness{std::get<1>(tup).load()};
+        std::get<2>(tup).store(Batches::tensmult<Dim>(stiffness, strain));
+      }
+    };
+    evaluate(aos_strain_map, aos_stiffness_map, aos_stress_map);
+    evaluate(soa_strain_map, soa_stiffness_map, soa_stress_map);
+    for (size_t i{0}; i < aos_stress_map.size(); ++i) {
+      const Eigen::Matrix<Real, Dim, Dim> reference{
+          Matrices::tensmult(aos_stiffness_map[i], aos_strain_map[i])};
+      BOOST_CHECK_LT((aos_stress_map[i] - reference).norm(), tol);
+      BOOST_CHECK_LT((soa_stress_map[i] - reference).norm(), tol);
+      // per-point tensor algebra on strided iterates
+      const Eigen::Matrix<Real, Dim, Dim> soa_reference{
+          Matrices::tensmult(soa_stiffness_map[i], soa_strain_map[i])};
+      BOOST_CHECK_LT((soa_reference - reference).norm(), tol);
+    }
+
+    // batches at the default width of contiguous maps
+    T2FieldMap<Real, Mapping::Const, Dim, IterUnit::SubPt> contiguous{
+        aos_strain};
+    nb_points = 0;
+    for (auto && batch : contiguous.batches()) {
+      const auto values{batch.load()};
+      for (Index_t point{0}; point < batch.size(); ++point) {
+        BOOST_CHECK_EQUAL(values.get_point(point),
+                          contiguous[batch.get_index(point)]);
+      }
+      nb_points += batch.size();
+    }
+    BOOST_CHECK_EQUAL(nb_points, contiguous.size());
+  }
+
   BOOST_AUTO_TEST_SUITE_END();
 }  // namespace muGrid
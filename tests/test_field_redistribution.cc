@@ -0,0 +1,114 @@
+/**
+ * @file   test_field_redistribution.cc
+ *
+ * @author Lars Pastewka <lars.pastewka@imtek.uni-freiburg.de>
+ *
+ * @date   16 Oct 2026
+ *
+ * @brief  Tests for the redistribution of fields between
+ *         collections
+ *
+ * Copyright © 2026 Lars Pastewka
+ *
+ * µGrid is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * µGrid is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with µGrid; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * Additional permission under GNU GPL version 3 section 7
+ *
+ * If you modify this Program, or any covered work, by linking or combining it
+ * with proprietary FFT implementations or numerical libraries, containing parts
+ * covered by the terms of those libraries' licenses, the licensors of this
+ * Program grant you additional permission to convey the resulting work.
+ *
+ */
+
+#include "tests.hh"
+
+#include "libmugrid/field_collection_global.hh"
+#include "libmugrid/field_map_static.hh"
+#include "libmugrid/field_redistribution.hh"
+#include "libmugrid/field_typed.hh"
+
+namespace muGrid {
+
+  BOOST_AUTO_TEST_SUITE(field_redistribution);
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(storage_orders_and_ghosts) {
+    const DynCcoord_t nb_grid_pts{5, 4};
+    const std::string quad{"quad"};
+    const FieldCollection::SubPtMap_t nb_sub_pts{{quad, 2}};
+    GlobalFieldCollection source_fc{nb_grid_pts, nb_grid_pts, {},
+                                    nb_sub_pts, StorageOrder::ColMajor};
+    // structure of arrays, padded by ghost layers
+    GlobalFieldCollection target_fc{nb_grid_pts.get_dim(), nb_sub_pts,
+                                    StorageOrder::RowMajor};
+    target_fc.initialise(nb_grid_pts, nb_grid_pts, DynCcoord_t{0, 0},
+                         DynCcoord_t{1, 1}, DynCcoord_t{2, 1}, Communicator{},
+                         StorageOrder::ColMajor);
+    const Shape_t components_shape{2, 3};
+    auto & source{
+        source_fc.register_real_field("tensor", components_shape, quad)};
+    auto & target{
+        target_fc.register_real_field("tensor", components_shape, quad)};
+    source.eigen_vec().setRandom();
+    target.eigen_vec().setConstant(-1);
+
+    FieldRedistribution redistribution{source_fc, target_fc};
+    BOOST_CHECK_EQUAL(redistribution.get_nb_send_pixels(), 5 * 4);
+    BOOST_CHECK_EQUAL(redistribution.get_nb_recv_pixels(), 5 * 4);
+    redistribution.redistribute(source, target);
+
+    using Map_t = StridedMatrixFieldMap<Real, Mapping::Const, 2, 3,
+                                        IterUnit::SubPt>;
+    Map_t source_map{source}, target_map{target};
+    for (auto && ccoord : CcoordOps::DynamicPixels(nb_grid_pts)) {
+      for (Index_t q{0}; q < 2; ++q) {
+        BOOST_CHECK_EQUAL(
+            source_map[source_fc.get_index(ccoord) * 2 + q],
+            target_map[target_fc.get_index(ccoord) * 2 + q]);
+      }
+    }
+    // the ghosts are left alone
+    BOOST_CHECK_EQUAL(target.eigen_vec().minCoeff(), -1);
+
+    // the plan is replayed for other fields with the same layout
+    auto & source_scalar{source_fc.register_int_field("scalar", 1, quad)};
+    auto & target_scalar{target_fc.register_int_field("scalar", 1, quad)};
+    source_scalar.eigen_vec().setRandom();
+    redistribution.redistribute(source_scalar, target_scalar);
+    ScalarFieldMap<Int, Mapping::Const, IterUnit::SubPt> source_scalars{
+        source_scalar},
+        target_scalars{target_scalar};
+    for (auto && ccoord : CcoordOps::DynamicPixels(nb_grid_pts)) {
+      for (Index_t q{0}; q < 2; ++q) {
+        BOOST_CHECK_EQUAL(
+            source_scalars[source_fc.get_index(ccoord) * 2 + q],
+            target_scalars[target_fc.get_index(ccoord) * 2 + q]);
+      }
+    }
+
+    // fields need to match the collections and each other
+    auto & vector{
+        target_fc.register_real_field("vector", Shape_t{6}, quad)};
+    BOOST_CHECK_THROW(redistribution.redistribute(source, vector),
+                      FieldError);
+    BOOST_CHECK_THROW(redistribution.redistribute(target, source),
+                      FieldError);
+  }
+
+  BOOST_AUTO_TEST_SUITE_END();
+
+}  // namespace muGrid
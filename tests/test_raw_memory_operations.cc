@@ -37,7 +37,12 @@
 #include "test_goodies.hh"
 
 #include "libmugrid/raw_memory_operations.hh"
+#include "libmugrid/thread_pool.hh"
 
+#include <boost/mpl/list.hpp>
+
+#include <cstring>
+#include <numeric>
 #include <vector>
 
 
@@ -130,6 +135,123 @@ namespace muGrid {
     BOOST_CHECK_EQUAL(rel_error, 0);
   }
 
+  /* ---------------------------------------------------------------------- */
+  //! element of an unusual size, copied byte by byte
+  struct ThreeBytes {
+    char bytes[3];  //!< data
+  };
+
+  //! reference copy, one element at a time
+  template <typename T>
+  void naive_strided_copy(const Shape_t & shape, const Shape_t & in_strides,
+                          const Shape_t & out_strides, const T * input,
+                          T * output) {
+    Shape_t index(shape.size(), 0);
+    for (size_t count{0}; count < raw_mem_ops::prod(shape); ++count) {
+      output[raw_mem_ops::linear_index(index, out_strides)] =
+          input[raw_mem_ops::linear_index(index, in_strides)];
+      for (size_t i{0}; i < shape.size(); ++i) {
+        if (++index[i] < shape[i]) {
+          break;
+        }
+        index[i] = 0;
+      }
+    }
+  }
+
+  //! copy between a padded column-major array and a permuted one
+  template <typename T>
+  void check_permuted_copy(const Shape_t & shape, const Shape_t & permutation,
+                           ThreadPool * thread_pool) {
+    // input: column-major with one element of padding along the first axis
+    Shape_t padded_shape{shape};
+    padded_shape.front() += 1;
+    const Shape_t in_strides{raw_mem_ops::col_major_strides(padded_shape)};
+    // output: contiguous, axes stored in the order of `permutation`
+    Shape_t permuted_shape{};
+    for (auto && axis : permutation) {
+      permuted_shape.push_back(shape[axis]);
+    }
+    const Shape_t permuted_strides{
+        raw_mem_ops::col_major_strides(permuted_shape)};
+    Shape_t out_strides(shape.size());
+    for (size_t i{0}; i < permutation.size(); ++i) {
+      out_strides[permutation[i]] = permuted_strides[i];
+    }
+
+    const size_t nb_in{raw_mem_ops::prod(padded_shape)};
+    const size_t nb_out{raw_mem_ops::prod(shape)};
+    std::vector<T> input(nb_in);
+    auto * bytes{reinterpret_cast<unsigned char *>(input.data())};
+    for (size_t i{0}; i < nb_in * sizeof(T); ++i) {
+      bytes[i] = static_cast<unsigned char>((i * 7919) % 251);
+    }
+    std::vector<T> output(nb_out), reference(nb_out);
+    raw_mem_ops::strided_copy(shape, in_strides, out_strides, input.data(),
+                              output.data(), thread_pool);
+    naive_strided_copy(shape, in_strides, out_strides, input.data(),
+                       reference.data());
+    BOOST_CHECK_EQUAL(std::memcmp(output.data(), reference.data(),
+                                  nb_out * sizeof(T)),
+                      0);
+
+    // and back
+    std::vector<T> round_trip(nb_in), round_trip_reference(nb_in);
+    raw_mem_ops::strided_copy(shape, out_strides, in_strides, output.data(),
+                              round_trip.data(), thread_pool);
+    naive_strided_copy(shape, out_strides, in_strides, output.data(),
+                       round_trip_reference.data());
+    BOOST_CHECK_EQUAL(std::memcmp(round_trip.data(),
+                                  round_trip_reference.data(),
+                                  nb_in * sizeof(T)),
+                      0);
+  }
+
+  using CopyTypes =
+      boost::mpl::list<char, short, float, Real, Complex, ThreeBytes>;
+
+  BOOST_AUTO_TEST_CASE_TEMPLATE(permutations, T, CopyTypes) {
+    const std::vector<std::pair<Shape_t, Shape_t>> cases{
+        {{17}, {0}},
+        {{5, 7}, {0, 1}},
+        {{5, 7}, {1, 0}},
+        {{3, 1, 70}, {2, 1, 0}},
+        {{9, 65, 33}, {1, 0, 2}},
+        {{4, 3, 5, 6}, {3, 1, 0, 2}},
+        {{2, 3, 4, 5, 3}, {4, 2, 3, 0, 1}},
+        {{2, 2, 3, 2, 2, 3}, {5, 4, 3, 2, 1, 0}},
+        {{0, 4}, {1, 0}}};
+    ThreadPool thread_pool{3};
+    for (auto && shape_permutation : cases) {
+      check_permuted_copy<T>(shape_permutation.first, shape_permutation.second,
+                             nullptr);
+      check_permuted_copy<T>(shape_permutation.first, shape_permutation.second,
+                             &thread_pool);
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(threaded_transpose) {
+    // large enough to be split among the threads
+    const Index_t nb_components{3}, nb_pixels{40000};
+    const Shape_t shape{nb_components, nb_pixels};
+    const Shape_t aos_strides{1, nb_components}, soa_strides{nb_pixels, 1};
+    std::vector<Real> aos(nb_components * nb_pixels), soa(aos.size()),
+        back(aos.size());
+    std::iota(aos.begin(), aos.end(), 0);
+    ThreadPool thread_pool{4};
+    raw_mem_ops::strided_copy(shape, aos_strides, soa_strides, aos.data(),
+                              soa.data(), &thread_pool);
+    for (Index_t i{0}; i < nb_components; ++i) {
+      for (Index_t j{0}; j < nb_pixels; ++j) {
+        BOOST_CHECK_EQUAL(soa[i * nb_pixels + j], aos[i + j * nb_components]);
+      }
+    }
+    raw_mem_ops::strided_copy(shape, soa_strides, aos_strides, soa.data(),
+                              back.data(), &thread_pool);
+    BOOST_CHECK(aos == back);
+  }
+
   BOOST_AUTO_TEST_SUITE_END();
 
 }  // namespace muGrid
@@ -0,0 +1,284 @@
+/**
+ * @file   test_thread_communicator.cc
+ *
+ * @author Lars Pastewka <lars.pastewka@imtek.uni-freiburg.de>
+ *
+ * @date   16 Oct 2026
+ *
+ * @brief  Tests for the communicator on a group of threads
+ *
+ * Copyright © 2026 Lars Pastewka
+ *
+ * µGrid is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * µGrid is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with µGrid; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * Additional permission under GNU GPL version 3 section 7
+ *
+ * If you modify this Program, or any covered work, by linking or combining it
+ * with proprietary FFT implementations or numerical libraries, containing parts
+ * covered by the terms of those libraries' licenses, the licensors of this
+ * Program grant you additional permission to convey the resulting work.
+ *
+ */
+
+#include "tests.hh"
+
+#include "libmugrid/cartesian_decomposition.hh"
+#include "libmugrid/communicator.hh"
+#include "libmugrid/field_collection_global.hh"
+#include "libmugrid/field_linalg.hh"
+#include "libmugrid/field_map.hh"
+#include "libmugrid/field_redistribution.hh"
+#include "libmugrid/field_typed.hh"
+#include "libmugrid/reduction_batch.hh"
+
+#include <stdexcept>
+
+namespace muGrid {
+
+  // Boost.Test is not thread-safe, hence the ranks only record their results
+  // (each in its own slot) and the checks are done after all ranks finished
+  BOOST_AUTO_TEST_SUITE(thread_communicator);
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(collectives) {
+    const int nb_ranks{4};
+    std::vector<int> ranks(nb_ranks), sizes(nb_ranks);
+    std::vector<Real> sums(nb_ranks), cumulative_sums(nb_ranks);
+    // not std::vector<bool>, whose elements share memory
+    std::vector<Int> maxima(nb_ranks), broadcasts(nb_ranks), ands(nb_ranks),
+        ors(nb_ranks);
+    std::vector<DynMatrix_t<Real>> matrix_sums(nb_ranks), gathers(nb_ranks),
+        igathers(nb_ranks);
+    Communicator::run_on_threads(nb_ranks, [&](Communicator & comm) {
+      const int rank{comm.rank()};
+      ranks[rank] = rank;
+      sizes[rank] = comm.size();
+      sums[rank] = comm.sum(Real(rank + 1));
+      maxima[rank] = comm.imax(Int(10 * rank)).wait();
+      cumulative_sums[rank] = comm.cumulative_sum(Real(rank + 1));
+      Int value{rank == 2 ? 42 : -1};
+      broadcasts[rank] = comm.bcast(value, 2);
+      ands[rank] = comm.logical_and(rank != 1);
+      ors[rank] = comm.logical_or(rank == 1);
+      DynMatrix_t<Real> matrix{DynMatrix_t<Real>::Constant(2, 3, rank)};
+      matrix_sums[rank] = comm.sum(Eigen::Ref<DynMatrix_t<Real>>(matrix));
+      // rank r contributes r columns, rank 0 an empty matrix
+      DynMatrix_t<Real> columns{DynMatrix_t<Real>::Constant(
+          rank == 0 ? 0 : 2, rank, rank)};
+      gathers[rank] = comm.gather(Eigen::Ref<DynMatrix_t<Real>>(columns));
+      igathers[rank] =
+          comm.igather(Eigen::Ref<DynMatrix_t<Real>>(columns)).wait();
+    });
+
+    DynMatrix_t<Real> gathered(2, 6);
+    gathered << 1, 2, 2, 3, 3, 3, 1, 2, 2, 3, 3, 3;
+    for (int rank{0}; rank < nb_ranks; ++rank) {
+      BOOST_CHECK_EQUAL(ranks[rank], rank);
+      BOOST_CHECK_EQUAL(sizes[rank], nb_ranks);
+      BOOST_CHECK_EQUAL(sums[rank], 10);
+      BOOST_CHECK_EQUAL(maxima[rank], 30);
+      BOOST_CHECK_EQUAL(cumulative_sums[rank], (rank + 1) * (rank + 2) / 2);
+      BOOST_CHECK_EQUAL(broadcasts[rank], 42);
+      BOOST_CHECK(not ands[rank]);
+      BOOST_CHECK(ors[rank]);
+      BOOST_CHECK_EQUAL(matrix_sums[rank],
+                        DynMatrix_t<Real>::Constant(2, 3, 6));
+      BOOST_CHECK_EQUAL(gathers[rank], gathered);
+      BOOST_CHECK_EQUAL(igathers[rank], gathered);
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(point_to_point) {
+    const int nb_ranks{3};
+    std::vector<Index_t> from_left(nb_ranks), from_right(nb_ranks),
+        exchanged(nb_ranks);
+    Communicator::run_on_threads(nb_ranks, [&](Communicator & comm) {
+      const int rank{comm.rank()};
+      const int left{(rank + nb_ranks - 1) % nb_ranks};
+      const int right{(rank + 1) % nb_ranks};
+      // the receives are posted before the matching sends
+      std::vector<Communicator::Request> requests{};
+      requests.push_back(comm.irecv(&from_left[rank], 1, left, 0));
+      requests.push_back(comm.irecv(&from_right[rank], 1, right, 1));
+      const Index_t message{10 * rank};
+      requests.push_back(comm.isend(&message, 1, right, 0));
+      requests.push_back(comm.isend(&message, 1, left, 1));
+      comm.wait_all(requests);
+      comm.sendrecv(&message, 1, right, &exchanged[rank], 1, left);
+    });
+    for (int rank{0}; rank < nb_ranks; ++rank) {
+      BOOST_CHECK_EQUAL(from_left[rank], 10 * ((rank + 2) % nb_ranks));
+      BOOST_CHECK_EQUAL(from_right[rank], 10 * ((rank + 1) % nb_ranks));
+      BOOST_CHECK_EQUAL(exchanged[rank], from_left[rank]);
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(failing_rank_aborts_group) {
+    // the other ranks would wait forever in the barrier if the failing rank
+    // did not abort the group
+    BOOST_CHECK_THROW(
+        Communicator::run_on_threads(3,
+                                     [](Communicator & comm) {
+                                       if (comm.rank() == 1) {
+                                         throw std::logic_error("failure");
+                                       }
+                                       comm.barrier();
+                                     }),
+        std::logic_error);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(reduction_batch) {
+    const int nb_ranks{3};
+    std::vector<Real> sums(nb_ranks);
+    std::vector<Int> maxima(nb_ranks);
+    std::vector<Index_t> minima(nb_ranks);
+    Communicator::run_on_threads(nb_ranks, [&](Communicator & comm) {
+      const int rank{comm.rank()};
+      ReductionBatch batch{comm};
+      auto sum{batch.sum(Real(rank) + 0.5)};
+      auto max{batch.max(Int(rank))};
+      auto min{batch.min(Index_t{rank - 7})};
+      batch.flush();
+      sums[rank] = batch.get(sum);
+      maxima[rank] = batch.get(max);
+      minima[rank] = batch.get(min);
+    });
+    for (int rank{0}; rank < nb_ranks; ++rank) {
+      BOOST_CHECK_EQUAL(sums[rank], 4.5);
+      BOOST_CHECK_EQUAL(maxima[rank], 2);
+      BOOST_CHECK_EQUAL(minima[rank], -7);
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(ghost_exchange) {
+    const int nb_ranks{4};
+    const DynCcoord_t nb_domain_grid_pts{8, 6};
+    auto && value{[](const DynCcoord_t & ccoord, const Index_t & dof) {
+      return 1000 * dof + 10 * ccoord[0] + ccoord[1];
+    }};
+    std::vector<Index_t> nb_subdivisions(nb_ranks), nb_wrong(nb_ranks);
+    Communicator::run_on_threads(nb_ranks, [&](Communicator & comm) {
+      CartesianDecomposition decomposition{nb_domain_grid_pts, comm};
+      GlobalFieldCollection fc{nb_domain_grid_pts.get_dim()};
+      decomposition.initialise(fc, DynCcoord_t{1, 2}, DynCcoord_t{2, 1});
+      nb_subdivisions[comm.rank()] = decomposition.get_nb_subdivisions()[0] *
+                                     decomposition.get_nb_subdivisions()[1];
+
+      auto & field{fc.register_real_field("field", 2)};
+      field.eigen_vec().setConstant(-1);
+      auto && map{field.get_pixel_map()};
+      for (auto && ccoord :
+           CcoordOps::DynamicPixels(fc.get_nb_subdomain_grid_pts(),
+                                    fc.get_subdomain_locations())) {
+        auto && pixel_vals{map[fc.get_pixels().get_index(ccoord)]};
+        for (Index_t dof{0}; dof < pixel_vals.size(); ++dof) {
+          pixel_vals(dof) = value(ccoord, dof);
+        }
+      }
+      field.communicate_ghosts();
+
+      for (auto && id_ccoord : fc.get_pixels().enumerate()) {
+        auto && pixel_vals{map[std::get<0>(id_ccoord)]};
+        DynCcoord_t ccoord{(std::get<1>(id_ccoord) + nb_domain_grid_pts) %
+                           nb_domain_grid_pts};
+        for (Index_t dof{0}; dof < pixel_vals.size(); ++dof) {
+          nb_wrong[comm.rank()] += pixel_vals(dof) != value(ccoord, dof);
+        }
+      }
+    });
+    for (int rank{0}; rank < nb_ranks; ++rank) {
+      BOOST_CHECK_EQUAL(nb_subdivisions[rank], nb_ranks);
+      BOOST_CHECK_EQUAL(nb_wrong[rank], 0);
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(redistribution_slabs_to_pencils) {
+    const int nb_ranks{3};
+    const DynCcoord_t nb_domain_grid_pts{6, 5, 4};
+    auto && value{[](const DynCcoord_t & ccoord, const Index_t & dof) {
+      return 1000 * dof + 100 * ccoord[0] + 10 * ccoord[1] + ccoord[2];
+    }};
+    std::vector<Index_t> nb_wrong(nb_ranks);
+    Communicator::run_on_threads(nb_ranks, [&](Communicator & comm) {
+      CartesianDecomposition slabs{nb_domain_grid_pts, comm,
+                                   DynCcoord_t{1, 1, comm.size()}};
+      CartesianDecomposition pencils{nb_domain_grid_pts, comm,
+                                     DynCcoord_t{0, 0, 1}};
+      GlobalFieldCollection source_fc{nb_domain_grid_pts.get_dim()};
+      GlobalFieldCollection target_fc{nb_domain_grid_pts.get_dim()};
+      slabs.initialise(source_fc);
+      pencils.initialise(target_fc);
+      auto & source{source_fc.register_real_field("field", 3)};
+      auto & target{target_fc.register_real_field("field", 3)};
+      auto && source_map{source.get_pixel_map()};
+      for (auto && ccoord :
+           CcoordOps::DynamicPixels(source_fc.get_nb_subdomain_grid_pts(),
+                                    source_fc.get_subdomain_locations())) {
+        auto && values{source_map[source_fc.get_index(ccoord)]};
+        for (Index_t dof{0}; dof < values.size(); ++dof) {
+          values(dof) = value(ccoord, dof);
+        }
+      }
+
+      FieldRedistribution{source_fc, target_fc, comm}.redistribute(source,
+                                                                   target);
+      auto && target_map{target.get_pixel_map()};
+      for (auto && ccoord :
+           CcoordOps::DynamicPixels(target_fc.get_nb_subdomain_grid_pts(),
+                                    target_fc.get_subdomain_locations())) {
+        auto && values{target_map[target_fc.get_index(ccoord)]};
+        for (Index_t dof{0}; dof < values.size(); ++dof) {
+          nb_wrong[comm.rank()] += values(dof) != value(ccoord, dof);
+        }
+      }
+    });
+    for (int rank{0}; rank < nb_ranks; ++rank) {
+      BOOST_CHECK_EQUAL(nb_wrong[rank], 0);
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(shared_linalg_thread_pool) {
+    // the ranks allocate and reduce fields large enough to be split over the
+    // threads of the linear algebra, all using its one pool
+    const int nb_ranks{3};
+    const DynCcoord_t nb_domain_grid_pts{256, 288};
+    const Index_t nb_components{3};
+    std::vector<Real> dots(nb_ranks);
+    linalg::set_nb_threads(2);
+    Communicator::run_on_threads(nb_ranks, [&](Communicator & comm) {
+      CartesianDecomposition decomposition{nb_domain_grid_pts, comm};
+      GlobalFieldCollection fc{nb_domain_grid_pts.get_dim()};
+      decomposition.initialise(fc);
+      auto & field{fc.register_real_field("field", nb_components)};
+      linalg::fill(Real{1}, field);
+      dots[comm.rank()] = linalg::dot(field, field);
+    });
+    linalg::set_nb_threads(1);
+    for (int rank{0}; rank < nb_ranks; ++rank) {
+      BOOST_CHECK_EQUAL(dots[rank], nb_domain_grid_pts[0] *
+                                        nb_domain_grid_pts[1] * nb_components);
+    }
+  }
+
+  BOOST_AUTO_TEST_SUITE_END();
+
+}  // namespace muGrid
@@ -0,0 +1,156 @@
+/**
+ * @file   test_thread_pool.cc
+ *
+ * @author Lars Pastewka <lars.pastewka@imtek.uni-freiburg.de>
+ *
+ * @date   16 Oct 2026
+ *
+ * @brief  Tests for the thread pool
+ *
+ * Copyright © 2026 Lars Pastewka
+ *
+ * µGrid is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * µGrid is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with µGrid; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * Additional permission under GNU GPL version 3 section 7
+ *
+ * If you modify this Program, or any covered work, by linking or combining it
+ * with proprietary FFT implementations or numerical libraries, containing parts
+ * covered by the terms of those libraries' licenses, the licensors of this
+ * Program grant you additional permission to convey the resulting work.
+ *
+ */
+
+
+#include "tests.hh"
+
+#include "libmugrid/thread_pool.hh"
+#include "libmugrid/exception.hh"
+
+#include <atomic>
+#include <numeric>
+#include <thread>
+
+namespace muGrid {
+
+  BOOST_AUTO_TEST_SUITE(thread_pool);
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(chunks_cover_range) {
+    const Index_t begin{3}, end{20};
+    for (Index_t nb_chunks{1}; nb_chunks < 25; ++nb_chunks) {
+      Index_t expected_begin{begin};
+      for (Index_t chunk{0}; chunk < nb_chunks; ++chunk) {
+        auto && range{ThreadPool::get_chunk(begin, end, nb_chunks, chunk)};
+        BOOST_CHECK_EQUAL(std::get<0>(range), expected_begin);
+        BOOST_CHECK_LE(std::get<1>(range) - std::get<0>(range),
+                       (end - begin) / nb_chunks + 1);
+        BOOST_CHECK_GE(std::get<1>(range) - std::get<0>(range),
+                       (end - begin) / nb_chunks);
+        expected_begin = std::get<1>(range);
+      }
+      BOOST_CHECK_EQUAL(expected_begin, end);
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(run_and_parallel_for) {
+    for (Index_t nb_threads{1}; nb_threads < 5; ++nb_threads) {
+      ThreadPool pool{nb_threads};
+      BOOST_CHECK_EQUAL(pool.get_nb_threads(), nb_threads);
+
+      // every thread executes the task exactly once
+      std::vector<Index_t> calls(nb_threads, 0);
+      for (Index_t i{0}; i < 10; ++i) {
+        pool.run([&calls](const Index_t & thread_id) { ++calls[thread_id]; });
+      }
+      for (auto && nb_calls : calls) {
+        BOOST_CHECK_EQUAL(nb_calls, 10);
+      }
+
+      // every index is visited exactly once
+      std::vector<Index_t> visits(101, 0);
+      pool.parallel_for(0, 101,
+                        [&visits](const Index_t & begin, const Index_t & end) {
+                          for (Index_t i{begin}; i < end; ++i) {
+                            ++visits[i];
+                          }
+                        });
+      BOOST_CHECK_EQUAL(
+          std::accumulate(visits.begin(), visits.end(), Index_t{0}), 101);
+      for (auto && nb_visits : visits) {
+        BOOST_CHECK_EQUAL(nb_visits, 1);
+      }
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(exceptions_are_rethrown) {
+    ThreadPool pool{3};
+    BOOST_CHECK_THROW(pool.run([](const Index_t & thread_id) {
+      if (thread_id == 2) {
+        throw RuntimeError("failure on a worker");
+      }
+    }),
+                      RuntimeError);
+    // the pool remains usable after a failed task
+    std::atomic<Index_t> nb_calls{0};
+    pool.run([&nb_calls](const Index_t &) { ++nb_calls; });
+    BOOST_CHECK_EQUAL(nb_calls, 3);
+
+    BOOST_CHECK_THROW(ThreadPool{0}, RuntimeError);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  BOOST_AUTO_TEST_CASE(busy_pool_runs_serially) {
+    // a task submitted from within a task of the same pool runs on the
+    // submitting thread, once per thread id
+    ThreadPool pool{3};
+    std::vector<std::vector<Index_t>> calls(3, std::vector<Index_t>(3, 0));
+    pool.run([&pool, &calls](const Index_t & outer_id) {
+      pool.run([&calls, &outer_id](const Index_t & inner_id) {
+        ++calls[outer_id][inner_id];
+      });
+    });
+    for (auto && inner_calls : calls) {
+      for (auto && nb_calls : inner_calls) {
+        BOOST_CHECK_EQUAL(nb_calls, 1);
+      }
+    }
+
+    // and so do tasks submitted concurrently from several threads
+    std::vector<Index_t> visits(2 * 1001, 0);
+    auto && visit{[&pool, &visits](const Index_t & offset) {
+      for (Index_t i{0}; i < 20; ++i) {
+        pool.parallel_for(offset, offset + 1001,
+                          [&visits](const Index_t & begin,
+                                    const Index_t & end) {
+                            for (Index_t j{begin}; j < end; ++j) {
+                              ++visits[j];
+                            }
+                          });
+      }
+    }};
+    std::thread other{visit, 1001};
+    visit(0);
+    other.join();
+    for (auto && nb_visits : visits) {
+      BOOST_CHECK_EQUAL(nb_visits, 20);
+    }
+  }
+
+  BOOST_AUTO_TEST_SUITE_END();
+
+}  // namespace muGrid
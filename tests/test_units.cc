@@ -197,6 +197,10 @@ namespace muGrid {
 
     BOOST_CHECK_NO_THROW(l2 * l2);
     BOOST_CHECK_NO_THROW(t2 * l2);
+
+    // the reciprocal keeps the tag
+    BOOST_CHECK_EQUAL(l2.reciprocal(), Unit::unitless(SomeTag) / l2);
+    BOOST_CHECK_THROW(l1 * l2.reciprocal(), UnitError);
   }
 
   /* ---------------------------------------------------------------------- */